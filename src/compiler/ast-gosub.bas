@@ -1,4 +1,4 @@
-'' ast support for GOSUB/RETURN (for asm and setjmp/longjmp implementations)
+'' ast support for GOSUB/RETURN (for asm, index dispatch and setjmp/longjmp implementations)
 ''
 '' chng: apr/2008 written [jeffm]
 
@@ -14,16 +14,23 @@
 
 '' -gen option is used to select the GOSUB implementation:
 ''     - GAS backend will use CALL/RET
-''     - C backend will use setjmp/longjmp
-'' However, setjmp/longjmp implementation will also work with the GAS backend,
+''     - C and LLVM backends will push the index of the return point on a
+''       stack of FB_GOSUBSTACKSIZE entries in the procedure frame (deeper
+''       nesting goes to a heap block managed by the rtlib), and RETURN
+''       pops it and jumps through a jump table built at the end of the proc
+'' However, setjmp/longjmp implementation will also work with all backends,
 '' but since it is like 1000 times slower than CALL/RET, it isn't.  To explicitly
-'' select setjmp/longjmp implementation with ASM backend, use "-z gosub-with-setjmp"
-'' on the command line (jeffm)
+'' select setjmp/longjmp implementation (which has no nesting limit), use
+'' "-z gosub-with-setjmp" on the command line (jeffm)
 ''
 #define AsmBackend() _
 	( (env.clopt.backend = FB_BACKEND_GAS) and _
 	  (env.clopt.gosubsetjmp = FALSE) )
 
+#define DispatchGosub() _
+	( (env.clopt.backend <> FB_BACKEND_GAS) and _
+	  (env.clopt.gosubsetjmp = FALSE) )
+
 sub astGosubAddInit( byval proc as FBSYMBOL ptr )
 	dim as FBARRAYDIM dTB(0) = any
 	dim as FBSYMBOL ptr sym = any
@@ -42,6 +49,35 @@ sub astGosubAddInit( byval proc as FBSYMBOL ptr )
 
 		'' DIM "{gosubctx}" as integer = 0
 		dtype = FB_DATATYPE_INTEGER
+	elseif( DispatchGosub() ) then
+		'' DIM "{gosubctx}" as uinteger = 0 (stack depth)
+		dtype = FB_DATATYPE_UINT
+
+		'' DIM "{gosubstk}"(0 to FB_GOSUBSTACKSIZE-1) as uinteger
+		'' no need to clear it, entries are only read after being pushed
+		dTB(0).lower = 0
+		dTB(0).upper = FB_GOSUBSTACKSIZE - 1
+		sym = symbAddVar( symbUniqueId( ), NULL, FB_DATATYPE_UINT, NULL, 0, _
+		                  1, dTB(), 0, FB_SYMBOPT_UNSCOPE )
+		symbSetIsImplicit( sym )
+		symbSetIsDeclared( sym )
+		astAddUnscoped( astNewDECL( sym, FALSE ) )
+		proc->proc.ext->gosub.stk = sym
+
+		'' DIM "{gosubovf}" as uinteger ptr = NULL
+		'' entries beyond FB_GOSUBSTACKSIZE, freed at the proc's exit
+		sym = symbAddImplicitVar( typeAddrOf( FB_DATATYPE_UINT ), NULL, FB_SYMBOPT_UNSCOPE )
+		symbSetIsDeclared( sym )
+		astAddUnscoped( astNewDECL( sym, TRUE ) )
+		proc->proc.ext->gosub.ovf = sym
+
+		'' DIM "{gosubret}" as uinteger
+		sym = symbAddImplicitVar( FB_DATATYPE_UINT, NULL, FB_SYMBOPT_UNSCOPE )
+		symbSetIsDeclared( sym )
+		astAddUnscoped( astNewDECL( sym, FALSE ) )
+		proc->proc.ext->gosub.ret = sym
+
+		proc->proc.ext->gosub.dispatchlabel = symbAddLabel( NULL )
 	else
 
 		'' create a local pointer to the gosub stack
@@ -64,6 +100,64 @@ sub astGosubAddInit( byval proc as FBSYMBOL ptr )
 	symbSetProcStatGosub( proc )
 end sub
 
+'' {gosubstk}({gosubctx})
+private function hStackTop( byval proc as FBSYMBOL ptr ) as ASTNODE ptr
+	function = astNewIDX( astNewVAR( proc->proc.ext->gosub.stk ), _
+	                      astNewBOP( AST_OP_MUL, _
+	                                 astNewVAR( symbGetProcGosubSym( proc ) ), _
+	                                 astNewCONSTi( symbGetLen( proc->proc.ext->gosub.stk ), FB_DATATYPE_UINT ) ) )
+end function
+
+'' Push the index of the return point, the caller emits the label after the jump
+private sub hDispatchPush _
+	( _
+		byval proc as FBSYMBOL ptr, _
+		byval retlabel as FBSYMBOL ptr _
+	)
+
+	dim as FBSYMBOL ptr label = any, endlabel = any
+
+	'' add the return point to the proc's list
+	with proc->proc.ext->gosub
+		.labels = xreallocate( .labels, sizeof( FBSYMBOL ptr ) * (.labelcount + 1) )
+		.labels[.labelcount] = retlabel
+		.labelcount += 1
+	end with
+
+	'' if( ctx < FB_GOSUBSTACKSIZE ) then
+	label = symbAddLabel( NULL )
+
+	astAdd( astBuildBranch( _
+			astNewBOP( AST_OP_LT, _
+				astNewVAR( symbGetProcGosubSym( proc ) ), _
+				astNewCONSTi( FB_GOSUBSTACKSIZE, FB_DATATYPE_UINT ) ), _
+		  label, _
+		  FALSE ) )
+
+	'' stk(ctx) = index
+	astAdd( astNewASSIGN( hStackTop( proc ), _
+			astNewCONSTi( proc->proc.ext->gosub.labelcount - 1, FB_DATATYPE_UINT ) ) )
+
+	'' else
+	endlabel = symbAddLabel( NULL )
+	astAdd( astNewBRANCH( AST_OP_JMP, endlabel ) )
+	astAdd( astNewLABEL( label ) )
+
+	'' fb_GosubStackPush( @ovf, ctx - FB_GOSUBSTACKSIZE, index )
+	'' (out of memory: error set/thrown, RETURN leaves the proc)
+	rtlGosubStackPush( astNewADDROF( astNewVAR( proc->proc.ext->gosub.ovf ) ), _
+	                   astNewBOP( AST_OP_SUB, _
+	                              astNewVAR( symbGetProcGosubSym( proc ) ), _
+	                              astNewCONSTi( FB_GOSUBSTACKSIZE, FB_DATATYPE_UINT ) ), _
+	                   astNewCONSTi( proc->proc.ext->gosub.labelcount - 1, FB_DATATYPE_UINT ) )
+
+	'' end if
+	astAdd( astNewLABEL( endlabel ) )
+
+	'' ctx += 1
+	astAdd( astBuildVarInc( symbGetProcGosubSym( proc ), 1 ) )
+end sub
+
 sub astGosubAddJmp _
 	( _
 		byval proc as FBSYMBOL ptr, _
@@ -80,6 +174,17 @@ sub astGosubAddJmp _
 		astAdd( astBuildVarInc( symbGetProcGosubSym( proc ), 1 ) )
 
 		astAdd( astNewBRANCH( AST_OP_CALL, l ) )
+	elseif( DispatchGosub() ) then
+		label = symbAddLabel( NULL )
+
+		'' push index of label
+		hDispatchPush( proc, label )
+
+		'' goto l
+		astAdd( astNewBRANCH( AST_OP_JMP, l ) )
+
+		'' return point
+		astAdd( astNewLABEL( label ) )
 	else
 		'' if ( setjmp( fb_GosubPush( @ctx ) ) ) = 0 ) then
 		label = symbAddLabel( NULL )
@@ -120,6 +225,12 @@ sub astGosubAddJumpPtr _
 		astAdd( astNewSTACK( AST_OP_PUSH, _
 				astNewADDROF( astNewVAR( exitlabel ) ) ) )
 
+		'' goto table[expr]
+		astAdd( jumptb )
+	elseif( DispatchGosub() ) then
+		'' push index of exit label
+		hDispatchPush( proc, exitlabel )
+
 		'' goto table[expr]
 		astAdd( jumptb )
 	else
@@ -206,6 +317,45 @@ function astGosubAddReturn _
 
 		function = TRUE
 
+	elseif( DispatchGosub() ) then
+
+		'' if( ctx <> 0 ) then
+		label = symbAddLabel( NULL )
+
+		astAdd( astBuildBranch( _
+				astNewBOP( AST_OP_NE, _
+					astNewVAR( symbGetProcGosubSym( proc ) ), _
+					astNewCONSTi( 0, FB_DATATYPE_UINT ) ), _
+			  label, _
+			  FALSE ) )
+
+		'' RETURN: goto the dispatcher, it pops the index
+		if( l = NULL ) then
+			astAdd( astNewBRANCH( AST_OP_JMP, proc->proc.ext->gosub.dispatchlabel ) )
+
+		'' RETURN [label]
+		else
+			'' ctx -= 1
+			astAdd( astBuildVarInc( symbGetProcGosubSym( proc ), -1 ) )
+
+			'' GOTO label
+			astAdd( astNewBRANCH( AST_OP_JMP, l ) )
+		end if
+
+		'' else
+		astAdd( astNewLABEL( label ) )
+
+		'' set/throw error
+		rtlErrorSetNum( astNewCONSTi( FB_RTERROR_RETURNWITHOUTGOSUB ) )
+		if( env.clopt.errorcheck ) then
+			rtlErrorThrow( astNewCONSTi( FB_RTERROR_RETURNWITHOUTGOSUB ), _
+								lexLineNum( ), env.inf.name )
+		end if
+
+		'' end if
+
+		function = TRUE
+
 	else
 
 		'' RETURN
@@ -252,9 +402,80 @@ function astGosubAddReturn _
 
 end function
 
+'' RETURN's dispatcher, emitted behind the proc's exit label (and skipped there):
+''    ctx -= 1
+''    if( ctx < FB_GOSUBSTACKSIZE ) then
+''        ret = stk(ctx)
+''    else
+''        ret = fb_GosubStackGet( ovf, ctx - FB_GOSUBSTACKSIZE )
+''    end if
+''    goto table[ret]
+'' followed by the freeing of the overflow block, if any
+private sub hAddDispatcher( byval proc as FBSYMBOL ptr )
+	dim as FBSYMBOL ptr skiplabel = any, label = any, endlabel = any
+	dim as ulongint ptr values = any
+
+	skiplabel = symbAddLabel( NULL )
+	astAdd( astNewBRANCH( AST_OP_JMP, skiplabel ) )
+
+	with proc->proc.ext->gosub
+		astAdd( astNewLABEL( .dispatchlabel ) )
+
+		astAdd( astBuildVarInc( symbGetProcGosubSym( proc ), -1 ) )
+
+		label = symbAddLabel( NULL )
+		astAdd( astBuildBranch( _
+				astNewBOP( AST_OP_LT, _
+					astNewVAR( symbGetProcGosubSym( proc ) ), _
+					astNewCONSTi( FB_GOSUBSTACKSIZE, FB_DATATYPE_UINT ) ), _
+			  label, _
+			  FALSE ) )
+
+		astAdd( astNewASSIGN( astNewVAR( .ret ), hStackTop( proc ) ) )
+
+		endlabel = symbAddLabel( NULL )
+		astAdd( astNewBRANCH( AST_OP_JMP, endlabel ) )
+		astAdd( astNewLABEL( label ) )
+
+		astAdd( astNewASSIGN( astNewVAR( .ret ), _
+				rtlGosubStackGet( astNewVAR( .ovf ), _
+					astNewBOP( AST_OP_SUB, _
+						astNewVAR( symbGetProcGosubSym( proc ) ), _
+						astNewCONSTi( FB_GOSUBSTACKSIZE, FB_DATATYPE_UINT ) ) ) ) )
+
+		astAdd( astNewLABEL( endlabel ) )
+
+		values = xallocate( sizeof( ulongint ) * (.labelcount + 1) )
+		for i as integer = 0 to .labelcount - 1
+			values[i] = i
+		next
+
+		'' the default is only taken if fb_GosubStackPush() failed
+		astAdd( astBuildJMPTB( .ret, values, .labels, .labelcount, skiplabel, _
+		                       0, iif( .labelcount > 0, .labelcount - 1, 0 ) ) )
+
+		deallocate( values )
+
+		astAdd( astNewLABEL( skiplabel ) )
+
+		'' if( ovf <> NULL ) then fb_GosubStackExit( @ovf )
+		label = symbAddLabel( NULL )
+		astAdd( astBuildBranch( _
+				astNewBOP( AST_OP_NE, _
+					astNewVAR( .ovf ), _
+					astNewCONSTi( 0, typeAddrOf( FB_DATATYPE_UINT ) ) ), _
+			  label, _
+			  FALSE ) )
+		astAdd( rtlGosubStackExit( astNewADDROF( astNewVAR( .ovf ) ) ) )
+		astAdd( astNewLABEL( label ) )
+	end with
+end sub
+
 sub astGosubAddExit(byval proc as FBSYMBOL ptr)
 	if( symbGetProcStatGosub( proc ) ) then
-		if( AsmBackend() = FALSE ) then
+		if( DispatchGosub() ) then
+			hAddDispatcher( proc )
+		elseif( AsmBackend() = FALSE ) then
 			astAdd( rtlGosubExit( astNewADDROF( astNewVAR( symbGetProcGosubSym( proc ) ) ) ) )
 		end if
 	end if
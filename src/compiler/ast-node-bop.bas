@@ -714,6 +714,120 @@ private function hShouldWarnAboutMixedBool( byval l as ASTNODE ptr, byval r as A
 	return FALSE
 end function
 
+private function hIsVector( byval n as ASTNODE ptr ) as integer
+	if( astGetDataType( n ) = FB_DATATYPE_STRUCT ) then
+		function = symbGetUdtIsVector( n->subtype )
+	else
+		function = FALSE
+	end if
+end function
+
+'' operand of a VECTOR BOP: the same VECTOR type, or a scalar, converted
+'' to the element type
+private function hVectorOperand _
+	( _
+		byref n as ASTNODE ptr, _
+		byval subtype as FBSYMBOL ptr _
+	) as integer
+
+	function = FALSE
+
+	if( astGetDataType( n ) = FB_DATATYPE_STRUCT ) then
+		function = (n->subtype = subtype)
+		exit function
+	end if
+
+	select case( typeGetClass( astGetDataType( n ) ) )
+	case FB_DATACLASS_INTEGER, FB_DATACLASS_FPOINT
+		if( typeIsPtr( astGetDataType( n ) ) ) then
+			exit function
+		end if
+
+		n = astNewCONV( typeGetDtAndPtrOnly( symbGetUdtVectorDtype( subtype ) ), NULL, n )
+		function = (n <> NULL)
+	end select
+
+end function
+
+'' element-wise arithmetic, bitwise and shift operators on VECTOR types,
+'' for the C backend's gcc vector types
+private function hVectorBOP _
+	( _
+		byval op as integer, _
+		byval l as ASTNODE ptr, _
+		byval r as ASTNODE ptr _
+	) as ASTNODE ptr
+
+	dim as ASTNODE ptr n = any
+	dim as FBSYMBOL ptr subtype = any
+	dim as integer dclass = any
+
+	function = NULL
+
+	if( hIsVector( l ) ) then
+		subtype = l->subtype
+	else
+		subtype = r->subtype
+	end if
+
+	dclass = typeGetClass( symbGetUdtVectorDtype( subtype ) )
+
+	select case as const( op )
+	case AST_OP_ADD, AST_OP_SUB, AST_OP_MUL
+
+	'' '/' only on floats, '\' and the rest only on integers, no
+	'' conversions like with scalars
+	case AST_OP_DIV
+		if( dclass <> FB_DATACLASS_FPOINT ) then
+			exit function
+		end if
+
+	case AST_OP_INTDIV, AST_OP_MOD, AST_OP_AND, AST_OP_OR, AST_OP_XOR, _
+	     AST_OP_SHL, AST_OP_SHR
+		if( dclass <> FB_DATACLASS_INTEGER ) then
+			exit function
+		end if
+
+	case else
+		exit function
+	end select
+
+	if( (hVectorOperand( l, subtype ) = FALSE) or _
+	    (hVectorOperand( r, subtype ) = FALSE) ) then
+		exit function
+	end if
+
+	if( env.clopt.backend <> FB_BACKEND_GCC ) then
+		errReport( FB_ERRMSG_VECTOROPWITHOUTGENGCC )
+		exit function
+	end if
+
+	n = astNewNode( AST_NODECLASS_BOP, FB_DATATYPE_STRUCT, subtype )
+	n->l = l
+	n->r = r
+	n->op.ex = NULL
+	n->op.op = op
+	n->op.options = AST_OPOPT_ALLOCRES
+
+	function = astBuildVectorResult( n )
+end function
+
+'' Store a VECTOR BOP/UOP into a temp var and access that, so it can be used
+'' like any other UDT in memory (field accesses, BYREF args, copies)
+function astBuildVectorResult( byval expr as ASTNODE ptr ) as ASTNODE ptr
+	dim as ASTNODE ptr n = any
+	dim as FBSYMBOL ptr tmp = any
+
+	tmp = symbAddTempVar( FB_DATATYPE_STRUCT, expr->subtype )
+
+	'' a plain ASSIGN, not astNewASSIGN()'s UDT copy from memory
+	n = astNewNode( AST_NODECLASS_ASSIGN, FB_DATATYPE_STRUCT, expr->subtype )
+	n->l = astNewVAR( tmp )
+	n->r = expr
+
+	function = astNewLINK( n, astNewVAR( tmp ), FALSE ) '' ASSIGN first, but return the VAR
+end function
+
 '':::::
 function astNewBOP _
 	( _
@@ -760,6 +874,11 @@ function astNewBOP _
 	if( (typeGet( ldtype ) = FB_DATATYPE_STRUCT) or _
 		(typeGet( rdtype ) = FB_DATATYPE_STRUCT) ) then
 
+		'' VECTOR types? built-in operators
+		if( hIsVector( l ) or hIsVector( r ) ) then
+			return hVectorBOP( op, l, r )
+		end if
+
 		'' recursion?
 		if( (options and AST_OPOPT_NOCOERCION) <> 0 ) then
 			exit function
@@ -65,10 +65,94 @@ function astNewBOUNDCHK _
     '' check must be done using a function because calling ErrorThrow
     '' would spill used regs only if it was called, causing wrong
     '' assumptions after the branches
+    '' (the high-level backends don't have that problem, they compare inline
+    '' and only call the function when the check fails, see astLoadBOUNDCHK())
 	n->r = rtlArrayBoundsCheck( astNewVAR( n->sym ), lb, ub, linenum, filename )
 
 end function
 
+'' Returns the expression passed to the given (1-based) parameter of a CALL
+private function hGetCallArg _
+	( _
+		byval callexpr as ASTNODE ptr, _
+		byval index as integer _
+	) as ASTNODE ptr
+
+	dim as FBSYMBOL ptr param = any
+	dim as ASTNODE ptr arg = any
+
+	param = symbGetProcHeadParam( callexpr->sym )
+	while( index > 1 )
+		param = symbGetParamNext( param )
+		index -= 1
+	wend
+
+	arg = callexpr->r
+	while( arg )
+		if( arg->sym = param ) then
+			return arg->l
+		end if
+		arg = arg->r
+	wend
+
+	function = NULL
+end function
+
+'' Gets the lbound/ubound passed to a BOUNDCHK's checking function,
+'' lb = NULL if it's fb_ArraySngBoundChk() (lbound 0)
+private sub hGetBoundChkBounds _
+	( _
+		byval n as ASTNODE ptr, _
+		byref lb as ASTNODE ptr, _
+		byref ub as ASTNODE ptr _
+	)
+
+	'' (idx, ubound, linenum, module)
+	if( symbGetProcParams( n->r->sym ) = 4 ) then
+		lb = NULL
+		ub = hGetCallArg( n->r, 2 )
+	'' (idx, lbound, ubound, linenum, module)
+	else
+		lb = hGetCallArg( n->r, 2 )
+		ub = hGetCallArg( n->r, 3 )
+	end if
+
+end sub
+
+'' Emit "if index within bounds then goto label" in front of the checking
+'' call, so the call is only made when the check fails
+private sub hLoadInlineBoundChk _
+	( _
+		byval n as ASTNODE ptr, _
+		byval label as FBSYMBOL ptr _
+	)
+
+	dim as ASTNODE ptr lb = any, ub = any, t = any
+
+	hGetBoundChkBounds( n, lb, ub )
+	if( ub = NULL ) then
+		exit sub
+	end if
+
+	'' cunsg( index - lbound ) <= cunsg( ubound - lbound ), a single
+	'' compare for both bounds, as done by fb_ArraySngBoundChk()
+	t = astNewVAR( n->sym )
+	ub = astCloneTree( ub )
+	if( lb <> NULL ) then
+		t = astNewBOP( AST_OP_SUB, t, astCloneTree( lb ) )
+		ub = astNewBOP( AST_OP_SUB, ub, astCloneTree( lb ) )
+	end if
+
+	t = astNewBOP( AST_OP_LE, _
+			astNewCONV( FB_DATATYPE_UINT, NULL, t ), _
+			astNewCONV( FB_DATATYPE_UINT, NULL, ub ), _
+			label, AST_OPOPT_NONE )
+
+	astLoad( t )
+	astDelNode( t )
+
+end sub
+
 '':::::
 function astLoadBOUNDCHK _
 	( _
@@ -92,12 +176,21 @@ function astLoadBOUNDCHK _
 	astLoad( t )
 	astDelNode( t )
 
+	label = NULL
+	if( ast.doemit and (env.clopt.backend <> FB_BACKEND_GAS) ) then
+		label = symbAddLabel( NULL )
+		symbSetLabelIsLikely( label )
+		hLoadInlineBoundChk( n, label )
+	end if
+
     vr = astLoad( r )
     astDelNode( r )
 
     if( ast.doemit ) then
     	'' handler = boundchk( ... ): if handler <> NULL then handler( )
-    	label = symbAddLabel( NULL )
+    	if( label = NULL ) then
+    		label = symbAddLabel( NULL )
+    	end if
     	irEmitBOP( AST_OP_EQ, _
     				 vr, _
     				 irAllocVRIMM( FB_DATATYPE_INTEGER, NULL, 0 ), _
@@ -184,13 +277,29 @@ function astLoadPTRCHK _
 	astLoad( t )
 	astDelNode( t )
 
+	'' high-level backends: "if ptr <> NULL then goto label" inline,
+	'' so the checking call is only made when it fails (see bounds checking)
+	label = NULL
+	if( ast.doemit and (env.clopt.backend <> FB_BACKEND_GAS) ) then
+		label = symbAddLabel( NULL )
+		symbSetLabelIsLikely( label )
+		t = astNewBOP( AST_OP_NE, _
+				astNewCONV( FB_DATATYPE_UINT, NULL, astNewVAR( n->sym ) ), _
+				astNewCONSTi( 0, FB_DATATYPE_UINT ), _
+				label, AST_OPOPT_NONE )
+		astLoad( t )
+		astDelNode( t )
+	end if
+
     ''
     vr = astLoad( r )
     astDelNode( r )
 
     if( ast.doemit ) then
     	'' handler = ptrchk( ... ): if handler <> NULL then handler( )
-    	label = symbAddLabel( NULL )
+    	if( label = NULL ) then
+    		label = symbAddLabel( NULL )
+    	end if
     	irEmitBOP( AST_OP_EQ, _
     				 vr, _
     				 irAllocVRIMM( FB_DATATYPE_INTEGER, NULL, 0 ), _
@@ -210,3 +319,202 @@ end function
 function astBuildPTRCHK( byval expr as ASTNODE ptr ) as ASTNODE ptr
 	function = astNewPTRCHK( expr, lexLineNum( ), env.inf.name )
 end function
+
+'':::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+'' bound check elimination for FOR loops
+'':::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+private function hIsCounter _
+	( _
+		byval n as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr _
+	) as integer
+
+	'' skip conversions that preserve the counter's value (indices are
+	'' converted to INTEGER): widening ones, and unsigned to a wider signed
+	'' type, but not narrowing ones or other sign changes: a(cbyte(i))
+	'' wraps around and must keep its check
+	while( n->class = AST_NODECLASS_CONV )
+		dim as integer dtype = astGetDataType( n )
+		dim as integer ltype = astGetDataType( n->l )
+
+		if( typeGetClass( dtype ) <> FB_DATACLASS_INTEGER ) then
+			return FALSE
+		end if
+		if( typeGetSize( dtype ) < typeGetSize( ltype ) ) then
+			return FALSE
+		end if
+		if( typeIsSigned( dtype ) <> typeIsSigned( ltype ) ) then
+			if( typeIsSigned( ltype ) or (typeGetSize( dtype ) = typeGetSize( ltype )) ) then
+				return FALSE
+			end if
+		end if
+		n = n->l
+	wend
+
+	if( n->class <> AST_NODECLASS_VAR ) then
+		return FALSE
+	end if
+
+	function = (n->sym = cnt) and (n->var_.ofs = 0)
+end function
+
+
+'' Is the lvalue the counter (and not just indexed by it, as in a(i) = ...)?
+private function hIsCounterLvalue _
+	( _
+		byval n as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr _
+	) as integer
+
+	if( n = NULL ) then
+		return FALSE
+	end if
+
+	while( (n->class = AST_NODECLASS_CONV) or (n->class = AST_NODECLASS_FIELD) )
+		n = n->l
+	wend
+
+	select case( n->class )
+	case AST_NODECLASS_VAR, AST_NODECLASS_OFFSET
+		function = (n->sym = cnt)
+	case else
+		function = FALSE
+	end select
+end function
+
+'' Could the statement change the counter, or let the loop body be entered
+'' with any other value than the FOR's?
+private function hMayChangeCounter _
+	( _
+		byval n as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr _
+	) as integer
+
+	if( n = NULL ) then
+		return FALSE
+	end if
+
+	select case as const( n->class )
+	case AST_NODECLASS_ASSIGN, AST_NODECLASS_ADDROF
+		'' taking the address covers BYREF args (they're ADDROF'ed by
+		'' astNewARG()) and any writes through pointers
+		if( hIsCounterLvalue( n->l, cnt ) ) then
+			return TRUE
+		end if
+
+	case AST_NODECLASS_OFFSET
+		if( n->sym = cnt ) then
+			return TRUE
+		end if
+
+	case AST_NODECLASS_ASM
+		return TRUE
+
+	'' user label: could be the target of a GOTO from outside the loop
+	case AST_NODECLASS_LABEL
+		if( symbGetName( n->sym ) <> NULL ) then
+			return TRUE
+		end if
+	end select
+
+	if( hMayChangeCounter( n->l, cnt ) ) then
+		return TRUE
+	end if
+
+	function = hMayChangeCounter( n->r, cnt )
+end function
+
+private function hElimBoundChk _
+	( _
+		byval n as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr, _
+		byval minval as longint, _
+		byval maxval as longint _
+	) as ASTNODE ptr
+
+	dim as ASTNODE ptr lb = any, ub = any, l = any
+
+	if( n = NULL ) then
+		return NULL
+	end if
+
+	n->l = hElimBoundChk( n->l, cnt, minval, maxval )
+	n->r = hElimBoundChk( n->r, cnt, minval, maxval )
+
+	function = n
+
+	if( n->class <> AST_NODECLASS_BOUNDCHK ) then
+		exit function
+	end if
+
+	if( (n->l = NULL) or (n->r = NULL) ) then
+		exit function
+	end if
+
+	if( hIsCounter( n->l, cnt ) = FALSE ) then
+		exit function
+	end if
+
+	'' only fixed-size arrays have compile-time bounds
+	hGetBoundChkBounds( n, lb, ub )
+	if( ub = NULL ) then
+		exit function
+	end if
+	if( astIsCONST( ub ) = FALSE ) then
+		exit function
+	end if
+	if( lb <> NULL ) then
+		if( astIsCONST( lb ) = FALSE ) then
+			exit function
+		end if
+		if( minval < astConstGetInt( lb ) ) then
+			exit function
+		end if
+	elseif( minval < 0 ) then
+		exit function
+	end if
+	if( maxval > astConstGetInt( ub ) ) then
+		exit function
+	end if
+
+	'' the counter can never be out of bounds here, drop the check
+	l = n->l
+	astDelTree( n->r )
+	astDelNode( n )
+	function = l
+end function
+
+'' Remove the bound checks on indices that are just a FOR loop's counter,
+'' from the loop body starting at stmt (up to the end of the current
+'' procedure's statement list). Only valid if the counter is a local declared
+'' by the FOR itself (so nothing outside the body can get at it) and is known
+'' to stay in minval..maxval while the body runs; checks on fixed-size arrays
+'' whose bounds include that range are redundant then, unless the body
+'' changes the counter.
+sub astForElimBoundChk _
+	( _
+		byval stmt as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr, _
+		byval minval as longint, _
+		byval maxval as longint _
+	)
+
+	dim as ASTNODE ptr n = any
+
+	n = stmt
+	while( n )
+		if( hMayChangeCounter( n, cnt ) ) then
+			exit sub
+		end if
+		n = n->next
+	wend
+
+	n = stmt
+	while( n )
+		n->l = hElimBoundChk( n->l, cnt, minval, maxval )
+		n->r = hElimBoundChk( n->r, cnt, minval, maxval )
+		n = n->next
+	wend
+
+end sub
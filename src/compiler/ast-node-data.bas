@@ -8,6 +8,7 @@
 #include once "ast.bi"
 
 declare sub hCreateDataDesc( )
+declare sub hLinkDataStmt( byval array as FBSYMBOL ptr )
 
 sub astDataStmtInit( )
 	ast.data.lastsym = NULL
@@ -94,16 +95,214 @@ function astDataStmtStore _
 
 end function
 
+'' Text of a DATA constant, without deleting it (as astConstFlushToStr())
+private function hConstText( byval n as ASTNODE ptr ) as string
+	if( typeGetClass( n->dtype ) = FB_DATACLASS_FPOINT ) then
+		if( typeGetDtAndPtrOnly( n->dtype ) = FB_DATATYPE_DOUBLE ) then
+			function = str( n->val.f )
+		else
+			function = str( csng( n->val.f ) )
+		end if
+	elseif( typeIsSigned( n->dtype ) ) then
+		function = str( n->val.i )
+	else
+		function = str( cunsg( n->val.i ) )
+	end if
+end function
+
+'' -z typed-data: a DATA stmt with only numbers is stored as an array of
+'' LONGs, LONGINTs or DOUBLEs, instead of their text. Only numbers that READ
+'' would give back the same, as number or as string, are allowed (no
+'' exponents, no unsigned values above the LONGINT range).
+'' Returns the values array, or NULL if the DATA must be stored as text.
+private function hBuildDataTable _
+	( _
+		byval tree as ASTNODE ptr, _
+		byref id as integer _
+	) as FBSYMBOL ptr
+
+	static as string symid
+	static as FBARRAYDIM dTB(0 to 0)
+	dim as ASTNODE ptr n = any, expr = any, initree = any
+	dim as integer i = any, j = any, count = any, dtype = any
+	dim as integer has_float = any, has_int64 = any, has_bigint = any
+	dim as string text
+	dim as FBSYMBOL ptr sym = any
+
+	function = NULL
+
+	'' without the link
+	count = tree->data.elmts - 1
+	if( count <= 0 ) then
+		exit function
+	end if
+
+	has_float = FALSE
+	has_int64 = FALSE
+	has_bigint = FALSE
+
+	n = tree->l
+	for i = 0 to count - 1
+		if( n->data.id <> FB_DATASTMT_ID_CONST ) then
+			exit function
+		end if
+
+		expr = n->l
+		if( astIsCONST( expr ) = FALSE ) then
+			exit function
+		end if
+
+		if( typeGetClass( expr->dtype ) = FB_DATACLASS_FPOINT ) then
+			has_float = TRUE
+		else
+			select case( typeGetDtAndPtrOnly( expr->dtype ) )
+			case FB_DATATYPE_BOOLEAN
+				exit function
+			end select
+
+			'' unsigned above 2^63-1?
+			if( (typeIsSigned( expr->dtype ) = FALSE) and (expr->val.i < 0) ) then
+				exit function
+			end if
+
+			if( (expr->val.i < -2147483648ll) or (expr->val.i > 2147483647ll) ) then
+				has_int64 = TRUE
+			end if
+
+			if( (expr->val.i <= -1000000000000000ll) or (expr->val.i >= 1000000000000000ll) ) then
+				has_bigint = TRUE
+			end if
+		end if
+
+		text = hConstText( expr )
+		for j = 0 to len( text ) - 1
+			select case( text[j] )
+			case CHAR_0 to CHAR_9, CHAR_MINUS, CHAR_DOT
+			case else
+				exit function
+			end select
+		next
+
+		n = n->r
+	next
+
+	if( has_float ) then
+		'' integers must still be exact as doubles
+		if( has_bigint ) then
+			exit function
+		end if
+		id = FB_DATASTMT_ID_TABLE_DOUBLE
+		dtype = FB_DATATYPE_DOUBLE
+	elseif( has_int64 ) then
+		id = FB_DATASTMT_ID_TABLE_LONGINT
+		dtype = FB_DATATYPE_LONGINT
+	else
+		id = FB_DATASTMT_ID_TABLE_LONG
+		dtype = FB_DATATYPE_LONG
+	end if
+
+	'' static values(0 to count-1) as dtype
+	symid = *symbUniqueLabel( )
+	dTB(0).upper = count - 1
+	sym = symbAddVar( symid, symbUniqueLabel( ), dtype, NULL, 0, _
+	                  1, dTB(), _
+	                  FB_SYMBATTRIB_SHARED or FB_SYMBATTRIB_STATIC, _
+	                  FB_SYMBOPT_MOVETOGLOB or FB_SYMBOPT_PRESERVECASE )
+
+	'' only referenced from the datadesc initializer
+	symbSetIsAccessed( sym )
+
+	initree = astTypeIniBegin( dtype, NULL, TRUE )
+	astTypeIniScopeBegin( initree, sym, TRUE )
+
+	n = tree->l
+	for i = 0 to count - 1
+		expr = n->l
+		if( dtype = FB_DATATYPE_DOUBLE ) then
+			'' the same value READ gets from the text
+			expr = astNewCONSTf( val( astConstFlushToStr( expr ) ), FB_DATATYPE_DOUBLE )
+		else
+			expr = astNewCONSTi( astConstGetAsInt64( expr ), dtype )
+			astDelNode( n->l )
+		end if
+		n->l = NULL
+
+		astTypeIniAddAssign( initree, expr, sym )
+
+		n = n->r
+	next
+
+	astTypeIniScopeEnd( initree, sym )
+	astTypeIniEnd( initree, TRUE )
+
+	symbSetTypeIniTree( sym, initree )
+
+	function = sym
+end function
+
 sub astDataStmtEnd( byval tree as ASTNODE ptr )
 
-    dim as FBSYMBOL ptr array = any, elm = any
-    dim as integer i = any, id = any
+    dim as FBSYMBOL ptr array = any, elm = any, table = NULL
+    dim as integer i = any, id = any, tableid = any
     dim as ASTNODE ptr n = any, expr = any, initree = any
     dim as string littext
 
     '' add the last node: the link
     astDataStmtStore( tree, NULL )
 
+	if( env.clopt.typeddata ) then
+		table = hBuildDataTable( tree, tableid )
+	end if
+
+	if( table <> NULL ) then
+		'' typed table: {table id, @values(0)}, {0, count}, link
+		array = astDataStmtAdd( NULL, 3 )
+
+		initree = astTypeIniBegin( FB_DATATYPE_STRUCT, ast.data.desc, TRUE )
+		astTypeIniScopeBegin( initree, array, TRUE )
+
+		for i = 0 to 2
+			select case( i )
+			case 0
+				id = tableid
+				expr = astNewADDROF( astNewVAR( table ) )
+			case 1
+				id = 0
+				expr = astNewCONSTi( tree->data.elmts - 1, typeAddrOf( FB_DATATYPE_VOID ) )
+			case else
+				id = FB_DATASTMT_ID_LINK
+				expr = astNewCONSTi( 0 )
+			end select
+
+			astTypeIniScopeBegin( initree, array, FALSE )
+
+			'' .id = id
+			elm = symbGetUDTSymbTbHead( ast.data.desc )
+			astTypeIniAddAssign( initree, astNewCONSTi( id, FB_DATATYPE_SHORT ), elm )
+
+			'' .node = expr
+			elm = symbGetNext( elm )
+			astTypeIniAddAssign( initree, expr, elm )
+
+			astTypeIniScopeEnd( initree, array )
+		next
+
+		'' the values were moved to the table
+		n = tree->l
+		while( n <> NULL )
+			dim as ASTNODE ptr nxt = n->r
+			astDelNode( n )
+			n = nxt
+		wend
+
+		astTypeIniScopeEnd( initree, array )
+		astTypeIniEnd( initree, TRUE )
+		symbSetTypeIniTree( array, initree )
+
+		hLinkDataStmt( array )
+		exit sub
+	end if
+
 	'' create/lookup the datadesc array symbol for the last symbol
 
 	array = astDataStmtAdd( NULL, tree->data.elmts )
@@ -167,6 +366,13 @@ sub astDataStmtEnd( byval tree as ASTNODE ptr )
 
     symbSetTypeIniTree( array, initree )
 
+	hLinkDataStmt( array )
+
+end sub
+
+private sub hLinkDataStmt( byval array as FBSYMBOL ptr )
+	dim as ASTNODE ptr n = any, initree = any
+
 	'' Link the previous DATA stmt to this new one
 	if( ast.data.lastsym <> NULL ) then
     	'' lastarray(ubound(lastarray)).next = @array(0)
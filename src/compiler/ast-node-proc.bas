@@ -618,15 +618,33 @@ end function
 '':::::
 private function hCallProfiler _
 	( _
-		byval head_node as ASTNODE ptr _
+		byval head_node as ASTNODE ptr, _
+		byval sym as FBSYMBOL ptr _
 	) as ASTNODE ptr
 
-	'' on all ports except dos _mcount() is just a normal call
-	if( env.clopt.profile ) then
+	dim as FBSYMBOL ptr handle = any
+
+	if( env.clopt.profile = FALSE ) then
+		return head_node
+	end if
+
+	select case( env.clopt.profgen )
+	case FB_PROFGEN_FBRT
+		'' handle = fb_ProfileEnter( "procname" ) at the top,
+		'' fb_ProfileExit( handle ) behind the exit label
+		handle = symbAddTempVar( typeAddrOf( FB_DATATYPE_VOID ) )
+
+		head_node = astAddAfter( astNewASSIGN( astNewVAR( handle ), _
+			rtlProfileEnter( astNewCONSTstr( symbGetFullProcName( sym ) ) ) ), head_node )
+
+		astAdd( rtlProfileExit( astNewVAR( handle ) ) )
+
+	case else
+		'' on all ports except dos _mcount() is just a normal call
 		if( env.clopt.target <> FB_COMPTARGET_DOS ) then
 			head_node = astAddAfter( rtlProfileCall_mcount(), head_node )
 		end if
-	end if
+	end select
 
 	function = head_node
 
@@ -690,7 +708,7 @@ function astProcEnd( byval callrtexit as integer ) as integer
 		dim as ASTNODE ptr head_node = n->l
 
 		if( enable_implicit_code ) then
-			head_node = hCallProfiler( head_node )
+			head_node = hCallProfiler( head_node, sym )
 			head_node = hCheckErrHnd( head_node, sym )
 		end if
 
@@ -146,6 +146,32 @@ function astNewUOP _
 
 	'' UDT?
 	case FB_DATATYPE_STRUCT ', FB_DATATYPE_CLASS
+		'' VECTOR type? element-wise negation and NOT, see astNewBOP()
+		if( symbGetUdtIsVector( o->subtype ) ) then
+			select case( op )
+			case AST_OP_NEG
+			case AST_OP_NOT
+				if( typeGetClass( symbGetUdtVectorDtype( o->subtype ) ) <> FB_DATACLASS_INTEGER ) then
+					exit function
+				end if
+			case else
+				exit function
+			end select
+
+			if( env.clopt.backend <> FB_BACKEND_GCC ) then
+				errReport( FB_ERRMSG_VECTOROPWITHOUTGENGCC )
+				exit function
+			end if
+
+			n = astNewNode( AST_NODECLASS_UOP, FB_DATATYPE_STRUCT, o->subtype )
+			n->l = o
+			n->r = NULL
+			n->op.op = op
+			n->op.ex = NULL
+			n->op.options = AST_OPOPT_ALLOCRES
+			return astBuildVectorResult( n )
+		end if
+
 		'' try to convert to the most precise type
 		'' (astNewCONV() will try symbFindCastOvlProc() which gives
 		'' special treatment to the FB_DATATYPE_VOID)
@@ -183,7 +183,8 @@ private function hOptConstAccum1( byval n as ASTNODE ptr ) as ASTNODE ptr
 	'' then begin accumulating the other constants at the nodes below the
 	'' current, deleting any constant leaf that was added
 	'' (this will handle for ex. a+1+b+2-3, that will become a+b
-	if( n->class = AST_NODECLASS_BOP ) then
+	'' (not on VECTOR types, astNewBOP() would store them into another temp var)
+	if( (n->class = AST_NODECLASS_BOP) and (astGetDataType( n ) <> FB_DATATYPE_STRUCT) ) then
 		r = n->r
 		if( astIsCONST( r ) ) then
 			accumval = NULL
@@ -230,7 +231,8 @@ private function hOptConstAccum2( byval n as ASTNODE ptr ) as ASTNODE ptr
 	'' any constants found there, deleting those nodes and then add the
 	'' result to a new node, at right side of the current one
 	'' (this will handle for ex. a+1+(b+2)+(c+3), that will become a+b+c+6)
-	if( n->class = AST_NODECLASS_BOP ) then
+	'' (not on VECTOR types, see hOptConstAccum1())
+	if( (n->class = AST_NODECLASS_BOP) and (astGetDataType( n ) <> FB_DATATYPE_STRUCT) ) then
 		accumval = NULL
 
 		select case n->op.op
@@ -751,3 +751,480 @@ sub astProcVectorize _
 	loop
 
 end sub
+
+'':::::
+'' FOR loop vectorization
+''
+'' A FOR loop with a local integer counter and STEP 1, whose body only
+'' assigns float array elements indexed by the counter, gets a second copy of
+'' its body that does W iterations at once: each statement is unrolled W times
+'' (grouped per statement), so astProcVectorize() will later merge the copies
+'' into packed SSE ops. The original body stays behind it and is used for the
+'' last iterations (and whenever the runtime checks fail):
+''
+''      if( cnt > end - (W-1) ) goto scalar
+''      if( (p + ofs_p) and (q + ofs_q) are closer than W elements ) goto scalar
+''      S1(cnt+0) .. S1(cnt+W-1)
+''      S2(cnt+0) .. S2(cnt+W-1)
+''      cnt += W-1
+''      goto cmplabel
+''  scalar:
+''      S1(cnt)
+''      S2(cnt)
+''
+'' The statements are reordered by the unrolling, so loads and stores to the
+'' same array/pointer must not depend on each other across iterations; with
+'' different pointers that can't be known at compile time, so they're checked
+'' at runtime.
+
+const VECFOR_MAXSTMTS		= 8
+const VECFOR_MAXACCESSES	= 32
+const VECFOR_MAXCHECKS		= 8
+
+type VECFOR_ACCESS
+	n				as ASTNODE ptr				'' IDX or DEREF
+	sym				as FBSYMBOL ptr				'' array or pointer var
+	isptr			as integer
+	isstore			as integer
+	stmt			as integer					'' statement index in the body
+end type
+
+type VECFOR_CHECK
+	s				as VECFOR_ACCESS ptr		'' store
+	a				as VECFOR_ACCESS ptr		'' access through another pointer
+end type
+
+type VECFOR_CTX
+	cnt				as FBSYMBOL ptr
+	dtype			as integer					'' SINGLE or DOUBLE, no mixing
+	lgt				as integer					'' element size
+	accesses		as integer
+	acctb(0 to VECFOR_MAXACCESSES-1) as VECFOR_ACCESS
+	checks			as integer
+	checktb(0 to VECFOR_MAXCHECKS-1) as VECFOR_CHECK
+end type
+
+dim shared as VECFOR_CTX vfor
+
+private function hIsForCounter( byval n as ASTNODE ptr ) as integer
+	if( n->class = AST_NODECLASS_CONV ) then
+		if( typeGetClass( n->dtype ) <> FB_DATACLASS_INTEGER ) then
+			return FALSE
+		end if
+		n = n->l
+	end if
+
+	if( n->class <> AST_NODECLASS_VAR ) then
+		return FALSE
+	end if
+
+	function = (n->sym = vfor.cnt) and (n->var_.ofs = 0)
+end function
+
+'' counter * element size (as MUL, or SHL after astOptimizeTree())
+private function hIsScaledForCounter( byval n as ASTNODE ptr ) as integer
+	if( n->class <> AST_NODECLASS_BOP ) then
+		return FALSE
+	end if
+
+	if( astIsCONST( n->r ) = FALSE ) then
+		return FALSE
+	end if
+
+	select case n->op.op
+	case AST_OP_MUL
+		if( astConstGetInt( n->r ) <> vfor.lgt ) then
+			return FALSE
+		end if
+	case AST_OP_SHL
+		if( (1 shl astConstGetInt( n->r )) <> vfor.lgt ) then
+			return FALSE
+		end if
+	case else
+		return FALSE
+	end select
+
+	function = hIsForCounter( n->l )
+end function
+
+private function hIsVecForType( byval n as ASTNODE ptr ) as integer
+	function = (astGetDataType( n ) = vfor.dtype)
+end function
+
+'' array(cnt) or *(p + cnt * lgt)
+private function hCheckForAccess _
+	( _
+		byval n as ASTNODE ptr, _
+		byval isstore as integer, _
+		byval stmt as integer _
+	) as integer
+
+	dim as ASTNODE ptr l = any, p = any
+
+	if( hIsVecForType( n ) = FALSE ) then
+		return FALSE
+	end if
+
+	if( (vfor.accesses = VECFOR_MAXACCESSES) or (n->l = NULL) ) then
+		return FALSE
+	end if
+
+	with( vfor.acctb(vfor.accesses) )
+		select case n->class
+		case AST_NODECLASS_IDX
+			if( n->r->class <> AST_NODECLASS_VAR ) then
+				return FALSE
+			end if
+
+			if( hIsForCounter( n->l ) ) then
+				if( n->idx.mult <> vfor.lgt ) then
+					return FALSE
+				end if
+			elseif( n->idx.mult = 1 ) then
+				if( hIsScaledForCounter( n->l ) = FALSE ) then
+					return FALSE
+				end if
+			else
+				return FALSE
+			end if
+
+			.sym = n->r->sym
+			.isptr = FALSE
+
+		case AST_NODECLASS_DEREF
+			l = n->l
+			if( astIsBOP( l, AST_OP_ADD ) = FALSE ) then
+				return FALSE
+			end if
+
+			if( hIsScaledForCounter( l->r ) ) then
+				p = l->l
+			elseif( hIsScaledForCounter( l->l ) ) then
+				p = l->r
+			else
+				return FALSE
+			end if
+
+			if( p->class <> AST_NODECLASS_VAR ) then
+				return FALSE
+			end if
+			if( (typeIsPtr( astGetFullType( p ) ) = FALSE) or (p->var_.ofs <> 0) ) then
+				return FALSE
+			end if
+
+			.sym = p->sym
+			.isptr = TRUE
+
+		case else
+			return FALSE
+		end select
+
+		.n = n
+		.isstore = isstore
+		.stmt = stmt
+	end with
+
+	vfor.accesses += 1
+	function = TRUE
+end function
+
+private function hCheckForExpr _
+	( _
+		byval n as ASTNODE ptr, _
+		byval stmt as integer _
+	) as integer
+
+	select case as const n->class
+	case AST_NODECLASS_BOP
+		select case n->op.op
+		case AST_OP_ADD, AST_OP_SUB, AST_OP_MUL, AST_OP_DIV
+		case else
+			return FALSE
+		end select
+
+		if( hIsVecForType( n ) = FALSE ) then
+			return FALSE
+		end if
+
+		if( hCheckForExpr( n->l, stmt ) = FALSE ) then
+			return FALSE
+		end if
+		function = hCheckForExpr( n->r, stmt )
+
+	case AST_NODECLASS_CONST
+		function = hIsVecForType( n )
+
+	'' scalar, loop-invariant (nothing but array elements is assigned)
+	case AST_NODECLASS_VAR
+		function = hIsVecForType( n )
+
+	case AST_NODECLASS_IDX, AST_NODECLASS_DEREF
+		function = hCheckForAccess( n, FALSE, stmt )
+
+	case else
+		function = FALSE
+	end select
+
+end function
+
+private function hGetForAccessOfs( byval a as VECFOR_ACCESS ptr ) as longint
+	if( a->isptr ) then
+		function = a->n->ptr.ofs
+	else
+		function = a->n->idx.ofs
+	end if
+end function
+
+'' Can the accesses be reordered as the unrolled body does?
+private function hCheckForAliasing( ) as integer
+	dim as VECFOR_ACCESS ptr s = any, a = any
+	dim as longint dist = any
+
+	vfor.checks = 0
+
+	for i as integer = 0 to vfor.accesses - 1
+		s = @vfor.acctb(i)
+		if( s->isstore = FALSE ) then
+			continue for
+		end if
+
+		for j as integer = 0 to vfor.accesses - 1
+			a = @vfor.acctb(j)
+			if( a = s ) then
+				continue for
+			end if
+
+			'' array vs. pointer: the pointer could point anywhere into it
+			if( a->isptr <> s->isptr ) then
+				return FALSE
+			end if
+
+			if( a->sym = s->sym ) then
+				if( a->isstore ) then
+					return FALSE
+				end if
+
+				'' a later statement sees all the block's stores, so it may
+				'' only read elements at or behind the stored one; the same
+				'' (loads come first) or an earlier statement sees none, so
+				'' only elements at or ahead of it
+				dist = hGetForAccessOfs( a ) - hGetForAccessOfs( s )
+				if( a->stmt > s->stmt ) then
+					if( dist > 0 ) then
+						return FALSE
+					end if
+				else
+					if( dist < 0 ) then
+						return FALSE
+					end if
+				end if
+
+			'' different pointers: check at runtime
+			elseif( s->isptr ) then
+				'' two stores? one check covers both
+				if( a->isstore and (j < i) ) then
+					continue for
+				end if
+
+				if( vfor.checks = VECFOR_MAXCHECKS ) then
+					return FALSE
+				end if
+
+				vfor.checktb(vfor.checks).s = s
+				vfor.checktb(vfor.checks).a = a
+				vfor.checks += 1
+			end if
+		next
+	next
+
+	function = TRUE
+end function
+
+'' if( cuint( (s + ofs_s) - (a + ofs_a) + W*lgt-1 ) < 2*W*lgt-1 ) goto label
+private function hBuildForAliasCheck _
+	( _
+		byval chk as VECFOR_CHECK ptr, _
+		byval vwidth as integer, _
+		byval label as FBSYMBOL ptr _
+	) as ASTNODE ptr
+
+	dim as ASTNODE ptr expr = any
+	dim as integer block = vwidth * vfor.lgt
+
+	expr = astNewBOP( AST_OP_SUB, _
+			astNewCONV( FB_DATATYPE_INTEGER, NULL, astNewVAR( chk->s->sym ) ), _
+			astNewCONV( FB_DATATYPE_INTEGER, NULL, astNewVAR( chk->a->sym ) ) )
+
+	expr = astNewBOP( AST_OP_ADD, expr, _
+			astNewCONSTi( hGetForAccessOfs( chk->s ) - hGetForAccessOfs( chk->a ) + block - 1 ) )
+
+	function = astNewBOP( AST_OP_LT, _
+			astNewCONV( FB_DATATYPE_UINT, NULL, expr ), _
+			astNewCONSTi( 2 * block - 1, FB_DATATYPE_UINT ), _
+			label, AST_OPOPT_NONE )
+end function
+
+private sub hShiftForAccesses _
+	( _
+		byval n as ASTNODE ptr, _
+		byval ofs as integer _
+	)
+
+	if( n = NULL ) then
+		exit sub
+	end if
+
+	select case n->class
+	case AST_NODECLASS_IDX
+		n->idx.ofs += ofs
+	case AST_NODECLASS_DEREF
+		n->ptr.ofs += ofs
+	case else
+		hShiftForAccesses( n->l, ofs )
+		hShiftForAccesses( n->r, ofs )
+	end select
+
+end sub
+
+'' link an already updated tree in behind ref
+private function hLinkForTree _
+	( _
+		byval n as ASTNODE ptr, _
+		byval ref as ASTNODE ptr _
+	) as ASTNODE ptr
+
+	n->prev = ref
+	n->next = ref->next
+	ref->next->prev = n
+	ref->next = n
+
+	function = n
+end function
+
+'' Vectorize the body of a FOR loop, from stmt up to the end of the current
+'' procedure's statement list (see above). cnt must be a local integer
+'' declared by the FOR itself, the STEP must be 1, and cmplabel is where the
+'' counter gets incremented. endexpr (the TO value) is deleted if unused.
+sub astForVectorize _
+	( _
+		byval stmt as ASTNODE ptr, _
+		byval cnt as FBSYMBOL ptr, _
+		byval endexpr as ASTNODE ptr, _
+		byval cmplabel as FBSYMBOL ptr _
+	)
+
+	dim as ASTNODE ptr n = any, ref = any
+	dim as ASTNODE ptr stmttb(0 to VECFOR_MAXSTMTS-1)
+	dim as integer stmts = any, vwidth = any, dtype = any
+	dim as FBSYMBOL ptr label = any
+
+	if( (stmt = NULL) orelse (stmt->prev = NULL) ) then
+		astDelTree( endexpr )
+		exit sub
+	end if
+
+	vfor.cnt = cnt
+	vfor.dtype = FB_DATATYPE_INVALID
+	vfor.accesses = 0
+
+	'' only assignments to array elements
+	stmts = 0
+	n = stmt
+	while( n )
+		select case n->class
+		case AST_NODECLASS_DBG, AST_NODECLASS_NOP
+
+		case AST_NODECLASS_ASSIGN
+			if( stmts = VECFOR_MAXSTMTS ) then
+				exit while
+			end if
+
+			if( vfor.dtype = FB_DATATYPE_INVALID ) then
+				vfor.dtype = astGetDataType( n->l )
+				select case vfor.dtype
+				case FB_DATATYPE_SINGLE, FB_DATATYPE_DOUBLE
+					vfor.lgt = typeGetSize( vfor.dtype )
+				case else
+					exit while
+				end select
+			end if
+
+			if( hCheckForAccess( n->l, TRUE, stmts ) = FALSE ) then
+				exit while
+			end if
+
+			if( hCheckForExpr( n->r, stmts ) = FALSE ) then
+				exit while
+			end if
+
+			stmttb(stmts) = n
+			stmts += 1
+
+		case else
+			exit while
+		end select
+
+		n = n->next
+	wend
+
+	if( (n <> NULL) or (stmts = 0) ) then
+		astDelTree( endexpr )
+		exit sub
+	end if
+
+	if( hCheckForAliasing( ) = FALSE ) then
+		astDelTree( endexpr )
+		exit sub
+	end if
+
+	'' 128-bit vectors
+	vwidth = 16 \ vfor.lgt
+	dtype = symbGetType( cnt )
+
+	'' a constant end must leave room for the whole block, a variable one
+	'' is checked for wrap-around below
+	if( astIsCONST( endexpr ) ) then
+		if( astConstGetInt( endexpr ) < vwidth - 1 ) then
+			astDelTree( endexpr )
+			exit sub
+		end if
+	end if
+
+	label = symbAddLabel( NULL )
+	ref = stmt->prev
+
+	'' if( end - (W-1) > end ) goto scalar
+	if( astIsCONST( endexpr ) = FALSE ) then
+		ref = astAddAfter( astNewBOP( AST_OP_GT, _
+				astNewBOP( AST_OP_SUB, astCloneTree( endexpr ), astNewCONSTi( vwidth - 1, dtype ) ), _
+				astCloneTree( endexpr ), _
+				label, AST_OPOPT_NONE ), ref )
+	end if
+
+	'' if( cnt > end - (W-1) ) goto scalar
+	ref = astAddAfter( astNewBOP( AST_OP_GT, _
+			astNewVAR( cnt ), _
+			astNewBOP( AST_OP_SUB, endexpr, astNewCONSTi( vwidth - 1, dtype ) ), _
+			label, AST_OPOPT_NONE ), ref )
+
+	for i as integer = 0 to vfor.checks - 1
+		ref = astAddAfter( hBuildForAliasCheck( @vfor.checktb(i), vwidth, label ), ref )
+	next
+
+	'' the unrolled statements, grouped so they can be merged
+	for i as integer = 0 to stmts - 1
+		for j as integer = 0 to vwidth - 1
+			n = astCloneTree( stmttb(i) )
+			hShiftForAccesses( n, j * vfor.lgt )
+			ref = hLinkForTree( n, ref )
+		next
+	next
+
+	'' cnt += W-1 (NEXT adds the last 1)
+	ref = astAddAfter( astNewASSIGN( astNewVAR( cnt ), _
+			astNewBOP( AST_OP_ADD, astNewVAR( cnt ), astNewCONSTi( vwidth - 1, dtype ) ) ), ref )
+
+	ref = astAddAfter( astNewBRANCH( AST_OP_JMP, cmplabel ), ref )
+	astAddAfter( astNewLABEL( label ), ref )
+
+end sub
@@ -10,6 +10,7 @@
 #include once "rtl.bi"
 #include once "emit.bi"
 #include once "symb.bi"
+#include once "outbuf.bi"
 
 declare function emitGasX86_ctor	_
 	( _
@@ -50,20 +51,12 @@ sub emitWriteStr _
 		byval addtab as integer _
 	)
 
-    static as string ostr
-
 	if( addtab ) then
-		ostr = TABCHAR
-		ostr += *s
-	else
-		ostr = *s
+		outbufWriteTabs( 1 )
 	end if
 
-	ostr += NEWLINE
-
-	if( put( #env.outf.num, , ostr ) <> 0 ) then
-		'' ...
-	end if
+	outbufWriteZ( s )
+	outbufWriteNewline( )
 
 end sub
 
@@ -16,6 +16,7 @@
 #include once "symb.bi"
 #include once "emit-private.bi"
 #include once "ir-private.bi"
+#include once "outbuf.bi"
 
 declare sub hDeclVariable _
 	( _
@@ -500,8 +501,7 @@ private sub outEx _
 		bytes = len( *s )
 	end if
 
-	if( put( #env.outf.num, , *s, bytes ) = 0 ) then
-	end if
+	outbufWrite( s, bytes )
 
 end sub
 
@@ -511,18 +511,12 @@ sub outp _
 		byval s as zstring ptr _
 	)
 
-    static as string ostr
-
 	if( env.clopt.debuginfo ) then
-		ostr = TABCHAR
-		ostr += *s
-	else
-		ostr = *s
+		outbufWriteTabs( 1 )
 	end if
 
-	ostr += NEWLINE
-
-	outEX( ostr, len( ostr ) )
+	outbufWriteZ( s )
+	outbufWriteNewline( )
 
 end sub
 
@@ -1102,7 +1096,7 @@ private sub hCreateFrame _
     		(proc->proc.ext->stk.argofs <> EMIT_ARGSTART) or _
         	symbGetIsMainProc( proc ) or _
 			env.clopt.debuginfo or _
-			env.clopt.profile ) then
+			fbProfileWithGmon( ) ) then
 
     		hPUSH( "ebp" )
     		outp( "mov ebp, esp" )
@@ -1121,7 +1115,7 @@ private sub hCreateFrame _
     	end if
 
 		if( env.clopt.target = FB_COMPTARGET_DOS ) then
-			if( env.clopt.profile ) then
+			if( fbProfileWithGmon( ) ) then
 				lprof = symbMakeProfileLabelName( )
 
 				outEx(".section .data" + NEWLINE )
@@ -1183,7 +1177,7 @@ private sub hDestroyFrame _
     		(proc->proc.ext->stk.argofs <> EMIT_ARGSTART) or _
         	symbGetIsMainProc( proc ) or _
 			env.clopt.debuginfo or _
-			env.clopt.profile ) then
+			fbProfileWithGmon( ) ) then
     		outp( "mov esp, ebp" )
     		hPOP( "ebp" )
     	end if
@@ -6810,12 +6804,7 @@ private function _open _
 	( _
 	) as integer
 
-	if( hFileExists( env.outf.name ) ) then
-		kill env.outf.name
-	end if
-
-	env.outf.num = freefile
-	if( open( env.outf.name, for binary, access read write, as #env.outf.num ) <> 0 ) then
+	if( outbufOpen( ) = FALSE ) then
 		return FALSE
 	end if
 
@@ -6849,11 +6838,7 @@ private sub _close( )
 	edbgEmitFooter( )
 
 	''
-	if( close( #env.outf.num ) <> 0 ) then
-		'' ...
-	end if
-
-	env.outf.num = 0
+	outbufClose( )
 
 end sub
 
@@ -413,7 +413,12 @@ declare function hMakeParamDesc _
 		 /'FB_ERRMSG_INCOMPATIBLEREFINIT                '/ @"Incompatible reference initializer", _
 		 /'FB_ERRMSG_ARRAYOFREFS                        '/ @"Array of references - not supported yet", _
 		 /'FB_ERRMSG_INVALIDCASERANGE                   '/ @"Invalid CASE range, start value is greater than the end value", _
-		 /'FB_ERRMSG_BYREFFIXSTR                        '/ @"Fixed-length string combined with BYREF (not supported)" _
+		 /'FB_ERRMSG_BYREFFIXSTR                        '/ @"Fixed-length string combined with BYREF (not supported)", _
+		 /'FB_ERRMSG_SERVERNOTSUPPORTED                 '/ @"-server is only supported on Unix hosts", _
+		 /'FB_ERRMSG_LTOWITHOUTGENGCC                   '/ @"-lto used, but it only works with -gen gcc", _
+		 /'FB_ERRMSG_PGOWITHOUTGENGCC                   '/ @"-pgo-gen/-pgo-use used, but they only work with -gen gcc", _
+		 /'FB_ERRMSG_INVALIDVECTORTYPE                  '/ @"Invalid VECTOR type, it needs 2, 4, 8, ... fields of the same integer or floating point type, 8, 16 or 32 bytes in total, not packed by FIELD, and no constructors or destructor", _
+		 /'FB_ERRMSG_VECTOROPWITHOUTGENGCC              '/ @"Operators on VECTOR types only work with -gen gcc, other backends need overloaded operators" _
 	}
 
 
@@ -427,6 +427,12 @@ sub fbInit( byval ismain as integer, byval restarts as integer )
 	rtlInit( )
 end sub
 
+'' -server: fbInit() was done ahead with ismain = FALSE, which only leaves
+'' out the __FB_MAIN__ define
+sub fbInitMain( )
+	symbAddDefine( "__FB_MAIN__", NULL, 0 )
+end sub
+
 sub fbEnd()
 	rtlEnd( )
 	parserEnd( )
@@ -486,6 +492,7 @@ sub fbGlobalInit()
 	env.clopt.nullptrchk    = FALSE
 	env.clopt.resumeerr     = FALSE
 	env.clopt.profile       = FALSE
+	env.clopt.profgen       = FB_PROFGEN_GMON
 
 	env.clopt.warninglevel  = FB_WARNINGMSGS_DEFAULT_LEVEL
 	env.clopt.showerror     = TRUE
@@ -493,6 +500,7 @@ sub fbGlobalInit()
 	env.clopt.pdcheckopt    = FB_PDCHECK_NONE
 
 	env.clopt.gosubsetjmp   = FALSE
+	env.clopt.typeddata     = FALSE
 	env.clopt.export        = FALSE
 	env.clopt.multithreaded = FALSE
 	env.clopt.gfx           = FALSE
@@ -570,6 +578,8 @@ sub fbSetOption( byval opt as integer, byval value as integer )
 		env.clopt.nullptrchk = value
 	case FB_COMPOPT_PROFILE
 		env.clopt.profile = value
+	case FB_COMPOPT_PROFGEN
+		env.clopt.profgen = value
 
 	case FB_COMPOPT_WARNINGLEVEL
 		env.clopt.warninglevel = value
@@ -584,6 +594,8 @@ sub fbSetOption( byval opt as integer, byval value as integer )
 		env.clopt.gosubsetjmp = value
 	case FB_COMPOPT_VALISTASPTR
 		env.clopt.valistasptr = value
+	case FB_COMPOPT_TYPEDDATA
+		env.clopt.typeddata = value
 	case FB_COMPOPT_EXPORT
 		env.clopt.export = value
 	case FB_COMPOPT_MSBITFIELDS
@@ -657,6 +669,8 @@ function fbGetOption( byval opt as integer ) as integer
 		function = env.clopt.nullptrchk
 	case FB_COMPOPT_PROFILE
 		function = env.clopt.profile
+	case FB_COMPOPT_PROFGEN
+		function = env.clopt.profgen
 
 	case FB_COMPOPT_WARNINGLEVEL
 		function = env.clopt.warninglevel
@@ -671,6 +685,8 @@ function fbGetOption( byval opt as integer ) as integer
 		function = env.clopt.gosubsetjmp
 	case FB_COMPOPT_VALISTASPTR
 		function = env.clopt.valistasptr
+	case FB_COMPOPT_TYPEDDATA
+		function = env.clopt.typeddata
 	case FB_COMPOPT_EXPORT
 		function = env.clopt.export
 	case FB_COMPOPT_MSBITFIELDS
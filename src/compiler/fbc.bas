@@ -9,6 +9,8 @@
 #include once "hash.bi"
 #include once "list.bi"
 #include once "objinfo.bi"
+#include once "profreport.bi"
+#include once "server.bi"
 
 #include once "file.bi"
 
@@ -50,6 +52,12 @@ type FBC_OBJINF
 	mt			as integer
 end type
 
+enum
+	FBC_PGO_NONE = 0
+	FBC_PGO_GEN       '' -pgo-gen: instrumented build
+	FBC_PGO_USE       '' -pgo-use: optimize using the collected profile
+end enum
+
 type FBCCTX
 	'' For command line parsing
 	optid				as integer    '' Current option
@@ -69,6 +77,11 @@ type FBCCTX
 	showversion			as integer
 	showhelp			as integer
 	print				as integer  '' PRINT_* (-print option)
+	profreport			as string   '' samples file from -profreport
+	serverpath			as string   '' socket from -server
+	serverinited			as integer  '' -server: fbInit() done ahead, for the next hCompileBas()
+	serverreuse			as integer  '' -server: request has none of the options changing fbInit() or the setup
+	cmdline				as TLIST    '' arguments with @files expanded, minus -server, to run a new fbc for a request
 
 	'' Command line input
 	modules				as TLIST '' FBCIOFILE's for input .bas files
@@ -102,6 +115,9 @@ type FBCCTX
 	nodeflibs			as integer
 	staticlink			as integer
 	stripsymbols			as integer
+	lto				as integer  '' -lto: gcc link-time optimization
+	pgo				as integer  '' FBC_PGO_*
+	pgodir				as string   '' profile data directory for -pgo-gen/-pgo-use
 
 	'' Compiler paths
 	prefix				as zstring * FB_MAXPATHLEN+1  '' Path from -prefix or empty
@@ -157,6 +173,7 @@ private sub fbcInit( )
 	strlistInit( @fbc.temps, FBC_INITFILES\4 )
 	strlistInit( @fbc.objlist, FBC_INITFILES )
 	strlistInit( @fbc.libfiles, FBC_INITFILES\4 )
+	strlistInit( @fbc.cmdline, FBC_INITFILES )
 	strsetInit( @fbc.libs, FBC_INITFILES\4 )
 	strsetInit( @fbc.libpaths, FBC_INITFILES\4 )
 
@@ -579,6 +596,72 @@ private function fbcIsUsingGoldLinker( ) as integer
 	return FALSE
 end function
 
+'' -profile using mcount()/gmon, needs gprof's startup code and libgmon
+private function hProfileWithGmon( ) as integer
+	function = fbGetOption( FB_COMPOPT_PROFILE ) andalso _
+	           (fbGetOption( FB_COMPOPT_PROFGEN ) = FB_PROFGEN_GMON)
+end function
+
+'' -lto: ld options to load gcc's LTO plugin, which hands the objects' IR to
+'' lto-wrapper to be optimized as a whole. Done the same way as the gcc driver
+'' (collect2) does it; lto-wrapper finds gcc and the options for the final
+'' compilation in the environment.
+private function hGetLtoLinkArgs( ) as string
+	dim as string gcc, plugin, wrapper, resfile, args, options
+
+	fbcFindBin( FBCTOOL_GCC, gcc )
+
+	'' gcc just echoes the name if it doesn't know about the file
+	wrapper = hGet1stOutputLineFromCommand( gcc + " -print-prog-name=lto-wrapper" )
+	if( (len( wrapper ) = 0) orelse (wrapper = hStripPath( wrapper )) ) then
+		errReportEx( FB_ERRMSG_FILENOTFOUND, "lto-wrapper", -1 )
+		exit function
+	end if
+
+	'' the plugin is installed next to it (-print-prog-name only finds
+	'' executables)
+	#if defined( __FB_WIN32__ ) or defined( __FB_CYGWIN__ )
+		plugin = hStripFilename( wrapper ) + "liblto_plugin.dll"
+	#else
+		plugin = hStripFilename( wrapper ) + "liblto_plugin.so"
+	#endif
+	if( hFileExists( plugin ) = FALSE ) then
+		errReportEx( FB_ERRMSG_FILENOTFOUND, plugin, -1 )
+		exit function
+	end if
+
+	options = "'-O" + str( fbGetOption( FB_COMPOPT_OPTIMIZELEVEL ) ) + "' '-flto'"
+	select case( fbGetCpuFamily( ) )
+	case FB_CPUFAMILY_X86
+		options += " '-m32'"
+	case FB_CPUFAMILY_X86_64
+		options += " '-m64'"
+	end select
+	if( fbGetOption( FB_COMPOPT_PIC ) ) then
+		options += " '-fPIC'"
+	end if
+	setenviron( "COLLECT_GCC=" + gcc )
+	setenviron( "COLLECT_GCC_OPTIONS=" + options )
+
+	resfile = hStripExt( fbc.outname ) + ".ltores"
+	fbcAddTemp( resfile )
+
+	args = " -plugin """ + plugin + """"
+	args += " ""-plugin-opt=" + wrapper + """"
+	args += " ""-plugin-opt=-fresolution=" + resfile + """"
+
+	'' code generated at link time may need libgcc & co again
+	scope
+		dim as TSTRSETITEM ptr i = listGetHead( @fbc.finallibs.list )
+		while( i )
+			args += " -plugin-opt=-pass-through=-l" + i->s
+			i = listGetNext( i )
+		wend
+	end scope
+
+	function = args
+end function
+
 private function hLinkFiles( ) as integer
 	dim as string ldcline, dllname, deffile
 
@@ -766,8 +849,12 @@ private function hLinkFiles( ) as integer
 		ldcline += " -Map " + fbc.mapfile
 	end if
 
+	if( fbc.lto ) then
+		ldcline += hGetLtoLinkArgs( )
+	end if
+
 	if( fbGetOption( FB_COMPOPT_DEBUGINFO ) = FALSE ) then
-		if( fbGetOption( FB_COMPOPT_PROFILE ) = FALSE ) then
+		if( hProfileWithGmon( ) = FALSE ) then
 			if( fbc.stripsymbols ) then
 				ldcline += " -s"
 			end if
@@ -792,7 +879,7 @@ private function hLinkFiles( ) as integer
 			'' TODO
 			ldcline += hFindLib( "crt0.o" )
 			'' additional support for gmon
-			if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+			if( hProfileWithGmon( ) ) then
 				ldcline += hFindLib( "gcrt0.o" )
 			end if
 		end if
@@ -803,7 +890,7 @@ private function hLinkFiles( ) as integer
 		else
 			ldcline += hFindLib( "crt2.o" )
 			'' additional support for gmon
-			if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+			if( hProfileWithGmon( ) ) then
 				ldcline += hFindLib( "gcrt2.o" )
 			end if
 		end if
@@ -811,7 +898,7 @@ private function hLinkFiles( ) as integer
 		ldcline += hFindLib( "crtbegin.o" )
 
 	case FB_COMPTARGET_DOS
-		if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+		if( hProfileWithGmon( ) ) then
 			ldcline += hFindLib( "gcrt0.o" )
 		else
 			ldcline += hFindLib( "crt0.o" )
@@ -822,7 +909,7 @@ private function hLinkFiles( ) as integer
 	     FB_COMPTARGET_NETBSD
 
 		if( fbGetOption( FB_COMPOPT_OUTTYPE ) = FB_OUTTYPE_EXECUTABLE) then
-			if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+			if( hProfileWithGmon( ) ) then
 				select case as const fbGetOption( FB_COMPOPT_TARGET )
 				case FB_COMPTARGET_OPENBSD, FB_COMPTARGET_NETBSD
 					ldcline += hFindLib( "gcrt0.o" )
@@ -1422,6 +1509,7 @@ enum
 	OPT_L
 	OPT_LANG
 	OPT_LIB
+	OPT_LTO
 	OPT_M
 	OPT_MAP
 	OPT_MAXERR
@@ -1433,16 +1521,21 @@ enum
 	OPT_O
 	OPT_OPTIMIZE
 	OPT_P
+	OPT_PGOGEN
+	OPT_PGOUSE
 	OPT_PIC
 	OPT_PP
 	OPT_PREFIX
 	OPT_PRINT
+	OPT_PROFGEN
 	OPT_PROFILE
+	OPT_PROFREPORT
 	OPT_R
 	OPT_RKEEPASM
 	OPT_RR
 	OPT_RRKEEPASM
 	OPT_S
+	OPT_SERVER
 	OPT_SHOWINCLUDES
 	OPT_STATIC
 	OPT_STRIP
@@ -1493,6 +1586,7 @@ dim shared as integer option_takes_argument(0 to (OPT__COUNT - 1)) = _
 	TRUE , _ '' OPT_L
 	TRUE , _ '' OPT_LANG
 	FALSE, _ '' OPT_LIB
+	FALSE, _ '' OPT_LTO
 	TRUE , _ '' OPT_M
 	TRUE , _ '' OPT_MAP
 	TRUE , _ '' OPT_MAXERR
@@ -1504,16 +1598,21 @@ dim shared as integer option_takes_argument(0 to (OPT__COUNT - 1)) = _
 	TRUE , _ '' OPT_O
 	TRUE , _ '' OPT_OPTIMIZE
 	TRUE , _ '' OPT_P
+	FALSE, _ '' OPT_PGOGEN
+	TRUE , _ '' OPT_PGOUSE
 	FALSE, _ '' OPT_PIC
 	FALSE, _ '' OPT_PP
 	TRUE , _ '' OPT_PREFIX
 	TRUE , _ '' OPT_PRINT
+	TRUE , _ '' OPT_PROFGEN
 	FALSE, _ '' OPT_PROFILE
+	TRUE , _ '' OPT_PROFREPORT
 	FALSE, _ '' OPT_R
 	FALSE, _ '' OPT_RKEEPASM
 	FALSE, _ '' OPT_RR
 	FALSE, _ '' OPT_RRKEEPASM
 	TRUE , _ '' OPT_S
+	TRUE , _ '' OPT_SERVER
 	FALSE, _ '' OPT_SHOWINCLUDES
 	FALSE, _ '' OPT_STATIC
 	FALSE, _ '' OPT_STRIP
@@ -1531,7 +1630,27 @@ dim shared as integer option_takes_argument(0 to (OPT__COUNT - 1)) = _
 	TRUE   _ '' OPT_Z
 }
 
+'' -server: options that only matter while compiling the modules and
+'' linking, a request with only these can go on with the compiler initialized
+'' ahead by the server
+private function hIsServerReusableOpt( byval optid as integer ) as integer
+	select case as const( optid )
+	case OPT_A, OPT_B, OPT_C, OPT_CKEEPOBJ, OPT_D, OPT_I, OPT_INCLUDE, _
+	     OPT_L, OPT_M, OPT_MAP, OPT_MAXERR, OPT_NOERRLINE, OPT_NOSTRIP, _
+	     OPT_O, OPT_P, OPT_R, OPT_RKEEPASM, OPT_RR, OPT_RRKEEPASM, _
+	     OPT_SHOWINCLUDES, OPT_STATIC, OPT_STRIP, OPT_W, OPT_WA, OPT_WC, _
+	     OPT_WL, OPT_X
+		function = TRUE
+	case else
+		function = FALSE
+	end select
+end function
+
 private sub handleOpt(byval optid as integer, byref arg as string)
+	if( hIsServerReusableOpt( optid ) = FALSE ) then
+		fbc.serverreuse = FALSE
+	end if
+
 	select case as const (optid)
 	case OPT_A
 		fbcAddObj( arg )
@@ -1686,6 +1805,9 @@ private sub handleOpt(byval optid as integer, byref arg as string)
 	case OPT_LIB
 		fbSetOption( FB_COMPOPT_OUTTYPE, FB_OUTTYPE_STATICLIB )
 
+	case OPT_LTO
+		fbc.lto = TRUE
+
 	case OPT_M
 		fbc.mainname = arg
 		fbc.mainset = TRUE
@@ -1755,6 +1877,14 @@ private sub handleOpt(byval optid as integer, byref arg as string)
 	case OPT_P
 		strsetAdd(@fbc.libpaths, pathStripDiv(arg), FALSE)
 
+	case OPT_PGOGEN
+		fbc.pgo = FBC_PGO_GEN
+		fbc.pgodir = curdir( ) + FB_HOST_PATHDIV + "fbpgo"
+
+	case OPT_PGOUSE
+		fbc.pgo = FBC_PGO_USE
+		fbc.pgodir = pathStripDiv( arg )
+
 	case OPT_PIC
 		fbSetOption( FB_COMPOPT_PIC, TRUE )
 
@@ -1779,9 +1909,25 @@ private sub handleOpt(byval optid as integer, byref arg as string)
 			hFatalInvalidOption( arg )
 		end select
 
+	case OPT_PROFGEN
+		select case( lcase( arg ) )
+		case "gmon"
+			fbSetOption( FB_COMPOPT_PROFGEN, FB_PROFGEN_GMON )
+		case "fbrt"
+			fbSetOption( FB_COMPOPT_PROFGEN, FB_PROFGEN_FBRT )
+		case else
+			hFatalInvalidOption( arg )
+		end select
+
+		'' -profgen implies -profile
+		fbSetOption( FB_COMPOPT_PROFILE, TRUE )
+
 	case OPT_PROFILE
 		fbSetOption( FB_COMPOPT_PROFILE, TRUE )
 
+	case OPT_PROFREPORT
+		fbc.profreport = arg
+
 	case OPT_R
 		'' -r changes the output type to .o, like -c, i.e. -m may have
 		'' to be used to mark the main module, just like -c.
@@ -1807,6 +1953,9 @@ private sub handleOpt(byval optid as integer, byref arg as string)
       		case "gui" : fbSetOption( FB_COMPOPT_MODEVIEW, FB_MODEVIEW_GUI )
       	end select
 
+	case OPT_SERVER
+		fbc.serverpath = arg
+
 	case OPT_SHOWINCLUDES
 		fbSetOption( FB_COMPOPT_SHOWINCLUDES, TRUE )
 
@@ -1937,6 +2086,8 @@ private sub handleOpt(byval optid as integer, byref arg as string)
 			fbSetOption( FB_COMPOPT_GOSUBSETJMP, TRUE )
 		case "valist-as-ptr"
 			fbSetOption( FB_COMPOPT_VALISTASPTR, TRUE )
+		case "typed-data"
+			fbSetOption( FB_COMPOPT_TYPEDDATA, TRUE )
 		case else
 			hFatalInvalidOption( arg )
 		end select
@@ -2009,6 +2160,7 @@ private function parseOption(byval opt as zstring ptr) as integer
 		ONECHAR(OPT_L)
 		CHECK("lang", OPT_LANG)
 		CHECK("lib", OPT_LIB)
+		CHECK("lto", OPT_LTO)
 
 	case asc("m")
 		ONECHAR(OPT_M)
@@ -2030,11 +2182,15 @@ private function parseOption(byval opt as zstring ptr) as integer
 
 	case asc("p")
 		ONECHAR(OPT_P)
+		CHECK("pgo-gen", OPT_PGOGEN)
+		CHECK("pgo-use", OPT_PGOUSE)
 		CHECK("pic", OPT_PIC)
 		CHECK("pp", OPT_PP)
 		CHECK("prefix", OPT_PREFIX)
 		CHECK("print", OPT_PRINT)
+		CHECK("profgen", OPT_PROFGEN)
 		CHECK("profile", OPT_PROFILE)
+		CHECK("profreport", OPT_PROFREPORT)
 
 	case asc("r")
 		ONECHAR(OPT_R)
@@ -2046,6 +2202,7 @@ private function parseOption(byval opt as zstring ptr) as integer
 
 	case asc("s")
 		ONECHAR(OPT_S)
+		CHECK("server", OPT_SERVER)
 		CHECK("showincludes", OPT_SHOWINCLUDES)
 		CHECK("static", OPT_STATIC)
 		CHECK("strip", OPT_STRIP)
@@ -2095,6 +2252,10 @@ private sub handleArg(byref arg as string)
 			hFatalInvalidOption( arg )
 		end if
 
+		if (fbc.optid <> OPT_SERVER) then
+			strlistAppend(@fbc.cmdline, arg)
+		end if
+
 		handleOpt(fbc.optid, arg)
 		fbc.optid = -1
 		return
@@ -2122,6 +2283,10 @@ private sub handleArg(byref arg as string)
 			hFatalInvalidOption( arg )
 		end if
 
+		if (optid <> OPT_SERVER) then
+			strlistAppend(@fbc.cmdline, arg)
+		end if
+
 		'' Does this option take a parameter?
 		if (option_takes_argument(optid)) then
 			'' Delay handling it, until the next argument is known.
@@ -2157,6 +2322,8 @@ private sub handleArg(byref arg as string)
 		reclevel -= 1
 
 	case else
+		strlistAppend(@fbc.cmdline, arg)
+
 		'' Input file, get its extension to determine what it is
 		dim as string ext = hGetFileExt(arg)
 
@@ -2274,6 +2441,65 @@ private function hTargetNeedsPIC( ) as integer
 	end if
 end function
 
+'' -server: run a new fbc for the request, with the server's and the
+'' request's arguments
+private sub hServeNewProcess( )
+	dim as string path = exepath( ) + FB_HOST_PATHDIV + hStripPath( command( 0 ) )
+
+	'' only returns if it couldn't be run
+	serverExec( path, @fbc.cmdline )
+
+	errReportEx( FB_ERRMSG_EXEMISSING, path, -1, FB_ERRMSGOPT_ADDCOLON or FB_ERRMSGOPT_ADDQUOTES )
+	fbcEnd( 1 )
+end sub
+
+'' -server: returns in the process forked for a request only, which goes on
+'' like a normal fbc run, with the request's arguments added to the server's.
+'' The server has checked its options, set up the paths and initialized the
+'' compiler already; if the request changes any of that (-lang, -gen, -target,
+'' -fpu, -prefix, ...), it's compiled by a new fbc instead.
+private sub hServe( )
+	dim as TLIST args
+	dim as string ptr arg = any
+	dim as string lastarg
+
+	strlistInit( @args, 16 )
+
+	'' Once, for all the requests, their processes are forked from this one
+	fbInit( FALSE, 0 )
+	fbc.serverinited = TRUE
+
+	if( serverRun( fbc.serverpath, @args ) = FALSE ) then
+		fbcEnd( 1 )
+	end if
+
+	fbc.serverpath = ""
+	fbc.serverreuse = TRUE
+
+	arg = listGetHead( @args )
+	while( arg )
+		lastarg = *arg
+		handleArg( *arg )
+		arg = listGetNext( arg )
+	wend
+
+	if( fbc.optid >= 0 ) then
+		'' Missing argument for command line option
+		hFatalInvalidOption( lastarg )
+	end if
+
+	'' No server started by a request
+	if( len( fbc.serverpath ) > 0 ) then
+		hFatalInvalidOption( "-server" )
+	end if
+
+	if( fbc.serverreuse = FALSE ) then
+		hServeNewProcess( )
+	end if
+
+	hCheckWaitingObjfile( )
+end sub
+
 private sub hParseArgs( byval argc as integer, byval argv as zstring ptr ptr )
 	fbc.optid = -1
 
@@ -2410,6 +2636,18 @@ private sub hParseArgs( byval argc as integer, byval argv as zstring ptr ptr )
 		end if
 	end if
 
+	'' -lto needs gcc to compile the modules
+	if( fbc.lto and (fbGetOption( FB_COMPOPT_BACKEND ) <> FB_BACKEND_GCC) ) then
+		errReportEx( FB_ERRMSG_LTOWITHOUTGENGCC, "", -1 )
+		fbc.lto = FALSE
+	end if
+
+	'' so do -pgo-gen/-pgo-use
+	if( (fbc.pgo <> FBC_PGO_NONE) and (fbGetOption( FB_COMPOPT_BACKEND ) <> FB_BACKEND_GCC) ) then
+		errReportEx( FB_ERRMSG_PGOWITHOUTGENGCC, "", -1 )
+		fbc.pgo = FBC_PGO_NONE
+	end if
+
 	'' TODO: Check whether subsystem/stacksize/xboxtitle were set and
 	'' complain about it when the target doesn't allow it, or just
 	'' ignore silently (that might not even be too bad for portability)?
@@ -2641,8 +2879,16 @@ private sub hCompileBas _
 	end if
 
 	do
-		'' init the parser
-		fbInit( is_main, restarts )
+		'' init the parser, unless -server did it ahead; that was done
+		'' with is_main = FALSE
+		if( fbc.serverinited ) then
+			fbc.serverinited = FALSE
+			if( is_main ) then
+				fbInitMain( )
+			end if
+		else
+			fbInit( is_main, restarts )
+		end if
 
 		if( is_fbctinf ) then
 			'' Let the compiler know about all libs collected so far,
@@ -2875,6 +3121,31 @@ private function hCompileXpm( ) as integer
 	function = TRUE
 end function
 
+'' -pgo-gen/-pgo-use: gcc options for the profile data. gcc names the .gcda
+'' files after the (mangled) absolute paths of the outputs, so they're made
+'' relative to the current directory, to match when building elsewhere; this
+'' needs gcc 11 or newer.
+private function hGetPgoOptions( ) as string
+	static as integer gccmajor = -1
+	dim as string ln, gcc
+
+	if( fbc.pgo = FBC_PGO_GEN ) then
+		ln = "-fprofile-generate=""" + fbc.pgodir + """ "
+	else
+		ln = "-fprofile-use=""" + fbc.pgodir + """ -fprofile-correction -Wno-missing-profile "
+	end if
+
+	if( gccmajor < 0 ) then
+		fbcFindBin( FBCTOOL_GCC, gcc )
+		gccmajor = valint( hGet1stOutputLineFromCommand( gcc + " -dumpversion" ) )
+	end if
+	if( gccmajor >= 11 ) then
+		ln += "-fprofile-prefix-path=""" + curdir( ) + """ "
+	end if
+
+	function = ln
+end function
+
 private function hCompileStage2Module( byval module as FBCIOFILE ptr ) as integer
 	dim as string ln, asmfile
 
@@ -2947,10 +3218,25 @@ private function hCompileStage2Module( byval module as FBCIOFILE ptr ) as intege
 		'' See ir-hlc.bas:hEmitType()
 		ln += "-Wno-format "
 
+		'' VECTOR types are gcc vector types, passing 32 byte ones without
+		'' -mavx works, but gcc warns about the ABI
+		ln += "-Wno-psabi "
+
 		if( fbGetOption( FB_COMPOPT_DEBUGINFO ) ) then
 			ln += "-g "
 		end if
 
+		'' -lto: the objects carry gcc's IR for the link; fat objects (with
+		'' normal code too) keep the objinfo section, and can still be
+		'' linked or archived without the LTO plugin
+		if( fbc.lto ) then
+			ln += "-flto -ffat-lto-objects "
+		end if
+
+		if( fbc.pgo <> FBC_PGO_NONE ) then
+			ln += hGetPgoOptions( )
+		end if
+
 		if( fbGetOption( FB_COMPOPT_FPUTYPE ) = FB_FPUTYPE_SSE ) then
 			ln += "-mfpmath=sse -msse2 "
 		end if
@@ -3288,6 +3574,11 @@ private sub hAddDefaultLibs( )
 	'' select the right FB rtlib
 	fbcAddDefLib( "fb" + hGetFbLibNameSuffix( ) )
 
+	'' -pgo-gen: the instrumented code writes the profile through libgcov
+	if( fbc.pgo = FBC_PGO_GEN ) then
+		fbcAddDefLib( "gcov" )
+	end if
+
 	'' and the gfxlib, if gfx functions were used
 	if( fbGetOption( FB_COMPOPT_GFX ) ) then
 		fbcAddDefLib( "fbgfx" + hGetFbLibNameSuffix( ) )
@@ -3331,7 +3622,7 @@ private sub hAddDefaultLibs( )
 		fbcAddDefLib( "user32" )
 
 		'' profiling?
-		if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+		if( hProfileWithGmon( ) ) then
 			fbcAddDefLib( "gmon" )
 		end if
 
@@ -3417,7 +3708,7 @@ private sub hAddDefaultLibs( )
 		end if
 
 		'' profiling?
-		if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+		if( hProfileWithGmon( ) ) then
 			fbcAddDefLib( "gmon" )
 		end if
 
@@ -3432,7 +3723,7 @@ private sub hAddDefaultLibs( )
 		fbcAddDefLib( "m" )
 
 		'' profiling?
-		if( fbGetOption( FB_COMPOPT_PROFILE ) ) then
+		if( hProfileWithGmon( ) ) then
 			fbcAddDefLib( "gmon" )
 		end if
 
@@ -3494,6 +3785,7 @@ private sub hPrintOptions( byval verbose as integer )
 	print "  -l <name>        Link in a library"
 	print "  -lang <name>     Select FB dialect: fb, deprecated, fblite, qb"
 	print "  -lib             Create a static library"
+	print "  -lto             Link-time optimization across modules and the rtlib (-gen gcc)"
 	print "  -m <name>        Specify main module (default if not -c: first input .bas)"
 	print "  -map <file>      Save linking map to file"
 	print "  -maxerr <n>      Only show <n> errors"
@@ -3505,6 +3797,9 @@ private sub hPrintOptions( byval verbose as integer )
 	print "  -o <file>        Set .o (or -pp .bas) file name for prev/next input file"
 	print "  -O <value>       Optimization level (default: 0)"
 	print "  -p <path>        Add a library search path"
+	print "  -pgo-gen         Build for profile-guided optimization: running the program"
+	print "                   writes its profile into ./fbpgo/ (-gen gcc)"
+	print "  -pgo-use <dir>   Optimize using the profile from a -pgo-gen build"
 	print "  -pic             Generate position-independent code (non-x86 Unix shared libs)"
 	print "  -pp              Write out preprocessed input file (.pp.bas) only"
 	print "  -prefix <path>   Set the compiler prefix path"
@@ -3515,11 +3810,17 @@ private sub hPrintOptions( byval verbose as integer )
 	print "  -print sha-1     Display compiler's source code commit sha-1 (if known)"
 	end if
 	print "  -profile         Enable function profiling"
+	print "  -profgen gmon|fbrt  Select profiling code: gprof (default), or the rtlib's"
+	print "                   profiler, writing profile.txt/profile.folded at exit"
+	print "  -profreport <file>  Display the procedures sampled in <file>, the"
+	print "                   profile.samples written by FB_SAMPLE_PROFILE=<rate>[,stack]"
 	print "  -r               Write out .asm/.c/.ll (-gen gas/gcc/llvm) only"
 	print "  -rr              Write out the final .asm only"
 	print "  -R               Preserve temporary .asm/.c/.ll/.def files"
 	print "  -RR              Preserve the final .asm file"
 	print "  -s console|gui   Select win32 subsystem"
+	print "  -server <socket> Stay resident, compiling the requests sent to the Unix"
+	print "                   domain <socket>, with these options as the defaults"
 	print "  -showincludes    Display a tree of file names of #included files"
 	print "  -static          Prefer static libraries over dynamic ones when linking"
 	print "  -strip           Omit all symbol information from the output file"
@@ -3543,6 +3844,7 @@ private sub hPrintOptions( byval verbose as integer )
 	if( verbose ) then
 	print "  -z gosub-setjmp  Use setjmp/longjmp to implement GOSUB"
 	print "  -z valist-as-ptr Use pointer expressions to implement CVA_*() macros"
+	print "  -z typed-data    Store numeric DATA as typed tables, READ with a per-thread cursor"
 	end if
 
 end sub
@@ -3608,6 +3910,11 @@ end sub
 	fbcDeterminePrefix( )
 	fbcSetupCompilerPaths( )
 
+	'' -server? Returns in the process compiling a request
+	if( len( fbc.serverpath ) > 0 ) then
+		hServe( )
+	end if
+
 	if( fbc.verbose ) then
 		fbcPrintTargetInfo( )
 	end if
@@ -3646,6 +3953,11 @@ end sub
 		fbcEnd( 0 )
 	end if
 
+	'' Map the samples of the rtlib's sampling profiler to procedures, and stop
+	if( len( fbc.profreport ) > 0 ) then
+		fbcEnd( iif( profreportPrint( fbc.profreport ), 0, 1 ) )
+	end if
+
 	fbcDetermineMainName( )
 
 	'' Show help if there are no input files
@@ -380,6 +380,19 @@ sub hReplaceSlash( byval s as zstring ptr, byval char as integer )
 	next
 end sub
 
+'' Returns count TABs, for appending indentation to emitted lines without
+'' building a temporary string( count, TABCHAR ) each time. The result is
+'' the tail of a static string, valid until the next call with a bigger count.
+function hTabs( byval count as integer ) as zstring ptr
+	static as string tabs
+
+	if( len( tabs ) < count ) then
+		tabs = string( count + 16, TABCHAR )
+	end if
+
+	function = strptr( tabs ) + (len( tabs ) - count)
+end function
+
 function pathStripDiv( byref path as string ) as string
 	dim as integer length = len( path )
 	if( length > 0 ) then
@@ -104,6 +104,7 @@
 #include once "flist.bi"
 #include once "lex.bi"
 #include once "ir-private.bi"
+#include once "outbuf.bi"
 
 '' The stack of nested sections allows us to go back and emit text to
 '' the headers of parent sections, while already working on emitting
@@ -195,6 +196,8 @@ type IRHLCCTX
 
 	linenum				as integer
 	escapedinputfilename		as string
+	linedirective			as string  '' last #line built, reused until linenum or file changes
+	linedirectivenum		as integer '' linenum the #line was built for, or -1
 	usedbuiltins			as uinteger  '' BUILTIN_*
 
 	anonstack			as TLIST  '' stack of nested anonymous structs/unions in a struct/union
@@ -315,7 +318,7 @@ private sub sectionWriteLine( byref s as string )
 	with( ctx.sections(ctx.section) )
 		if( .old ) then
 			if( .indent > 0 ) then
-				.text = string( .indent, TABCHAR )
+				.text = *hTabs( .indent )
 				.text += s
 			else
 				.text = s
@@ -323,7 +326,7 @@ private sub sectionWriteLine( byref s as string )
 			.old = FALSE
 		else
 			if( .indent > 0 ) then
-				.text += string( .indent, TABCHAR )
+				.text += *hTabs( .indent )
 			end if
 			.text += s
 		end if
@@ -385,12 +388,15 @@ end sub
 '' Main emitting function
 '' Writes out line of code to current section, and adds #line's
 private sub hWriteLine( byref s as string, byval noline as integer = FALSE )
-	static as string ln
-
 	if( env.clopt.debuginfo and (noline = FALSE) ) then
-		ln = "#line " + str( ctx.linenum )
-		ln += " """ + ctx.escapedinputfilename + """"
-		sectionWriteLine( ln )
+		'' Consecutive lines usually come from the same source line,
+		'' only rebuild the #line directive when that changes
+		if( ctx.linedirectivenum <> ctx.linenum ) then
+			ctx.linedirective = "#line " + str( ctx.linenum )
+			ctx.linedirective += " """ + ctx.escapedinputfilename + """"
+			ctx.linedirectivenum = ctx.linenum
+		end if
+		sectionWriteLine( ctx.linedirective )
 	end if
 
 	sectionWriteLine( s )
@@ -398,6 +404,7 @@ end sub
 
 private sub hUpdateCurrentFileName( byval filename as zstring ptr )
 	ctx.escapedinputfilename = hReplace( filename, "\", $"\\" )
+	ctx.linedirectivenum = -1
 end sub
 
 private sub hWriteStaticAssert( byref expr as string )
@@ -456,6 +463,28 @@ private sub hAppendCtorAttrib _
 	end if
 end sub
 
+private sub hAppendFuncAttrib _
+	( _
+		byref ln as string, _
+		byval proc as FBSYMBOL ptr _
+	)
+
+	if( proc->stats and FB_SYMBSTATS_NORETURN ) then
+		ln += " __attribute__(( noreturn ))"
+	end if
+
+	if( proc->stats and FB_SYMBSTATS_COLD ) then
+		ln += " __attribute__(( cold ))"
+	end if
+
+	'' const implies pure
+	if( proc->stats and FB_SYMBSTATS_CONSTPROC ) then
+		ln += " __attribute__(( const ))"
+	elseif( proc->stats and FB_SYMBSTATS_PURE ) then
+		ln += " __attribute__(( pure ))"
+	end if
+end sub
+
 '' Helper function to add underscore prefix or @N stdcall suffix to mangled
 '' procedure names (because symb-mangling doesn't do it for -gen gcc), for use
 '' in inline ASM and such.
@@ -633,6 +662,9 @@ private function hEmitProcHeader _
 
 		'' ctor/dtor flags on prototypes
 		hAppendCtorAttrib( ln, proc, FALSE )
+
+		'' noreturn/cold/pure/const flags on prototypes (RTL procs)
+		hAppendFuncAttrib( ln, proc )
 	end if
 
 	function = ln
@@ -640,6 +672,11 @@ end function
 
 private function hGetUdtTag( byval sym as FBSYMBOL ptr ) as string
 	if( symbIsStruct( sym ) ) then
+		'' VECTOR types are typedefs
+		if( symbGetUdtIsVector( sym ) ) then
+			exit function
+		end if
+
 		if( symbGetUDTIsUnion( sym ) ) then
 			function = "union "
 		else
@@ -1079,10 +1116,31 @@ private sub hEmitStructWithFields( byval s as FBSYMBOL ptr )
 	assert( listGetHead( @ctx.anonstack ) = NULL )
 end sub
 
+'' VECTOR: a gcc vector type, aligned like its elements to keep FB's layout,
+'' so it can be accessed field by field like any other UDT
+private sub hEmitVectorType( byval s as FBSYMBOL ptr )
+	dim as integer dtype = any
+
+	symbSetIsEmitted( s )
+
+	dtype = typeGetDtAndPtrOnly( symbGetUdtVectorDtype( s ) )
+
+	hWriteLine( "typedef " + hEmitType( dtype, NULL ) + " " + hGetUdtId( s ) + _
+	            " __attribute__((vector_size(" & symbGetLen( s ) & "), aligned(" & typeGetSize( dtype ) & ")));", TRUE )
+
+	hWriteStaticAssert( "sizeof( " + hGetUdtId( s ) + " ) == " + str( culngint( symbGetLen( s ) ) ) )
+end sub
+
 private sub hEmitStruct( byval s as FBSYMBOL ptr, byval is_ptr as integer )
 	dim as integer emit_fields = any
 	dim as string ln
 
+	'' Only made of scalars, no other UDTs to emit first
+	if( symbGetUdtIsVector( s ) ) then
+		hEmitVectorType( s )
+		exit sub
+	end if
+
 	'' Already in the process of emitting this UDT?
 	if( symbGetIsBeingEmitted( s ) ) then
 		'' This means there is a circular dependency with another UDT.
@@ -1268,12 +1326,7 @@ private sub hMaybeEmitProcExport( byval proc as FBSYMBOL ptr )
 end sub
 
 private function _emitBegin( ) as integer
-	if( hFileExists( env.outf.name ) ) then
-		kill env.outf.name
-	end if
-
-	env.outf.num = freefile
-	if( open( env.outf.name, for binary, access read write, as #env.outf.num ) <> 0 ) then
+	if( outbufOpen( ) = FALSE ) then
 		return FALSE
 	end if
 
@@ -1384,15 +1437,11 @@ private sub _emitEnd( )
 
 	'' Emit & close the main section
 	if( ctx.sections(0).old = FALSE ) then
-		if( put( #env.outf.num, , ctx.sections(0).text ) <> 0 ) then
-		end if
+		outbufWriteStr( ctx.sections(0).text )
 	end if
 	sectionEnd( )
 
-	if( close( #env.outf.num ) <> 0 ) then
-		'' ...
-	end if
-	env.outf.num = 0
+	outbufClose( )
 
 	assert( ctx.sectiongosublevel = 0 )
 	assert( ctx.section = -1 )
@@ -1911,7 +1960,12 @@ private function exprNewUOP _
 			solved_out = (l->op = op)
 		end if
 
-		dtype = typeCBop( op, l->dtype, l->dtype )
+		'' VECTOR types: element-wise, the result is the same vector type
+		if( typeGet( l->dtype ) = FB_DATATYPE_STRUCT ) then
+			dtype = l->dtype
+		else
+			dtype = typeCBop( op, l->dtype, l->dtype )
+		end if
 
 
 	case AST_OP_ABS, AST_OP_FLOOR, _
@@ -1949,9 +2003,20 @@ private function exprNewBOP _
 
 	dim as EXPRNODE ptr n = any
 	dim as integer dtype = any
+	dim as FBSYMBOL ptr subtype = NULL
 
-	'' To find out the BOPs result type, apply C type promotion rules
-	dtype = typeCBop( op, l->dtype, r->dtype )
+	'' VECTOR types: element-wise, the result is the vector type, the
+	'' other operand may be a scalar of the element type
+	if( typeGet( l->dtype ) = FB_DATATYPE_STRUCT ) then
+		dtype = l->dtype
+		subtype = l->subtype
+	elseif( typeGet( r->dtype ) = FB_DATATYPE_STRUCT ) then
+		dtype = r->dtype
+		subtype = r->subtype
+	else
+		'' To find out the BOPs result type, apply C type promotion rules
+		dtype = typeCBop( op, l->dtype, r->dtype )
+	end if
 
 	'' BOPs should only be done on simple int/float types,
 	'' and on pointers only after casting to ubyte* first,
@@ -1973,7 +2038,7 @@ private function exprNewBOP _
 		end if
 	end select
 
-	n = exprNew( EXPRCLASS_BOP, dtype, NULL )
+	n = exprNew( EXPRCLASS_BOP, dtype, subtype )
 	n->l = l
 	n->r = r
 	n->op = op
@@ -2819,6 +2884,7 @@ private sub _emitBop _
 	)
 
 	dim as EXPRNODE ptr l = any, r = any
+	dim as integer dtype = any
 
 	l = exprNewVREG( v1 )
 	r = exprNewVREG( v2 )
@@ -2828,7 +2894,15 @@ private sub _emitBop _
 		assert( vr = NULL )
 		static as string s
 		s = "if( "
-		s += exprFlush( exprNewBOP( op, l, r ) )
+		'' error checks: tell gcc which way the branch normally goes,
+		'' so the error path is moved out of line
+		if( symbGetLabelIsLikely( label ) ) then
+			s += "__builtin_expect( "
+			s += exprFlush( exprNewBOP( op, l, r ) )
+			s += ", 1 )"
+		else
+			s += exprFlush( exprNewBOP( op, l, r ) )
+		end if
 		s += " ) goto "
 		s += *symbGetMangledName( label )
 		s += ";"
@@ -2840,6 +2914,25 @@ private sub _emitBop _
 		vr = v1
 	end if
 
+	'' VECTOR types: the AST only allows arithmetic, bitwise and shift
+	'' operators on them, with the same meaning for the elements
+	if( typeGet( vr->dtype ) = FB_DATATYPE_STRUCT ) then
+		select case as const( op )
+		case AST_OP_SHL, AST_OP_SHR
+			'' Mask the shift amount like for scalars, casting a scalar
+			'' back to the element type, because gcc doesn't allow
+			'' int with a vector of shorts
+			dtype = typeGetDtAndPtrOnly( symbGetUdtVectorDtype( vr->subtype ) )
+			r = exprNewBOP( AST_OP_AND, r, exprNewIMMi( typeGetBits( dtype ) - 1 ) )
+			if( typeGet( r->dtype ) <> FB_DATATYPE_STRUCT ) then
+				r = exprNewCAST( dtype, NULL, r )
+			end if
+		end select
+
+		exprSTORE( vr, exprNewBOP( op, l, r ) )
+		exit sub
+	end if
+
 	select case as const( op )
 	case AST_OP_EQ, AST_OP_NE, AST_OP_GT, AST_OP_LT, AST_OP_GE, AST_OP_LE
 		l = exprNewBOP( op, l, r )
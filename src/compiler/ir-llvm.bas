@@ -91,6 +91,7 @@
 #include once "flist.bi"
 #include once "lex.bi"
 #include once "ir-private.bi"
+#include once "outbuf.bi"
 
 enum
 	SECTION_HEAD  '' global declarations
@@ -258,21 +259,24 @@ private sub _end( )
 end sub
 
 private sub hWriteLine( byref ln as string )
-	if( (ctx.indent > 0) andalso (len( ln ) > 0) ) then
-		ln = string( ctx.indent, TABCHAR ) + ln
-	end if
-
-	ln += NEWLINE
+	dim as string ptr txt = any
 
 	'' Write it out to the current section
 	select case as const( ctx.section )
 	case SECTION_HEAD
-		ctx.head_txt += ln
+		txt = @ctx.head_txt
 	case SECTION_BODY
-		ctx.body_txt += ln
-	case SECTION_FOOT
-		ctx.foot_txt += ln
+		txt = @ctx.body_txt
+	case else
+		txt = @ctx.foot_txt
 	end select
+
+	'' Append directly, without building the indented line in a temporary
+	if( (ctx.indent > 0) andalso (len( ln ) > 0) ) then
+		*txt += *hTabs( ctx.indent )
+	end if
+	*txt += ln
+	*txt += NEWLINE
 end sub
 
 private sub hInternalCommand( byref message as string )
@@ -869,12 +873,7 @@ private sub hAddGlobalCtorDtor( byval proc as FBSYMBOL ptr )
 end sub
 
 private function _emitBegin( ) as integer
-	if( hFileExists( env.outf.name ) ) then
-		kill env.outf.name
-	end if
-
-	env.outf.num = freefile
-	if( open( env.outf.name, for binary, access read write, as #env.outf.num ) <> 0 ) then
+	if( outbufOpen( ) = FALSE ) then
 		return FALSE
 	end if
 
@@ -944,18 +943,11 @@ private sub _emitEnd( )
 	ctx.section = SECTION_FOOT
 
 	' flush all sections to file
-	if( put( #env.outf.num, , ctx.head_txt ) <> 0 ) then
-	end if
-	if( put( #env.outf.num, , ctx.body_txt ) <> 0 ) then
-	end if
-	if( put( #env.outf.num, , ctx.foot_txt ) <> 0 ) then
-	end if
-
-	if( close( #env.outf.num ) <> 0 ) then
-		'' ...
-	end if
+	outbufWriteStr( ctx.head_txt )
+	outbufWriteStr( ctx.body_txt )
+	outbufWriteStr( ctx.foot_txt )
 
-	env.outf.num = 0
+	outbufClose( )
 end sub
 
 private function _getOptionValue( byval opt as IR_OPTIONVALUE ) as integer
@@ -46,43 +46,39 @@
 
 '':::::
 private function hUTF8ToChar( ) as integer static
-    dim as ubyte src(0 to 6)
     dim as ubyte ptr p
     dim as uinteger c
     dim as ubyte ptr dst
     dim as integer chars, extbytes, i
 
 	dst = cast( ubyte ptr, @lex.ctx->buffw )
+	p = lex.ctx->fileptr
 	chars = 0
 
 	do while( chars < LEX_MAXBUFFCHARS )
-		if( eof( env.inf.num ) ) then
+		if( p >= lex.ctx->fileend ) then
 			exit do
 		end if
 
-		if( get( #env.inf.num, , src(0) ) <> 0 ) then
+		extbytes = utf8_trailingTb(*p)
+
+		'' sequence cut at EOF?
+		if( p + extbytes >= lex.ctx->fileend ) then
+			p = lex.ctx->fileend
 			exit do
 		end if
 
-		extbytes = utf8_trailingTb(src(0))
-
 		c = 0
-		p = @src(0)
-		if( extbytes > 0 ) then
-			if( get( #env.inf.num, , src(1), extbytes ) <> 0 ) then
-				exit do
-			end if
-
-			i = extbytes
-			do
-				c += *p
-				p += 1
-				c shl= 6
-        		i -= 1
-        	loop while( i > 0 )
-		end if
+		i = extbytes
+		do while( i > 0 )
+			c += *p
+			p += 1
+			c shl= 6
+			i -= 1
+		loop
 
 		c += *p
+		p += 1
 
 		c -= utf8_offsetsTb(extbytes)
 
@@ -95,49 +91,47 @@ private function hUTF8ToChar( ) as integer static
 		chars += 1
 	loop
 
+	lex.ctx->fileptr = p
+
 	function = chars
 
 end function
 
 '':::::
 private function hUTF8ToUTF16LE( ) as integer static
-    dim as ubyte src(0 to 6)
     dim as ubyte ptr p
     dim as uinteger c
     dim as ushort ptr dst
     dim as integer chars, extbytes, i
 
 	dst = cast( ushort ptr, @lex.ctx->buffw )
+	p = lex.ctx->fileptr
 	chars = 0
 
 	do while( chars < LEX_MAXBUFFCHARS )
-		if( eof( env.inf.num ) ) then
+		if( p >= lex.ctx->fileend ) then
 			exit do
 		end if
 
-		if( get( #env.inf.num, , src(0) ) <> 0 ) then
+		extbytes = utf8_trailingTb(*p)
+
+		'' sequence cut at EOF?
+		if( p + extbytes >= lex.ctx->fileend ) then
+			p = lex.ctx->fileend
 			exit do
 		end if
 
-		extbytes = utf8_trailingTb(src(0))
-
 		c = 0
-		p = @src(0)
-		if( extbytes > 0 ) then
-			if( get( #env.inf.num, , src(1), extbytes ) <> 0 ) then
-				exit do
-			end if
-
-			i = extbytes
-			do
-				c += *p
-				p += 1
-				c shl= 6
-        		i -= 1
-        	loop while( i > 0 )
-		end if
+		i = extbytes
+		do while( i > 0 )
+			c += *p
+			p += 1
+			c shl= 6
+			i -= 1
+		loop
 
 		c += *p
+		p += 1
 
 		c -= utf8_offsetsTb(extbytes)
 
@@ -157,49 +151,47 @@ private function hUTF8ToUTF16LE( ) as integer static
 		chars += 1
 	loop
 
+	lex.ctx->fileptr = p
+
 	function = chars
 
 end function
 
 '':::::
 private function hUTF8ToUTF32LE( ) as integer static
-    dim as ubyte src(0 to 6)
     dim as ubyte ptr p
     dim as uinteger c
     dim as ulong ptr dst
     dim as integer chars, extbytes, i
 
 	dst = cast( ulong ptr, @lex.ctx->buffw )
+	p = lex.ctx->fileptr
 	chars = 0
 
 	do while( chars < LEX_MAXBUFFCHARS )
-		if( eof( env.inf.num ) ) then
+		if( p >= lex.ctx->fileend ) then
 			exit do
 		end if
 
-		if( get( #env.inf.num, , src(0) ) <> 0 ) then
+		extbytes = utf8_trailingTb(*p)
+
+		'' sequence cut at EOF?
+		if( p + extbytes >= lex.ctx->fileend ) then
+			p = lex.ctx->fileend
 			exit do
 		end if
 
-		extbytes = utf8_trailingTb(src(0))
-
 		c = 0
-		p = @src(0)
-		if( extbytes > 0 ) then
-			if( get( #env.inf.num, , src(1), extbytes ) <> 0 ) then
-				exit do
-			end if
-
-			i = extbytes
-			do
-				c += *p
-				p += 1
-				c shl= 6
-        		i -= 1
-        	loop while( i > 0 )
-		end if
+		i = extbytes
+		do while( i > 0 )
+			c += *p
+			p += 1
+			c shl= 6
+			i -= 1
+		loop
 
 		c += *p
+		p += 1
 
 		c -= utf8_offsetsTb(extbytes)
 
@@ -208,6 +200,8 @@ private function hUTF8ToUTF32LE( ) as integer static
 		chars += 1
 	loop
 
+	lex.ctx->fileptr = p
+
 	function = chars
 
 end function
@@ -232,6 +226,7 @@ private function hUTF8ToUTF32BE( ) as integer static
 end function
 
 '':::::
+'' decode the next buffer-full from the file read into lex.ctx->filebuff
 sub lexReadUTF8( )
 	dim as integer chars
 
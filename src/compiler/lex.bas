@@ -27,7 +27,24 @@ declare sub hSkipChar( )
 
 const UINVALID as uinteger = cuint( INVALID )
 
+'' char classes, for the loops scanning the file buffer directly
+enum
+	LEXCC_IDENT		= &h01						'' A-Z, a-z, 0-9, _
+	LEXCC_SPACE		= &h02						'' tab, space
+	LEXCC_LINE		= &h04						'' anything but CR, LF, null
+	LEXCC_COMMENT	= &h08						'' same, but not ' or / either
+end enum
+
+'' reading ASCII text straight from the file, with no current or look-ahead
+'' char pending, and no chars to collect for the debug output?
+#define hCanScanDirect( ) _
+	((lex.ctx->deflen = 0) andalso (lex.ctx->filebuff <> NULL) andalso _
+	 (lex.ctx->currchar = UINVALID) andalso (lex.ctx->lahdchar = UINVALID) andalso _
+	 (env.inf.format = FBFILE_FORMAT_ASCII) andalso _
+	 ((env.clopt.debuginfo = FALSE) orelse (env.includerec > 0)))
+
 dim shared as LEX_CTX lex
+dim shared as ubyte charclassTb(0 to 255)
 
 '' Buffer holding the current line when emitting in -pp only mode
 dim shared as string pponly_ln
@@ -46,6 +63,16 @@ sub lexPushCtx( )
 
 end sub
 
+'':::::
+private sub hFreeFile( )
+
+	if( lex.ctx->filebuff <> NULL ) then
+		deallocate( lex.ctx->filebuff )
+		lex.ctx->filebuff = NULL
+	end if
+
+end sub
+
 '':::::
 sub lexPopCtx( )
 
@@ -53,6 +80,8 @@ sub lexPopCtx( )
 		DZstrAllocate( lex.ctx->currline, 0 )
 	end if
 
+	hFreeFile( )
+
 	'' free dynamic strings used in macro expansions
 	if( env.inf.format = FBFILE_FORMAT_ASCII ) then
 		DZstrAllocate( lex.ctx->deftext, 0 )
@@ -120,6 +149,9 @@ sub lexInit _
 	end if
 
 	''
+	lex.ctx->filebuff = NULL
+	lex.ctx->fileptr = NULL
+	lex.ctx->fileend = NULL
 	lex.ctx->filepos = 0
 	lex.ctx->lastfilepos = 0
 
@@ -133,6 +165,22 @@ sub lexInit _
 
 	if( isinclude = FALSE ) then
 		ppInit( )
+
+		for i = 0 to 255
+			select case as const i
+			case CHAR_AUPP to CHAR_ZUPP, CHAR_ALOW to CHAR_ZLOW, _
+				 CHAR_0 to CHAR_9, CHAR_UNDER
+				charclassTb(i) = LEXCC_IDENT or LEXCC_LINE or LEXCC_COMMENT
+			case CHAR_TAB, CHAR_SPACE
+				charclassTb(i) = LEXCC_SPACE or LEXCC_LINE or LEXCC_COMMENT
+			case 0, CHAR_CR, CHAR_LF
+				charclassTb(i) = 0
+			case CHAR_APOST, CHAR_SLASH
+				charclassTb(i) = LEXCC_LINE
+			case else
+				charclassTb(i) = LEXCC_LINE or LEXCC_COMMENT
+			end select
+		next
 	end if
 
 end sub
@@ -140,6 +188,8 @@ end sub
 '':::::
 sub lexEnd( )
 
+	hFreeFile( )
+
 	pponly_ln = ""
 
 	ppEnd( )
@@ -173,6 +223,53 @@ private sub hCollectCharForDebugOutput( byval char as uinteger )
 	DZstrConcatAssignC( lex.ctx->currline, char )
 end sub
 
+'':::::
+'' read the rest of the source file at once, instead of a buffer-full at a time
+private sub hLoadFile( )
+	dim as integer size = any
+	dim as uinteger bytes = any
+
+	lex.ctx->filepos = seek( env.inf.num )
+	size = lof( env.inf.num ) - (lex.ctx->filepos - 1)
+	if( size < 0 ) then
+		size = 0
+	end if
+
+	lex.ctx->filebuff = xallocate( size + 1 )
+
+	bytes = 0
+	if( size > 0 ) then
+		if( get( #env.inf.num, , *lex.ctx->filebuff, size, bytes ) <> 0 ) then
+			bytes = 0
+		end if
+	end if
+
+	'' null-term, the scanning loops stop at it
+	lex.ctx->filebuff[bytes] = 0
+
+	lex.ctx->fileptr = lex.ctx->filebuff
+	lex.ctx->fileend = lex.ctx->filebuff + bytes
+
+end sub
+
+'':::::
+'' skip the chars of the given class(es), straight from the file buffer
+private sub hSkipDirect( byval class_ as integer )
+	dim as ubyte ptr p = any, start = any
+
+	p = cast( ubyte ptr, lex.ctx->buffptr )
+	start = p
+
+	'' the null-term has no class, so this stops at the end of the buffer
+	while( (charclassTb(*p) and class_) <> 0 )
+		p += 1
+	wend
+
+	lex.ctx->buffptr = cast( zstring ptr, p )
+	lex.ctx->bufflen -= p - start
+
+end sub
+
 '':::::
 private function hReadChar _
 	( _
@@ -206,34 +303,44 @@ private function hReadChar _
 
 		'' buffer empty?
 		if( lex.ctx->bufflen = 0 ) then
-			if( eof( env.inf.num ) = FALSE ) then
-				lex.ctx->filepos = seek( env.inf.num )
-
-				select case as const env.inf.format
-				case FBFILE_FORMAT_ASCII
-					if( get( #env.inf.num, , lex.ctx->buff ) = 0 ) then
-						lex.ctx->bufflen = seek( env.inf.num ) - lex.ctx->filepos
-						lex.ctx->buffptr = @lex.ctx->buff
-					end if
+			select case as const env.inf.format
+			'' the whole file is the buffer, loaded just once
+			case FBFILE_FORMAT_ASCII
+				if( lex.ctx->filebuff = NULL ) then
+					hLoadFile( )
+					lex.ctx->bufflen = lex.ctx->fileend - lex.ctx->filebuff
+					lex.ctx->buffptr = cast( zstring ptr, lex.ctx->filebuff )
+				end if
 
-				case FBFILE_FORMAT_UTF8
-					lexReadUTF8( )
+			'' decoded from the whole file, a buffer-full at a time
+			case FBFILE_FORMAT_UTF8
+				if( lex.ctx->filebuff = NULL ) then
+					hLoadFile( )
+				end if
 
-				case FBFILE_FORMAT_UTF16LE
-				    lexReadUTF16LE( )
+				lexReadUTF8( )
 
-				case FBFILE_FORMAT_UTF16BE
-					lexReadUTF16BE( )
+			case else
+				if( eof( env.inf.num ) = FALSE ) then
+					lex.ctx->filepos = seek( env.inf.num )
 
-				case FBFILE_FORMAT_UTF32LE
-					lexReadUTF32LE( )
+					select case as const env.inf.format
+					case FBFILE_FORMAT_UTF16LE
+						lexReadUTF16LE( )
 
-				case FBFILE_FORMAT_UTF32BE
-					lexReadUTF32BE( )
+					case FBFILE_FORMAT_UTF16BE
+						lexReadUTF16BE( )
 
-				end select
+					case FBFILE_FORMAT_UTF32LE
+						lexReadUTF32LE( )
 
-			end if
+					case FBFILE_FORMAT_UTF32BE
+						lexReadUTF32BE( )
+
+					end select
+				end if
+
+			end select
 		end if
 
 		''
@@ -392,7 +499,8 @@ private sub hReadIdentifier _
 		end if
 	#endmacro
 
-	dim as integer skipchar = any
+	dim as integer skipchar = any, n = any
+	dim as ubyte ptr p = any
 
 	'' (ALPHA | '_' )
 	*pid = lexCurrentChar( )
@@ -402,6 +510,22 @@ private sub hReadIdentifier _
 
 	skipchar = FALSE
 
+	'' copy the ALPHADIGIT | '_' run straight from the file buffer, the
+	'' loop below takes care of the rest (periods, a too long name)
+	if( hCanScanDirect( ) ) then
+		p = cast( ubyte ptr, lex.ctx->buffptr )
+		n = 0
+		do while( (n < FB_MAXNAMELEN - tlen) andalso ((charclassTb(p[n]) and LEXCC_IDENT) <> 0) )
+			pid[n] = p[n]
+			n += 1
+		loop
+
+		pid += n
+		tlen += n
+		lex.ctx->buffptr += n
+		lex.ctx->bufflen -= n
+	end if
+
 	'' { [ALPHADIGIT | '_' ] }
 	do
 		var c = lexCurrentChar( )
@@ -1660,6 +1784,11 @@ re_read:
 
 			lexEatChar( )
 
+			'' and the rest of the run
+			if( hCanScanDirect( ) ) then
+				hSkipDirect( LEXCC_SPACE )
+			end if
+
 		''
 		case else
 			if( islinecont = FALSE ) then
@@ -1667,11 +1796,19 @@ re_read:
 			end if
 
 			lexEatChar( )
+
+			'' the rest of the line after the '_' is skipped
+			if( hCanScanDirect( ) ) then
+				hSkipDirect( LEXCC_LINE )
+			end if
 		end select
 
 	loop
 
-	lex.ctx->lastfilepos = lex.ctx->filepos + (lex.ctx->buffptr - @lex.ctx->buff) - 1
+	'' the token's offset in the file, for lexPeekCurrentLine()
+	if( env.inf.format = FBFILE_FORMAT_ASCII ) then
+		lex.ctx->lastfilepos = lex.ctx->filepos + (cast( ubyte ptr, lex.ctx->buffptr ) - lex.ctx->filebuff) - 1
+	end if
 
 	select case as const char
 	'' '.'?
@@ -1965,6 +2102,11 @@ private sub hMultiLineComment( ) static
 		'' anything else, skip..
 		case else
 			lexEatChar( )
+
+			'' up to the next new-line, ' or /
+			if( hCanScanDirect( ) ) then
+				hSkipDirect( LEXCC_COMMENT )
+			end if
 		end select
 	loop
 
@@ -2295,6 +2437,12 @@ sub lexReadLine _
 		lexEatChar( )
 		if( skipline = FALSE ) then
 			*dst += chr( char )
+
+		'' skipping (a comment usually), just find the new-line
+		elseif( endchar = UINVALID ) then
+			if( hCanScanDirect( ) ) then
+				hSkipDirect( LEXCC_LINE )
+			end if
 		end if
 	loop
 
@@ -70,9 +70,9 @@
 ''    then calls hLoadFbctinfFromObj().
 ''
 '' objinfoReadLibfile():
-''    reads in a lib*.a archive file,
+''    reads the member headers of a lib*.a archive file,
 ''    looks for the fbctinf object file added to static libraries by fbc -lib,
-''    and if found, calls hLoadFbctinfFromObj().
+''    and if found, loads only that member and calls hLoadFbctinfFromObj().
 ''
 '' objinfoReadLib():
 ''    searches a libfile for the given libname in the given libpaths,
@@ -104,8 +104,7 @@ type DATABUFFER
 end type
 
 dim shared as DATABUFFER _
-	ardata, _   '' current .a file content (if any)
-	objdata, _  '' current .o file content (can point into ardata)
+	objdata, _  '' current .o file content (or .a member)
 	fbctinf     '' .fbctinf section content, points into objdata
 
 enum
@@ -510,53 +509,80 @@ private function hLoadArString _
 	function = @s
 end function
 
-private sub hLoadObjFromAr( )
-	dim as AR_H ptr h = any
-	dim as string filename
-	dim as integer i = any, filesize = any
+private sub hLoadObjFromAr( byref filename as string )
+	dim as AR_H h
+	dim as ubyte magic(0 to 7)
+	dim as string membername
+	dim as integer f = any, i = any
+	dim as longint arsize = any, filepos = any, membersize = any
 
 	objdata.p = NULL
 	objdata.size = 0
 
+	'' Only the member headers and the fbctinf member itself are read,
+	'' not the whole archive: fbc -lib puts the fbctinf object first
+	'' (see hArchiveFiles()), so the loop below never gets far.
+	f = freefile( )
+	if( open( filename, for binary, access read, as #f ) <> 0 ) then
+		INFO( "file not found: " + filename )
+		exit sub
+	end if
+
+	arsize = lof( f )
+
 	'' 8 magic bytes
-	if( ardata.size < 8 ) then
+	if( arsize < 8 ) then
+		close #f
+		exit sub
+	end if
+
+	if( get( #f, 1, magic(0), 8 ) <> 0 ) then
+		close #f
 		exit sub
 	end if
 
 	for i = 0 to 7
-		if( ardata.p[i] <> armagic(i) ) then
+		if( magic(i) <> armagic(i) ) then
+			close #f
 			exit sub
 		end if
 	next
 
-	i = 8
+	filepos = 8
 	do
 		'' Enough room for header?
-		if( ((i + sizeof( AR_H )) > ardata.size) ) then
-			exit sub
+		if( ((filepos + sizeof( AR_H )) > arsize) ) then
+			exit do
 		end if
 
-		h = cptr( any ptr, ardata.p ) + i
-		filename = *hLoadArString( @h->name(0), 16 )
-		filesize = val( *hLoadArString( @h->size(0), 10 ) )
+		if( get( #f, filepos + 1, h ) <> 0 ) then
+			exit do
+		end if
 
-		INFO( "ar: found " + filename + ", " + str( filesize ) + " bytes" )
+		membername = *hLoadArString( @h.name(0), 16 )
+		membersize = val( *hLoadArString( @h.size(0), 10 ) )
 
-		if( filesize < 0 ) then
-			filesize = 0
-		elseif( (filesize > ardata.size) or _
-			(filesize > (ardata.size - i)) ) then
-			filesize = ardata.size - i
-		end if
+		INFO( "ar: found " + membername + ", " + str( membersize ) + " bytes" )
 
 		'' Skip over header
-		i += sizeof( AR_H )
+		filepos += sizeof( AR_H )
 
-		select case( filename )
+		if( membersize < 0 ) then
+			membersize = 0
+		elseif( membersize > (arsize - filepos) ) then
+			membersize = arsize - filepos
+		end if
+
+		select case( membername )
 		case "__fb_ct.inf", "__fb_ct.inf/"
-			if( filesize > 0 ) then
-				objdata.p = cptr( any ptr, ardata.p ) + i
-				objdata.size = filesize
+			if( membersize > 0 ) then
+				objdata.p = allocate( membersize )
+				if( get( #f, filepos + 1, *objdata.p, membersize ) <> 0 ) then
+					deallocate( objdata.p )
+					objdata.p = NULL
+				else
+					objdata.size = membersize
+				end if
 			end if
 			exit do
 
@@ -572,11 +598,13 @@ private sub hLoadObjFromAr( )
 		end select
 
 		'' Skip over file data
-		i += filesize
+		filepos += membersize
 
 		'' Archive headers are 2-byte aligned
-		i += i and 1
+		filepos += filepos and 1
 	loop
+
+	close #f
 end sub
 
 private sub hLoadFile _
@@ -667,8 +695,6 @@ dim shared as ENTRYINFO entries(0 to (OBJINFO__COUNT - 1)) = _
 }
 
 private sub hResetBuffers( )
-	ardata.p = NULL
-	ardata.size = 0
 	objdata.p = NULL
 	objdata.size = 0
 	fbctinf.p = NULL
@@ -697,12 +723,7 @@ end sub
 sub objinfoReadLibfile( byref libfile as string )
 	objinfoInit( libfile )
 
-	hLoadFile( libfile, @ardata )
-	if( ardata.size = 0 ) then
-		exit sub
-	end if
-
-	hLoadObjFromAr( )
+	hLoadObjFromAr( libfile )
 	if( objdata.size = 0 ) then
 		exit sub
 	end if
@@ -842,12 +863,8 @@ function objinfoGetFilename( ) as zstring ptr
 end function
 
 sub objinfoReadEnd( )
-	if( ardata.p ) then
-		'' Archive buffer was allocated, the others point into it
-		deallocate( ardata.p )
-	elseif( objdata.p ) then
-		'' Object buffer was allocated, fbctinf points into it,
-		'' archive buffer is unused
+	if( objdata.p ) then
+		'' Object buffer was allocated, fbctinf points into it
 		deallocate( objdata.p )
 	end if
 
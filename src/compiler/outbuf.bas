@@ -0,0 +1,108 @@
+'' buffered backend output
+''
+''
+
+#include once "fb.bi"
+#include once "fbint.bi"
+#include once "outbuf.bi"
+#include once "crt/string.bi"
+
+const OUTBUF_SIZE = 256 * 1024
+
+type OUTBUFCTX
+	p	as ubyte ptr
+	len	as integer
+end type
+
+dim shared as OUTBUFCTX outbuf
+
+'' Opens env.outf for writing, replacing any existing file
+function outbufOpen( ) as integer
+	if( hFileExists( env.outf.name ) ) then
+		kill env.outf.name
+	end if
+
+	env.outf.num = freefile
+	if( open( env.outf.name, for binary, access read write, as #env.outf.num ) <> 0 ) then
+		env.outf.num = 0
+		return FALSE
+	end if
+
+	if( outbuf.p = NULL ) then
+		outbuf.p = allocate( OUTBUF_SIZE )
+	end if
+	outbuf.len = 0
+
+	function = TRUE
+end function
+
+sub outbufFlush( )
+	if( outbuf.len > 0 ) then
+		if( put( #env.outf.num, , *outbuf.p, outbuf.len ) <> 0 ) then
+			'' ...
+		end if
+		outbuf.len = 0
+	end if
+end sub
+
+sub outbufClose( )
+	outbufFlush( )
+
+	if( close( #env.outf.num ) <> 0 ) then
+		'' ...
+	end if
+
+	env.outf.num = 0
+
+	deallocate( outbuf.p )
+	outbuf.p = NULL
+end sub
+
+sub outbufWrite _
+	( _
+		byval p as const any ptr, _
+		byval length as integer _
+	)
+
+	if( length <= 0 ) then
+		exit sub
+	end if
+
+	if( (outbuf.len + length) > OUTBUF_SIZE ) then
+		outbufFlush( )
+
+		'' Too big to be worth copying? Write it out directly.
+		if( length >= OUTBUF_SIZE ) then
+			if( put( #env.outf.num, , *cptr( ubyte ptr, p ), length ) <> 0 ) then
+				'' ...
+			end if
+			exit sub
+		end if
+	end if
+
+	memcpy( outbuf.p + outbuf.len, p, length )
+	outbuf.len += length
+end sub
+
+sub outbufWriteZ( byval s as const zstring ptr )
+	outbufWrite( s, len( *s ) )
+end sub
+
+sub outbufWriteStr( byref s as string )
+	outbufWrite( strptr( s ), len( s ) )
+end sub
+
+sub outbufWriteTabs( byval count as integer )
+	while( count > 0 )
+		if( outbuf.len = OUTBUF_SIZE ) then
+			outbufFlush( )
+		end if
+		outbuf.p[outbuf.len] = CHAR_TAB
+		outbuf.len += 1
+		count -= 1
+	wend
+end sub
+
+sub outbufWriteNewline( )
+	outbufWrite( @NEWLINE, len( NEWLINE ) )
+end sub
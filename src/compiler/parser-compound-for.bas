@@ -801,6 +801,8 @@ sub cForStmtBegin( )
 	'' extract counter variable from the expression
 	stk->for.cnt.sym = astGetSymbol( idexpr )
 	stk->for.cnt.dtype = dtype
+	stk->for.constrange = FALSE
+	stk->for.unitstep = FALSE
 
 	dim as integer isconst = 0
 
@@ -813,6 +815,18 @@ sub cForStmtBegin( )
 	'' STEP
 	hForStep( stk, isconst, dtype, subtype, flags )
 
+	'' STEP 1 on a 32/64-bit counter declared by the FOR? the body can be
+	'' vectorized at NEXT (see hForStmtClose())
+	if( ((flags and (FOR_ISLOCAL or FOR_ISUDT)) = FOR_ISLOCAL) and (stk->for.stp.sym = NULL) ) then
+		if( (typeIsPtr( dtype ) = FALSE) and (symbIsStatic( stk->for.cnt.sym ) = FALSE) ) then
+			select case as const( typeGetSizeType( dtype ) )
+			case FB_SIZETYPE_INT32, FB_SIZETYPE_UINT32, _
+			     FB_SIZETYPE_INT64, FB_SIZETYPE_UINT64
+				stk->for.unitstep = (stk->for.stp.value.i = 1)
+			end select
+		end if
+	end if
+
 	'' labels
     dim as FBSYMBOL ptr il = any, tl = any, el = any, cl = any
 
@@ -837,6 +851,21 @@ sub cForStmtBegin( )
 	'' if inic, endc and stepc are all constants,
 	'' check if this branch is needed
 	if( isconst = 3 ) then
+		'' counter declared by the FOR itself? then the body's bound checks
+		'' on it can be removed at NEXT (see hForStmtClose()); not if it's
+		'' STATIC, recursive calls from the body would share it
+		if( (flags and FOR_ISLOCAL) <> 0 ) then
+			if( (typeIsPtr( dtype ) = FALSE) and (symbIsStatic( stk->for.cnt.sym ) = FALSE) ) then
+				select case as const( typeGetSizeType( dtype ) )
+				case FB_SIZETYPE_INT8, FB_SIZETYPE_UINT8, _
+				     FB_SIZETYPE_INT16, FB_SIZETYPE_UINT16, _
+				     FB_SIZETYPE_INT32, FB_SIZETYPE_UINT32, _
+				     FB_SIZETYPE_INT64
+					stk->for.constrange = TRUE
+				end select
+			end if
+		end if
+
 		expr = astNewBOP( iif( stk->for.ispos.value.i, AST_OP_LE, AST_OP_GE ), _
 					astNewCONST( @stk->for.cnt.value, stk->for.cnt.dtype ), _
 					astNewCONST( @stk->for.end.value, stk->for.end.dtype ) )
@@ -941,6 +970,34 @@ private function hUdtCallOpOvl _
 end function
 
 private sub hForStmtClose(byval stk as FB_CMPSTMTSTK ptr)
+	'' counter known to stay within start..end? drop the redundant bound checks
+	if( env.clopt.arrayboundchk andalso stk->for.constrange ) then
+		if( stk->scopenode <> NULL ) then
+			dim as longint lo = any, hi = any
+			if( stk->for.ispos.value.i ) then
+				lo = stk->for.cnt.value.i
+				hi = stk->for.end.value.i
+			else
+				lo = stk->for.end.value.i
+				hi = stk->for.cnt.value.i
+			end if
+			if( lo <= hi ) then
+				astForElimBoundChk( stk->scopenode->next, stk->for.cnt.sym, lo, hi )
+			end if
+		end if
+	end if
+
+	'' -vec: unroll the body so its statements can be merged into SSE ops
+	'' (x87 code gets nothing from it, as the SLP pass won't merge them)
+	if( (env.clopt.vectorize >= FB_VECTORIZE_NORMAL) andalso stk->for.unitstep ) then
+		if( (env.clopt.backend = FB_BACKEND_GAS) and _
+		    (env.clopt.fputype >= FB_FPUTYPE_SSE) and _
+		    (stk->scopenode <> NULL) ) then
+			astForVectorize( stk->scopenode->next, stk->for.cnt.sym, _
+			                 hElmToExpr( @stk->for.end ), stk->for.cmplabel )
+		end if
+	end if
+
 	'' close the scope block
 	if( stk->scopenode <> NULL ) then
 		astScopeEnd( stk->scopenode )
@@ -5,6 +5,7 @@
 
 #include once "fb.bi"
 #include once "fbint.bi"
+#include once "dstr.bi"
 #include once "parser.bi"
 #include once "ast.bi"
 #include once "rtl.bi"
@@ -16,18 +17,51 @@ enum FB_CASETYPE
 	FB_CASETYPE_ELSE
 end enum
 
-const FB_MAXCASEEXPR 	= 1024
+const FB_MAXCASEEXPR 	= 4096
+
+'' SELECT CASE on a string with at least this many CASE literals uses a hash
+'' lookup; at most FB_MAXCASEEXPR/2 literals are held back for it, by all
+'' nested SELECTs together, to leave room for the CASE being parsed
+const FB_SELHASH_MINLITERALS	= 8
+const FB_SELHASH_MAXLITERALS	= FB_MAXCASEEXPR \ 2
+const FB_SELHASH_MAXSLOTS	= FB_SELHASH_MAXLITERALS * 2
+const FB_SELHASH_SEEDS		= 64
 
 type FBCASECTX
 	typ 		as FB_CASETYPE
 	op 			as integer
 	expr1		as ASTNODE ptr
 	expr2		as ASTNODE ptr
+	hash		as ulong			'' literal's hash, when held back
+	label		as FBSYMBOL ptr		'' block label, when held back
+	isdup		as integer
+end type
+
+'' CASE whose compares were held back
+type FBDEFERCTX
+	base		as integer			'' clauses in caseTB
+	cnt			as integer
+	label		as FBSYMBOL ptr		'' block label
+	nxtlabel	as FBSYMBOL ptr		'' next CASE's compares
+	ref			as ASTNODE ptr		'' statement behind which the compares go
 end type
 
 type FBCTX
 	base		as integer
 	caseTB(0 to FB_MAXCASEEXPR-1) as FBCASECTX
+
+	deferbase	as integer
+	deferTB(0 to FB_SELHASH_MAXLITERALS-1) as FBDEFERCTX
+
+	'' astAddAfter() position while emitting held back compares
+	inserting	as integer
+	insertref	as ASTNODE ptr
+
+	'' hash lookup scratch tables
+	slothead(0 to FB_SELHASH_MAXSLOTS-1) as integer
+	slotnext(0 to FB_SELHASH_MAXLITERALS-1) as integer
+	slotvalues(0 to FB_SELHASH_MAXSLOTS-1) as ulongint
+	slotlabels(0 to FB_SELHASH_MAXSLOTS-1) as FBSYMBOL ptr
 end type
 
 '' globals
@@ -35,6 +69,8 @@ end type
 
 sub parserSelectStmtInit( )
 	ctx.base = 0
+	ctx.deferbase = 0
+	ctx.inserting = FALSE
 end sub
 
 sub parserSelectStmtEnd( )
@@ -193,6 +229,14 @@ sub cSelectStmtBegin( )
 	stk->select.cmplabel = symbAddLabel( NULL, FB_SYMBOPT_NONE )
 	stk->select.endlabel = el
 	stk->select.outerscopenode = outerscopenode
+
+	'' string SELECT? the CASE compares may be replaced by a hash lookup
+	stk->select.hash.enabled = (typeGet( dtype ) = FB_DATATYPE_STRING) and _
+	                           (symbGetType( sym ) = FB_DATATYPE_STRING)
+	stk->select.hash.casebase = ctx.base
+	stk->select.hash.deferbase = ctx.deferbase
+	stk->select.hash.ref = astGetProcTailNode( )
+	stk->select.hash.elselabel = NULL
 end sub
 
 '':::::
@@ -250,6 +294,19 @@ private sub hCaseExpression _
 	end if
 end sub
 
+'' Add a statement at the end, or behind the CASE it belongs to when emitting
+'' held back compares
+private sub hAddStmt( byval n as ASTNODE ptr )
+	if( ctx.inserting ) then
+		n = astAddAfter( n, ctx.insertref )
+		if( n <> NULL ) then
+			ctx.insertref = n
+		end if
+	else
+		astAdd( n )
+	end if
+end sub
+
 private function hFlushCaseExpr _
 	( _
 		byref casectx as FBCASECTX, _
@@ -283,7 +340,7 @@ private function hFlushCaseExpr _
 			return FALSE
 		end if
 
-		astAdd( expr )
+		hAddStmt( expr )
 
 		expr = NEWCASEVAR( sym )
 		if( islast ) then
@@ -297,15 +354,337 @@ private function hFlushCaseExpr _
 		return FALSE
 	end if
 
-	astAdd( expr )
+	hAddStmt( expr )
+
+	function = TRUE
+end function
+
+private sub hFlushCases _
+	( _
+		byval sym as FBSYMBOL ptr, _
+		byval cntbase as integer, _
+		byval cnt as integer, _
+		byval il as FBSYMBOL ptr, _
+		byval cmplabel as FBSYMBOL ptr _
+	)
+
+	dim as FBSYMBOL ptr nl = any
+
+	for i as integer = 0 to cnt-1
+		if( i < cnt-1 ) then
+			'' add next label
+			nl = symbAddLabel( NULL, FB_SYMBOPT_NONE )
+		else
+			nl = cmplabel
+		end if
+
+		if( ctx.caseTB(cntbase+i).typ <> FB_CASETYPE_ELSE ) then
+			if( hFlushCaseExpr( ctx.caseTB(cntbase+i), sym, _
+			                    il, nl, i = cnt-1 ) = FALSE ) then
+				errReport( FB_ERRMSG_INVALIDDATATYPES, TRUE )
+			end if
+		end if
+
+		if( i < cnt-1 ) then
+			'' emit next label
+			hAddStmt( astNewLABEL( nl ) )
+		end if
+	next
+end sub
+
+'' FNV-1a of the literal's text, the same as fb_StrHash() computes before
+'' mixing in the seed
+private function hHashText _
+	( _
+		byval text as zstring ptr, _
+		byval length as integer _
+	) as ulong
+
+	dim as ulong h = 2166136261u
+
+	for i as integer = 0 to length-1
+		h = culng( (culngint( h xor text[i] ) * 16777619ull) and &hFFFFFFFFull )
+	next
+
+	function = h
+end function
+
+private function hHashMix( byval h as ulong, byval seed as ulong ) as ulong
+	h = culng( (culngint( h xor seed ) * 2654435761ull) and &hFFFFFFFFull )
+	function = h xor (h shr 16)
+end function
+
+'' CASE "literal" (not a wstring, no embedded null chars, which hUnescape()
+'' would cut off)
+private function hIsHashableCase( byref casectx as FBCASECTX ) as integer
+	dim as FBSYMBOL ptr lit = any
+	dim as zstring ptr text = any
+
+	function = FALSE
+
+	if( (casectx.typ <> FB_CASETYPE_SINGLE) or (casectx.op <> AST_OP_EQ) ) then
+		exit function
+	end if
+
+	if( astGetDataType( casectx.expr1 ) <> FB_DATATYPE_CHAR ) then
+		exit function
+	end if
+
+	lit = astGetStrLitSymbol( casectx.expr1 )
+	if( lit = NULL ) then
+		exit function
+	end if
+
+	text = hUnescape( symbGetVarLitText( lit ) )
+	if( len( *text ) <> symbGetStrLen( lit ) - 1 ) then
+		exit function
+	end if
+
+	casectx.hash = hHashText( text, len( *text ) )
+
+	function = TRUE
+end function
+
+'' Hold back the compares of a CASE with literals only, returns FALSE if it
+'' has anything else
+private function hDeferCase _
+	( _
+		byval stk as FB_CMPSTMTSTK ptr, _
+		byval cntbase as integer, _
+		byval cnt as integer, _
+		byval il as FBSYMBOL ptr _
+	) as integer
+
+	function = FALSE
+
+	'' ctx.base already counts this CASE's clauses; the bound is for the
+	'' held back clauses of all (nested) SELECTs, so it also bounds the
+	'' ones of this SELECT
+	if( (ctx.base > FB_SELHASH_MAXLITERALS) or _
+	    (ctx.deferbase >= FB_SELHASH_MAXLITERALS) ) then
+		exit function
+	end if
+
+	for i as integer = cntbase to cntbase + cnt - 1
+		if( hIsHashableCase( ctx.caseTB(i) ) = FALSE ) then
+			exit function
+		end if
+		ctx.caseTB(i).label = il
+		ctx.caseTB(i).isdup = FALSE
+	next
+
+	with( ctx.deferTB(ctx.deferbase) )
+		.base = cntbase
+		.cnt = cnt
+		.label = il
+		.nxtlabel = stk->select.cmplabel
+		.ref = astGetProcTailNode( )
+	end with
+	ctx.deferbase += 1
 
 	function = TRUE
 end function
 
+'' Emit the held back compares where they would have been, and stop holding
+'' back the rest
+private sub hUndeferCases( byval stk as FB_CMPSTMTSTK ptr )
+	ctx.inserting = TRUE
+	for i as integer = stk->select.hash.deferbase to ctx.deferbase - 1
+		with( ctx.deferTB(i) )
+			ctx.insertref = .ref
+			hFlushCases( stk->select.sym, .base, .cnt, .label, .nxtlabel )
+		end with
+	next
+	ctx.inserting = FALSE
+
+	ctx.deferbase = stk->select.hash.deferbase
+	stk->select.hash.enabled = FALSE
+end sub
+
+'' Emit the held back compares while parsing a CASE, and move its clauses
+'' parsed so far down over the held back ones, that are no longer needed;
+'' returns the CASE's new first clause
+private function hUndeferCasesAt _
+	( _
+		byval stk as FB_CMPSTMTSTK ptr, _
+		byval cntbase as integer, _
+		byval cnt as integer _
+	) as integer
+
+	dim as integer casebase = stk->select.hash.casebase
+
+	hUndeferCases( stk )
+
+	if( cntbase > casebase ) then
+		for i as integer = 0 to cnt - 1
+			ctx.caseTB(casebase + i) = ctx.caseTB(cntbase + i)
+		next
+		ctx.base -= cntbase - casebase
+	end if
+
+	function = casebase
+end function
+
+'' Replace the held back compares by
+''
+''		tmp = fb_StrHash( sym, seed ) and (slots - 1)
+''		goto table(tmp)
+''	slot:
+''		if( sym = "literal" ) then goto CASE block
+''		...
+''		goto CASE ELSE or END SELECT
+''
+'' with the seed picked for the fewest literals sharing a slot, so mostly a
+'' single string compare is done, instead of one for every CASE literal.
+private sub hBuildHashLookup( byval stk as FB_CMPSTMTSTK ptr )
+	static as DZSTRING ltext
+	dim as integer first = any, last = any, n = any, i = any, j = any
+	dim as integer slots = any, used = any, collisions = any, best = any
+	dim as ulong seed = any, bestseed = any, slot = any
+	dim as FBSYMBOL ptr sym = any, lsym = any, rsym = any
+	dim as FBSYMBOL ptr dispatchlabel = any, misslabel = any, tmp = any
+	dim as ASTNODE ptr expr = any
+
+	sym = stk->select.sym
+	first = stk->select.hash.casebase
+	last = ctx.base - 1
+
+	'' the same literal in a later CASE is never reached
+	n = 0
+	for i = first to last
+		lsym = astGetStrLitSymbol( ctx.caseTB(i).expr1 )
+		DZstrAssign( ltext, hUnescape( symbGetVarLitText( lsym ) ) )
+		for j = first to i - 1
+			if( ctx.caseTB(j).isdup = FALSE ) then
+				if( ctx.caseTB(j).hash = ctx.caseTB(i).hash ) then
+					rsym = astGetStrLitSymbol( ctx.caseTB(j).expr1 )
+					if( *ltext.data = *hUnescape( symbGetVarLitText( rsym ) ) ) then
+						ctx.caseTB(i).isdup = TRUE
+						exit for
+					end if
+				end if
+			end if
+		next
+		if( ctx.caseTB(i).isdup = FALSE ) then
+			n += 1
+		end if
+	next
+
+	'' power of 2 slots, at least twice the number of literals
+	slots = 2
+	while( slots < n * 2 )
+		slots shl= 1
+	wend
+
+	bestseed = 0
+	best = n
+	for seed = 0 to FB_SELHASH_SEEDS - 1
+		for slot = 0 to slots - 1
+			ctx.slothead(slot) = FALSE
+		next
+
+		collisions = 0
+		for i = first to last
+			if( ctx.caseTB(i).isdup = FALSE ) then
+				slot = hHashMix( ctx.caseTB(i).hash, seed ) and (slots - 1)
+				if( ctx.slothead(slot) ) then
+					collisions += 1
+				end if
+				ctx.slothead(slot) = TRUE
+			end if
+		next
+
+		if( collisions < best ) then
+			best = collisions
+			bestseed = seed
+			if( best = 0 ) then
+				exit for
+			end if
+		end if
+	next
+
+	'' literals by slot, in CASE order
+	for slot = 0 to slots - 1
+		ctx.slothead(slot) = -1
+	next
+	for i = last to first step -1
+		if( ctx.caseTB(i).isdup = FALSE ) then
+			slot = hHashMix( ctx.caseTB(i).hash, bestseed ) and (slots - 1)
+			ctx.slotnext(i - first) = ctx.slothead(slot)
+			ctx.slothead(slot) = i
+		else
+			astDelTree( ctx.caseTB(i).expr1 )
+		end if
+	next
+
+	misslabel = stk->select.hash.elselabel
+	if( misslabel = NULL ) then
+		misslabel = stk->select.endlabel
+	end if
+
+	'' the last CASE block must skip the lookup
+	astAdd( astNewBRANCH( AST_OP_JMP, stk->select.endlabel ) )
+
+	dispatchlabel = symbAddLabel( NULL, FB_SYMBOPT_NONE )
+	astAdd( astNewLABEL( dispatchlabel ) )
+
+	'' dim tmp as uinteger = fb_StrHash( sym, seed ) and (slots - 1)
+	expr = astNewBOP( AST_OP_AND, _
+	                  rtlStrHash( astNewVAR( sym ), bestseed ), _
+	                  astNewCONSTi( slots - 1, FB_DATATYPE_ULONG ) )
+
+	if( fbLangOptIsSet( FB_LANG_OPT_SCOPE ) ) then
+		tmp = symbAddImplicitVar( FB_DATATYPE_UINT, NULL, 0 )
+		symbSetDontInit( tmp )
+		astAdd( astNewLINK( _
+			astNewDECL( tmp, FALSE ), _
+			astNewASSIGN( astNewVAR( tmp ), expr, AST_OPOPT_ISINI ) ) )
+	else
+		tmp = symbAddImplicitVar( FB_DATATYPE_UINT, NULL, FB_SYMBOPT_UNSCOPE )
+		symbSetDontInit( tmp )
+		astAddUnscoped( astNewDECL( tmp, TRUE ) )
+		astAdd( astNewASSIGN( astNewVAR( tmp ), expr ) )
+	end if
+
+	used = 0
+	for slot = 0 to slots - 1
+		if( ctx.slothead(slot) <> -1 ) then
+			ctx.slotvalues(used) = slot
+			ctx.slotlabels(used) = symbAddLabel( NULL, FB_SYMBOPT_NONE )
+			used += 1
+		end if
+	next
+
+	astAdd( astBuildJMPTB( tmp, @ctx.slotvalues(0), @ctx.slotlabels(0), _
+	                       used, misslabel, 0, slots - 1 ) )
+
+	used = 0
+	for slot = 0 to slots - 1
+		i = ctx.slothead(slot)
+		if( i <> -1 ) then
+			astAdd( astNewLABEL( ctx.slotlabels(used) ) )
+			used += 1
+
+			do
+				'' if( sym = "literal" ) then goto CASE block
+				astAdd( astNewBOP( AST_OP_EQ, astNewVAR( sym ), _
+				                   ctx.caseTB(i).expr1, ctx.caseTB(i).label, _
+				                   AST_OPOPT_NONE ) )
+				i = ctx.slotnext(i - first)
+			loop while( i <> -1 )
+
+			astAdd( astNewBRANCH( AST_OP_JMP, misslabel ) )
+		end if
+	next
+
+	'' go to the lookup from where the first CASE's compares would be
+	astAddAfter( astNewBRANCH( AST_OP_JMP, dispatchlabel ), stk->select.hash.ref )
+end sub
+
 '' SelectStmtNext  =  CASE (ELSE | (CaseExpression (',' CaseExpression)*)) .
 sub cSelectStmtNext( )
-	dim as FBSYMBOL ptr il = any, nl = any
-	dim as integer cnt = any, i = any, cntbase = any
+	dim as FBSYMBOL ptr il = any, prevlabel = NULL
+	dim as integer cnt = any, cntbase = any
 	dim as FB_CMPSTMTSTK ptr stk = any
 
 	stk = cCompStmtGetTOS( FB_TK_SELECT, FALSE )
@@ -343,6 +722,7 @@ sub cSelectStmtNext( )
 		astAdd( astNewBRANCH( AST_OP_JMP, stk->select.endlabel ) )
 
 		astAdd( astNewLABEL( stk->select.cmplabel ) )
+		prevlabel = stk->select.cmplabel
 		stk->select.cmplabel = symbAddLabel( NULL )
 	end if
 
@@ -350,6 +730,9 @@ sub cSelectStmtNext( )
 	if( lexGetToken( ) = FB_TK_ELSE ) then
 		lexSkipToken( )
 
+		'' where the hash lookup misses go
+		stk->select.hash.elselabel = prevlabel
+
 		'' begin scope
 		stk->scopenode = astScopeBegin( )
 
@@ -363,6 +746,20 @@ sub cSelectStmtNext( )
 	cntbase = ctx.base
 
 	do
+		'' table full? the held back clauses make room, if any
+		if( cntbase + cnt >= FB_MAXCASEEXPR ) then
+			if( stk->select.hash.enabled ) then
+				cntbase = hUndeferCasesAt( stk, cntbase, cnt )
+			end if
+
+			if( cntbase + cnt >= FB_MAXCASEEXPR ) then
+				errReport( FB_ERRMSG_TOOMANYEXPRESSIONS )
+				'' error recovery: skip the rest of the CASE
+				hSkipUntil( FB_TK_EOL )
+				exit do
+			end if
+		end if
+
 		hCaseExpression( ctx.caseTB(cntbase + cnt), stk->select.sym )
 		cnt += 1
 
@@ -378,26 +775,17 @@ sub cSelectStmtNext( )
 	'' add block ini label
 	il = symbAddLabel( NULL )
 
-	for i = 0 to cnt-1
-		if( i < cnt-1 ) then
-			'' add next label
-			nl = symbAddLabel( NULL, FB_SYMBOPT_NONE )
+	if( stk->select.hash.enabled ) then
+		if( hDeferCase( stk, cntbase, cnt, il ) ) then
+			'' held back, keep the clauses until END SELECT
+			cnt = 0
 		else
-			nl = stk->select.cmplabel
-		end if
-
-		if( ctx.caseTB(cntbase+i).typ <> FB_CASETYPE_ELSE ) then
-			if( hFlushCaseExpr( ctx.caseTB(cntbase+i), stk->select.sym, _
-			                    il, nl, i = cnt-1 ) = FALSE ) then
-				errReport( FB_ERRMSG_INVALIDDATATYPES, TRUE )
-			end if
+			'' not a literal, or too many: emit the held back compares
+			cntbase = hUndeferCasesAt( stk, cntbase, cnt )
 		end if
+	end if
 
-		if( i < cnt-1 ) then
-			'' emit next label
-			astAdd( astNewLABEL( nl ) )
-		end if
-	next
+	hFlushCases( stk->select.sym, cntbase, cnt, il, stk->select.cmplabel )
 
  	ctx.base -= cnt
 
@@ -440,6 +828,18 @@ sub cSelectStmtEnd( )
 		astScopeEnd( stk->scopenode )
 	end if
 
+	'' all CASEs compared against literals? (and not CASE ELSE alone)
+	if( stk->select.hash.enabled ) then
+		if( ctx.base - stk->select.hash.casebase >= FB_SELHASH_MINLITERALS ) then
+			hBuildHashLookup( stk )
+		else
+			hUndeferCases( stk )
+		end if
+	end if
+
+	ctx.base = stk->select.hash.casebase
+	ctx.deferbase = stk->select.hash.deferbase
+
     '' emit end label
     astAdd( astNewLABEL( stk->select.cmplabel ) )
     astAdd( astNewLABEL( stk->select.endlabel ) )
@@ -927,7 +927,7 @@ private sub hDisallowNestedClasses( byval sym as FBSYMBOL ptr )
 end sub
 
 '' TypeDecl  =
-''  TYPE|UNION ID (ALIAS LITSTR)? (EXTENDS SymbolType)? (FIELD '=' Expression)?
+''  TYPE|UNION ID (ALIAS LITSTR)? VECTOR? (EXTENDS SymbolType)? (FIELD '=' Expression)?
 ''      TypeLine+
 ''  END (TYPE|UNION) .
 sub cTypeDecl( byval attrib as integer )
@@ -1005,6 +1005,13 @@ sub cTypeDecl( byval attrib as integer )
 	'' [ALIAS "id"]
 	dim as zstring ptr palias = cAliasAttribute()
 
+	'' [VECTOR]
+	dim as integer isvector = FALSE
+	if( ucase( *lexGetText( ) ) = "VECTOR" ) then
+		lexSkipToken( )
+		isvector = TRUE
+	end if
+
 	'' (EXTENDS SymbolType)?
 	dim as FBSYMBOL ptr baseSubtype = NULL
 	dim as integer baseDType = 0
@@ -1107,6 +1114,14 @@ sub cTypeDecl( byval attrib as integer )
 
 	hDisallowNestedClasses( sym )
 
+	if( isvector ) then
+		if( symbUdtCheckVector( sym ) ) then
+			symbSetUdtIsVector( sym )
+		else
+			errReportEx( FB_ERRMSG_INVALIDVECTORTYPE, id )
+		end if
+	end if
+
 	'' end the compound
 	stk = cCompStmtGetTOS( FB_TK_TYPE )
 	if( stk <> NULL ) then
@@ -11,7 +11,7 @@
 
 '':::::
 ''DataStmt   	  =   RESTORE LABEL?
-''				  |   READ Variable{int|flt|str} (',' Variable{int|flt|str})*
+''				  |   READ (Variable{int|flt|str} | Array '(' ')') (',' ...)*
 ''				  |   DATA literal|constant (',' literal|constant)*
 ''
 function cDataStmt  _
@@ -50,19 +50,41 @@ function cDataStmt  _
 
 		function = rtlDataRestore( sym )
 
-	'' READ Variable{int|flt|str} (',' Variable{int|flt|str})*
+	'' READ (Variable{int|flt|str} | Array '(' ')') (',' ...)*
 	case FB_TK_READ
 		lexSkipToken( )
 
 		dim as ASTNODE ptr expr = NULL
 		do
-			expr = cVarOrDeref( )
+			expr = cVarOrDeref( FB_VAREXPROPT_NOARRAYCHECK )
 			if( expr = NULL ) then
 				errReport( FB_ERRMSG_EXPECTEDIDENTIFIER )
 				hSkipUntil( CHAR_COMMA )
+			elseif( astIsNIDXARRAY( expr ) ) then
+				errReport( FB_ERRMSG_EXPECTEDINDEX )
+				astDelTree( expr )
 			else
-				if( rtlDataRead( expr ) = FALSE ) then
-					exit function
+				'' Array '(' ')'? read all of its elements
+				dim as FBSYMBOL ptr s = astGetSymbol( expr )
+				dim as integer is_array = FALSE
+				if( s <> NULL ) then
+					if( symbIsArray( s ) and (lexGetToken( ) = CHAR_LPRNT) ) then
+						is_array = (lexGetLookAhead( 1 ) = CHAR_RPRNT)
+					end if
+				end if
+
+				if( is_array ) then
+					'' '(' ')'
+					lexSkipToken( )
+					lexSkipToken( )
+
+					if( rtlDataReadArray( expr ) = FALSE ) then
+						exit function
+					end if
+				else
+					if( rtlDataRead( expr ) = FALSE ) then
+						exit function
+					end if
 				end if
 			end if
 		loop while( hMatch( CHAR_COMMA ) )
@@ -0,0 +1,485 @@
+''
+'' -profreport: report for the samples taken by the rtlib's sampling profiler
+''
+'' Programs started with FB_SAMPLE_PROFILE=<rate>[,stack] in the environment
+'' write a profile.samples file at exit (see rtlib/linux/sys_profile_sample.c):
+''
+''    fbsamples 1
+''    exe <path to the executable>
+''    rate <samples per second of CPU time>
+''    stack 0|1
+''    lost <number of samples overwritten in the runtime's ring buffer>
+''    <pc> [<return address> ...]
+''    ...
+''
+'' with one line per sample, holding the interrupted program counter and, with
+'' stack walks, the return addresses of the callers, as hex offsets into the
+'' executable's image (0 = code outside the executable, e.g. in libc).
+''
+'' The addresses are mapped back to procedures using the ELF symbol table of
+'' the executable, which is only kept when it was linked with -g.
+''
+
+#include once "profreport.bi"
+#include once "fb.bi"
+
+type PROFSYMBOL
+	addr		as ulongint
+	size		as ulongint
+	name		as string
+	self		as integer  '' samples with the program counter in the procedure
+	total		as integer  '' samples with the procedure anywhere on the stack
+	stamp		as integer  '' last sample counted in total
+end type
+
+type PROFCTX
+	exe		as string
+	rate		as integer
+	stack		as integer
+	lost		as integer
+	samples		as integer
+	symcount	as integer
+end type
+
+dim shared as PROFCTX ctx
+dim shared as PROFSYMBOL syms()
+
+''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+'' ELF symbol table loading
+
+type ELF32_H field = 1
+	e_ident(0 to 15)  as ubyte
+	e_type            as ushort
+	e_machine         as ushort
+	e_version         as ulong
+	e_entry           as ulong
+	e_phoff           as ulong
+	e_shoff           as ulong
+	e_flags           as ulong
+	e_ehsize          as ushort
+	e_phentsize       as ushort
+	e_phnum           as ushort
+	e_shentsize       as ushort
+	e_shnum           as ushort
+	e_shstrndx        as ushort
+end type
+type ELF64_H field = 1
+	e_ident(0 to 15)  as ubyte
+	e_type            as ushort
+	e_machine         as ushort
+	e_version         as ulong
+	e_entry           as ulongint
+	e_phoff           as ulongint
+	e_shoff           as ulongint
+	e_flags           as ulong
+	e_ehsize          as ushort
+	e_phentsize       as ushort
+	e_phnum           as ushort
+	e_shentsize       as ushort
+	e_shnum           as ushort
+	e_shstrndx        as ushort
+end type
+
+type ELF32_SH field = 1
+	sh_name         as ulong
+	sh_type         as ulong
+	sh_flags        as ulong
+	sh_addr         as ulong
+	sh_offset       as ulong
+	sh_size         as ulong
+	sh_link         as ulong
+	sh_info         as ulong
+	sh_addralign    as ulong
+	sh_entsize      as ulong
+end type
+type ELF64_SH field = 1
+	sh_name         as ulong
+	sh_type         as ulong
+	sh_flags        as ulongint
+	sh_addr         as ulongint
+	sh_offset       as ulongint
+	sh_size         as ulongint
+	sh_link         as ulong
+	sh_info         as ulong
+	sh_addralign    as ulongint
+	sh_entsize      as ulongint
+end type
+
+type ELF32_SYM field = 1
+	st_name         as ulong
+	st_value        as ulong
+	st_size         as ulong
+	st_info         as ubyte
+	st_other        as ubyte
+	st_shndx        as ushort
+end type
+type ELF64_SYM field = 1
+	st_name         as ulong
+	st_info         as ubyte
+	st_other        as ubyte
+	st_shndx        as ushort
+	st_value        as ulongint
+	st_size         as ulongint
+end type
+
+const SHT_SYMTAB = 2
+const SHT_DYNSYM = 11
+const STT_FUNC = 2
+
+private sub hAddSymbol _
+	( _
+		byval addr as ulongint, _
+		byval size as ulongint, _
+		byval symname as zstring ptr _
+	)
+
+	if( ctx.symcount > ubound( syms ) ) then
+		redim preserve syms( 0 to ctx.symcount * 2 + 255 )
+	end if
+
+	with( syms(ctx.symcount) )
+		.addr = addr
+		.size = size
+		.name = *symname
+	end with
+
+	ctx.symcount += 1
+end sub
+
+'' Same as in objinfo.bas, the 32bit and 64bit ELF loading code only differs
+'' in the header types
+
+#macro ELFSYMBOLCODE(ELF_H, ELF_SH, ELF_SYM)
+
+private function hLoadSymtabFrom##ELF_H _
+	( _
+		byval p as ubyte ptr, _
+		byval size as integer, _
+		byval shtype as integer _
+	) as integer
+
+	dim as ELF_H ptr h = cptr( any ptr, p )
+	dim as ELF_SH ptr sh = any, strtb = any
+	dim as ELF_SYM ptr sym = any
+
+	if( size < sizeof( ELF_H ) ) then
+		exit function
+	end if
+
+	if( (h->e_shentsize <> sizeof( ELF_SH )) or _
+	    ((culngint( h->e_shoff ) + (h->e_shnum * sizeof( ELF_SH ))) > size) ) then
+		exit function
+	end if
+
+	for i as integer = 0 to h->e_shnum - 1
+		sh = cptr( any ptr, p + h->e_shoff + (i * sizeof( ELF_SH )) )
+		if( (sh->sh_type <> shtype) or (sh->sh_entsize <> sizeof( ELF_SYM )) or _
+		    (sh->sh_link >= h->e_shnum) ) then
+			continue for
+		end if
+
+		strtb = cptr( any ptr, p + h->e_shoff + (sh->sh_link * sizeof( ELF_SH )) )
+		if( ((culngint( sh->sh_offset ) + sh->sh_size) > size) or _
+		    ((culngint( strtb->sh_offset ) + strtb->sh_size) > size) ) then
+			continue for
+		end if
+
+		for j as integer = 0 to (sh->sh_size \ sizeof( ELF_SYM )) - 1
+			sym = cptr( any ptr, p + sh->sh_offset + (j * sizeof( ELF_SYM )) )
+			if( ((sym->st_info and 15) = STT_FUNC) and (sym->st_value <> 0) and _
+			    (sym->st_name < strtb->sh_size) ) then
+				hAddSymbol( sym->st_value, sym->st_size, _
+				            cptr( zstring ptr, p + strtb->sh_offset + sym->st_name ) )
+			end if
+		next
+
+		function = TRUE
+	next
+
+end function
+
+#endmacro
+
+ELFSYMBOLCODE( ELF32_H, ELF32_SH, ELF32_SYM )
+ELFSYMBOLCODE( ELF64_H, ELF64_SH, ELF64_SYM )
+
+private sub hLoadSymbols( byref exe as string )
+	dim as integer f = any, size = any
+	dim as ubyte ptr p = any
+
+	f = freefile( )
+	if( open( exe, for binary, access read, as #f ) <> 0 ) then
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, exe, -1 )
+		exit sub
+	end if
+
+	size = lof( f )
+	if( size < 16 ) then
+		close #f
+		exit sub
+	end if
+
+	p = allocate( size )
+	if( get( #f, , *p, size ) <> 0 ) then
+		deallocate( p )
+		close #f
+		exit sub
+	end if
+	close #f
+
+	'' little-endian ELF only, which is what the sampler runs on
+	if( (p[0] = &h7f) and (p[1] = asc( "E" )) and (p[2] = asc( "L" )) and _
+	    (p[3] = asc( "F" )) and (p[5] = 1) ) then
+		'' the full symbol table if it wasn't stripped, otherwise
+		'' at least the exported procedures
+		select case( p[4] )
+		case 1
+			if( hLoadSymtabFromELF32_H( p, size, SHT_SYMTAB ) = FALSE ) then
+				hLoadSymtabFromELF32_H( p, size, SHT_DYNSYM )
+			end if
+		case 2
+			if( hLoadSymtabFromELF64_H( p, size, SHT_SYMTAB ) = FALSE ) then
+				hLoadSymtabFromELF64_H( p, size, SHT_DYNSYM )
+			end if
+		end select
+	end if
+
+	deallocate( p )
+end sub
+
+private sub hSortSymbols( )
+	dim as integer gap = any, j = any, n = any
+
+	'' shell sort by address
+	gap = ctx.symcount \ 2
+	while( gap > 0 )
+		for i as integer = gap to ctx.symcount - 1
+			j = i
+			while( j >= gap )
+				if( syms(j - gap).addr <= syms(j).addr ) then
+					exit while
+				end if
+				swap syms(j - gap), syms(j)
+				j -= gap
+			wend
+		next
+		gap \= 2
+	wend
+
+	'' drop aliases (same address), keeping the first name
+	n = 0
+	for i as integer = 0 to ctx.symcount - 1
+		if( n > 0 ) then
+			if( syms(n - 1).addr = syms(i).addr ) then
+				continue for
+			end if
+		end if
+		if( n <> i ) then
+			syms(n) = syms(i)
+		end if
+		n += 1
+	next
+	ctx.symcount = n
+
+	'' the last entry collects the addresses outside of any procedure
+	hAddSymbol( 0, 0, @"[unknown]" )
+end sub
+
+private function hLookupSymbol( byval addr as ulongint ) as integer
+	dim as integer lo = any, hi = any, i = any
+	dim as integer unknown = ctx.symcount - 1
+
+	function = unknown
+
+	if( addr = 0 ) then
+		exit function
+	end if
+
+	'' last symbol at or below addr
+	lo = 0
+	hi = unknown - 1
+	while( lo <= hi )
+		i = (lo + hi) \ 2
+		if( syms(i).addr <= addr ) then
+			lo = i + 1
+		else
+			hi = i - 1
+		end if
+	wend
+
+	if( hi < 0 ) then
+		exit function
+	end if
+
+	with( syms(hi) )
+		if( (.size = 0) or (addr < .addr + .size) ) then
+			function = hi
+		end if
+	end with
+end function
+
+''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
+'' samples file
+
+private sub hAddSample( byref ln as string )
+	dim as integer i = any, j = any, frame = any, sym = any
+	dim as ulongint addr = any
+
+	ctx.samples += 1
+
+	i = 1
+	frame = 0
+	while( i <= len( ln ) )
+		j = instr( i, ln, " " )
+		if( j = 0 ) then
+			j = len( ln ) + 1
+		end if
+
+		addr = valulng( "&h" + mid( ln, i, j - i ) )
+
+		'' return addresses point behind the call, which may already be
+		'' the next procedure
+		if( (frame > 0) and (addr > 0) ) then
+			addr -= 1
+		end if
+
+		sym = hLookupSymbol( addr )
+		with( syms(sym) )
+			if( frame = 0 ) then
+				.self += 1
+			end if
+			'' count recursive procedures once per sample
+			if( .stamp <> ctx.samples ) then
+				.stamp = ctx.samples
+				.total += 1
+			end if
+		end with
+
+		frame += 1
+		i = j + 1
+	wend
+end sub
+
+private function hAlign( byref s as string, byval w as integer ) as string
+	if( len( s ) < w ) then
+		function = space( w - len( s ) ) + s
+	else
+		function = s
+	end if
+end function
+
+private function hPercent( byval n as integer ) as string
+	dim as integer tenths = (n * 1000 + ctx.samples \ 2) \ ctx.samples
+	function = hAlign( str( tenths \ 10 ) + "." + str( tenths mod 10 ), 7 )
+end function
+
+private sub hPrintReport( )
+	dim as integer order(0 to ctx.symcount - 1)
+	dim as integer n = any, gap = any, j = any
+
+	'' procedures with samples, by self samples
+	n = 0
+	for i as integer = 0 to ctx.symcount - 1
+		if( syms(i).total > 0 ) then
+			order(n) = i
+			n += 1
+		end if
+	next
+
+	gap = n \ 2
+	while( gap > 0 )
+		for i as integer = gap to n - 1
+			j = i
+			while( j >= gap )
+				with( syms(order(j - gap)) )
+					if( (.self > syms(order(j)).self) or _
+					    ((.self = syms(order(j)).self) and (.total >= syms(order(j)).total)) ) then
+						exit while
+					end if
+				end with
+				swap order(j - gap), order(j)
+				j -= gap
+			wend
+		next
+		gap \= 2
+	wend
+
+	print "executable: " + ctx.exe
+	print "samples:    " & ctx.samples & " at " & ctx.rate & " Hz (" & ctx.lost & " lost)"
+	if( ctx.symcount = 1 ) then
+		print "no symbol table found, link the program with -g"
+	end if
+	print
+
+	if( ctx.stack ) then
+		print " self %  total %     self    total  procedure"
+	else
+		print " self %     self  procedure"
+	end if
+
+	for i as integer = 0 to n - 1
+		with( syms(order(i)) )
+			if( ctx.stack ) then
+				print hPercent( .self ) + "  " + hPercent( .total ) + " " + _
+				      hAlign( str( .self ), 8 ) + " " + hAlign( str( .total ), 8 ) + "  " + .name
+			else
+				print hPercent( .self ) + " " + hAlign( str( .self ), 8 ) + "  " + .name
+			end if
+		end with
+	next
+end sub
+
+function profreportPrint( byref samplesfile as string ) as integer
+	dim as integer f = any
+	dim as string ln, key
+
+	f = freefile( )
+	if( open( samplesfile, for input, as #f ) <> 0 ) then
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, samplesfile, -1 )
+		exit function
+	end if
+
+	line input #f, ln
+	if( ln <> "fbsamples 1" ) then
+		close #f
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, samplesfile, -1 )
+		exit function
+	end if
+
+	'' header
+	while( eof( f ) = FALSE )
+		line input #f, ln
+		key = left( ln, instr( ln, " " ) - 1 )
+		select case( key )
+		case "exe"
+			ctx.exe = mid( ln, 5 )
+		case "rate"
+			ctx.rate = valint( mid( ln, 6 ) )
+		case "stack"
+			ctx.stack = (valint( mid( ln, 7 ) ) <> 0)
+		case "lost"
+			ctx.lost = valint( mid( ln, 6 ) )
+			exit while
+		end select
+	wend
+
+	hLoadSymbols( ctx.exe )
+	hSortSymbols( )
+
+	while( eof( f ) = FALSE )
+		line input #f, ln
+		if( len( ln ) > 0 ) then
+			hAddSample( ln )
+		end if
+	wend
+
+	close #f
+
+	if( ctx.samples > 0 ) then
+		hPrintReport( )
+	else
+		print "no samples in " + samplesfile
+	end if
+
+	function = TRUE
+end function
@@ -238,7 +238,7 @@
 		( _
 			@FB_RTL_ARRAYSNGBOUNDCHK, NULL, _
 			typeAddrOf( FB_DATATYPE_VOID ), FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_CANBECLONED, _
+			NULL, FB_RTL_OPT_CANBECLONED or FB_RTL_OPT_COLD, _
 			4, _
 			{ _
 				( typeSetIsConst( FB_DATATYPE_UINT ), FB_PARAMMODE_BYVAL, FALSE ), _
@@ -258,7 +258,7 @@
 		( _
 			@FB_RTL_ARRAYBOUNDCHK, NULL, _
 			typeAddrOf( FB_DATATYPE_VOID ), FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_CANBECLONED, _
+			NULL, FB_RTL_OPT_CANBECLONED or FB_RTL_OPT_COLD, _
 			5, _
 			{ _
 				( typeSetIsConst( FB_DATATYPE_INTEGER ), FB_PARAMMODE_BYVAL, FALSE ), _
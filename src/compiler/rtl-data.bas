@@ -159,6 +159,87 @@
 				( FB_DATATYPE_DOUBLE, FB_PARAMMODE_BYREF, FALSE ) _
 			} _
 		), _
+		/' sub fb_DataReadArray( array() as any, byval type as long ) '/ _
+		( _
+			@FB_RTL_DATAREADARRAY, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			2, _
+			{ _
+				( FB_DATATYPE_VOID, FB_PARAMMODE_BYDESC, FALSE ), _
+				( FB_DATATYPE_LONG, FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_DataTblStart( byval labeladdr as FB_DATADESC ptr ) '/ _
+		( _
+			@FB_RTL_DATATBLSTART, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			1, _
+			{ _
+				( typeAddrOf( FB_DATATYPE_VOID ), FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_DataTblRestore( byval labeladdr as FB_DATADESC ptr ) '/ _
+		( _
+			@FB_RTL_DATATBLRESTORE, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			1, _
+			{ _
+				( typeAddrOf( FB_DATATYPE_VOID ), FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_DataTblRead( byref dst as any, byval type as long ) '/ _
+		( _
+			@FB_RTL_DATATBLREAD, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			2, _
+			{ _
+				( FB_DATATYPE_VOID, FB_PARAMMODE_BYREF, FALSE ), _
+				( FB_DATATYPE_LONG, FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_DataTblReadStr _
+			( _
+				byref dst as any, _
+				byval dst_size as const integer, _
+				byval fillrem as const long = 1 _
+			) '/ _
+		( _
+			@FB_RTL_DATATBLREADSTR, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			3, _
+			{ _
+				( FB_DATATYPE_VOID, FB_PARAMMODE_BYREF, FALSE ), _
+				( typeSetIsConst( FB_DATATYPE_INTEGER ), FB_PARAMMODE_BYVAL, FALSE ), _
+				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, TRUE, 1 ) _
+			} _
+		), _
+		/' sub fb_DataTblReadWstr( byval dst as wstring ptr, byval dst_size as const integer ) '/ _
+		( _
+			@FB_RTL_DATATBLREADWSTR, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			2, _
+			{ _
+				( typeAddrOf( FB_DATATYPE_WCHAR ),FB_PARAMMODE_BYVAL, FALSE ), _
+				( typeSetIsConst( FB_DATATYPE_INTEGER ),FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_DataTblReadArray( array() as any, byval type as long ) '/ _
+		( _
+			@FB_RTL_DATATBLREADARRAY, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			2, _
+			{ _
+				( FB_DATATYPE_VOID, FB_PARAMMODE_BYDESC, FALSE ), _
+				( FB_DATATYPE_LONG, FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
 		/' EOL '/ _
 		( _
 			NULL _
@@ -179,6 +260,107 @@ sub rtlDataModEnd( )
 
 end sub
 
+'' FB_DATAELM_* for a numeric READ destination, or -1
+private function hElmType( byval dtype as integer ) as integer
+	select case as const typeGet( dtype )
+	case FB_DATATYPE_BOOLEAN
+		function = FB_DATAELM_BOOL
+
+	case FB_DATATYPE_BYTE, FB_DATATYPE_UBYTE, _
+	     FB_DATATYPE_SHORT, FB_DATATYPE_USHORT, _
+	     FB_DATATYPE_INTEGER, FB_DATATYPE_ENUM, FB_DATATYPE_UINT, _
+	     FB_DATATYPE_LONG, FB_DATATYPE_ULONG, FB_DATATYPE_POINTER, _
+	     FB_DATATYPE_LONGINT, FB_DATATYPE_ULONGINT
+
+		select case as const( typeGetSizeType( dtype ) )
+		case FB_SIZETYPE_INT8   : function = FB_DATAELM_BYTE
+		case FB_SIZETYPE_UINT8  : function = FB_DATAELM_UBYTE
+		case FB_SIZETYPE_INT16  : function = FB_DATAELM_SHORT
+		case FB_SIZETYPE_UINT16 : function = FB_DATAELM_USHORT
+		case FB_SIZETYPE_INT32  : function = FB_DATAELM_INT
+		case FB_SIZETYPE_UINT32 : function = FB_DATAELM_UINT
+		case FB_SIZETYPE_INT64  : function = FB_DATAELM_LONGINT
+		case FB_SIZETYPE_UINT64 : function = FB_DATAELM_ULONGINT
+		case else               : function = -1
+		end select
+
+	case FB_DATATYPE_SINGLE
+		function = FB_DATAELM_SINGLE
+
+	case FB_DATATYPE_DOUBLE
+		function = FB_DATAELM_DOUBLE
+
+	case else
+		function = -1
+	end select
+end function
+
+'' -z typed-data: READ from typed tables, with the calling thread's cursor
+private function hDataTblRead _
+	( _
+		byval varexpr as ASTNODE ptr _
+	) as integer
+
+	dim as ASTNODE ptr proc = any
+	dim as integer dtype = any, elmtype = any
+	dim as longint lgt = any
+
+	function = FALSE
+
+	dtype = astGetDataType( varexpr )
+
+	select case as const typeGet( dtype )
+	case FB_DATATYPE_STRING, FB_DATATYPE_FIXSTR, FB_DATATYPE_CHAR
+		proc = astNewCALL( PROCLOOKUP( DATATBLREADSTR ) )
+		lgt = rtlCalcStrLen( varexpr, dtype )
+
+		'' byref var as any, byval dst_size as integer, byval fillrem as integer
+		if( astNewARG( proc, varexpr ) = NULL ) then
+			exit function
+		end if
+		if( astNewARG( proc, astNewCONSTi( lgt ) ) = NULL ) then
+			exit function
+		end if
+		if( astNewARG( proc, astNewCONSTi( dtype = FB_DATATYPE_FIXSTR ) ) = NULL ) then
+			exit function
+		end if
+
+	case FB_DATATYPE_WCHAR
+		proc = astNewCALL( PROCLOOKUP( DATATBLREADWSTR ) )
+		lgt = rtlCalcStrLen( varexpr, dtype )
+
+		if( astNewARG( proc, varexpr ) = NULL ) then
+			exit function
+		end if
+		if( astNewARG( proc, astNewCONSTi( lgt ) ) = NULL ) then
+			exit function
+		end if
+
+	case else
+		elmtype = hElmType( dtype )
+		if( elmtype < 0 ) then
+			exit function
+		end if
+
+		proc = astNewCALL( PROCLOOKUP( DATATBLREAD ) )
+
+		'' byref var as any
+		if( astNewARG( proc, varexpr ) = NULL ) then
+			exit function
+		end if
+
+		'' byval type as long
+		if( astNewARG( proc, astNewCONSTi( elmtype, FB_DATATYPE_LONG ) ) = NULL ) then
+			exit function
+		end if
+	end select
+
+	astAdd( proc )
+
+	function = TRUE
+
+end function
+
 '':::::
 function rtlDataRead _
 	( _
@@ -192,6 +374,10 @@ function rtlDataRead _
 
     function = FALSE
 
+	if( env.clopt.typeddata ) then
+		return hDataTblRead( varexpr )
+	end if
+
 	f = NULL
 	args = 1
 	dtype = astGetDataType( varexpr )
@@ -277,6 +463,52 @@ function rtlDataRead _
 
 end function
 
+'' READ array(): all elements in memory order
+function rtlDataReadArray _
+	( _
+		byval arrayexpr as ASTNODE ptr _
+	) as integer
+
+	dim as ASTNODE ptr proc = any
+	dim as integer dtype = any, elmtype = any
+
+	function = FALSE
+
+	dtype = astGetDataType( arrayexpr )
+
+	if( typeGet( dtype ) = FB_DATATYPE_STRING ) then
+		elmtype = FB_DATAELM_STRING
+	else
+		'' fixed-len strings and UDTs aren't supported, READ them one by one
+		elmtype = hElmType( dtype )
+		if( elmtype < 0 ) then
+			errReport( FB_ERRMSG_INVALIDDATATYPES )
+			exit function
+		end if
+	end if
+
+	if( env.clopt.typeddata ) then
+		proc = astNewCALL( PROCLOOKUP( DATATBLREADARRAY ) )
+	else
+		proc = astNewCALL( PROCLOOKUP( DATAREADARRAY ) )
+	end if
+
+	'' array() as any
+	if( astNewARG( proc, arrayexpr, dtype ) = NULL ) then
+		exit function
+	end if
+
+	'' byval type as long
+	if( astNewARG( proc, astNewCONSTi( elmtype, FB_DATATYPE_LONG ) ) = NULL ) then
+		exit function
+	end if
+
+	astAdd( proc )
+
+	function = TRUE
+
+end function
+
 function rtlDataRestore _
 	( _
 		byval label as FBSYMBOL ptr, _
@@ -288,7 +520,17 @@ function rtlDataRestore _
 
     function = FALSE
 
-    proc = astNewCALL( PROCLOOKUP( DATARESTORE ), NULL )
+	if( env.clopt.typeddata ) then
+		'' the main module's initialization (the only caller passing
+		'' afternode) also sets where new threads start reading
+		if( afternode <> NULL ) then
+			proc = astNewCALL( PROCLOOKUP( DATATBLSTART ), NULL )
+		else
+			proc = astNewCALL( PROCLOOKUP( DATATBLRESTORE ), NULL )
+		end if
+	else
+		proc = astNewCALL( PROCLOOKUP( DATARESTORE ), NULL )
+	end if
 
 	'' byval labeladdrs as void ptr
 	if( label = NULL ) then
@@ -20,7 +20,7 @@
 		( _
 			@FB_RTL_ERRORTHROW, NULL, _
 			typeAddrOf( FB_DATATYPE_VOID ), FB_FUNCMODE_CDECL, _
-			NULL, FB_RTL_OPT_NONE, _
+			NULL, FB_RTL_OPT_COLD, _
 			4, _
 	 		{ _
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, FALSE ), _
@@ -40,7 +40,7 @@
 		( _
 			@FB_RTL_ERRORTHROWEX, NULL, _
 			typeAddrOf( FB_DATATYPE_VOID ), FB_FUNCMODE_CDECL, _
-			NULL, FB_RTL_OPT_NONE, _
+			NULL, FB_RTL_OPT_COLD, _
 			5, _
 	 		{ _
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, FALSE ), _
@@ -288,8 +288,9 @@ function rtlErrorCheck( byval expr as ASTNODE ptr ) as ASTNODE ptr
 	end if
 
 	if( env.clopt.errorcheck ) then
-		'' if expr = 0 then
+		'' if expr = 0 then (the likely case)
 		nxtlabel = symbAddLabel( NULL )
+		symbSetLabelIsLikely( nxtlabel )
 		t = astNewLINK( t, astNewBOP( AST_OP_EQ, expr, astNewCONSTi( 0 ), nxtlabel, AST_OPOPT_NONE ) )
 
 		'' fb_ErrorThrow()
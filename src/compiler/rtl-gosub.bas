@@ -50,6 +50,44 @@
 				( typeMultAddrOf( FB_DATATYPE_VOID, 2 ), FB_PARAMMODE_BYVAL, FALSE ) _
 	 		} _
 	 	), _
+		/' function fb_GosubStackPush _
+			( _
+				byval stk as uinteger ptr ptr, _
+				byval depth as uinteger, _
+				byval index as uinteger _
+			) as long '/ _
+		( _
+			@FB_RTL_GOSUBSTACKPUSH, NULL, _
+			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
+	 		NULL, FB_RTL_OPT_ERROR, _
+	 		3, _
+	 		{ _
+				( typeMultAddrOf( FB_DATATYPE_UINT, 2 ), FB_PARAMMODE_BYVAL, FALSE ), _
+				( FB_DATATYPE_UINT, FB_PARAMMODE_BYVAL, FALSE ), _
+				( FB_DATATYPE_UINT, FB_PARAMMODE_BYVAL, FALSE ) _
+	 		} _
+	 	), _
+		/' function fb_GosubStackGet( byval stk as uinteger ptr, byval depth as uinteger ) as uinteger '/ _
+		( _
+			@FB_RTL_GOSUBSTACKGET, NULL, _
+			FB_DATATYPE_UINT, FB_FUNCMODE_FBCALL, _
+	 		NULL, FB_RTL_OPT_NONE, _
+	 		2, _
+	 		{ _
+				( typeAddrOf( FB_DATATYPE_UINT ), FB_PARAMMODE_BYVAL, FALSE ), _
+				( FB_DATATYPE_UINT, FB_PARAMMODE_BYVAL, FALSE ) _
+	 		} _
+	 	), _
+		/' sub fb_GosubStackExit( byval stk as uinteger ptr ptr ) '/ _
+		( _
+			@FB_RTL_GOSUBSTACKEXIT, NULL, _
+	 		FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+	 		NULL, FB_RTL_OPT_NONE, _
+	 		1, _
+	 		{ _
+				( typeMultAddrOf( FB_DATATYPE_UINT, 2 ), FB_PARAMMODE_BYVAL, FALSE ) _
+	 		} _
+	 	), _
 	 	/' EOL '/ _
 	 	( _
 	 		NULL _
@@ -196,6 +234,79 @@ function rtlGosubExit _
 
 end function
 
+'' Overflow of the index stack, see ast-gosub.bas::hDispatchPush()
+function rtlGosubStackPush _
+	( _
+		byval stk as ASTNODE ptr, _
+		byval depth as ASTNODE ptr, _
+		byval index as ASTNODE ptr _
+	) as integer
+
+	dim as ASTNODE ptr proc = any
+
+	function = FALSE
+
+	proc = astNewCALL( PROCLOOKUP( GOSUBSTACKPUSH ) )
+
+	'' byval stk as uinteger ptr ptr
+	if( astNewARG( proc, stk ) = NULL ) then
+		exit function
+	end if
+
+	'' byval depth as uinteger
+	if( astNewARG( proc, depth ) = NULL ) then
+		exit function
+	end if
+
+	'' byval index as uinteger
+	if( astNewARG( proc, index ) = NULL ) then
+		exit function
+	end if
+
+	astAdd( rtlErrorCheck( proc ) )
+	function = TRUE
+end function
+
+function rtlGosubStackGet _
+	( _
+		byval stk as ASTNODE ptr, _
+		byval depth as ASTNODE ptr _
+	) as ASTNODE ptr
+
+	dim as ASTNODE ptr proc = any
+
+	function = NULL
+
+	proc = astNewCALL( PROCLOOKUP( GOSUBSTACKGET ) )
+
+	'' byval stk as uinteger ptr
+	if( astNewARG( proc, stk ) = NULL ) then
+		exit function
+	end if
+
+	'' byval depth as uinteger
+	if( astNewARG( proc, depth ) = NULL ) then
+		exit function
+	end if
+
+	function = proc
+end function
+
+function rtlGosubStackExit( byval stk as ASTNODE ptr ) as ASTNODE ptr
+	dim as ASTNODE ptr proc = any
+
+	function = NULL
+
+	proc = astNewCALL( PROCLOOKUP( GOSUBSTACKEXIT ) )
+
+	'' byval stk as uinteger ptr ptr
+	if( astNewARG( proc, stk ) = NULL ) then
+		exit function
+	end if
+
+	function = proc
+end function
+
 '':::::
 function rtlSetJmp _
 	( _
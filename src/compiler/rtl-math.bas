@@ -221,7 +221,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_SGN, @"fb_SGNi", _
 			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_LONG, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -231,7 +231,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_SGN, @"fb_SGNl", _
 			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_LONGINT, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -241,7 +241,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_SGN, @"fb_SGNSingle", _
 			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_SINGLE, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -251,7 +251,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_SGN, @"fb_SGNDouble", _
 			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_DOUBLE, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -261,7 +261,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_FIX, @"fb_FIXSingle", _
 			FB_DATATYPE_SINGLE, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_SINGLE, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -271,7 +271,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_FIX, @"fb_FIXDouble", _
 			FB_DATATYPE_DOUBLE, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_DOUBLE, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -281,7 +281,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_FRAC, @"fb_FRACf", _
 			FB_DATATYPE_SINGLE, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_SINGLE, FB_PARAMMODE_BYVAL, FALSE ) _
@@ -291,7 +291,7 @@ declare function hRndCallback( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_FRAC, @"fb_FRACd", _
 			FB_DATATYPE_DOUBLE, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_OVER, _
+			NULL, FB_RTL_OPT_OVER or FB_RTL_OPT_CONST, _
 			1, _
 	 		{ _
 				( FB_DATATYPE_DOUBLE, FB_PARAMMODE_BYVAL, FALSE ) _
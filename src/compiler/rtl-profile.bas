@@ -47,6 +47,32 @@
 		( NULL ) _
 	}
 
+	'' -profgen fbrt
+	dim shared as FB_RTL_PROCDEF dataProfile(0 to 2) = _
+	{ _
+		/' function fb_ProfileEnter( byval procname as const zstring ptr ) as any ptr '/ _
+		( _
+			@FB_RTL_PROFILEENTER, NULL, _
+			typeAddrOf( FB_DATATYPE_VOID ), FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			1, _
+			{ _
+				( typeAddrOf( typeSetIsConst( FB_DATATYPE_CHAR ) ), FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		/' sub fb_ProfileExit( byval handle as any ptr ) '/ _
+		( _
+			@FB_RTL_PROFILEEXIT, NULL, _
+			FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			1, _
+			{ _
+				( typeAddrOf( FB_DATATYPE_VOID ), FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
+		( NULL ) _
+	}
+
 sub rtlProfileModInit( )
 	if( (env.clopt.target = FB_COMPTARGET_WIN32) and fbIs64bit( ) ) then
 		rtlAddIntrinsicProcs( @dataMcountWin64(0) )
@@ -54,6 +80,7 @@ sub rtlProfileModInit( )
 		rtlAddIntrinsicProcs( @dataMcountNormal(0) )
 	end if
 	rtlAddIntrinsicProcs( @dataMonstartup(0) )
+	rtlAddIntrinsicProcs( @dataProfile(0) )
 end sub
 
 sub rtlProfileModEnd( )
@@ -69,3 +96,29 @@ sub rtlProfileCall_monstartup( )
 	'' we are using the _monstartup(0) taking 0 arguments.
 	astAdd( astNewCALL( PROCLOOKUP( PROFILEMONSTARTUP ), NULL ) )
 end sub
+
+'' handle = fb_ProfileEnter( procname )
+function rtlProfileEnter( byval procname as ASTNODE ptr ) as ASTNODE ptr
+	dim as ASTNODE ptr proc = any
+
+	proc = astNewCALL( PROCLOOKUP( PROFILEENTER ) )
+
+	if( astNewARG( proc, procname ) = NULL ) then
+		return NULL
+	end if
+
+	function = proc
+end function
+
+'' fb_ProfileExit( handle )
+function rtlProfileExit( byval handle as ASTNODE ptr ) as ASTNODE ptr
+	dim as ASTNODE ptr proc = any
+
+	proc = astNewCALL( PROCLOOKUP( PROFILEEXIT ) )
+
+	if( astNewARG( proc, handle ) = NULL ) then
+		return NULL
+	end if
+
+	function = proc
+end function
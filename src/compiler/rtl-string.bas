@@ -198,7 +198,7 @@
 		( _
 			@FB_RTL_WSTRCOMPARE, NULL, _
 			FB_DATATYPE_LONG, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_NONE, _
+			NULL, FB_RTL_OPT_PURE, _
 			2, _
 			{ _
 				( typeAddrOf( typeSetIsConst( FB_DATATYPE_WCHAR ) ), FB_PARAMMODE_BYVAL, FALSE ), _
@@ -621,7 +621,7 @@
 		( _
 			@FB_RTL_WSTRLEN, NULL, _
 			FB_DATATYPE_INTEGER, FB_FUNCMODE_FBCALL, _
-			NULL, FB_RTL_OPT_NONE, _
+			NULL, FB_RTL_OPT_PURE, _
 			1, _
 			{ _
 				( typeAddrOf( typeSetIsConst( FB_DATATYPE_WCHAR ) ), FB_PARAMMODE_BYVAL, FALSE ) _
@@ -1027,6 +1027,17 @@
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, FALSE ) _
 			} _
 		), _
+		/' function fb_StrHash( byref str as const string, byval seed as const ulong ) as ulong '/ _
+		( _
+			@FB_RTL_STRHASH, NULL, _
+			FB_DATATYPE_ULONG, FB_FUNCMODE_FBCALL, _
+			NULL, FB_RTL_OPT_NONE, _
+			2, _
+			{ _
+				( typeSetIsConst( FB_DATATYPE_STRING ), FB_PARAMMODE_BYREF, FALSE ), _
+				( typeSetIsConst( FB_DATATYPE_ULONG ), FB_PARAMMODE_BYVAL, FALSE ) _
+			} _
+		), _
 		/' sub fb_WstrSwap( byval str1 as wstring ptr, byval size1 as const integer, _
 				    byval str2 as wstring ptr, byval size2 as const integer ) '/ _
 		( _
@@ -3898,6 +3909,30 @@ function rtlStrSwap _
 	function = TRUE
 end function
 
+'':::::
+function rtlStrHash _
+	( _
+		byval expr as ASTNODE ptr, _
+		byval seed as ulong _
+	) as ASTNODE ptr
+
+	function = NULL
+
+	var proc = astNewCALL( PROCLOOKUP( STRHASH ) )
+
+	'' byref str as const string
+	if( astNewARG( proc, expr ) = NULL ) then
+		exit function
+	end if
+
+	'' byval seed as const ulong
+	if( astNewARG( proc, astNewCONSTi( seed, FB_DATATYPE_ULONG ) ) = NULL ) then
+		exit function
+	end if
+
+	function = proc
+end function
+
 '':::::
 function rtlWstrSwap _
 	( _
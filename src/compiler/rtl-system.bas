@@ -50,7 +50,7 @@ declare function 	hThreadCall_cb		( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@FB_RTL_END, NULL, _
 	 		FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
-	 		NULL, FB_RTL_OPT_NONE, _
+	 		NULL, FB_RTL_OPT_NORETURN, _
 	 		1, _
 	 		{ _
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, FALSE ) _
@@ -125,7 +125,7 @@ declare function 	hThreadCall_cb		( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@"system", @"fb_End", _
 	 		FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
-	 		NULL, FB_RTL_OPT_NONE, _
+	 		NULL, FB_RTL_OPT_NORETURN, _
 	 		1, _
 	 		{ _
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, TRUE, 0 ) _
@@ -135,7 +135,7 @@ declare function 	hThreadCall_cb		( byval sym as FBSYMBOL ptr ) as integer
 		( _
 			@"stop", @"fb_End", _
 	 		FB_DATATYPE_VOID, FB_FUNCMODE_FBCALL, _
-	 		NULL, FB_RTL_OPT_NONE, _
+	 		NULL, FB_RTL_OPT_NORETURN, _
 	 		1, _
 	 		{ _
 				( typeSetIsConst( FB_DATATYPE_LONG ), FB_PARAMMODE_BYVAL, TRUE, 0 ) _
@@ -663,7 +663,7 @@ function rtlInitApp _
 		'' call __monstartup() on win32/cygwin if profiling
 		select case( env.clopt.target )
 		case FB_COMPTARGET_WIN32, FB_COMPTARGET_CYGWIN
-			if( env.clopt.profile ) then
+			if( fbProfileWithGmon( ) ) then
 				'' __monstartup()
 				rtlProfileCall_monstartup( )
 			end if
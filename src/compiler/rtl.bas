@@ -265,6 +265,20 @@ sub rtlAddIntrinsicProcs( byval procdef as const FB_RTL_PROCDEF ptr )
 				if( procdef->options and FB_RTL_OPT_CANBECLONED ) then
 					proc->stats or= FB_SYMBSTATS_CANBECLONED
 				end if
+
+				'' function attributes, only used by the C backend
+				if( procdef->options and FB_RTL_OPT_NORETURN ) then
+					proc->stats or= FB_SYMBSTATS_NORETURN
+				end if
+				if( procdef->options and FB_RTL_OPT_COLD ) then
+					proc->stats or= FB_SYMBSTATS_COLD
+				end if
+				if( procdef->options and FB_RTL_OPT_PURE ) then
+					proc->stats or= FB_SYMBSTATS_PURE
+				end if
+				if( procdef->options and FB_RTL_OPT_CONST ) then
+					proc->stats or= FB_SYMBSTATS_CONSTPROC
+				end if
 			else
 				errReportEx( FB_ERRMSG_DUPDEFINITION, *procdef->name )
 			end if
@@ -0,0 +1,333 @@
+''
+'' -server: compile server
+''
+'' fbc -server <socket> [options] listens on a Unix domain socket. A client
+'' connects and sends one request, the working directory and the fbc command
+'' line, one argument per line (LF or CR LF), ended by an empty line:
+''
+''    /home/user/project
+''    -c
+''    foo.bas
+''    <empty line>
+''
+'' The server forks a process for the request, which compiles in that
+'' directory with the server's options plus the request's, and writes fbc's
+'' output back to the connection, followed by a last line with the exit code
+'' (128 + signal number if it crashed):
+''
+''    exit <code>
+''
+'' Requests are handled in parallel. The server has parsed and checked its
+'' options, set up the paths, and initialized the compiler (symbol tables,
+'' rtl procedures) once; each request's process is a copy of that, and goes
+'' on compiling its first module without a new fbInit(). A request with
+'' options changing any of that (-lang, -gen, -target, -fpu, ...) is compiled
+'' by a new fbc instead; for the main module, __FB_MAIN__ is added.
+''
+'' The socket is only accessible to its owner (mode 0600). A file left over
+'' at its path is only removed if it's a socket no server answers on.
+''
+
+#include once "fb.bi"
+#include once "server.bi"
+
+#ifdef __FB_UNIX__
+
+extern "C"
+	declare function socket_ alias "socket" ( byval domain as long, byval type_ as long, byval protocol as long ) as long
+	declare function bind_ alias "bind" ( byval fd as long, byval addr as const any ptr, byval addrlen as ulong ) as long
+	declare function listen_ alias "listen" ( byval fd as long, byval backlog as long ) as long
+	declare function connect_ alias "connect" ( byval fd as long, byval addr as const any ptr, byval addrlen as ulong ) as long
+	declare function accept_ alias "accept" ( byval fd as long, byval addr as any ptr, byval addrlen as ulong ptr ) as long
+	declare function read_ alias "read" ( byval fd as long, byval buffer as any ptr, byval size as uinteger ) as integer
+	declare function write_ alias "write" ( byval fd as long, byval buffer as const any ptr, byval size as uinteger ) as integer
+	declare function close_ alias "close" ( byval fd as long ) as long
+	declare function unlink_ alias "unlink" ( byval path as const zstring ptr ) as long
+	declare function open_ alias "open" ( byval path as const zstring ptr, byval flags as long, ... ) as long
+	declare function chmod_ alias "chmod" ( byval path as const zstring ptr, byval mode as ulong ) as long
+	declare function chdir_ alias "chdir" ( byval path as const zstring ptr ) as long
+	declare function dup2_ alias "dup2" ( byval oldfd as long, byval newfd as long ) as long
+	declare function fork_ alias "fork" ( ) as long
+	declare function waitpid_ alias "waitpid" ( byval pid as long, byval status as long ptr, byval options as long ) as long
+	declare function execv_ alias "execv" ( byval path as const zstring ptr, byval argv as const zstring const ptr ptr ) as long
+	declare sub exit_ alias "_exit" ( byval status as long )
+end extern
+
+'' the same on Linux, the BSDs and Darwin
+const AF_UNIX     = 1
+const SOCK_STREAM = 1
+const WNOHANG     = 1
+const O_RDONLY    = 0
+
+#if defined( __FB_LINUX__ ) or defined( __FB_CYGWIN__ )
+	const O_NONBLOCK = &o4000
+#else
+	const O_NONBLOCK = &h0004
+#endif
+
+type SERVERADDR
+#if defined( __FB_LINUX__ ) or defined( __FB_CYGWIN__ )
+	family		as ushort
+	path		as zstring * 108
+#else
+	len_		as ubyte
+	family		as ubyte
+	path		as zstring * 104
+#endif
+end type
+
+const SERVER_MAXREQUEST = 256 * 1024
+
+private sub hWriteExit( byval conn as long, byval status as long )
+	dim as string s
+
+	'' exited normally, or killed by a signal?
+	if( (status and &h7F) = 0 ) then
+		s = "exit " & ((status shr 8) and &hFF) & !"\n"
+	else
+		s = "exit " & (128 + (status and &h7F)) & !"\n"
+	end if
+
+	write_( conn, strptr( s ), len( s ) )
+end sub
+
+'' read the request, up to the empty line ending it
+private function hReadRequest( byval conn as long, byref request as string ) as integer
+	dim as zstring * 4096+1 buffer = any
+	dim as integer bytes = any
+
+	function = FALSE
+
+	request = ""
+	do
+		bytes = read_( conn, @buffer, 4096 )
+		if( bytes <= 0 ) then
+			exit function
+		end if
+
+		buffer[bytes] = 0
+		request += buffer
+		if( len( request ) > SERVER_MAXREQUEST ) then
+			exit function
+		end if
+
+		'' the empty line?
+		if( (right( request, 2 ) = !"\n\n") orelse _
+		    (right( request, 4 ) = !"\r\n\r\n") ) then
+			exit do
+		end if
+	loop
+
+	function = TRUE
+end function
+
+'' split the request into the working directory and the arguments
+private sub hParseRequest( byref request as string, byref dir_ as string, byval args as TLIST ptr )
+	dim as integer i = any, start = any, first = any
+	dim as string ln
+
+	dir_ = ""
+	start = 1
+	first = TRUE
+	do
+		i = instr( start, request, !"\n" )
+		if( i = 0 ) then
+			exit do
+		end if
+
+		ln = mid( request, start, i - start )
+		if( right( ln, 1 ) = !"\r" ) then
+			ln = left( ln, len( ln ) - 1 )
+		end if
+		start = i + 1
+
+		'' empty: stay in the server's directory
+		if( first ) then
+			dir_ = ln
+			first = FALSE
+
+		'' the empty line at the end?
+		elseif( len( ln ) = 0 ) then
+			exit do
+
+		else
+			strlistAppend( args, ln )
+		end if
+	loop
+end sub
+
+'' handle a connection, returns in the process compiling the request only
+private sub hServeConnection( byval conn as long, byval args as TLIST ptr )
+	dim as string request, dir_
+	dim as long pid = any, status = any
+
+	if( hReadRequest( conn, request ) = FALSE ) then
+		close_( conn )
+		exit_( 0 )
+	end if
+
+	hParseRequest( request, dir_, args )
+
+	pid = fork_( )
+	select case( pid )
+	case 0
+		'' the compiler's output goes to the client
+		dup2_( conn, 1 )
+		dup2_( conn, 2 )
+		close_( conn )
+
+		if( len( dir_ ) > 0 ) then
+			if( chdir_( dir_ ) <> 0 ) then
+				errReportEx( FB_ERRMSG_FILEACCESSERROR, dir_, -1 )
+				end 1
+			end if
+		end if
+
+		exit sub
+
+	case -1
+		status = 1 shl 8
+
+	case else
+		if( waitpid_( pid, @status, 0 ) <> pid ) then
+			status = 1 shl 8
+		end if
+	end select
+
+	hWriteExit( conn, status )
+	close_( conn )
+	exit_( 0 )
+end sub
+
+'' is the file at the address a socket left over by a server that was
+'' killed? Nothing answers on it, and it can't be opened (regular files,
+'' directories and FIFOs can)
+private function hIsStaleSocket( byval addr as SERVERADDR ptr ) as integer
+	dim as long fd = any
+
+	function = FALSE
+
+	fd = socket_( AF_UNIX, SOCK_STREAM, 0 )
+	if( fd < 0 ) then
+		exit function
+	end if
+
+	'' a server still running?
+	if( connect_( fd, addr, sizeof( SERVERADDR ) ) = 0 ) then
+		close_( fd )
+		exit function
+	end if
+	close_( fd )
+
+	fd = open_( addr->path, O_RDONLY or O_NONBLOCK )
+	if( fd >= 0 ) then
+		close_( fd )
+		exit function
+	end if
+
+	function = TRUE
+end function
+
+function serverRun( byref sockpath as string, byval args as TLIST ptr ) as integer
+	dim as SERVERADDR addr
+	dim as long listenfd = any, conn = any
+
+	function = FALSE
+
+	if( len( sockpath ) >= sizeof( addr.path ) ) then
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, sockpath, -1 )
+		exit function
+	end if
+
+	listenfd = socket_( AF_UNIX, SOCK_STREAM, 0 )
+	if( listenfd < 0 ) then
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, sockpath, -1 )
+		exit function
+	end if
+
+	addr.family = AF_UNIX
+	addr.path = sockpath
+
+	if( bind_( listenfd, @addr, sizeof( addr ) ) <> 0 ) then
+		'' left over by a server that was killed?
+		if( hIsStaleSocket( @addr ) ) then
+			unlink_( sockpath )
+		end if
+
+		if( bind_( listenfd, @addr, sizeof( addr ) ) <> 0 ) then
+			errReportEx( FB_ERRMSG_FILEACCESSERROR, sockpath, -1 )
+			close_( listenfd )
+			exit function
+		end if
+	end if
+
+	if( (chmod_( sockpath, &o600 ) <> 0) orelse _
+	    (listen_( listenfd, 16 ) <> 0) ) then
+		errReportEx( FB_ERRMSG_FILEACCESSERROR, sockpath, -1 )
+		close_( listenfd )
+		exit function
+	end if
+
+	do
+		'' reap the processes of the finished requests
+		while( waitpid_( -1, NULL, WNOHANG ) > 0 )
+		wend
+
+		conn = accept_( listenfd, NULL, NULL )
+		if( conn < 0 ) then
+			continue do
+		end if
+
+		select case( fork_( ) )
+		case 0
+			close_( listenfd )
+			hServeConnection( conn, args )
+			return TRUE
+
+		case -1
+			hWriteExit( conn, 1 shl 8 )
+		end select
+
+		close_( conn )
+	loop
+end function
+
+'' run the program with the arguments as they are, no shell in between to
+'' split or unquote them; only returns if it couldn't be run
+sub serverExec( byref path as string, byval args as TLIST ptr )
+	dim as string ptr arg = any
+	dim as integer i = any
+
+	i = 1
+	arg = listGetHead( args )
+	while( arg )
+		i += 1
+		arg = listGetNext( arg )
+	wend
+
+	dim as const zstring ptr argv(0 to i)
+
+	argv(0) = strptr( path )
+	i = 1
+	arg = listGetHead( args )
+	while( arg )
+		argv(i) = strptr( *arg )
+		i += 1
+		arg = listGetNext( arg )
+	wend
+	argv(i) = NULL
+
+	execv_( path, @argv(0) )
+end sub
+
+#else
+
+function serverRun( byref sockpath as string, byval args as TLIST ptr ) as integer
+	errReportEx( FB_ERRMSG_SERVERNOTSUPPORTED, "", -1 )
+	function = FALSE
+end function
+
+sub serverExec( byref path as string, byval args as TLIST ptr )
+end sub
+
+#endif
@@ -49,6 +49,7 @@ end sub
 
 sub symbProcFreeExt( byval proc as FBSYMBOL ptr )
 	if( proc->proc.ext ) then
+		deallocate( proc->proc.ext->gosub.labels )
 		deallocate( proc->proc.ext )
 		proc->proc.ext = NULL
 	end if
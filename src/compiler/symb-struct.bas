@@ -861,6 +861,69 @@ function symbUdtGetNextField( byval sym as FBSYMBOL ptr ) as FBSYMBOL ptr
 	function = hSkipToField( sym->next )
 end function
 
+'' TYPE ... VECTOR: 2, 4, 8, ... plain fields of the same integer or floating
+'' point type, 8, 16 or 32 bytes in total, not packed, no constructors or destructor;
+'' the -gen gcc backend emits it as a gcc vector type
+function symbUdtCheckVector( byval s as FBSYMBOL ptr ) as integer
+	dim as FBSYMBOL ptr fld = any
+	dim as integer dtype = any, count = any
+
+	function = FALSE
+
+	if( symbGetUDTIsUnion( s ) or symbGetUDTHasAnonUnion( s ) or _
+	    symbGetUdtHasBitfield( s ) or (symbCompIsTrivial( s ) = FALSE) or _
+	    (symbGetCompCtorHead( s ) <> NULL) or (s->udt.base <> NULL) or _
+	    symbGetUdtIsZstring( s ) or symbGetUdtIsWstring( s ) ) then
+		exit function
+	end if
+
+	fld = symbUdtGetFirstField( s )
+	if( fld = NULL ) then
+		exit function
+	end if
+
+	dtype = symbGetFullType( fld )
+	select case( typeGetDtAndPtrOnly( dtype ) )
+	case FB_DATATYPE_BYTE, FB_DATATYPE_UBYTE, FB_DATATYPE_SHORT, FB_DATATYPE_USHORT, _
+	     FB_DATATYPE_LONG, FB_DATATYPE_ULONG, FB_DATATYPE_INTEGER, FB_DATATYPE_UINT, _
+	     FB_DATATYPE_LONGINT, FB_DATATYPE_ULONGINT, FB_DATATYPE_SINGLE, FB_DATATYPE_DOUBLE
+	case else
+		exit function
+	end select
+
+	'' aligned like the elements in the C code, FIELD can't pack it
+	if( (symbGetUDTAlign( s ) > 0) and (symbGetUDTAlign( s ) < typeGetSize( dtype )) ) then
+		exit function
+	end if
+
+	count = 0
+	while( fld )
+		if( (symbGetFullType( fld ) <> dtype) or _
+		    (symbGetArrayDimensions( fld ) <> 0) ) then
+			exit function
+		end if
+		count += 1
+		fld = symbUdtGetNextField( fld )
+	wend
+
+	if( (count < 2) or ((count and (count - 1)) <> 0) ) then
+		exit function
+	end if
+
+	select case( s->lgt )
+	case 8, 16, 32
+	case else
+		exit function
+	end select
+
+	function = (s->lgt = count * typeGetSize( dtype ))
+end function
+
+'' element type of a VECTOR type
+function symbGetUdtVectorDtype( byval s as FBSYMBOL ptr ) as integer
+	function = symbGetFullType( symbUdtGetFirstField( s ) )
+end function
+
 private function hFindCommonParent _
 	( _
 		byval a as FBSYMBOL ptr, _
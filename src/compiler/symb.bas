@@ -2549,12 +2549,20 @@ function symbDumpToStr( byval sym as FBSYMBOL ptr ) as string
 		checkStat( UNIONFIELD )
 	elseif( symbIsProc( sym ) ) then
 		checkStat( PROCEMITTED )
+	elseif( symbIsLabel( sym ) ) then
+		checkStat( LIKELYJUMP )
 	else
 		checkStat( WSTRING )
 	end if
 	checkStat( RTL_CONST )
 	checkStat( EMITTED )
 	checkStat( BEINGEMITTED )
+	if( symbIsProc( sym ) ) then
+		checkStat( NORETURN )
+		checkStat( COLD )
+		checkStat( PURE )
+		checkStat( CONSTPROC )
+	end if
 #endif
 
 	if( sym->class = FB_SYMBCLASS_NSIMPORT ) then
@@ -52,6 +52,7 @@
 #define CTX_WINDOW_SCREEN		0x00000008
 #define CTX_VIEWPORT_SET		0x00000010
 #define CTX_VIEW_SCREEN			0x00000020
+#define CTX_ALPHA_PIXELS		0x00000040
 
 #define COORD_TYPE_AA			0
 #define COORD_TYPE_AR			1
@@ -455,6 +456,8 @@ extern void fb_hTranslateCoord(FB_GFXCTX *ctx, float fx, float fy, int *x, int *
 extern void fb_hFixRelative(FB_GFXCTX *ctx, int coord_type, float *x1, float *y1, float *x2, float *y2);
 extern void fb_hFixCoordsOrder(int *x1, int *y1, int *x2, int *y2);
 extern void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned int color, unsigned int style);
+extern void fb_hGfxDrawLine_NoLock(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned int color, unsigned int style);
+extern int fb_hGfxPixelRun(FB_GFXCTX *context, int x, int y, int step_x, int step_y, int count, unsigned int color, unsigned int style, int bit);
 extern void fb_hGfxBox(int x1, int y1, int x2, int y2, unsigned int color, int full, unsigned int style);
 extern void fb_hScreenInfo(ssize_t *width, ssize_t *height, ssize_t *depth, ssize_t *refresh);
 extern void *fb_hMemCpyMMX(void *dest, const void *src, size_t size);
@@ -496,6 +499,8 @@ extern FBCALL float fb_GfxCursor(int func);
 extern FBCALL void fb_GfxView(int x1, int y1, int x2, int y2, unsigned int fill_color, unsigned int border_color, int screen);
 extern FBCALL void fb_GfxWindow(float x1, float y1, float x2, float y2, int screen);
 extern FBCALL void fb_GfxLine(void *target, float x1, float y1, float x2, float y2, unsigned int color, int type, unsigned int style, int coord_type);
+extern FBCALL void fb_GfxPolyLine(void *target, const float *coords, ssize_t count, unsigned int color, unsigned int style, int flags);
+extern FBCALL void fb_GfxLineSegments(void *target, const float *coords, ssize_t count, unsigned int color, unsigned int style, int flags);
 extern FBCALL void fb_GfxEllipse(void *target, float x, float y, float radius, unsigned int color, float aspect, float start, float end, int fill, int coord_type);
 extern FBCALL int fb_GfxGet(void *target, float x1, float y1, float x2, float y2, unsigned char *dest, int coord_type, FBARRAY *array);
 extern FBCALL int fb_GfxGetQB(void *target, float x1, float y1, float x2, float y2, unsigned char *dest, int coord_type, FBARRAY *array);
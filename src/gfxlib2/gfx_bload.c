@@ -45,6 +45,29 @@ static void convert_8to32(const unsigned char *src, unsigned char *dest, int w,
 	fb_image_convert_8to32(src, dest, w);
 }
 
+/* Plain BI_RGB 24 and 32-bit images are stored in the same BGR(A) byte
+ * order fbgfx uses, so the shared image converters can be used for them
+ * instead of the generic bitfield ones below */
+static void convert_24to16(const unsigned char *src, unsigned char *dest, int w, const uint32_t *masks, const int *shifts, const int *bits)
+{
+	fb_image_convert_24bgrto16(src, dest, w);
+}
+
+static void convert_24to32(const unsigned char *src, unsigned char *dest, int w, const uint32_t *masks, const int *shifts, const int *bits)
+{
+	fb_image_convert_24bgrto32(src, dest, w);
+}
+
+static void convert_32to16(const unsigned char *src, unsigned char *dest, int w, const uint32_t *masks, const int *shifts, const int *bits)
+{
+	fb_image_convert_32bgrto16(src, dest, w);
+}
+
+static void convert_32to32(const unsigned char *src, unsigned char *dest, int w, const uint32_t *masks, const int *shifts, const int *bits)
+{
+	fb_image_convert_32bgrto32(src, dest, w);
+}
+
 #define CONVERT_DEPTH(c, from, to) \
 	((from) <= (to) ? \
 		((c) << (to - from)) | (c >> (from - (to - from))) \
@@ -179,9 +202,9 @@ static int load_bmp(FB_GFXCTX *ctx, FILE *f, void *dest, void *pal, int usenewhe
 	int flipped = FALSE;
 
 	PUT_HEADER *put_header = NULL;
-	unsigned char *buffer;
+	unsigned char *data, *buffer, *src;
 	int result = fb_ErrorSetNum( FB_RTERROR_OK );
-	int i, j, width, height, bpp, color, expand, size, padding, palette[256], palette_entries;
+	int i, j, row, rows, width, height, bpp, color, expand, rowsize, palette[256], palette_entries;
 	int shifts[4] = {0, 0, 0, 0};
 	uint32_t masks[4];
 	int bits[4] = {0, 0, 0, 0};
@@ -374,17 +397,17 @@ static int load_bmp(FB_GFXCTX *ctx, FILE *f, void *dest, void *pal, int usenewhe
 	else if (biBitCount <= 24) {
 		switch (bpp) {
 			case 1: return FB_RTERROR_ILLEGALFUNCTIONCALL;
-			case 2: convert = convert_bf_24to16; break;
+			case 2: convert = (biCompression == BI_RGB) ? convert_24to16 : convert_bf_24to16; break;
 			case 3:
-			case 4: convert = convert_bf_24to32; break;
+			case 4: convert = (biCompression == BI_RGB) ? convert_24to32 : convert_bf_24to32; break;
 		}
 	}
 	else if (biBitCount <= 32) {
 		switch (bpp) {
 			case 1: return FB_RTERROR_ILLEGALFUNCTIONCALL;
-			case 2: convert = convert_bf_32to16; break;
+			case 2: convert = (biCompression == BI_RGB) ? convert_32to16 : convert_bf_32to16; break;
 			case 3:
-			case 4: convert = convert_bf_32to32; break;
+			case 4: convert = (biCompression == BI_RGB) ? convert_32to32 : convert_bf_32to32; break;
 		}
 	}
 	else
@@ -407,51 +430,55 @@ static int load_bmp(FB_GFXCTX *ctx, FILE *f, void *dest, void *pal, int usenewhe
 		}
 	}
 
+	/* the whole pixel array is read with a single fread() and then
+	 * converted row by row from memory */
+	rowsize = (((biWidth * biBitCount) + 31) >> 5) << 2;
+	data = (unsigned char *)malloc(((size_t)rowsize * biHeight) + 1);
+	if (data == NULL)
+		return FB_RTERROR_OUTOFMEM;
+
+	buffer = NULL;
+	if (expand) {
+		buffer = (unsigned char *)malloc(biWidth);
+		if (buffer == NULL) {
+			free(data);
+			return FB_RTERROR_OUTOFMEM;
+		}
+	}
+
+	fseek(f, bfOffBits, SEEK_SET);
+	rows = (int)(fread(data, 1, (size_t)rowsize * biHeight, f) / rowsize);
+	if (rows < biHeight)
+		result = FB_RTERROR_FILEIO;
+
 	DRIVER_LOCK();
 	fb_hMemCpy(target_pal, palette, palette_entries * sizeof(int));
 	if (!pal)
 		fb_hRestorePalette();
-	size = ((biWidth * BYTES_PER_PIXEL(biBitCount)) + 3) & ~0x3;
-	buffer = (unsigned char *)malloc(size + 1);
-	switch (expand) {
-		case 1: padding = 4 - (((biWidth + 7) >> 3) & 0x3); break;
-		case 4: padding = 4 - (((biWidth + 1) >> 1) & 0x3); break;
-		default: padding = 4 - ((biWidth * BYTES_PER_PIXEL(biBitCount)) & 0x3); break;
-	}
-	padding &= 0x3;
-	fseek(f, bfOffBits, SEEK_SET);
-	for (i = flipped ? 0 : (biHeight - 1);
-	     flipped ? (i < biHeight) : (i >= 0);
-	     flipped ? i++ : i--) {
+	for (row = 0; row < rows; row++) {
+		i = flipped ? row : (biHeight - 1 - row);
+		if (i >= height)
+			continue;
 
+		src = data + ((size_t)row * rowsize);
 		if (expand) {
 			color = 0;
 			for (j = 0; j < biWidth; j++) {
-				if (j % (8 / expand) == 0) {
-					if ((color = fgetc(f)) < 0) {
-						result = FB_RTERROR_FILEIO;
-						goto exit_error;
-					}
-				}
+				if (j % (8 / expand) == 0)
+					color = *src++;
 				buffer[j] = color >> (8 - expand);
 				color = (color << expand) & 0xFF;
 			}
-			for (j = 0; j < padding; j++)
-				fgetc(f);
-		}
-		else if (!fread(buffer, size, 1, f)) {
-			result = FB_RTERROR_FILEIO;
-			break;
+			src = buffer;
 		}
-		if (i < height)
-			convert(buffer, ctx->line[i], width, masks, shifts, bits);
+		convert(src, ctx->line[i], width, masks, shifts, bits);
 	}
 
-exit_error:
 	SET_DIRTY(ctx, 0, __fb_gfx->h);
 	DRIVER_UNLOCK();
 
 	free(buffer);
+	free(data);
 
 	return result;
 }
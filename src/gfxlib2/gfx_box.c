@@ -44,13 +44,8 @@ void fb_hGfxBox(int x1, int y1, int x2, int y2, unsigned int color, int full, un
 		if (y2 < context->view_y + context->view_h) {
 			if (style == 0xFFFF)
 				context->pixel_set(context->line[y2] + (clipped_x1 * context->target_bpp), color, clipped_x2 - clipped_x1 + 1);
-			else {
-				for (w = clipped_x1; w <= clipped_x2; w++) {
-					if (style & bit)
-						context->put_pixel(context, w, y2, color);
-					RORW1(bit);
-				}
-			}
+			else
+				bit = fb_hGfxPixelRun(context, clipped_x1, y2, 1, 0, clipped_x2 - clipped_x1 + 1, color, style, bit);
 		}
 		else if (style != 0xFFFF) {
 			rot = (clipped_x2 - clipped_x1 + 1) & 0xF;
@@ -64,13 +59,8 @@ void fb_hGfxBox(int x1, int y1, int x2, int y2, unsigned int color, int full, un
 		if (y1 >= context->view_y) {
 			if (style == 0xFFFF)
 				context->pixel_set(context->line[y1] + (clipped_x1 * context->target_bpp), color, clipped_x2 - clipped_x1 + 1);
-			else {
-				for (w = clipped_x1; w <= clipped_x2; w++) {
-					if (style & bit)
-						context->put_pixel(context, w, y1, color);
-					RORW1(bit);
-				}
-			}
+			else
+				bit = fb_hGfxPixelRun(context, clipped_x1, y1, 1, 0, clipped_x2 - clipped_x1 + 1, color, style, bit);
 		}
 		else if (style != 0xFFFF) {
 			rot = (clipped_x2 - clipped_x1 + 1) & 0xF;
@@ -81,11 +71,7 @@ void fb_hGfxBox(int x1, int y1, int x2, int y2, unsigned int color, int full, un
 			RORW(bit, rot);
 		}
 		if (x2 < context->view_x + context->view_w) {
-			for (h = clipped_y1; h <= clipped_y2; h++) {
-				if (style & bit)
-					context->put_pixel(context, x2, h, color);
-				RORW1(bit);
-			}
+			bit = fb_hGfxPixelRun(context, x2, clipped_y1, 0, 1, clipped_y2 - clipped_y1 + 1, color, style, bit);
 		}
 		else if (style != 0xFFFF) {
 			rot = (clipped_y2 - clipped_y1 + 1) & 0xF;
@@ -96,11 +82,7 @@ void fb_hGfxBox(int x1, int y1, int x2, int y2, unsigned int color, int full, un
 			RORW(bit, rot);
 		}
 		if (x1 >= context->view_x) {
-			for (h = clipped_y1; h <= clipped_y2; h++) {
-				if (style & bit)
-					context->put_pixel(context, x1, h, color);
-				RORW1(bit);
-			}
+			bit = fb_hGfxPixelRun(context, x1, clipped_y1, 0, 1, clipped_y2 - clipped_y1 + 1, color, style, bit);
 		}
 	}
 
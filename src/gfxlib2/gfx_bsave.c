@@ -25,44 +25,95 @@ typedef struct BMP_HEADER
 	unsigned int   biClrImportant;
 } FBPACKED BMP_HEADER;
 
-static int save_bmp(FB_GFXCTX *ctx, FILE *f, void *src, void *pal, int outbpp)
+/* Description of the pixels to be saved: either an image buffer or the
+ * current work page */
+typedef struct SAVE_SOURCE
+{
+	int w, h, bpp, pitch;
+	int has_alpha;		/* image buffers only, the screen's alpha bytes are undefined */
+	unsigned char *data;
+} SAVE_SOURCE;
+
+static int get_source(FB_GFXCTX *ctx, void *src, SAVE_SOURCE *img)
 {
-	BMP_HEADER header;
 	PUT_HEADER *put_header;
-	int w, h, i, bfSize, biSizeImage, bfOffBits, biClrUsed, inbpp, inpitch, outpitch, color;
-	unsigned char *s, *buffer, *p;
-	unsigned int *palette = (unsigned int *)pal, *paltmp = 0;
 
 	if (src) {
 		put_header = (PUT_HEADER *)src;
 		if (put_header->type == PUT_HEADER_NEW) {
-			w = put_header->width;
-			h = put_header->height;
-			s = (unsigned char *)src + sizeof(PUT_HEADER);
-			inbpp = put_header->bpp;
-			inpitch = put_header->pitch;
+			img->w = put_header->width;
+			img->h = put_header->height;
+			img->data = (unsigned char *)src + sizeof(PUT_HEADER);
+			img->bpp = put_header->bpp;
+			img->pitch = put_header->pitch;
 		}
 		else {
-			w = put_header->old.width;
-			h = put_header->old.height;
-			s = (unsigned char *)src + 4;
-			inbpp = (put_header->old.bpp ? put_header->old.bpp : __fb_gfx->bpp);
-			inpitch = w * inbpp;
+			img->w = put_header->old.width;
+			img->h = put_header->old.height;
+			img->data = (unsigned char *)src + 4;
+			img->bpp = (put_header->old.bpp ? put_header->old.bpp : __fb_gfx->bpp);
+			img->pitch = img->w * img->bpp;
 		}
+		img->has_alpha = TRUE;
 	}
 	else {
-		w = __fb_gfx->w;
-		h = __fb_gfx->h;
-		s = ctx->line[0];
-		inbpp = __fb_gfx->bpp;
-		inpitch = __fb_gfx->pitch;
+		img->w = __fb_gfx->w;
+		img->h = __fb_gfx->h;
+		img->data = ctx->line[0];
+		img->bpp = __fb_gfx->bpp;
+		img->pitch = __fb_gfx->pitch;
+		img->has_alpha = FALSE;
 	}
 
-	if (w <= 0 || h <= 0 || s == 0 || inpitch < w * inbpp) {
+	if (img->w <= 0 || img->h <= 0 || img->data == 0 || img->pitch < img->w * img->bpp) {
 		/* Something wrong with the image header */
 		return FB_RTERROR_ILLEGALFUNCTIONCALL;
 	}
 
+	return FB_RTERROR_OK;
+}
+
+/* Returns the palette to use for 8-bit sources, in device palette format
+ * (0x00BBGGRR); a user supplied palette (6 bits per component) is
+ * converted into a temporary copy stored in *paltmp */
+static unsigned int *get_palette(void *pal, unsigned int **paltmp)
+{
+	unsigned int *palette = (unsigned int *)pal;
+	int i;
+
+	*paltmp = NULL;
+	if (!pal)
+		return __fb_gfx->device_palette;
+
+	*paltmp = (unsigned int *)calloc(sizeof(unsigned int), 256);
+	if (*paltmp == NULL)
+		return NULL;
+	for (i = 0; i < 256; i++) {
+		(*paltmp)[i] = (palette[i] & 0x3f0000) >> (16 - 2)
+		             | (palette[i] & 0x003f00) << 2
+		             | (palette[i] & 0x00003f) << (16 + 2);
+	}
+	return *paltmp;
+}
+
+static int save_bmp(FB_GFXCTX *ctx, FILE *f, void *src, void *pal, int outbpp)
+{
+	BMP_HEADER header;
+	SAVE_SOURCE img;
+	int w, h, i, bfSize, biSizeImage, bfOffBits, biClrUsed, inbpp, inpitch, outpitch, color, res;
+	unsigned char *s, *buffer, *p;
+	unsigned int *palette = NULL, *paltmp = 0;
+
+	res = get_source(ctx, src, &img);
+	if (res != FB_RTERROR_OK)
+		return res;
+
+	w = img.w;
+	h = img.h;
+	s = img.data;
+	inbpp = img.bpp;
+	inpitch = img.pitch;
+
 	switch (inbpp) {
 	case 1: /* 8-bit or 24-bit output (default to 8) */
 		if (outbpp > 8) {
@@ -131,21 +182,9 @@ static int save_bmp(FB_GFXCTX *ctx, FILE *f, void *src, void *pal, int outbpp)
 		return FB_RTERROR_FILEIO;
 
 	if (inbpp == 1) {
-		if (!pal) {
-			palette = __fb_gfx->device_palette;
-		}
-		else {
-			paltmp = (unsigned int *)calloc(sizeof(unsigned int), 256);
-			if (paltmp == 0) {
-				return FB_RTERROR_OUTOFMEM;
-			}
-			for (i = 0; i < 256; i++) {
-				paltmp[i] = (palette[i] & 0x3f0000) >> (16 - 2)
-				          | (palette[i] & 0x003f00) << 2
-				          | (palette[i] & 0x00003f) << (16 + 2);
-			}
-			palette = paltmp;
-		}
+		palette = get_palette(pal, &paltmp);
+		if (palette == NULL)
+			return FB_RTERROR_OUTOFMEM;
 
 		if (outbpp == 1) {
 			for (i = 0; i < 256; i++) {
@@ -214,6 +253,447 @@ static int save_bmp(FB_GFXCTX *ctx, FILE *f, void *src, void *pal, int outbpp)
 	return fb_ErrorSetNum( FB_RTERROR_OK );
 }
 
+/* Converts one source row to packed 8-bit R,G,B[,A] components; without an
+ * alpha channel in the source (8/16-bit, or the screen: CLS and drawing
+ * without alpha leave 0 there), alpha is always 255 */
+static void convert_row_rgba(const SAVE_SOURCE *img, const unsigned char *s, const unsigned int *palette, unsigned char *p, int channels)
+{
+	unsigned int color;
+	int i;
+
+	switch (img->bpp) {
+		case 1:
+			for (i = 0; i < img->w; i++, p += channels) {
+				color = palette[s[i]];
+				p[0] = color & 0xFF;
+				p[1] = (color >> 8) & 0xFF;
+				p[2] = (color >> 16) & 0xFF;
+				if (channels == 4)
+					p[3] = 0xFF;
+			}
+			break;
+
+		case 2:
+			for (i = 0; i < img->w; i++, p += channels) {
+				color = ((unsigned short *)s)[i];
+				p[0] = ((color & 0xF800) >> 8) | ((color & 0xF800) >> 13);
+				p[1] = ((color & 0x07E0) >> 3) | ((color & 0x07E0) >> 9);
+				p[2] = ((color & 0x001F) << 3) | ((color & 0x001F) >> 2);
+				if (channels == 4)
+					p[3] = 0xFF;
+			}
+			break;
+
+		case 4:
+		default:
+			for (i = 0; i < img->w; i++, p += channels) {
+				color = ((unsigned int *)s)[i];
+				p[0] = (color >> 16) & 0xFF;
+				p[1] = (color >> 8) & 0xFF;
+				p[2] = color & 0xFF;
+				if (channels == 4)
+					p[3] = img->has_alpha ? (color >> 24) : 0xFF;
+			}
+			break;
+	}
+}
+
+/* Common part of the PPM/QOI/PNG writers: validates the source, sets up the
+ * palette and allocates a row buffer for channels components per pixel */
+static int begin_rgba(FB_GFXCTX *ctx, void *src, void *pal, SAVE_SOURCE *img, unsigned int **palette, unsigned int **paltmp, unsigned char **row, int channels)
+{
+	int res;
+
+	res = get_source(ctx, src, img);
+	if (res != FB_RTERROR_OK)
+		return res;
+
+	if ((img->bpp != 1) && (img->bpp != 2) && (img->bpp != 4))
+		return FB_RTERROR_ILLEGALFUNCTIONCALL;
+
+	*paltmp = NULL;
+	*palette = NULL;
+	if (img->bpp == 1) {
+		*palette = get_palette(pal, paltmp);
+		if (*palette == NULL)
+			return FB_RTERROR_OUTOFMEM;
+	}
+
+	*row = (unsigned char *)malloc(img->w * channels + 15);
+	if (*row == NULL) {
+		if (*paltmp) free(*paltmp);
+		return FB_RTERROR_OUTOFMEM;
+	}
+
+	return FB_RTERROR_OK;
+}
+
+/* Binary PPM (P6), always 24-bit */
+static int save_ppm(FB_GFXCTX *ctx, FILE *f, void *src, void *pal)
+{
+	SAVE_SOURCE img;
+	unsigned int *palette, *paltmp;
+	unsigned char *row, *s;
+	int y, res;
+
+	res = begin_rgba(ctx, src, pal, &img, &palette, &paltmp, &row, 3);
+	if (res != FB_RTERROR_OK)
+		return res;
+
+	if (fprintf(f, "P6\n%d %d\n255\n", img.w, img.h) < 0)
+		res = FB_RTERROR_FILEIO;
+
+	s = img.data;
+	for (y = 0; (y < img.h) && (res == FB_RTERROR_OK); y++, s += img.pitch) {
+		convert_row_rgba(&img, s, palette, row, 3);
+		if (!fwrite(row, img.w * 3, 1, f))
+			res = FB_RTERROR_FILEIO;
+	}
+
+	free(row);
+	if (paltmp) free(paltmp);
+
+	return res;
+}
+
+static void put_be32(unsigned char *p, unsigned int value)
+{
+	p[0] = value >> 24;
+	p[1] = (value >> 16) & 0xFF;
+	p[2] = (value >> 8) & 0xFF;
+	p[3] = value & 0xFF;
+}
+
+#define QOI_OP_INDEX	0x00
+#define QOI_OP_DIFF		0x40
+#define QOI_OP_LUMA		0x80
+#define QOI_OP_RUN		0xC0
+#define QOI_OP_RGB		0xFE
+#define QOI_OP_RGBA		0xFF
+#define QOI_HASH(p)		(((p)[0] * 3 + (p)[1] * 5 + (p)[2] * 7 + (p)[3] * 11) & 63)
+
+/* QOI ("Quite OK Image"); RGBA for 32-bit sources, RGB otherwise */
+static int save_qoi(FB_GFXCTX *ctx, FILE *f, void *src, void *pal)
+{
+	static const unsigned char qoi_end[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+	SAVE_SOURCE img;
+	unsigned int *palette, *paltmp;
+	unsigned char *row, *s, *p, *out, *o, prev[4], index[64][4], header[14];
+	int x, y, run, res, channels;
+	signed char vr, vg, vb, vg_r, vg_b;
+
+	res = begin_rgba(ctx, src, pal, &img, &palette, &paltmp, &row, 4);
+	if (res != FB_RTERROR_OK)
+		return res;
+
+	/* worst case is QOI_OP_RGBA for every pixel */
+	out = (unsigned char *)malloc(img.w * 5 + 16);
+	if (out == NULL) {
+		free(row);
+		if (paltmp) free(paltmp);
+		return FB_RTERROR_OUTOFMEM;
+	}
+
+	channels = (img.bpp == 4) ? 4 : 3;
+
+	fb_hMemCpy(header, "qoif", 4);
+	put_be32(header + 4, img.w);
+	put_be32(header + 8, img.h);
+	header[12] = channels;
+	header[13] = 0; /* sRGB with linear alpha */
+	if (!fwrite(header, 14, 1, f))
+		res = FB_RTERROR_FILEIO;
+
+	fb_hMemSet(index, 0, sizeof(index));
+	prev[0] = prev[1] = prev[2] = 0;
+	prev[3] = 0xFF;
+	run = 0;
+
+	s = img.data;
+	for (y = 0; (y < img.h) && (res == FB_RTERROR_OK); y++, s += img.pitch) {
+		convert_row_rgba(&img, s, palette, row, 4);
+		o = out;
+		for (x = 0, p = row; x < img.w; x++, p += 4) {
+			if (!memcmp(p, prev, 4)) {
+				if (++run == 62) {
+					*o++ = QOI_OP_RUN | (run - 1);
+					run = 0;
+				}
+				continue;
+			}
+
+			if (run) {
+				*o++ = QOI_OP_RUN | (run - 1);
+				run = 0;
+			}
+
+			if (!memcmp(index[QOI_HASH(p)], p, 4)) {
+				*o++ = QOI_OP_INDEX | QOI_HASH(p);
+			} else {
+				fb_hMemCpy(index[QOI_HASH(p)], p, 4);
+				if (p[3] == prev[3]) {
+					vr = p[0] - prev[0];
+					vg = p[1] - prev[1];
+					vb = p[2] - prev[2];
+					vg_r = vr - vg;
+					vg_b = vb - vg;
+					if ((vr > -3) && (vr < 2) && (vg > -3) && (vg < 2) && (vb > -3) && (vb < 2)) {
+						*o++ = QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+					} else if ((vg_r > -9) && (vg_r < 8) && (vg > -33) && (vg < 32) && (vg_b > -9) && (vg_b < 8)) {
+						*o++ = QOI_OP_LUMA | (vg + 32);
+						*o++ = ((vg_r + 8) << 4) | (vg_b + 8);
+					} else {
+						*o++ = QOI_OP_RGB;
+						*o++ = p[0];
+						*o++ = p[1];
+						*o++ = p[2];
+					}
+				} else {
+					*o++ = QOI_OP_RGBA;
+					*o++ = p[0];
+					*o++ = p[1];
+					*o++ = p[2];
+					*o++ = p[3];
+				}
+			}
+			fb_hMemCpy(prev, p, 4);
+		}
+
+		/* a pending run is flushed at the end of the image only */
+		if ((y == img.h - 1) && run)
+			*o++ = QOI_OP_RUN | (run - 1);
+
+		if ((o != out) && !fwrite(out, o - out, 1, f))
+			res = FB_RTERROR_FILEIO;
+	}
+
+	if ((res == FB_RTERROR_OK) && !fwrite(qoi_end, 8, 1, f))
+		res = FB_RTERROR_FILEIO;
+
+	free(out);
+	free(row);
+	if (paltmp) free(paltmp);
+
+	return res;
+}
+
+/* PNG writer state; the zlib stream uses stored (uncompressed) deflate
+ * blocks, so no compression library is needed and encoding speed is
+ * bound by memory bandwidth. Each full block goes out as one IDAT chunk. */
+#define PNG_BLOCK_SIZE	65535
+
+typedef struct PNG_WRITER
+{
+	FILE *f;
+	unsigned int adler_a, adler_b;
+	int used, first, res;
+	/* IDAT chunk data: zlib header, stored block header, block data,
+	   adler-32, plus room for the chunk crc */
+	unsigned char chunk[2 + 5 + PNG_BLOCK_SIZE + 4 + 4];
+} PNG_WRITER;
+
+/* CRC-32 (polynomial 0xEDB88320) of each byte value, for the chunks */
+static const unsigned int png_crc_table[256] = {
+	0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
+	0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
+	0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
+	0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+	0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
+	0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
+	0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
+	0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+	0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
+	0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
+	0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
+	0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+	0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
+	0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
+	0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
+	0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+	0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
+	0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
+	0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
+	0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+	0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
+	0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
+	0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
+	0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+	0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
+	0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
+	0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
+	0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+	0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
+	0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
+	0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
+	0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+	0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
+	0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
+	0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
+	0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+	0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
+	0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
+	0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
+	0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+	0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693,
+	0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
+	0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+};
+
+static unsigned int png_crc(unsigned int crc, const unsigned char *p, size_t len)
+{
+	crc = ~crc;
+	for (; len; len--)
+		crc = png_crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+static void png_write_chunk(PNG_WRITER *png, const char *type, unsigned char *data, int len)
+{
+	unsigned char buf[8];
+
+	if (png->res != FB_RTERROR_OK)
+		return;
+
+	put_be32(buf, len);
+	fb_hMemCpy(buf + 4, type, 4);
+	put_be32(data + len, png_crc(png_crc(0, buf + 4, 4), data, len));
+	if (!fwrite(buf, 8, 1, png->f) || !fwrite(data, len + 4, 1, png->f))
+		png->res = FB_RTERROR_FILEIO;
+}
+
+/* Writes out the pending stored block as an IDAT chunk, with the zlib
+ * header in front of the first one and the adler-32 after the last one */
+static void png_flush_block(PNG_WRITER *png, int final)
+{
+	unsigned char *block = png->chunk + 2, *data = block;
+	int len;
+
+	if (png->first) {
+		data = png->chunk;
+		data[0] = 0x78;
+		data[1] = 0x01;
+		png->first = FALSE;
+	}
+
+	block[0] = final ? 1 : 0;
+	block[1] = png->used & 0xFF;
+	block[2] = png->used >> 8;
+	block[3] = ~png->used & 0xFF;
+	block[4] = (~png->used >> 8) & 0xFF;
+	len = (block + 5 + png->used) - data;
+
+	if (final) {
+		put_be32(data + len, (png->adler_b << 16) | png->adler_a);
+		len += 4;
+	}
+
+	png_write_chunk(png, "IDAT", data, len);
+	png->used = 0;
+}
+
+static void png_adler(PNG_WRITER *png, const unsigned char *p, int len)
+{
+	unsigned int a = png->adler_a, b = png->adler_b;
+	int n;
+
+	while (len > 0) {
+		/* 5552 is the largest n for which b can't overflow */
+		n = MIN(len, 5552);
+		len -= n;
+		for (; n; n--) {
+			a += *p++;
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+
+	png->adler_a = a;
+	png->adler_b = b;
+}
+
+static void png_write_data(PNG_WRITER *png, const unsigned char *p, int len)
+{
+	unsigned char *block = png->chunk + 2 + 5;
+	int n;
+
+	png_adler(png, p, len);
+
+	while (len > 0) {
+		n = MIN(len, PNG_BLOCK_SIZE - png->used);
+		fb_hMemCpy(block + png->used, p, n);
+		png->used += n;
+		p += n;
+		len -= n;
+		if (png->used == PNG_BLOCK_SIZE)
+			png_flush_block(png, FALSE);
+	}
+}
+
+/* PNG, 8 bits per component; RGBA for 32-bit sources, RGB otherwise */
+static int save_png(FB_GFXCTX *ctx, FILE *f, void *src, void *pal)
+{
+	static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	SAVE_SOURCE img;
+	PNG_WRITER *png;
+	unsigned int *palette, *paltmp;
+	unsigned char *row, *s, ihdr[13 + 4];
+	int y, res, channels;
+
+	channels = 4;
+	res = begin_rgba(ctx, src, pal, &img, &palette, &paltmp, &row, 4);
+	if (res != FB_RTERROR_OK)
+		return res;
+
+	png = (PNG_WRITER *)malloc(sizeof(PNG_WRITER));
+	if (png == NULL) {
+		free(row);
+		if (paltmp) free(paltmp);
+		return FB_RTERROR_OUTOFMEM;
+	}
+
+	png->f = f;
+	png->adler_a = 1;
+	png->adler_b = 0;
+	png->used = 0;
+	png->first = TRUE;
+	png->res = FB_RTERROR_OK;
+
+	if (img.bpp != 4)
+		channels = 3;
+
+	if (!fwrite(signature, 8, 1, f))
+		png->res = FB_RTERROR_FILEIO;
+
+	put_be32(ihdr, img.w);
+	put_be32(ihdr + 4, img.h);
+	ihdr[8] = 8;						/* bit depth */
+	ihdr[9] = (channels == 4) ? 6 : 2;	/* RGBA or RGB */
+	ihdr[10] = 0;						/* deflate */
+	ihdr[11] = 0;						/* no filtering */
+	ihdr[12] = 0;						/* not interlaced */
+	png_write_chunk(png, "IHDR", ihdr, 13);
+
+	/* row[0] holds the filter type (none) in front of the pixels */
+	s = img.data;
+	for (y = 0; (y < img.h) && (png->res == FB_RTERROR_OK); y++, s += img.pitch) {
+		convert_row_rgba(&img, s, palette, row + 1, channels);
+		row[0] = 0;
+		png_write_data(png, row, img.w * channels + 1);
+	}
+
+	png_flush_block(png, TRUE);
+	png_write_chunk(png, "IEND", png->chunk, 0);
+
+	res = png->res;
+
+	free(png);
+	free(row);
+	if (paltmp) free(paltmp);
+
+	return res;
+}
+
 FBCALL int fb_GfxBsaveEx(FBSTRING *filename, void *src, unsigned int size, void *pal, int bitsperpixel)
 {
 	FILE *f;
@@ -242,6 +722,12 @@ FBCALL int fb_GfxBsaveEx(FBSTRING *filename, void *src, unsigned int size, void
 	p = strrchr(filename->data, '.');
 	if (p && (!strcasecmp(p + 1, "bmp"))) {
 		result = save_bmp(context, f, src, pal, bitsperpixel);
+	} else if (p && (!strcasecmp(p + 1, "png"))) {
+		result = save_png(context, f, src, pal);
+	} else if (p && (!strcasecmp(p + 1, "qoi"))) {
+		result = save_qoi(context, f, src, pal);
+	} else if (p && (!strcasecmp(p + 1, "ppm"))) {
+		result = save_ppm(context, f, src, pal);
 	} else {
 		if ((size == 0) && src) {
 			fclose(f);
@@ -15,10 +15,16 @@ static void draw_scanline(FB_GFXCTX *ctx, int y, int x1, int x2, unsigned int co
 			ctx->pixel_set(ctx->line[y] + (x1 * ctx->target_bpp), color, x2 - x1 + 1);
 		}
 		else {
-			if ((x1 >= ctx->view_x) && (x1 < ctx->view_x + ctx->view_w))
-				ctx->put_pixel(ctx, x1, y, color);
-			if ((x2 >= ctx->view_x) && (x2 < ctx->view_x + ctx->view_w))
-				ctx->put_pixel(ctx, x2, y, color);
+			int in1 = (x1 >= ctx->view_x) && (x1 < ctx->view_x + ctx->view_w);
+			int in2 = (x2 >= ctx->view_x) && (x2 < ctx->view_x + ctx->view_w);
+
+			/* both outline points in one run when visible */
+			if (in1 && in2)
+				fb_hGfxPixelRun(ctx, x1, y, x2 - x1, 0, (x2 != x1) ? 2 : 1, color, 0xFFFF, 0x8000);
+			else if (in1)
+				fb_hGfxPixelRun(ctx, x1, y, 0, 0, 1, color, 0xFFFF, 0x8000);
+			else if (in2)
+				fb_hGfxPixelRun(ctx, x2, y, 0, 0, 1, color, 0xFFFF, 0x8000);
 		}
 	}
 }
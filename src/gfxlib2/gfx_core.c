@@ -115,10 +115,12 @@ void fb_hSetPixelTransfer(FB_GFXCTX *context, unsigned int color)
 	if ((__fb_gfx->flags & ALPHA_PRIMITIVES) && (context->target_bpp == 4) && ((color & MASK_A_32) != MASK_A_32)) {
 		context->put_pixel = fb_hPutPixelAlpha;
 		context->pixel_set = fb_hPixelSetAlpha;
+		context->flags |= CTX_ALPHA_PIXELS;
 	}
 	else {
 		context->put_pixel = fb_hPutPixelSolid;
 		context->pixel_set = fb_hPixelSetSolid;
+		context->flags &= ~CTX_ALPHA_PIXELS;
 	}
 	context->get_pixel = fb_hGetPixel;
 }
@@ -4,11 +4,87 @@
 
 /* !!!FIXME!!! little-endian only */
 
+/* The 24/32-bit source conversions have SSSE3 (pshufb) versions, picked
+ * at runtime when the CPU supports them; the 8-bit ones are palette lookups
+ * and stay scalar */
+#if (defined HOST_X86 || defined HOST_X86_64) && !defined HOST_DOS && \
+    defined __GNUC__ && (__GNUC__ >= 5)
+	#define ENABLE_SSSE3_CONVERT
+	#include <tmmintrin.h>
+#endif
+
+#ifdef ENABLE_SSSE3_CONVERT
+static int has_ssse3 = -1;
+
+static int hHasSSSE3(void)
+{
+	if (has_ssse3 < 0)
+		has_ssse3 = __builtin_cpu_supports("ssse3") ? 1 : 0;
+	return has_ssse3;
+}
+
+/* Converts as many whole groups of 4 pixels as possible, using the given
+ * pshufb mask (-1 entries give 0, then alpha is OR'ed in); returns the
+ * number of pixels done, the caller does the remainder. Packed 24-bit
+ * sources load 16 bytes for every 12 used, so the last group is left to
+ * the scalar loop. */
+__attribute__((target("ssse3")))
+static int hConvertShuffle4(const unsigned char *src, unsigned char *dest, int w, int src_bytes, __m128i mask, __m128i alpha)
+{
+	int done = 0;
+	__m128i c;
+
+	if (src_bytes == 3)
+		w -= 2;
+
+	for (; done + 4 <= w; done += 4) {
+		c = _mm_loadu_si128((const __m128i *)src);
+		c = _mm_or_si128(_mm_shuffle_epi8(c, mask), alpha);
+		_mm_storeu_si128((__m128i *)dest, c);
+		src += src_bytes * 4;
+		dest += 16;
+	}
+
+	return done;
+}
+
+/* Same as hConvertShuffle4, but to 5-6-5 pixels: the mask must give
+ * 0x00RRGGBB in each 32-bit lane, which is then packed to 16 bits */
+__attribute__((target("ssse3")))
+static int hConvertShuffle4to16(const unsigned char *src, unsigned char *dest, int w, int src_bytes, __m128i mask)
+{
+	int done = 0;
+	const __m128i pack = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i mask_r = _mm_set1_epi32(0xF800);
+	const __m128i mask_g = _mm_set1_epi32(0x07E0);
+	const __m128i mask_b = _mm_set1_epi32(0x001F);
+	__m128i c, r, g, b;
+
+	if (src_bytes == 3)
+		w -= 2;
+
+	for (; done + 4 <= w; done += 4) {
+		c = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)src), mask);
+		r = _mm_and_si128(_mm_srli_epi32(c, 8), mask_r);
+		g = _mm_and_si128(_mm_srli_epi32(c, 5), mask_g);
+		b = _mm_and_si128(_mm_srli_epi32(c, 3), mask_b);
+		c = _mm_or_si128(_mm_or_si128(r, g), b);
+		_mm_storel_epi64((__m128i *)dest, _mm_shuffle_epi8(c, pack));
+		src += src_bytes * 4;
+		dest += 8;
+	}
+
+	return done;
+}
+#endif
+
 /* Caller is expected to hold FB_GRAPHICSLOCK() */
 void fb_image_convert_8to8(const unsigned char *src, unsigned char *dest, int w)
 {
+	const unsigned char mask = __fb_gfx->color_mask;
+
 	for (; w; w--)
-		*dest++ = *src++ & __fb_gfx->color_mask;
+		*dest++ = *src++ & mask;
 }
 
 /* Caller is expected to hold FB_GRAPHICSLOCK() */
@@ -16,11 +92,13 @@ void fb_image_convert_8to16(const unsigned char *src, unsigned char *dest, int w
 {
 	int r, g, b;
 	unsigned short *d = (unsigned short *)dest;
+	/* local copy of the pointer, so it isn't reloaded after every store */
+	const unsigned int *palette = __fb_gfx->device_palette;
 
 	for (; w; w--) {
-		r = __fb_gfx->device_palette[*src] & 0xFF;
-		g = (__fb_gfx->device_palette[*src] >> 8) & 0xFF;
-		b = (__fb_gfx->device_palette[*src] >> 16) & 0xFF;
+		r = palette[*src] & 0xFF;
+		g = (palette[*src] >> 8) & 0xFF;
+		b = (palette[*src] >> 16) & 0xFF;
 		*d++ = (b >> 3) | ((g << 3) & 0x07E0) | ((r << 8) & 0xF800);
 		src++;
 	}
@@ -31,11 +109,12 @@ void fb_image_convert_8to32(const unsigned char *src, unsigned char *dest, int w
 {
 	int r, g, b;
 	unsigned int *d = (unsigned int *)dest;
+	const unsigned int *palette = __fb_gfx->device_palette;
 
 	for (; w; w--) {
-		r = __fb_gfx->device_palette[*src] & 0xFF;
-		g = (__fb_gfx->device_palette[*src] >> 8) & 0xFF;
-		b = (__fb_gfx->device_palette[*src] >> 16) & 0xFF;
+		r = palette[*src] & 0xFF;
+		g = (palette[*src] >> 8) & 0xFF;
+		b = (palette[*src] >> 16) & 0xFF;
 		*d++ = 0xFF000000 | b | (g << 8) | (r << 16);
 		src++;
 	}
@@ -43,7 +122,19 @@ void fb_image_convert_8to32(const unsigned char *src, unsigned char *dest, int w
 
 void fb_image_convert_24to16(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned short *d = (unsigned short *)dest;
+	unsigned short *d;
+
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4to16(src, dest, w, 3,
+		                                _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+		src += done * 3;
+		dest += done * 2;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned short *)dest;
 	for (; w; w--) {
 		*d++ = (((unsigned short)src[0] << 8) & 0xF800) | (((unsigned short)src[1] << 3) & 0x07E0) | ((unsigned short)src[2] >> 3);
 		src += 3;
@@ -53,8 +144,20 @@ void fb_image_convert_24to16(const unsigned char *src, unsigned char *dest, int
 
 void fb_image_convert_24to32(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned int *d = (unsigned int *)dest;
+	unsigned int *d;
+
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4(src, dest, w, 3,
+		                            _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1),
+		                            _mm_set1_epi32(0xFF000000));
+		src += done * 3;
+		dest += done * 4;
+		w -= done;
+	}
+#endif
 
+	d = (unsigned int *)dest;
 	for (; w; w--) {
 		*d++ = 0xFF000000 | ((unsigned int)src[0] << 16) | ((unsigned int)src[1] << 8) | ((unsigned int)src[2]);
 		src += 3;
@@ -63,9 +166,21 @@ void fb_image_convert_24to32(const unsigned char *src, unsigned char *dest, int
 
 void fb_image_convert_32to16(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned short *d = (unsigned short *)dest;
+	unsigned short *d;
 	unsigned int c;
 
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4to16(src, dest, w, 4,
+		                                _mm_setr_epi8(2, 1, 0, -1, 6, 5, 4, -1, 10, 9, 8, -1, 14, 13, 12, -1));
+		src += done * 4;
+		dest += done * 2;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned short *)dest;
+
 	for (; w; w--)
 	{
 		c = *(unsigned int *)src & 0x00FFFFFF;
@@ -76,20 +191,44 @@ void fb_image_convert_32to16(const unsigned char *src, unsigned char *dest, int
 
 void fb_image_convert_32to32(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned int *d = (unsigned int *)dest;
+	unsigned int *d;
 	unsigned int c;
 
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4(src, dest, w, 4,
+		                            _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15),
+		                            _mm_setzero_si128());
+		src += done * 4;
+		dest += done * 4;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned int *)dest;
 	for (; w; w--)
 	{
 		c = *(unsigned int *)src;
-		*d++ = (c >> 16) | (c & 0xFF00FF00) | (c << 16);
+		*d++ = ((c >> 16) & 0xFF) | (c & 0xFF00FF00) | ((c & 0xFF) << 16);
 		src += sizeof( unsigned int );
 	}
 }
 
 void fb_image_convert_24bgrto16(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned short *d = (unsigned short *)dest;
+	unsigned short *d;
+
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4to16(src, dest, w, 3,
+		                                _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+		src += done * 3;
+		dest += done * 2;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned short *)dest;
 	for (; w; w--) {
 		*d++ = ((unsigned short)src[0] >> 3) | (((unsigned short)src[1] << 3) & 0x07E0) | (((unsigned short)src[2] << 8) & 0xF800);
 		src += 3;
@@ -98,18 +237,44 @@ void fb_image_convert_24bgrto16(const unsigned char *src, unsigned char *dest, i
 
 void fb_image_convert_24bgrto32(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned int *d = (unsigned int *)dest;
+	unsigned int *d;
 
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4(src, dest, w, 3,
+		                            _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1),
+		                            _mm_set1_epi32(0xFF000000));
+		src += done * 3;
+		dest += done * 4;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned int *)dest;
 	for (; w; w--) {
-		*d++ = 0xFF000000 | (*(unsigned int *)src & 0xFFFFFF);
+		/* not a 32-bit load, that would read past the last pixel */
+		*d++ = 0xFF000000 | ((unsigned int)src[2] << 16) | ((unsigned int)src[1] << 8) | ((unsigned int)src[0]);
 		src += 3;
 	}
 }
 
 void fb_image_convert_32bgrto16(const unsigned char *src, unsigned char *dest, int w)
 {
-	unsigned short *d = (unsigned short *)dest;
-	const unsigned int *s = (const unsigned int *)src;
+	unsigned short *d;
+	const unsigned int *s;
+
+#ifdef ENABLE_SSSE3_CONVERT
+	if (hHasSSSE3()) {
+		int done = hConvertShuffle4to16(src, dest, w, 4,
+		                                _mm_setr_epi8(0, 1, 2, -1, 4, 5, 6, -1, 8, 9, 10, -1, 12, 13, 14, -1));
+		src += done * 4;
+		dest += done * 2;
+		w -= done;
+	}
+#endif
+
+	d = (unsigned short *)dest;
+	s = (const unsigned int *)src;
 
 	for (; w; w--) {
 		*d++ = (unsigned short)(((*s & 0xFF) >> 3) | ((*s >> 5) & 0x07E0) | ((*s >> 8) & 0xF800));
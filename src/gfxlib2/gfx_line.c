@@ -11,11 +11,144 @@ static int reverse_mask(int mask)
 	return mask;
 }
 
+/* Direct-to-buffer pixel writers, one per target bpp plus blended 32bpp.
+ * These replace the per pixel context->put_pixel() calls (which recompute
+ * the line address every time) in the inner loops below. */
+
+static inline void plot_1(unsigned char *d, unsigned int color)
+{
+	*d = color;
+}
+
+static inline void plot_2(unsigned char *d, unsigned int color)
+{
+	*(unsigned short *)d = color;
+}
+
+static inline void plot_4(unsigned char *d, unsigned int color)
+{
+	*(unsigned int *)d = color;
+}
+
+static inline void plot_4a(unsigned char *d, unsigned int color)
+{
+	unsigned int dc, srb, sg, drb, dg, a;
+
+	dc = *(unsigned int *)d;
+	a = color >> 24;
+	srb = color & MASK_RB_32;
+	sg = color & MASK_G_32;
+	drb = dc & MASK_RB_32;
+	dg = dc & MASK_G_32;
+	srb = ((srb - drb) * a) >> 8;
+	sg = ((sg - dg) * a) >> 8;
+	*(unsigned int *)d = ((drb + srb) & MASK_RB_32) | ((dg + sg) & MASK_G_32) | (color & MASK_A_32);
+}
+
+/* Plots count pixels starting at d, advancing by step bytes each time */
+#define DEFINE_PIXEL_RUN(bpp)	\
+static int pixel_run_##bpp(unsigned char *d, ssize_t step, int count, unsigned int color, unsigned int style, int bit) \
+{ \
+	if (style == 0xFFFF) { \
+		for (; count; count--, d += step) \
+			plot_##bpp(d, color); \
+	} else { \
+		for (; count; count--, d += step) { \
+			if (style & bit) \
+				plot_##bpp(d, color); \
+			RORW1(bit); \
+		} \
+	} \
+	return bit; \
+}
+
+/* Bresenham inner loops; same stepping and termination as the generic
+ * x/y version, but walking a pointer (x and y are only kept for the end
+ * condition). */
+#define DEFINE_LINE_RUN(bpp)	\
+static void line_run_##bpp(unsigned char *d, ssize_t step_x, ssize_t step_y, int x, int y, int x2, int y2, int ax, int ay, int e, int dx, int dy, unsigned int color, unsigned int style, int bit) \
+{ \
+	if (dx >= dy) { \
+		while ((x != x2) && (y != y2)) { \
+			if (style & bit) \
+				plot_##bpp(d, color); \
+			RORW1(bit); \
+			if (e >= 0) { \
+				y += ay; \
+				d += step_y; \
+				e -= dx; \
+			} \
+			e += dy; \
+			x += ax; \
+			d += step_x; \
+		} \
+	} else { \
+		while ((y != y2) && (x != x2)) { \
+			if (style & bit) \
+				plot_##bpp(d, color); \
+			RORW1(bit); \
+			if (e <= 0) { \
+				x += ax; \
+				d += step_x; \
+				e += dy; \
+			} \
+			e -= dx; \
+			y += ay; \
+			d += step_y; \
+		} \
+	} \
+}
+
+DEFINE_PIXEL_RUN(1)
+DEFINE_PIXEL_RUN(2)
+DEFINE_PIXEL_RUN(4)
+DEFINE_PIXEL_RUN(4a)
+
+DEFINE_LINE_RUN(1)
+DEFINE_LINE_RUN(2)
+DEFINE_LINE_RUN(4)
+DEFINE_LINE_RUN(4a)
+
+typedef int (*PIXEL_RUN)(unsigned char *d, ssize_t step, int count, unsigned int color, unsigned int style, int bit);
+typedef void (*LINE_RUN)(unsigned char *d, ssize_t step_x, ssize_t step_y, int x, int y, int x2, int y2, int ax, int ay, int e, int dx, int dy, unsigned int color, unsigned int style, int bit);
+
+static const PIXEL_RUN pixel_run[4] = { pixel_run_1, pixel_run_2, pixel_run_4, pixel_run_4a };
+static const LINE_RUN line_run[4] = { line_run_1, line_run_2, line_run_4, line_run_4a };
+
+/* index into the tables above matching the current context->put_pixel */
+static int pixel_kind(FB_GFXCTX *context)
+{
+	if (context->flags & CTX_ALPHA_PIXELS)
+		return 3;
+
+	switch (context->target_bpp) {
+		case 1:  return 0;
+		case 2:  return 1;
+		default: return 2;
+	}
+}
+
+/* Plots count pixels starting at physical x, y and advancing by step_x,
+ * step_y after each one; all of them must lie inside the view.
+ * Returns the style bit to use for the next pixel.
+ * Caller is expected to hold FB_GRAPHICSLOCK() and DRIVER_LOCK() */
+int fb_hGfxPixelRun(FB_GFXCTX *context, int x, int y, int step_x, int step_y, int count, unsigned int color, unsigned int style, int bit)
+{
+	ssize_t step;
+
+	if (count <= 0)
+		return bit;
+
+	step = ((ssize_t)step_y * context->target_pitch) + (step_x * context->target_bpp);
+
+	return pixel_run[pixel_kind(context)](context->line[y] + (x * context->target_bpp), step, count, color, style, bit);
+}
+
 /* Assumes coordinates to be physical ones.
  * Also assumes color is already masked. */
 
-/* Caller is expected to hold FB_GRAPHICSLOCK() */
-void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned int color, unsigned int style)
+/* Caller is expected to hold FB_GRAPHICSLOCK() and DRIVER_LOCK() */
+void fb_hGfxDrawLine_NoLock(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned int color, unsigned int style)
 {
 	int x, y, d, dx, dy, ax, ay, skip, rot, bit;
 	int xmin = context->view_x, xmax = context->view_x + context->view_w - 1;
@@ -41,7 +174,6 @@ void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned
 
 	rot = 0;
 
-	DRIVER_LOCK();
 	/* vertical line */
 	if (dx == 0) {
 		/* clip y1 */
@@ -60,11 +192,7 @@ void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned
 		}
 		bit = 0x8000 >> (rot & 0xF);
 
-		for (y = y1; y <= y2; y++) {
-			if (style & bit)
-				context->put_pixel(context, x1, y, color);
-			RORW1(bit);
-		}
+		fb_hGfxPixelRun(context, x1, y1, 0, 1, y2 - y1 + 1, color, style, bit);
 	}
 	/* horizontal line */
 	else if (dy == 0) {
@@ -85,14 +213,9 @@ void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned
 		bit = 0x8000 >> (rot & 0xF );
 
 		if (style == 0xFFFF)
-			context->pixel_set(context->line[y1] + (x1 * __fb_gfx->bpp), color, x2 - x1 + 1);
-		else {
-			for (x = x1; x <= x2; x++) {
-				if (style & bit)
-					context->put_pixel(context, x, y1, color);
-				RORW1(bit);
-			}
-		}
+			context->pixel_set(context->line[y1] + (x1 * context->target_bpp), color, x2 - x1 + 1);
+		else
+			fb_hGfxPixelRun(context, x1, y1, 1, 0, x2 - x1 + 1, color, style, bit);
 	/* diagonal line */
 	} else {
 		ax = ay = 1;
@@ -134,30 +257,16 @@ void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned
 				y += ay * skip;
 				d -= skip * dx;
 				if ((y < ymin) || (y > ymax))
-					goto done;
+					return;
 			} else if (d < (dy - dx)) {
 				skip = ((dy - dx) - d) / dy + 1;
 				x += ax * skip;
 				d += skip * dy;
 				rot += skip;
 				if ((x < xmin) || (x > xmax))
-					goto done;
-			}
-			bit = 0x8000 >> (rot & 0xF);
-			y1 = y; /* first dirty row */
-
-			while ((x != x2) && (y != y2)) {
-				if (style & bit)
-					context->put_pixel(context, x, y, color);
-				RORW1(bit);
-				if (d >= 0) {
-					y += ay;
-					d -= dx;
-				}
-				d += dy;
-				x += ax;
-				/* invariant: (-dx + dy) <= d < dy */
+					return;
 			}
+			/* invariant: (-dx + dy) <= d < dy */
 		/* steep gradient */
 		} else {
 			/* put x, y back on the line if clipped */
@@ -166,37 +275,36 @@ void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned
 				x += ax * skip;
 				d += skip * dy;
 				if ((x < xmin) || (x > xmax))
-					goto done;
+					return;
 			} else if (d > dy - dx) {
 				skip = (d - (dy - dx)) / dx + 1;
 				y += ay * skip;
 				d -= skip * dx;
 				rot += skip;
 				if ((y < ymin) || (y > ymax))
-					goto done;
-			}
-			bit = 0x8000 >> (rot & 0xF);
-			y1 = y; /* first dirty row */
-
-			while ((y != y2) && (x != x2)) {
-				if (style & bit)
-					context->put_pixel(context, x, y, color);
-				RORW1(bit);
-				if (d <= 0) {
-					x += ax;
-					d += dy;
-				}
-				d -= dx;
-				y += ay;
-				/* invariant: (-dx) <= d < (-dx + dy) */
+					return;
 			}
+			/* invariant: (-dx) <= d < (-dx + dy) */
 		}
+		bit = 0x8000 >> (rot & 0xF);
+		y1 = y; /* first dirty row */
+
+		line_run[pixel_kind(context)](context->line[y] + (x * context->target_bpp),
+		                              ax * context->target_bpp, (ssize_t)ay * context->target_pitch,
+		                              x, y, x2, y2, ax, ay, d, dx, dy, color, style, bit);
+
 		y2 -= ay; /* last dirty row */
 	}
 	if (y1 > y2)
 		SWAP(y1, y2);
 	SET_DIRTY(context, y1, y2 - y1 + 1);
-	done:
+}
+
+/* Caller is expected to hold FB_GRAPHICSLOCK() */
+void fb_GfxDrawLine(FB_GFXCTX *context, int x1, int y1, int x2, int y2, unsigned int color, unsigned int style)
+{
+	DRIVER_LOCK();
+	fb_hGfxDrawLine_NoLock(context, x1, y1, x2, y2, color, style);
 	DRIVER_UNLOCK();
 }
 
@@ -0,0 +1,78 @@
+/* batched line drawing: polylines and independent segments */
+
+#include "fb_gfx.h"
+
+/* Draws count lines from coords[]; with is_strip each line starts where the
+ * previous one ended (coords holds count + 1 points), otherwise every line
+ * has its own pair of points (coords holds 2 * count points).
+ * All lines are drawn under a single graphics and driver lock. */
+static void hDrawLines(void *target, const float *coords, ssize_t count, unsigned int color, unsigned int style, int flags, int is_strip)
+{
+	FB_GFXCTX *context;
+	float fx1, fy1, fx2 = 0.0, fy2 = 0.0;
+	int x1, y1, x2 = 0, y2 = 0;
+
+	if ((coords == NULL) || (count <= 0))
+		return;
+
+	FB_GRAPHICS_LOCK( );
+
+	if (!__fb_gfx) {
+		FB_GRAPHICS_UNLOCK( );
+		return;
+	}
+
+	context = fb_hGetContext( );
+	fb_hPrepareTarget(context, target);
+
+	if (flags & DEFAULT_COLOR_1)
+		color = context->fg_color;
+	else
+		color = fb_hFixColor(context->target_bpp, color);
+
+	fb_hSetPixelTransfer(context, color);
+
+	style &= 0xFFFF;
+
+	DRIVER_LOCK();
+
+	if (is_strip) {
+		fx2 = *coords++;
+		fy2 = *coords++;
+		fb_hTranslateCoord(context, fx2, fy2, &x2, &y2);
+	}
+
+	for (; count; count--) {
+		if (is_strip) {
+			x1 = x2;
+			y1 = y2;
+		} else {
+			fx1 = *coords++;
+			fy1 = *coords++;
+			fb_hTranslateCoord(context, fx1, fy1, &x1, &y1);
+		}
+		fx2 = *coords++;
+		fy2 = *coords++;
+		fb_hTranslateCoord(context, fx2, fy2, &x2, &y2);
+
+		fb_hGfxDrawLine_NoLock(context, x1, y1, x2, y2, color, style);
+	}
+
+	/* graphics cursor ends on the last point drawn, as with LINE */
+	context->last_x = fx2;
+	context->last_y = fy2;
+
+	DRIVER_UNLOCK();
+	FB_GRAPHICS_UNLOCK( );
+}
+
+FBCALL void fb_GfxPolyLine(void *target, const float *coords, ssize_t count, unsigned int color, unsigned int style, int flags)
+{
+	/* count points make count - 1 connected lines */
+	hDrawLines(target, coords, count - 1, color, style, flags, TRUE);
+}
+
+FBCALL void fb_GfxLineSegments(void *target, const float *coords, ssize_t count, unsigned int color, unsigned int style, int flags)
+{
+	hDrawLines(target, coords, count, color, style, flags, FALSE);
+}
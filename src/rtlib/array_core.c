@@ -41,3 +41,67 @@ ssize_t fb_hArrayCalcDiff
 
 	return -diff;
 }
+
+/* Bytes allocated at array->ptr; more than array->size only if storage
+   was reserved ahead, see fb_hArraySetCapacity() */
+size_t fb_hArrayCapacity( const FBARRAY *array )
+{
+	size_t shift = (array->flags & FBARRAY_FLAGS_CAPACITY) >> FBARRAY_FLAGS_CAPACITY_SHIFT;
+
+	if( shift == 0 )
+		return array->size;
+
+	return (size_t)1 << shift;
+}
+
+/* Reallocates the storage to hold exactly size bytes if capacity is 0,
+   otherwise the larger of size and capacity, rounded up to a power of two
+   (only its log2 fits in the descriptor flags). array->data is moved along;
+   array->size is left to the caller. */
+int fb_hArraySetCapacity( FBARRAY *array, size_t size, size_t capacity )
+{
+	size_t shift = 0;
+	size_t i;
+	ssize_t diff;
+	void *reallocTemp;
+
+	if( capacity != 0 ) {
+		if( capacity < size )
+			capacity = size;
+		while( ((size_t)1 << shift) < capacity )
+			++shift;
+		capacity = (size_t)1 << shift;
+	} else {
+		capacity = size;
+	}
+
+	if( capacity == 0 ) {
+		/* nothing allocated and nothing to reserve */
+		return fb_ErrorSetNum( FB_RTERROR_OK );
+	}
+
+	/* offset of data into the block, from the bounds rather than from
+	   the old pointer (gcc sinks data - ptr below the realloc() and then
+	   warns about a use after free) */
+	diff = 0;
+	if( array->data != NULL ) {
+		for( i = 0; i < array->dimensions; i++ )
+			diff = diff * (ssize_t)array->dimTB[i].elements + array->dimTB[i].lbound;
+		diff = -diff * (ssize_t)array->element_len;
+	}
+
+	reallocTemp = realloc( array->ptr, capacity );
+	if( reallocTemp == NULL )
+		return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+
+	/* unallocated arrays keep data = NULL, so they still look unallocated
+	   to LBOUND/UBOUND until the first REDIM PRESERVE */
+	if( array->data != NULL )
+		array->data = ((unsigned char *)reallocTemp) + diff;
+	array->ptr = reallocTemp;
+
+	array->flags = (array->flags & ~FBARRAY_FLAGS_CAPACITY) |
+	               (shift << FBARRAY_FLAGS_CAPACITY_SHIFT);
+
+	return fb_ErrorSetNum( FB_RTERROR_OK );
+}
@@ -14,13 +14,12 @@ int fb_hArrayRealloc
 		va_list ap
 	)
 {
-	size_t i, elements, size;
+	size_t i, elements, size, capacity;
 	ssize_t diff;
     FBARRAYDIM *dim;
 	ssize_t lbTB[FB_MAXDIMENSIONS];
 	ssize_t ubTB[FB_MAXDIMENSIONS];
 	unsigned char *this_;
-	void *reallocTemp;
 
 	/* ditto, see fb_hArrayAlloc() */
 	if( (dimensions != array->dimensions) && (array->dimensions != 0) )
@@ -52,12 +51,29 @@ int fb_hArrayRealloc
     diff = fb_hArrayCalcDiff( dimensions, &lbTB[0], &ubTB[0] ) * element_len;
     size = elements * element_len;
 
-	/* realloc */
-    reallocTemp = realloc( array->ptr, size );
-    if( reallocTemp == NULL )
-        return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+	/* realloc, unless the storage reserved ahead already fits */
+	capacity = fb_hArrayCapacity( array );
+	if( size > capacity ) {
+		/* Growing by less than double (the REDIM PRESERVE a(UBOUND(a)+1)
+		   append pattern): leave room up to the next power of two, so
+		   appending n elements only reallocs O(log n) times */
+		if( (size - capacity) < capacity ) {
+			if( fb_hArraySetCapacity( array, size, size ) != FB_RTERROR_OK ) {
+				/* retry without the extra room */
+				if( fb_hArraySetCapacity( array, size, 0 ) != FB_RTERROR_OK )
+					return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+			}
+		} else if( fb_hArraySetCapacity( array, size, 0 ) != FB_RTERROR_OK ) {
+			return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+		}
+	} else if( (size < array->size) &&
+	           ((capacity == array->size) || (size < (capacity >> 2))) ) {
+		/* Shrinking without room reserved, or to less than a quarter of
+		   it: give the memory back */
+		if( fb_hArraySetCapacity( array, size, 0 ) != FB_RTERROR_OK )
+			return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+	}
 
-    array->ptr = reallocTemp;
     /* Have remainder? */
     if( size > array->size ) {
         /* Construct or clear new array elements: */
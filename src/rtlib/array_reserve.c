@@ -0,0 +1,37 @@
+/* reserve storage ahead of REDIM PRESERVE, and release it again */
+
+#include "fb.h"
+
+FBCALL int fb_ArrayReserve( FBARRAY *array, size_t elements )
+{
+	/* only dynamic arrays own their memory */
+	if( (array->flags & FBARRAY_FLAGS_FIXED_LEN) || (array->element_len == 0) )
+		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
+
+	if( elements > SIZE_MAX / array->element_len )
+		return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+
+	/* never shrinks, only the logical size (the bounds) does that */
+	if( (elements * array->element_len) <= fb_hArrayCapacity( array ) )
+		return fb_ErrorSetNum( FB_RTERROR_OK );
+
+	return fb_hArraySetCapacity( array, array->size, elements * array->element_len );
+}
+
+FBCALL int fb_ArrayShrink( FBARRAY *array )
+{
+	if( array->flags & FBARRAY_FLAGS_FIXED_LEN )
+		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
+
+	if( fb_hArrayCapacity( array ) == array->size )
+		return fb_ErrorSetNum( FB_RTERROR_OK );
+
+	/* unallocated but reserved? just free it */
+	if( array->size == 0 ) {
+		free( array->ptr );
+		fb_ArrayResetDesc( array );
+		return fb_ErrorSetNum( FB_RTERROR_OK );
+	}
+
+	return fb_hArraySetCapacity( array, array->size, 0 );
+}
@@ -0,0 +1,22 @@
+/* READ array() */
+
+#include "fb.h"
+
+FBCALL void fb_DataReadArray( FBARRAY *array, int type )
+{
+	FB_DATACTX ctx;
+
+	FB_LOCK();
+
+	/* the global cursor never points into a typed table, those are only
+	   read through fb_DataTbl*() */
+	ctx.ptr = __fb_data_ptr;
+	ctx.index = 0;
+	ctx.started = TRUE;
+
+	fb_hDataReadArray( &ctx, array, type );
+
+	__fb_data_ptr = ctx.ptr;
+
+	FB_UNLOCK();
+}
@@ -0,0 +1,316 @@
+/* DATA with typed tables and a per-thread read cursor (fbc -z typed-data)
+
+   READ of a value from a typed table is a load from an array, instead of a
+   conversion from its text form, and as every thread has its own cursor it
+   doesn't need the global lock. Each thread starts reading at the first DATA,
+   and RESTORE only moves the cursor of the thread calling it. */
+
+#include "fb.h"
+
+/* the first DATA, set by the main module's initialization */
+static FB_DATADESC *data_start = NULL;
+
+static void hSkipLinks( FB_DATACTX *ctx )
+{
+	while( ctx->ptr && (ctx->ptr->len == FB_DATATYPE_LINK) )
+		ctx->ptr = ctx->ptr->next;
+}
+
+static FB_DATACTX *hGetCtx( void )
+{
+	FB_DATACTX *ctx = FB_TLSGETCTX( DATA );
+
+	if( !ctx->started ) {
+		ctx->started = TRUE;
+		ctx->ptr = data_start;
+		ctx->index = 0;
+		hSkipLinks( ctx );
+	}
+
+	return ctx;
+}
+
+void fb_hDataNext( FB_DATACTX *ctx )
+{
+	if( ctx->ptr == NULL )
+		return;
+
+	if( FB_DATA_ISTABLE( ctx->ptr ) ) {
+		ctx->index += 1;
+		if( ctx->index < FB_DATA_TABLECOUNT( ctx->ptr ) )
+			return;
+
+		/* skip the table and the count */
+		ctx->index = 0;
+		ctx->ptr += 2;
+	} else {
+		ctx->ptr += 1;
+	}
+
+	hSkipLinks( ctx );
+}
+
+static void hStoreLongint( void *dst, int type, long long value )
+{
+	switch( type ) {
+	case FB_DATAELM_BOOL:     *(char *)dst = (value != 0); break;
+	case FB_DATAELM_BYTE:     *(char *)dst = value; break;
+	case FB_DATAELM_UBYTE:    *(unsigned char *)dst = value; break;
+	case FB_DATAELM_SHORT:    *(short *)dst = value; break;
+	case FB_DATAELM_USHORT:   *(unsigned short *)dst = value; break;
+	case FB_DATAELM_INT:      *(int *)dst = value; break;
+	case FB_DATAELM_UINT:     *(unsigned int *)dst = value; break;
+	case FB_DATAELM_LONGINT:  *(long long *)dst = value; break;
+	case FB_DATAELM_ULONGINT: *(unsigned long long *)dst = value; break;
+	case FB_DATAELM_SINGLE:   *(float *)dst = value; break;
+	case FB_DATAELM_DOUBLE:   *(double *)dst = value; break;
+	}
+}
+
+static void hStoreDouble( void *dst, int type, double value )
+{
+	switch( type ) {
+	case FB_DATAELM_BOOL:
+		*(char *)dst = (value != 0.0);
+		break;
+	case FB_DATAELM_SINGLE:
+		*(float *)dst = value;
+		break;
+	case FB_DATAELM_DOUBLE:
+		*(double *)dst = value;
+		break;
+	default:
+		/* fbc only puts numbers without exponent into typed tables, so
+		   this gives the same as the text conversion, which stops at the
+		   decimal point */
+		hStoreLongint( dst, type, (long long)value );
+		break;
+	}
+}
+
+/* same conversions as the fb_DataRead*() functions */
+static void hStoreText( void *dst, int type, FB_DATADESC *desc )
+{
+	char *zstr = desc->zstr;
+	FB_WCHAR *wstr = desc->wstr;
+	ssize_t len = desc->len & 0x7FFF;
+
+	if( desc->len & FB_DATATYPE_WSTR ) {
+		switch( type ) {
+		case FB_DATAELM_BOOL:     *(char *)dst = fb_WstrToBool( wstr, len ); break;
+		case FB_DATAELM_BYTE:
+		case FB_DATAELM_SHORT:
+		case FB_DATAELM_INT:      hStoreLongint( dst, type, fb_WstrToInt( wstr, len ) ); break;
+		case FB_DATAELM_UBYTE:
+		case FB_DATAELM_USHORT:
+		case FB_DATAELM_UINT:     hStoreLongint( dst, type, fb_WstrToUInt( wstr, len ) ); break;
+		case FB_DATAELM_LONGINT:  *(long long *)dst = fb_WstrToLongint( wstr, len ); break;
+		case FB_DATAELM_ULONGINT: *(unsigned long long *)dst = fb_WstrToULongint( wstr, len ); break;
+		case FB_DATAELM_SINGLE:   *(float *)dst = fb_WstrToDouble( wstr, len ); break;
+		case FB_DATAELM_DOUBLE:   *(double *)dst = fb_WstrToDouble( wstr, len ); break;
+		}
+	} else {
+		switch( type ) {
+		case FB_DATAELM_BOOL:     *(char *)dst = fb_hStr2Bool( zstr, len ); break;
+		case FB_DATAELM_BYTE:
+		case FB_DATAELM_SHORT:
+		case FB_DATAELM_INT:      hStoreLongint( dst, type, fb_hStr2Int( zstr, len ) ); break;
+		case FB_DATAELM_UBYTE:
+		case FB_DATAELM_USHORT:
+		case FB_DATAELM_UINT:     hStoreLongint( dst, type, fb_hStr2UInt( zstr, len ) ); break;
+		case FB_DATAELM_LONGINT:  *(long long *)dst = fb_hStr2Longint( zstr, len ); break;
+		case FB_DATAELM_ULONGINT: *(unsigned long long *)dst = fb_hStr2ULongint( zstr, len ); break;
+		case FB_DATAELM_SINGLE:   *(float *)dst = fb_hStr2Double( zstr, len ); break;
+		case FB_DATAELM_DOUBLE:   *(double *)dst = fb_hStr2Double( zstr, len ); break;
+		}
+	}
+}
+
+/* read a number into dst and move to the next value */
+void fb_hDataRead( FB_DATACTX *ctx, void *dst, int type )
+{
+	FB_DATADESC *desc = ctx->ptr;
+
+	if( desc == NULL ) {
+		/* no more DATA */
+		hStoreLongint( dst, type, 0 );
+		return;
+	}
+
+	switch( desc->len ) {
+	case FB_DATATYPE_TABLE_LONG:
+		hStoreLongint( dst, type, ((int *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_TABLE_LONGINT:
+		hStoreLongint( dst, type, ((long long *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_TABLE_DOUBLE:
+		hStoreDouble( dst, type, ((double *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_OFS:
+		hStoreLongint( dst, type, (size_t)desc->ofs );
+		break;
+	default:
+		hStoreText( dst, type, desc );
+		break;
+	}
+
+	fb_hDataNext( ctx );
+}
+
+static void hReadStr( FB_DATACTX *ctx, void *dst, ssize_t dst_size, int fillrem )
+{
+	FB_DATADESC *desc = ctx->ptr;
+
+	if( desc == NULL ) {
+		/* no more DATA, return empty string */
+		fb_StrAssign( dst, dst_size, "", 0, fillrem );
+		return;
+	}
+
+	switch( desc->len ) {
+	case FB_DATATYPE_TABLE_LONG:
+		fb_StrAssign( dst, dst_size, fb_LongintToStr( ((int *)desc->ofs)[ctx->index] ), -1, fillrem );
+		break;
+	case FB_DATATYPE_TABLE_LONGINT:
+		fb_StrAssign( dst, dst_size, fb_LongintToStr( ((long long *)desc->ofs)[ctx->index] ), -1, fillrem );
+		break;
+	case FB_DATATYPE_TABLE_DOUBLE:
+		/* the same text as the DATA had, fbc only uses typed tables for
+		   numbers that STR() gives back unchanged */
+		fb_StrAssign( dst, dst_size, fb_DoubleToStr( ((double *)desc->ofs)[ctx->index] ), -1, fillrem );
+		break;
+	case FB_DATATYPE_OFS:
+		/* !!!WRITEME!!! */
+		break;
+	default:
+		if( desc->len & FB_DATATYPE_WSTR )
+			fb_WstrAssignToA( dst, dst_size, desc->wstr, fillrem );
+		else
+			fb_StrAssign( dst, dst_size, desc->zstr, 0, fillrem );
+		break;
+	}
+
+	fb_hDataNext( ctx );
+}
+
+/* READ array(): all elements, in memory order */
+void fb_hDataReadArray( FB_DATACTX *ctx, FBARRAY *array, int type )
+{
+	char *dst, *limit;
+	ssize_t count, left;
+	size_t len;
+
+	if( (array == NULL) || (array->ptr == NULL) || (array->element_len == 0) )
+		return;
+
+	len = array->element_len;
+	dst = (char *)array->ptr;
+	limit = dst + array->size;
+
+	if( type == FB_DATAELM_STRING ) {
+		for( ; dst < limit; dst += len )
+			hReadStr( ctx, dst, -1, FALSE );
+		return;
+	}
+
+	while( dst < limit ) {
+		/* same type as the array: copy the rest of the table at once */
+		if( (ctx->ptr != NULL) &&
+		    (((ctx->ptr->len == FB_DATATYPE_TABLE_LONG) && (len == sizeof( int )) &&
+		      ((type == FB_DATAELM_INT) || (type == FB_DATAELM_UINT))) ||
+		     ((ctx->ptr->len == FB_DATATYPE_TABLE_LONGINT) && (len == sizeof( long long )) &&
+		      ((type == FB_DATAELM_LONGINT) || (type == FB_DATAELM_ULONGINT))) ||
+		     ((ctx->ptr->len == FB_DATATYPE_TABLE_DOUBLE) && (type == FB_DATAELM_DOUBLE))) ) {
+			left = FB_DATA_TABLECOUNT( ctx->ptr ) - ctx->index;
+			count = (limit - dst) / len;
+			if( count > left )
+				count = left;
+
+			memcpy( dst, (char *)ctx->ptr->ofs + ctx->index * len, count * len );
+			dst += count * len;
+
+			/* move to the last one copied, and past it */
+			ctx->index += count - 1;
+			fb_hDataNext( ctx );
+			continue;
+		}
+
+		fb_hDataRead( ctx, dst, type );
+		dst += len;
+	}
+}
+
+/* called by the main module's initialization instead of the first
+   fb_DataTblRestore(); module constructors may have done a RESTORE already */
+FBCALL void fb_DataTblStart( FB_DATADESC *labeladdr )
+{
+	data_start = labeladdr;
+	fb_DataTblRestore( labeladdr );
+}
+
+FBCALL void fb_DataTblRestore( FB_DATADESC *labeladdr )
+{
+	FB_DATACTX *ctx = FB_TLSGETCTX( DATA );
+
+	ctx->started = TRUE;
+	ctx->ptr = labeladdr;
+	ctx->index = 0;
+	hSkipLinks( ctx );
+}
+
+FBCALL void fb_DataTblRead( void *dst, int type )
+{
+	fb_hDataRead( hGetCtx( ), dst, type );
+}
+
+FBCALL void fb_DataTblReadStr( void *dst, ssize_t dst_size, int fillrem )
+{
+	hReadStr( hGetCtx( ), dst, dst_size, fillrem );
+}
+
+FBCALL void fb_DataTblReadWstr( FB_WCHAR *dst, ssize_t dst_size )
+{
+	FB_DATACTX *ctx = hGetCtx( );
+	FB_DATADESC *desc = ctx->ptr;
+	FB_WCHAR *tmp = NULL;
+
+	if( desc == NULL ) {
+		/* no more DATA, return empty string */
+		fb_WstrAssign( dst, dst_size, _LC("") );
+		return;
+	}
+
+	switch( desc->len ) {
+	case FB_DATATYPE_TABLE_LONG:
+		tmp = fb_LongintToWstr( ((int *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_TABLE_LONGINT:
+		tmp = fb_LongintToWstr( ((long long *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_TABLE_DOUBLE:
+		tmp = fb_DoubleToWstr( ((double *)desc->ofs)[ctx->index] );
+		break;
+	case FB_DATATYPE_OFS:
+		/* !!!WRITEME!!! */
+		break;
+	default:
+		if( desc->len & FB_DATATYPE_WSTR )
+			fb_WstrAssign( dst, dst_size, desc->wstr );
+		else
+			fb_WstrAssignFromA( dst, dst_size, desc->zstr, desc->len );
+		break;
+	}
+
+	if( tmp != NULL ) {
+		fb_WstrAssign( dst, dst_size, tmp );
+		fb_WstrDelete( tmp );
+	}
+
+	fb_hDataNext( ctx );
+}
+
+FBCALL void fb_DataTblReadArray( FBARRAY *array, int type )
+{
+	fb_hDataReadArray( hGetCtx( ), array, type );
+}
@@ -0,0 +1,17 @@
+/* UTF-encoded file device close */
+
+#include "fb.h"
+
+int fb_DevFileCloseEncod( FB_FILE *handle )
+{
+	FB_LOCK();
+
+	if( handle->decode != NULL ) {
+		free( handle->decode );
+		handle->decode = NULL;
+	}
+
+	FB_UNLOCK();
+
+	return fb_DevFileClose( handle );
+}
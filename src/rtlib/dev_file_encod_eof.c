@@ -0,0 +1,22 @@
+/* detects EOF for UTF-encoded file devices */
+
+#include "fb.h"
+
+int fb_DevFileEofEncod( FB_FILE *handle )
+{
+	FB_FILE_DECODE *buf;
+	int eof;
+
+	FB_LOCK();
+
+	/* bytes read ahead, but not decoded yet? */
+	buf = handle->decode;
+	if( (buf != NULL) && !buf->detached && (buf->pos < buf->len) )
+		eof = FB_FALSE;
+	else
+		eof = fb_DevFileEof( handle );
+
+	FB_UNLOCK();
+
+	return eof;
+}
@@ -3,10 +3,10 @@
 #include "fb.h"
 
 static FB_FILE_HOOKS hooks_dev_file = {
-    fb_DevFileEof,
-    fb_DevFileClose,
-    fb_DevFileSeek,
-    fb_DevFileTell,
+    fb_DevFileEofEncod,
+    fb_DevFileCloseEncod,
+    fb_DevFileSeekEncod,
+    fb_DevFileTellEncod,
     fb_DevFileReadEncod,
     fb_DevFileReadEncodWstr,
     fb_DevFileWriteEncod,
@@ -188,6 +188,17 @@ int fb_DevFileOpenEncod
         return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
 	}
 
+    /* decode buffer */
+    if( handle->mode == FB_FILE_MODE_INPUT )
+    {
+        if( !fb_hFileDecodeInit( handle ) )
+        {
+            fclose( fp );
+            FB_UNLOCK();
+            return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+        }
+    }
+
     FB_UNLOCK();
 
 	return fb_ErrorSetNum( FB_RTERROR_OK );
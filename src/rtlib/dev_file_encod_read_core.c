@@ -1,410 +1,572 @@
 /* UTF-encoded to char or wchar file reading
  * (based on ConvertUTF.c free implementation from Unicode, Inc)
+ *
+ * the input is read ahead in large blocks into the handle's decode buffer
+ * (see FB_FILE_DECODE), and a sequence cut at the end of a block is kept
+ * there until the next block completes it. The encoded file device's seek,
+ * tell and EOF take the bytes read ahead into account. Pipes and other
+ * files that aren't regular are never read past the chars asked for, so
+ * reads don't wait for input that isn't needed yet.
  */
 
 #include "fb.h"
+#include <sys/stat.h>
 
 extern const char __fb_utf8_trailingTb[256];
 extern const UTF_32 __fb_utf8_offsetsTb[6];
 
-/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
- * to char                                                                              *
- *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+/* the result's char type: char (with '?' for chars > 255), UTF-16 (with
+   surrogate pairs) or UTF-32 */
+#define DST_CHAR  1
+#define DST_UTF16 2
+#define DST_UTF32 4
 
-static ssize_t hReadUTF8ToChar( FILE *fp, char *dst, ssize_t max_chars )
+/* store a char, returns the number of units used, 0 if it didn't fit
+   (the char is skipped then, as the original char by char version did) */
+static __inline__ ssize_t hStore( void *dst, int dst_type, UTF_32 wc, ssize_t room )
 {
-	UTF_32 wc;
-	unsigned char c[7], *p;
-	ssize_t chars, extbytes;
-
-	chars = max_chars;
-    while( chars > 0 )
-    {
-		if( fread( &c[0], 1, 1, fp ) != 1 )
-			break;
-
-		extbytes = __fb_utf8_trailingTb[c[0]];
-
-		if( extbytes > 0 )
-			if( fread( &c[1], extbytes, 1, fp ) != 1 )
-				break;
+	switch( dst_type )
+	{
+	case DST_CHAR:
+		*(char *)dst = (wc > 255) ? '?' : wc;
+		return 1;
 
-		wc = 0;
-		p = &c[0];
-		switch( extbytes )
+	case DST_UTF16:
+		if( wc <= UTF16_MAX_BMP )
 		{
-			case 5:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 4:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 3:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 2:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 1:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 0:
-				wc += *p++;
+			*(UTF_16 *)dst = wc;
+			return 1;
 		}
+		if( room < 2 )
+			return 0;
+		wc -= UTF16_HALFBASE;
+		((UTF_16 *)dst)[0] = ((wc >> UTF16_HALFSHIFT) + UTF16_SUR_HIGH_START);
+		((UTF_16 *)dst)[1] = ((wc & UTF16_HALFMASK) + UTF16_SUR_LOW_START);
+		return 2;
 
-		wc -= __fb_utf8_offsetsTb[extbytes];
-
-		if( wc > 255 )
-			wc = '?';
-
-		*dst++ = wc;
-		--chars;
+	default:
+		*(UTF_32 *)dst = wc;
+		return 1;
 	}
-
-	return max_chars - chars;
 }
 
-static ssize_t hReadUTF16ToChar( FILE *fp, char *dst, ssize_t max_chars )
+/* copy ASCII chars as they are, widening them if needed */
+static __inline__ void hStoreAscii( void *dst, int dst_type, const UTF_8 *src, ssize_t len )
 {
-    ssize_t chars;
-    UTF_16 c;
-
-    chars = max_chars;
-    while( chars > 0 )
-    {
-        if( fread( &c, sizeof( UTF_16 ), 1, fp ) != 1 )
-            break;
-
-        if( c > 255 )
-        {
-            if( c >= UTF16_SUR_HIGH_START && c <= UTF16_SUR_HIGH_END )
-            {
-                if( fread( &c, sizeof( UTF_16 ), 1, fp ) != 1 )
-                    break;
-            }
-            c = '?';
-        }
-
-        *dst++ = c;
-        --chars;
-    }
-
-	return max_chars - chars;
-}
+	ssize_t i;
 
-static ssize_t hReadUTF32ToChar( FILE *fp, char *dst, ssize_t max_chars )
-{
-	ssize_t chars;
-	UTF_32 c;
+	switch( dst_type )
+	{
+	case DST_CHAR:
+		memcpy( dst, src, len );
+		break;
+
+	case DST_UTF16:
+		for( i = 0; i < len; i++ )
+			((UTF_16 *)dst)[i] = src[i];
+		break;
+
+	default:
+		for( i = 0; i < len; i++ )
+			((UTF_32 *)dst)[i] = src[i];
+		break;
+	}
+}
 
-	chars = max_chars;
-    while( chars > 0 )
-    {
-        if( fread( &c, sizeof( UTF_32 ), 1, fp ) != 1 )
-            break;
+/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * UTF-8                                                                                *
+ *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
 
-        if( c > 255 )
-            c = '?';
+static __inline__ UTF_32 hDecodeUTF8( const UTF_8 *p, ssize_t extbytes )
+{
+	UTF_32 wc = 0;
 
-        *dst++ = c;
-        --chars;
-    }
+	switch( extbytes )
+	{
+		case 5:
+			wc += *p++;
+			wc <<= 6;
+			/* fall through */
+		case 4:
+			wc += *p++;
+			wc <<= 6;
+			/* fall through */
+		case 3:
+			wc += *p++;
+			wc <<= 6;
+			/* fall through */
+		case 2:
+			wc += *p++;
+			wc <<= 6;
+			/* fall through */
+		case 1:
+			wc += *p++;
+			wc <<= 6;
+			/* fall through */
+		case 0:
+			wc += *p++;
+	}
 
-    return max_chars - chars;
+	return wc - __fb_utf8_offsetsTb[extbytes];
 }
 
-ssize_t fb_hFileRead_UTFToChar( FILE *fp, FB_FILE_ENCOD encod, char *dst, ssize_t max_chars )
+/* decode the complete sequences in src; returns the number of units
+   stored, and in *used the bytes decoded (less than len if the last
+   sequence is cut) */
+static ssize_t hDecodeUTF8Block
+	(
+		const UTF_8 *src,
+		ssize_t len,
+		ssize_t *used,
+		char *dst,
+		int dst_type,
+		ssize_t room
+	)
 {
-	switch( encod )
-	{
-	case FB_FILE_ENCOD_UTF8:
-		return hReadUTF8ToChar( fp, dst, max_chars );
+	const UTF_8 *p = src, *limit = src + len;
+	ssize_t units = 0, ascii, extbytes;
 
-	case FB_FILE_ENCOD_UTF16:
-		return hReadUTF16ToChar( fp, dst, max_chars );
+	while( (p < limit) && (units < room) )
+	{
+		/* ASCII fast path */
+		ascii = fb_hUTF8AsciiLen( p, limit - p );
+		if( ascii > room - units )
+			ascii = room - units;
+		if( ascii > 0 )
+		{
+			hStoreAscii( dst + units * dst_type, dst_type, p, ascii );
+			p += ascii;
+			units += ascii;
+			continue;
+		}
 
-	case FB_FILE_ENCOD_UTF32:
-		return hReadUTF32ToChar( fp, dst, max_chars );
+		extbytes = __fb_utf8_trailingTb[*p];
+		if( p + extbytes >= limit )
+			break;
 
-	default:
-		return 0;
+		units += hStore( dst + units * dst_type, dst_type,
+		                 hDecodeUTF8( p, extbytes ), room - units );
+		p += extbytes + 1;
 	}
 
+	*used = p - src;
+	return units;
 }
 
 /*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
- * to wchar                                                                             *
+ * UTF-16                                                                               *
  *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
 
-static ssize_t hUTF8ToUTF16( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+static ssize_t hDecodeUTF16Block
+	(
+		const UTF_8 *src,
+		ssize_t len,
+		ssize_t *used,
+		char *dst,
+		int dst_type,
+		ssize_t room
+	)
 {
+	const UTF_8 *p = src, *limit = src + (len & ~(ssize_t)1);
+	ssize_t units = 0, stored;
+	UTF_16 c, low;
 	UTF_32 wc;
-	unsigned char c[7], *p;
-	ssize_t chars, extbytes;
-
-	chars = max_chars;
-    while( chars > 0 )
-    {
-		if( fread( &c[0], 1, 1, fp ) != 1 )
-			break;
 
-		extbytes = __fb_utf8_trailingTb[c[0]];
+	/* same size? */
+	if( dst_type == DST_UTF16 )
+	{
+		units = (limit - p) / sizeof( UTF_16 );
+		if( units > room )
+			units = room;
+		memcpy( dst, src, units * sizeof( UTF_16 ) );
+		*used = units * sizeof( UTF_16 );
+		return units;
+	}
 
-		if( extbytes > 0 )
-			if( fread( &c[1], extbytes, 1, fp ) != 1 )
-				break;
+	while( (p < limit) && (units < room) )
+	{
+		memcpy( &c, p, sizeof( UTF_16 ) );
 
-		wc = 0;
-		p = &c[0];
-		switch( extbytes )
+		if( c >= UTF16_SUR_HIGH_START && c <= UTF16_SUR_HIGH_END )
 		{
-			case 5:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 4:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 3:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 2:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 1:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 0:
-				wc += *p++;
-		}
+			/* cut at the end of the block? */
+			if( p + 2 * sizeof( UTF_16 ) > limit )
+				break;
 
-		wc -= __fb_utf8_offsetsTb[extbytes];
+			if( dst_type == DST_CHAR )
+				wc = '?';
+			else
+			{
+				memcpy( &low, p + sizeof( UTF_16 ), sizeof( UTF_16 ) );
+				wc = ((c - UTF16_SUR_HIGH_START) << UTF16_HALFSHIFT) +
+				     (low - UTF16_SUR_LOW_START) + UTF16_HALFBASE;
+			}
 
-		if( wc <= UTF16_MAX_BMP )
-		{
-			*dst++ = wc;
+			stored = hStore( dst + units * dst_type, dst_type, wc, room - units );
+			if( stored == 0 )
+				break;
+			units += stored;
+			p += 2 * sizeof( UTF_16 );
 		}
 		else
 		{
-			if( chars > 1 )
-			{
-				wc -= UTF16_HALFBASE;
-				*dst++ = ((wc >> UTF16_HALFSHIFT) +	UTF16_SUR_HIGH_START);
-				*dst++ = ((wc & UTF16_HALFMASK)	+ UTF16_SUR_LOW_START);
-				--chars;
-			}
+			units += hStore( dst + units * dst_type, dst_type, c, room - units );
+			p += sizeof( UTF_16 );
 		}
-
-		--chars;
 	}
 
-	return max_chars - chars;
+	*used = p - src;
+	return units;
 }
 
-static ssize_t hUTF8ToUTF32( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * UTF-32                                                                               *
+ *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+static ssize_t hDecodeUTF32Block
+	(
+		const UTF_8 *src,
+		ssize_t len,
+		ssize_t *used,
+		char *dst,
+		int dst_type,
+		ssize_t room
+	)
 {
-	UTF_32 wc;
-	unsigned char c[7], *p;
-	ssize_t chars, extbytes;
+	const UTF_8 *p = src, *limit = src + (len & ~(ssize_t)3);
+	ssize_t units = 0, stored;
+	UTF_32 c;
+
+	/* same size? */
+	if( dst_type == DST_UTF32 )
+	{
+		units = (limit - p) / sizeof( UTF_32 );
+		if( units > room )
+			units = room;
+		memcpy( dst, src, units * sizeof( UTF_32 ) );
+		*used = units * sizeof( UTF_32 );
+		return units;
+	}
 
-	chars = max_chars;
-    while( chars > 0 )
-    {
-		if( fread( &c[0], 1, 1, fp ) != 1 )
+	while( (p < limit) && (units < room) )
+	{
+		memcpy( &c, p, sizeof( UTF_32 ) );
+		stored = hStore( dst + units * dst_type, dst_type, c, room - units );
+		/* didn't fit */
+		if( stored == 0 )
 			break;
+		units += stored;
+		p += sizeof( UTF_32 );
+	}
+
+	*used = p - src;
+	return units;
+}
 
-		extbytes = __fb_utf8_trailingTb[c[0]];
+/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * decode buffer                                                                        *
+ *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
 
-		if( extbytes > 0 )
-			if( fread( &c[1], extbytes, 1, fp ) != 1 )
-				break;
+/* called when a file is opened for INPUT, after the BOM */
+int fb_hFileDecodeInit( FB_FILE *handle )
+{
+	FILE *fp = (FILE *)handle->opaque;
+	FB_FILE_DECODE *buf;
+	struct stat st;
+
+	buf = (FB_FILE_DECODE *)malloc( sizeof( FB_FILE_DECODE ) );
+	if( buf == NULL )
+		return FALSE;
+
+	buf->regular = (fstat( fileno( fp ), &st ) == 0) && S_ISREG( st.st_mode );
+	buf->start = buf->regular ? ftello( fp ) : 0;
+	buf->pos = 0;
+	buf->len = 0;
+	buf->detached = FALSE;
+
+	handle->decode = buf;
+	return TRUE;
+}
 
-		wc = 0;
-		p = &c[0];
-		switch( extbytes )
-		{
-			case 5:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 4:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 3:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 2:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 1:
-				wc += *p++;
-				wc <<= 6;
-				/* fall through */
-			case 0:
-				wc += *p++;
-		}
+static __inline__ ssize_t hUnitSize( FB_FILE_ENCOD encod )
+{
+	switch( encod )
+	{
+	case FB_FILE_ENCOD_UTF16:
+		return sizeof( UTF_16 );
+	case FB_FILE_ENCOD_UTF32:
+		return sizeof( UTF_32 );
+	default:
+		return sizeof( UTF_8 );
+	}
+}
 
-		wc -= __fb_utf8_offsetsTb[extbytes];
+static __inline__ UTF_32 hGetUnit( const FB_FILE_DECODE *buf, ssize_t unit )
+{
+	UTF_16 c16;
+	UTF_32 c32;
 
-		*dst++ = wc;
-		--chars;
+	switch( unit )
+	{
+	case sizeof( UTF_16 ):
+		memcpy( &c16, &buf->data[buf->pos], sizeof( UTF_16 ) );
+		return c16;
+	case sizeof( UTF_32 ):
+		memcpy( &c32, &buf->data[buf->pos], sizeof( UTF_32 ) );
+		return c32;
+	default:
+		return buf->data[buf->pos];
 	}
+}
+
+/* bytes of the sequence at buf->pos */
+static ssize_t hSeqLen( const FB_FILE_DECODE *buf, FB_FILE_ENCOD encod )
+{
+	UTF_32 c;
+
+	switch( encod )
+	{
+	case FB_FILE_ENCOD_UTF16:
+		if( buf->len - buf->pos < sizeof( UTF_16 ) )
+			return sizeof( UTF_16 );
+		c = hGetUnit( buf, sizeof( UTF_16 ) );
+		if( c >= UTF16_SUR_HIGH_START && c <= UTF16_SUR_HIGH_END )
+			return 2 * sizeof( UTF_16 );
+		return sizeof( UTF_16 );
+
+	case FB_FILE_ENCOD_UTF32:
+		return sizeof( UTF_32 );
 
-	return max_chars - chars;
+	default:
+		return __fb_utf8_trailingTb[buf->data[buf->pos]] + 1;
+	}
 }
 
-static ssize_t hReadUTF8ToWchar( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+static ssize_t hDecodeBlock
+	(
+		FB_FILE_DECODE *buf,
+		FB_FILE_ENCOD encod,
+		ssize_t len,
+		char *dst,
+		int dst_type,
+		ssize_t room
+	)
 {
-	ssize_t res = 0;
+	const UTF_8 *src = &buf->data[buf->pos];
+	ssize_t units, used = 0;
 
-	/* convert.. */
-	switch( sizeof( FB_WCHAR ) )
+	switch( encod )
 	{
-	case sizeof( char ):
-		res = hReadUTF8ToChar( fp, (char *)dst, max_chars );
+	case FB_FILE_ENCOD_UTF16:
+		units = hDecodeUTF16Block( src, len, &used, dst, dst_type, room );
 		break;
-
-	case sizeof( UTF_16 ):
-		res = hUTF8ToUTF16( fp, dst, max_chars );
+	case FB_FILE_ENCOD_UTF32:
+		units = hDecodeUTF32Block( src, len, &used, dst, dst_type, room );
 		break;
-
-	case sizeof( UTF_32 ):
-		res = hUTF8ToUTF32( fp, dst, max_chars );
+	default:
+		units = hDecodeUTF8Block( src, len, &used, dst, dst_type, room );
 		break;
 	}
 
-	return res;
+	buf->pos += used;
+	return units;
 }
 
-static ssize_t hUTF16ToUTF32( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+/* offset of the first CR or LF at or after buf->pos, or buf->len; both are
+   never part of a multi-byte sequence or surrogate pair */
+static size_t hFindEol( const FB_FILE_DECODE *buf, ssize_t unit )
 {
-    UTF_32 c, c2;
-	ssize_t chars;
-
-    chars = max_chars;
-    while( chars > 0 )
-    {
-        if( fread( &c, sizeof( UTF_16 ), 1, fp ) != 1 )
-            break;
-
-        c &= 0x0000FFFF;
-        if( c >= UTF16_SUR_HIGH_START && c <= UTF16_SUR_HIGH_END )
-        {
-            if( fread( &c2, sizeof( UTF_16 ), 1, fp ) != 1 )
-                break;
-
-            c = ((c - UTF16_SUR_HIGH_START) << UTF16_HALFSHIFT) +
-                 (c2 - UTF16_SUR_LOW_START) + UTF16_HALFBASE;
-        }
-
-        *dst++ = c;
-        --chars;
-    }
-
-    return max_chars - chars;
+	const UTF_8 *p = &buf->data[buf->pos], *limit = &buf->data[buf->len], *cr;
+	UTF_16 c16;
+	UTF_32 c32;
+
+	switch( unit )
+	{
+	case sizeof( UTF_16 ):
+		for( ; p + sizeof( UTF_16 ) <= limit; p += sizeof( UTF_16 ) )
+		{
+			memcpy( &c16, p, sizeof( UTF_16 ) );
+			if( (c16 == '\n') || (c16 == '\r') )
+				return p - buf->data;
+		}
+		return buf->len;
+
+	case sizeof( UTF_32 ):
+		for( ; p + sizeof( UTF_32 ) <= limit; p += sizeof( UTF_32 ) )
+		{
+			memcpy( &c32, p, sizeof( UTF_32 ) );
+			if( (c32 == '\n') || (c32 == '\r') )
+				return p - buf->data;
+		}
+		return buf->len;
+
+	default:
+		cr = memchr( p, '\r', limit - p );
+		if( cr != NULL )
+			limit = cr;
+		p = memchr( p, '\n', limit - p );
+		if( p != NULL )
+			return p - buf->data;
+		return limit - buf->data;
+	}
 }
 
-static ssize_t hReadUTF16ToWchar( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+/* append at least need bytes, up to ahead if the file isn't a regular one
+   (a pipe would wait for more input); FALSE at EOF */
+static int hFill( FILE *fp, FB_FILE_DECODE *buf, size_t need, size_t ahead )
 {
-	ssize_t res = 0;
-
-	/* same size? */
-	if( sizeof( FB_WCHAR ) == sizeof( UTF_16 ) )
-		return fread( (char *)dst, sizeof( UTF_16 ), max_chars, fp );
+	size_t want, got;
 
-	/* convert.. */
-	switch( sizeof( FB_WCHAR ) )
+	if( buf->pos > 0 )
 	{
-	case sizeof( char ):
-		res = hReadUTF16ToChar( fp, (char *)dst, max_chars );
-		break;
-
-	case sizeof( UTF_32 ):
-		res = hUTF16ToUTF32( fp, dst, max_chars );
-		break;
+		buf->len -= buf->pos;
+		memmove( buf->data, &buf->data[buf->pos], buf->len );
+		buf->start += buf->pos;
+		buf->pos = 0;
 	}
 
-	return res;
+	if( buf->regular || (ahead > FB_FILE_DECODE_BUFSIZE - buf->len) )
+		want = FB_FILE_DECODE_BUFSIZE - buf->len;
+	else
+		want = (ahead > need) ? ahead : need;
+
+	got = fread( &buf->data[buf->len], 1, want, fp );
+	buf->len += got;
+
+	return (got >= need);
 }
 
-static ssize_t hUTF32ToUTF16( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+/* decode up to max_units, stopping after a line end if eol isn't NULL (CR,
+   LF or CR LF, not stored) */
+static ssize_t hRead( FB_FILE *handle, char *dst, int dst_type, ssize_t max_units, int *eol )
 {
-    UTF_32 c;
-	ssize_t chars;
+	FB_FILE_DECODE *buf = handle->decode;
+	FILE *fp = (FILE *)handle->opaque;
+	FB_FILE_ENCOD encod = handle->encod;
+	ssize_t units = 0, unit, limit, seqlen, need, ahead, pos;
+	UTF_32 c;
+
+	if( eol != NULL )
+		*eol = FALSE;
+
+	if( (buf == NULL) || (fp == NULL) )
+		return 0;
+
+	/* seeked outside the buffer: continue from the file position */
+	if( buf->detached )
+	{
+		buf->pos = 0;
+		buf->len = 0;
+		if( buf->regular )
+			buf->start = ftello( fp );
+		buf->detached = FALSE;
+	}
 
-    chars = max_chars;
-    while( chars > 0 )
-    {
-        if( fread( &c, sizeof( UTF_32 ), 1, fp ) != 1 )
-            break;
+	unit = hUnitSize( encod );
 
-		if( c > UTF16_MAX_BMP )
+	while( units < max_units )
+	{
+		limit = (eol != NULL) ? hFindEol( buf, unit ) : buf->len;
+
+		units += hDecodeBlock( buf, encod, limit - buf->pos,
+		                       dst + units * dst_type, dst_type, max_units - units );
+
+		if( (eol != NULL) && (buf->pos == (size_t)limit) && ((size_t)limit < buf->len) )
+		{
+			c = hGetUnit( buf, unit );
+			buf->pos += unit;
+
+			/* CR: skip a LF following it */
+			if( c == '\r' )
+			{
+				if( buf->len - buf->pos < (size_t)unit )
+					hFill( fp, buf, unit - (buf->len - buf->pos), unit );
+				if( (buf->len - buf->pos >= (size_t)unit) && (hGetUnit( buf, unit ) == '\n') )
+					buf->pos += unit;
+			}
+
+			*eol = TRUE;
+			break;
+		}
+
+		if( units >= max_units )
+			break;
+
+		/* what's left is a sequence cut at the end of the block, or one
+		   that didn't fit, or one that spans a line end (invalid data,
+		   decoded the same as any other) */
+		if( buf->pos < buf->len )
 		{
-			c -= UTF16_HALFBASE;
-			if( chars > 1 )
+			seqlen = hSeqLen( buf, encod );
+			if( buf->pos + seqlen <= buf->len )
 			{
-				*dst++ = (UTF_16)((c >> UTF16_HALFSHIFT) + UTF16_SUR_HIGH_START);
-				--chars;
+				pos = buf->pos;
+				units += hDecodeBlock( buf, encod, seqlen,
+				                       dst + units * dst_type, dst_type, max_units - units );
+				/* didn't fit */
+				if( buf->pos == (size_t)pos )
+					break;
+				continue;
 			}
-			c = ((c & UTF16_HALFMASK) + UTF16_SUR_LOW_START);
+			need = buf->pos + seqlen - buf->len;
 		}
+		else
+			need = unit;
+
+		/* a char takes at least one unit; from UTF-32 to UTF-16 it can
+		   take two */
+		ahead = (eol != NULL) ? 0 : (max_units - units) * unit;
+		if( (encod == FB_FILE_ENCOD_UTF32) && (dst_type == DST_UTF16) )
+			ahead /= 2;
 
-		*dst++ = (UTF_16)c;
-		--chars;
-    }
+		if( !hFill( fp, buf, need, ahead ) )
+		{
+			/* EOF: an incomplete sequence at the end is dropped */
+			buf->pos = buf->len;
+			break;
+		}
+	}
 
-	return max_chars - chars;
+	return units;
 }
 
-static ssize_t hReadUTF32ToWchar( FILE *fp, FB_WCHAR *dst, ssize_t max_chars )
+static __inline__ int hWcharType( void )
 {
-	ssize_t res = 0;
-
 	switch( sizeof( FB_WCHAR ) )
 	{
 	case sizeof( char ):
-		res = hReadUTF32ToChar( fp, (char *)dst, max_chars );
-		break;
-
+		return DST_CHAR;
 	case sizeof( UTF_16 ):
-		res = hUTF32ToUTF16( fp, dst, max_chars );
-		break;
-
-	case sizeof( UTF_32 ):
-		res = fread( (char *)dst, sizeof( UTF_32 ), max_chars, fp );
-		break;
+		return DST_UTF16;
+	default:
+		return DST_UTF32;
 	}
-
-	return res;
 }
 
-ssize_t fb_hFileRead_UTFToWchar( FILE *fp, FB_FILE_ENCOD encod, FB_WCHAR *dst, ssize_t max_chars )
+/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * to char                                                                              *
+ *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+ssize_t fb_hFileRead_UTFToChar( FB_FILE *handle, char *dst, ssize_t max_chars )
 {
-	switch( encod )
-	{
-	case FB_FILE_ENCOD_UTF8:
-		return hReadUTF8ToWchar( fp, dst, max_chars );
+	return hRead( handle, dst, DST_CHAR, max_chars, NULL );
+}
 
-	case FB_FILE_ENCOD_UTF16:
-		return hReadUTF16ToWchar( fp, dst, max_chars );
+ssize_t fb_hFileReadLine_UTFToChar( FB_FILE *handle, char *dst, ssize_t max_chars, int *eol )
+{
+	return hRead( handle, dst, DST_CHAR, max_chars, eol );
+}
 
-	case FB_FILE_ENCOD_UTF32:
-		return hReadUTF32ToWchar( fp, dst, max_chars );
+/*::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * to wchar                                                                             *
+ *::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
 
-	default:
-		return 0;
-	}
+ssize_t fb_hFileRead_UTFToWchar( FB_FILE *handle, FB_WCHAR *dst, ssize_t max_chars )
+{
+	return hRead( handle, (char *)dst, hWcharType( ), max_chars, NULL );
+}
 
+ssize_t fb_hFileReadLine_UTFToWchar( FB_FILE *handle, FB_WCHAR *dst, ssize_t max_chars, int *eol )
+{
+	return hRead( handle, (char *)dst, hWcharType( ), max_chars, eol );
 }
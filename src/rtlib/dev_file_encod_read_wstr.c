@@ -12,9 +12,6 @@ int fb_DevFileReadEncodWstr( FB_FILE *handle, FB_WCHAR *dst, size_t *max_chars )
     chars = *max_chars;
 
     fp = (FILE *)handle->opaque;
-    if( fp == stdout || fp == stderr )
-        fp = stdin;
-
     if( fp == NULL )
     {
         FB_UNLOCK();
@@ -22,7 +19,7 @@ int fb_DevFileReadEncodWstr( FB_FILE *handle, FB_WCHAR *dst, size_t *max_chars )
     }
 
 	/* do read */
-	chars = fb_hFileRead_UTFToWchar( fp, handle->encod, dst, chars );
+	chars = fb_hFileRead_UTFToWchar( handle, dst, chars );
 
 	/* fill with nulls if at eof */
 	if( chars != *max_chars )
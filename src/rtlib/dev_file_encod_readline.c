@@ -2,17 +2,38 @@
 
 #include "fb.h"
 
+/* chars are decoded into here and appended in one go */
+#define BUFFER_LEN 4096
+
+static void hAppend( FBSTRING *dst, char *buffer, ssize_t len )
+{
+	char *src, *end, *p;
+
+	/* a null char is dropped, same as the concat would */
+	p = memchr( buffer, '\0', len );
+	if( p != NULL ) {
+		end = buffer + len;
+		for( src = p; src < end; src++ )
+			if( *src != '\0' )
+				*p++ = *src;
+		len = p - buffer;
+	}
+
+	if( len > 0 ) {
+		buffer[len] = '\0';
+		fb_StrConcatAssign( (void *)dst, -1, buffer, len, FB_FALSE );
+	}
+}
+
 int fb_DevFileReadLineEncod( FB_FILE *handle, FBSTRING *dst )
 {
-	int res;
+	int res = FB_RTERROR_OK, eol = FALSE;
+	char buffer[BUFFER_LEN + 1];
+	ssize_t len;
 
 	FB_LOCK();
 
-	FILE* fp = (FILE *)handle->opaque;
-	if( fp == stdout || fp == stderr )
-		fp = stdin;
-
-	if( fp == NULL ) {
+	if( handle->opaque == NULL ) {
 		FB_UNLOCK();
 		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
 	}
@@ -20,37 +41,40 @@ int fb_DevFileReadLineEncod( FB_FILE *handle, FBSTRING *dst )
 	/* Clear string first, we're only using += concat assign below... */
 	fb_StrDelete( dst );
 
-	/* Read one byte at a time until CR and/or LF is found.
-	   The fb_FileGetDataEx() will handle the decoding. */
-	while( TRUE ) {
+	/* chars put back by INPUT come first, fb_FileGetDataEx() returns them */
+	while( handle->putback_size != 0 ) {
 		char c[2];
-		size_t len;
+		size_t n;
 
-		res = fb_FileGetDataEx( handle, 0, c, 1, &len, FALSE, FALSE );
-		if( (res != FB_RTERROR_OK) || (len == 0) )
+		res = fb_FileGetDataEx( handle, 0, c, 1, &n, FALSE, FALSE );
+		if( (res != FB_RTERROR_OK) || (n == 0) ) {
+			eol = TRUE;
 			break;
+		}
 
 		/* CR? Check for following LF too, and skip it if it's there */
 		if( c[0] == '\r' ) {
-			res = fb_FileGetDataEx( handle, 0, c, 1, &len, FALSE, FALSE );
-			if( (res != FB_RTERROR_OK) || (len == 0) )
-				break;
-
-			/* No LF? Ok then, don't skip it yet */
-			if( c[0] != '\n' )
+			res = fb_FileGetDataEx( handle, 0, c, 1, &n, FALSE, FALSE );
+			if( (res == FB_RTERROR_OK) && (n != 0) && (c[0] != '\n') )
 				fb_FilePutBackEx( handle, c, 1 );
-
+			eol = TRUE;
 			break;
 		}
 
-		/* LF? */
 		if( c[0] == '\n' ) {
+			eol = TRUE;
 			break;
 		}
 
-		/* Any other char? Append to string, and continue... */
-		c[1] = 0;
-		fb_StrConcatAssign( (void *)dst, -1, c, 1, FB_FALSE );
+		hAppend( dst, c, 1 );
+	}
+
+	/* the rest of the line, decoded straight from the file's buffer */
+	while( !eol ) {
+		len = fb_hFileReadLine_UTFToChar( handle, buffer, BUFFER_LEN, &eol );
+		if( len == 0 && !eol )
+			break;
+		hAppend( dst, buffer, len );
 	}
 
 	FB_UNLOCK();
@@ -2,59 +2,86 @@
 
 #include "fb.h"
 
+/* drop null chars, as the concat would; returns the new length */
+static ssize_t hDropNulls( FB_WCHAR *buffer, ssize_t len )
+{
+	FB_WCHAR *src, *dst, *end = buffer + len;
+
+	for( dst = buffer; (dst < end) && (*dst != _LC('\0')); dst++ )
+		;
+
+	for( src = dst; src < end; src++ )
+		if( *src != _LC('\0') )
+			*dst++ = *src;
+
+	return dst - buffer;
+}
+
 int fb_DevFileReadLineEncodWstr( FB_FILE *handle, FB_WCHAR *dst, ssize_t max_chars )
 {
-	int res;
+	int res = FB_RTERROR_OK, eol = FALSE;
+	ssize_t len_chars = 0, len;
+	FB_WCHAR skip[256];
 
 	FB_LOCK();
 
-	FILE* fp = (FILE *)handle->opaque;
-	if( fp == stdout || fp == stderr )
-		fp = stdin;
-
-	if( fp == NULL ) {
+	if( handle->opaque == NULL ) {
 		FB_UNLOCK();
 		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
 	}
 
-	/* Clear string first, we're only using += concat assign below... */
+	/* Clear string first */
 	dst[0] = _LC('\0');
 
-	/* Read one byte at a time until CR and/or LF is found.
-	   The fb_FileGetDataEx() will handle the decoding. The length to read
-	   is specified in wchars, not bytes, because we're passing TRUE for
-	   is_unicode. */
-	while( TRUE ) {
+	/* chars put back by INPUT come first, fb_FileGetDataEx() returns them.
+	   The length to read is specified in wchars, not bytes, because we're
+	   passing TRUE for is_unicode. */
+	while( handle->putback_size != 0 ) {
 		FB_WCHAR c[2];
-		size_t len;
+		size_t n;
 
-		res = fb_FileGetDataEx( handle, 0, c, 1, &len, FALSE, TRUE );
-		if( (res != FB_RTERROR_OK) || (len == 0) )
+		res = fb_FileGetDataEx( handle, 0, c, 1, &n, FALSE, TRUE );
+		if( (res != FB_RTERROR_OK) || (n == 0) ) {
+			eol = TRUE;
 			break;
+		}
 
 		/* CR? Check for following LF too, and skip it if it's there */
 		if( c[0] == _LC('\r') ) {
-			res = fb_FileGetDataEx( handle, 0, c, 1, &len, FALSE, TRUE );
-			if( (res != FB_RTERROR_OK) || (len == 0) )
-				break;
-
-			/* No LF? Ok then, don't skip it yet */
-			if( c[0] != _LC('\n') )
+			res = fb_FileGetDataEx( handle, 0, c, 1, &n, FALSE, TRUE );
+			if( (res == FB_RTERROR_OK) && (n != 0) && (c[0] != _LC('\n')) )
 				fb_FilePutBackEx( handle, c, 1 );
-
+			eol = TRUE;
 			break;
 		}
 
-		/* LF? */
 		if( c[0] == _LC('\n') ) {
+			eol = TRUE;
 			break;
 		}
 
-		/* Any other char? Append to string, and continue... */
-		c[1] = _LC('\0');
-		fb_WstrConcatAssign( dst, max_chars, c );
+		if( (c[0] != _LC('\0')) && (len_chars < max_chars - 1) )
+			dst[len_chars++] = c[0];
+	}
+
+	/* the rest of the line, decoded straight from the file's buffer into
+	   dst; what doesn't fit is skipped */
+	while( !eol ) {
+		if( len_chars < max_chars - 1 ) {
+			len = fb_hFileReadLine_UTFToWchar( handle, dst + len_chars, max_chars - 1 - len_chars, &eol );
+			if( len == 0 && !eol )
+				break;
+			len_chars += hDropNulls( dst + len_chars, len );
+		} else {
+			len = fb_hFileReadLine_UTFToWchar( handle, skip, sizeof( skip ) / sizeof( FB_WCHAR ), &eol );
+			if( len == 0 && !eol )
+				break;
+		}
 	}
 
+	if( max_chars > 0 )
+		dst[len_chars] = _LC('\0');
+
 	FB_UNLOCK();
 
 	return res;
@@ -0,0 +1,95 @@
+/* UTF-encoded file device seek and tell, which have to take the bytes read
+   ahead into the decode buffer into account */
+
+#include "fb.h"
+
+static fb_off_t hTell( FILE *fp, FB_FILE_DECODE *buf )
+{
+	fb_off_t pos = ftello( fp );
+
+	if( (pos != -1) && !buf->detached )
+		pos -= buf->len - buf->pos;
+
+	return pos;
+}
+
+int fb_DevFileSeekEncod( FB_FILE *handle, fb_off_t offset, int whence )
+{
+	FB_FILE_DECODE *buf;
+	FILE *fp;
+	int res;
+
+	buf = handle->decode;
+	if( buf == NULL )
+		return fb_DevFileSeek( handle, offset, whence );
+
+	FB_LOCK();
+
+	fp = (FILE *)handle->opaque;
+	if( fp == NULL ) {
+		FB_UNLOCK();
+		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
+	}
+
+	if( whence == SEEK_CUR ) {
+		offset += hTell( fp, buf );
+		whence = SEEK_SET;
+	}
+
+	/* within the buffer? then it can be kept, e.g. for LOF(), which
+	   seeks to the end and back */
+	if( buf->regular && (whence == SEEK_SET) &&
+	    (offset >= buf->start) && (offset <= buf->start + (fb_off_t)buf->len) ) {
+		res = FB_RTERROR_OK;
+		if( buf->detached ) {
+			if( fseeko( fp, buf->start + buf->len, SEEK_SET ) == 0 )
+				buf->detached = FALSE;
+			else
+				res = FB_RTERROR_FILEIO;
+		}
+		if( res == FB_RTERROR_OK )
+			buf->pos = offset - buf->start;
+	} else {
+		if( fseeko( fp, offset, whence ) == 0 ) {
+			res = FB_RTERROR_OK;
+			/* keep the buffer for a seek back into it; the next read
+			   starts over at the file position */
+			if( buf->regular ) {
+				buf->detached = TRUE;
+			} else {
+				buf->pos = 0;
+				buf->len = 0;
+			}
+		} else {
+			res = FB_RTERROR_FILEIO;
+		}
+	}
+
+	FB_UNLOCK();
+
+	return fb_ErrorSetNum( res );
+}
+
+int fb_DevFileTellEncod( FB_FILE *handle, fb_off_t *pOffset )
+{
+	FB_FILE_DECODE *buf;
+	FILE *fp;
+
+	buf = handle->decode;
+	if( buf == NULL )
+		return fb_DevFileTell( handle, pOffset );
+
+	FB_LOCK();
+
+	fp = (FILE *)handle->opaque;
+	if( fp == NULL ) {
+		FB_UNLOCK();
+		return fb_ErrorSetNum( FB_RTERROR_ILLEGALFUNCTIONCALL );
+	}
+
+	*pOffset = hTell( fp, buf );
+
+	FB_UNLOCK();
+
+	return fb_ErrorSetNum( FB_RTERROR_OK );
+}
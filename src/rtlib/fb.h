@@ -469,6 +469,8 @@ typedef struct FB_RTLIB_CTX_ {
 	int             do_file_reset;
 	int             lang;
 	void          (*exit_gfxlib2)(void);
+	void          (*profile_thread_end)(void *ctx);
+	void          (*exit_profile)(void);
 } FB_RTLIB_CTX;
 
 extern FB_RTLIB_CTX __fb_ctx;
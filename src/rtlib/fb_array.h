@@ -8,9 +8,12 @@ typedef enum _FBARRAY_FLAGS {
 	FBARRAY_FLAGS_DIMENSIONS = 0x0000000f,
 	FBARRAY_FLAGS_FIXED_DIM  = 0x00000010,
 	FBARRAY_FLAGS_FIXED_LEN  = 0x00000020,
-	FBARRAY_FLAGS_RESERVED   = 0xffffffc0
+	FBARRAY_FLAGS_CAPACITY   = 0x00000fc0, /* log2 of allocated bytes if more than size, else 0 */
+	FBARRAY_FLAGS_RESERVED   = 0xfffff000
 } FBARRAY_FLAGS;
 
+#define FBARRAY_FLAGS_CAPACITY_SHIFT 6
+
 typedef struct _FBARRAY {
 	void           *data;        /* ptr + diff, must be at ofs 0! */
 	void           *ptr;
@@ -71,8 +74,12 @@ FBCALL int        fb_ArrayRedimTo      ( FBARRAY *dest, const FBARRAY *source, i
 FBCALL void       fb_ArrayResetDesc    ( FBARRAY *array );
 FBCALL ssize_t    fb_ArrayLBound       ( FBARRAY *array, ssize_t dimension );
 FBCALL ssize_t    fb_ArrayUBound       ( FBARRAY *array, ssize_t dimension );
+FBCALL int        fb_ArrayReserve      ( FBARRAY *array, size_t elements );
+FBCALL int        fb_ArrayShrink       ( FBARRAY *array );
        size_t     fb_hArrayCalcElements( size_t dimensions, const ssize_t *lboundTB, const ssize_t *uboundTB );
        ssize_t    fb_hArrayCalcDiff    ( size_t dimensions, const ssize_t *lboundTB, const ssize_t *uboundTB );
+       size_t     fb_hArrayCapacity    ( const FBARRAY *array );
+       int        fb_hArraySetCapacity ( FBARRAY *array, size_t size, size_t capacity );
 
 int fb_hArrayAlloc
 	(
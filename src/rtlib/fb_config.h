@@ -59,6 +59,20 @@
 	#define HOST_64BIT
 #endif
 
+/* Keep the runtime's thread-local contexts in compiler-native TLS (__thread)
+   instead of pthread keys, -DDISABLE_NATIVE_TLS to use the keys anyway */
+#if defined ENABLE_MT && defined HOST_UNIX && !defined HOST_DARWIN && !defined DISABLE_NATIVE_TLS
+	#define ENABLE_NATIVE_TLS
+	#ifdef HOST_X86
+		/* the non-PIC x86 libs are also linked into shared libraries, where
+		   the default (local-exec) model can't be used; ld relaxes this back
+		   to local-exec when linking executables */
+		#define FB_TLSVAR __thread __attribute__((tls_model("global-dynamic")))
+	#else
+		#define FB_TLSVAR __thread
+	#endif
+#endif
+
 #ifdef HOST_MINGW
 	/* work around gcc bug 52991 */
 	/* Since MinGW gcc 4.7, structs default to "ms_struct" instead of
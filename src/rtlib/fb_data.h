@@ -16,6 +16,42 @@ extern FB_DATADESC *__fb_data_ptr;
 #define FB_DATATYPE_OFS  -2
 #define FB_DATATYPE_WSTR 0x8000
 
+/* typed tables (fbc -z typed-data): a DATA statement with only numbers is a
+   single descriptor pointing to the values, followed by one holding their
+   count in .ofs, instead of one descriptor with a text per value */
+#define FB_DATATYPE_TABLE_LONG    -3
+#define FB_DATATYPE_TABLE_LONGINT -4
+#define FB_DATATYPE_TABLE_DOUBLE  -5
+
+#define FB_DATA_ISTABLE( desc ) \
+	(((desc)->len <= FB_DATATYPE_TABLE_LONG) && ((desc)->len >= FB_DATATYPE_TABLE_DOUBLE))
+#define FB_DATA_TABLECOUNT( desc ) ((ssize_t)(size_t)(desc)[1].ofs)
+
+/* READ destination types for fb_DataTblRead() and the READ array() functions,
+   must match fbc's rtl.bi */
+enum {
+	FB_DATAELM_BOOL,
+	FB_DATAELM_BYTE,
+	FB_DATAELM_UBYTE,
+	FB_DATAELM_SHORT,
+	FB_DATAELM_USHORT,
+	FB_DATAELM_INT,
+	FB_DATAELM_UINT,
+	FB_DATAELM_LONGINT,
+	FB_DATAELM_ULONGINT,
+	FB_DATAELM_SINGLE,
+	FB_DATAELM_DOUBLE,
+	FB_DATAELM_STRING
+};
+
+/* read cursor: the current descriptor, and the position in it if it's a
+   typed table; per-thread with -z typed-data, see data_table.c */
+typedef struct _FB_DATACTX {
+	FB_DATADESC *ptr;
+	ssize_t      index;
+	int          started;
+} FB_DATACTX;
+
 FBCALL void         fb_DataRestore      ( FB_DATADESC *labeladdr );
        void         fb_DataNext         ( void );
 FBCALL void         fb_DataReadStr      ( void *dst, ssize_t dst_size, int fillrem );
@@ -31,3 +67,14 @@ FBCALL void         fb_DataReadLongint  ( long long *dst );
 FBCALL void         fb_DataReadULongint ( unsigned long long *dst );
 FBCALL void         fb_DataReadSingle   ( float *dst );
 FBCALL void         fb_DataReadDouble   ( double *dst );
+FBCALL void         fb_DataReadArray    ( FBARRAY *array, int type );
+
+       void         fb_hDataNext        ( FB_DATACTX *ctx );
+       void         fb_hDataRead        ( FB_DATACTX *ctx, void *dst, int type );
+       void         fb_hDataReadArray   ( FB_DATACTX *ctx, FBARRAY *array, int type );
+FBCALL void         fb_DataTblStart     ( FB_DATADESC *labeladdr );
+FBCALL void         fb_DataTblRestore   ( FB_DATADESC *labeladdr );
+FBCALL void         fb_DataTblRead      ( void *dst, int type );
+FBCALL void         fb_DataTblReadStr   ( void *dst, ssize_t dst_size, int fillrem );
+FBCALL void         fb_DataTblReadWstr  ( FB_WCHAR *dst, ssize_t dst_size );
+FBCALL void         fb_DataTblReadArray ( FBARRAY *array, int type );
@@ -29,6 +29,10 @@
 
        /* ENCOD */
        int          fb_DevFileOpenEncod     ( FB_FILE *handle, const char *filename, size_t fname_len );
+       int          fb_DevFileCloseEncod    ( FB_FILE *handle );
+       int          fb_DevFileEofEncod      ( FB_FILE *handle );
+       int          fb_DevFileSeekEncod     ( FB_FILE *handle, fb_off_t offset, int whence );
+       int          fb_DevFileTellEncod     ( FB_FILE *handle, fb_off_t *pOffset );
        int          fb_DevFileOpenUTF       ( FB_FILE *handle, const char *filename, size_t filename_len );
        int          fb_DevFileReadEncod     ( FB_FILE *handle, void *dst, size_t *max_chars );
        int          fb_DevFileReadEncodWstr ( FB_FILE *handle, FB_WCHAR *dst, size_t *max_chars );
@@ -94,6 +94,20 @@ typedef struct _FB_FILE_HOOKS {
     FnFileFlush         pfnFlush;
 } FB_FILE_HOOKS;
 
+/* bytes read ahead of the decoded chars, for UTF-encoded files opened for
+   INPUT; data[0] is at file offset start (for regular files, to allow seeks
+   within the buffer) */
+#define FB_FILE_DECODE_BUFSIZE 32768
+
+typedef struct _FB_FILE_DECODE {
+    fb_off_t        start;
+    size_t          pos;            /* next byte to decode */
+    size_t          len;            /* bytes in data */
+    int             regular;        /* regular file: read ahead in large blocks */
+    int             detached;       /* seeked away: the file position isn't start + len */
+    unsigned char   data[FB_FILE_DECODE_BUFSIZE];
+} FB_FILE_DECODE;
+
 typedef struct _FB_FILE {
     int             mode;
     int             len;
@@ -109,6 +123,9 @@ typedef struct _FB_FILE {
     char            putback_buffer[4];
     size_t          putback_size;
 
+    /* UTF-encoded files opened for INPUT, NULL otherwise */
+    FB_FILE_DECODE  *decode;
+
     FB_FILE_HOOKS   *hooks;
     /* an i/o handler might store additional (handler specific) data here */
     void 			*opaque;
@@ -344,10 +361,15 @@ FBCALL FBSTRING    *fb_DirNext64        ( long long *outattrib );
 extern const UTF_8 __fb_utf8_bmarkTb[7];
 
        void         fb_hCharToUTF8      ( const char *src, ssize_t chars, char *dst, ssize_t *bytes );
+       ssize_t      fb_hUTF8AsciiLen    ( const UTF_8 *src, ssize_t len );
+       ssize_t      fb_hUTF8AsciiLenZ   ( const UTF_8 *src, ssize_t max );
        char        *fb_CharToUTF        ( FB_FILE_ENCOD encod, const char *src, ssize_t chars, char *dst, ssize_t *bytes );
        char        *fb_WCharToUTF       ( FB_FILE_ENCOD encod, const FB_WCHAR *src, ssize_t chars, char *dst, ssize_t *bytes );
-       ssize_t      fb_hFileRead_UTFToChar( FILE *fp, FB_FILE_ENCOD encod, char *dst, ssize_t max_chars );
-       ssize_t      fb_hFileRead_UTFToWchar( FILE *fp, FB_FILE_ENCOD encod, FB_WCHAR *dst, ssize_t max_chars );
+       int          fb_hFileDecodeInit  ( FB_FILE *handle );
+       ssize_t      fb_hFileRead_UTFToChar( FB_FILE *handle, char *dst, ssize_t max_chars );
+       ssize_t      fb_hFileRead_UTFToWchar( FB_FILE *handle, FB_WCHAR *dst, ssize_t max_chars );
+       ssize_t      fb_hFileReadLine_UTFToChar( FB_FILE *handle, char *dst, ssize_t max_chars, int *eol );
+       ssize_t      fb_hFileReadLine_UTFToWchar( FB_FILE *handle, FB_WCHAR *dst, ssize_t max_chars, int *eol );
 
 /**************************************************************************************************
  * VB-compatible functions
@@ -110,9 +110,13 @@ FBCALL FBSTRING    *fb_hStrAllocTemp            ( FBSTRING *str, ssize_t size );
 FBCALL FBSTRING    *fb_hStrAllocTemp_NoLock     ( FBSTRING *str, ssize_t size );
 FBCALL int          fb_hStrDelTemp              ( FBSTRING *str );
 FBCALL int          fb_hStrDelTemp_NoLock       ( FBSTRING *str );
+FBCALL FBSTRING    *fb_hStrTempPart             ( FBSTRING *src, const char *part, ssize_t len );
 FBCALL void         fb_hStrCopy                 ( char *dst, const char *src, ssize_t bytes );
 FBCALL char        *fb_hStrSkipChar             ( char *s, ssize_t len, int c );
 FBCALL char        *fb_hStrSkipCharRev          ( char *s, ssize_t len, int c );
+       ssize_t      fb_hStrSkipAny              ( const char *s, ssize_t len, const char *set, ssize_t set_len );
+       ssize_t      fb_hStrSkipAnyRev           ( const char *s, ssize_t len, const char *set, ssize_t set_len );
+       void         fb_hStrConvCase             ( char *dst, const char *src, ssize_t len, int upper, int mode );
 
 
 /* public */
@@ -130,6 +134,20 @@ FBCALL FBSTRING    *fb_StrAllocTempDescV( FBSTRING *str );
 FBCALL FBSTRING    *fb_StrAllocTempDescZEx( const char *str, ssize_t len );
 FBCALL FBSTRING    *fb_StrAllocTempDescZ( const char *str );
 FBCALL ssize_t      fb_StrLen           ( void *str, ssize_t str_size );
+FBCALL unsigned int fb_StrHash          ( FBSTRING *str, unsigned int seed );
+
+/* string builder, see inc/fbstrbuilder.bi */
+FBCALL void         fb_StrReserve       ( FBSTRING *sb, ssize_t capacity );
+FBCALL ssize_t      fb_StrCapacity      ( FBSTRING *sb );
+FBCALL void         fb_StrClear         ( FBSTRING *sb );
+FBCALL void         fb_StrAppend        ( FBSTRING *sb, FBSTRING *src );
+FBCALL void         fb_StrAppendBuf     ( FBSTRING *sb, const void *src, ssize_t len );
+FBCALL void         fb_StrAppendChar    ( FBSTRING *sb, int ch, ssize_t count );
+FBCALL void         fb_StrAppendLongint ( FBSTRING *sb, long long value );
+FBCALL void         fb_StrAppendULongint( FBSTRING *sb, unsigned long long value );
+FBCALL void         fb_StrAppendDouble  ( FBSTRING *sb, double value );
+FBCALL void         fb_StrAppendSingle  ( FBSTRING *sb, float value );
+FBCALL FBSTRING    *fb_StrTake          ( FBSTRING *sb );
 
 FBCALL char        *fb_hBoolToStr       ( char num );
 FBCALL FBSTRING    *fb_BoolToStr        ( char num );
@@ -30,6 +30,26 @@ FBCALL int          fb_Exec             ( FBSTRING *program, FBSTRING *args );
 FBCALL int          fb_ExecEx           ( FBSTRING *program, FBSTRING *args, int do_wait );
        int          fb_hParseArgs       ( char *dst, const char *src, ssize_t length );
 
+/* child processes with pipes, see inc/fbprocess.bi */
+typedef struct _FB_PROCESS FB_PROCESS;
+
+#define FB_PROCESS_STDIN    1
+#define FB_PROCESS_STDOUT   2
+#define FB_PROCESS_STDERR   4
+#define FB_PROCESS_MERGE    8       /* stderr goes to the stdout pipe */
+#define FB_PROCESS_EXITED   16      /* fb_ProcessPoll() result */
+#define FB_PROCESS_RUNNING  (-2)    /* fb_ProcessWait() result */
+
+FBCALL FB_PROCESS  *fb_ProcessStart     ( const char *program, const char *args, int flags );
+FBCALL ssize_t      fb_ProcessWrite     ( FB_PROCESS *proc, const void *buffer, ssize_t size );
+FBCALL int          fb_ProcessCloseInput( FB_PROCESS *proc );
+FBCALL ssize_t      fb_ProcessRead      ( FB_PROCESS *proc, int stream, void *buffer, ssize_t size );
+FBCALL FBSTRING    *fb_ProcessReadAll   ( FB_PROCESS *proc, int stream );
+FBCALL int          fb_ProcessPoll      ( FB_PROCESS *proc, int timeout );
+FBCALL int          fb_ProcessWait      ( FB_PROCESS *proc, int timeout );
+FBCALL int          fb_ProcessKill      ( FB_PROCESS *proc );
+FBCALL int          fb_ProcessClose     ( FB_PROCESS *proc );
+
 FBCALL size_t       fb_GetMemAvail      ( int mode );
 
 FBCALL void        *fb_DylibLoad        ( FBSTRING *library );
@@ -49,3 +69,12 @@ FBCALL int          fb_Wait             ( unsigned short port, int val_and, int
 
        void         fb_hRtInit          ( void );
        void         fb_hRtExit          ( void );
+
+FBCALL void        *fb_ProfileEnter     ( const char *procname );
+FBCALL void         fb_ProfileExit      ( void *handle );
+
+#ifdef HOST_LINUX
+       void         fb_hProfileSampleInit  ( void );
+       void         fb_hProfileSampleExit  ( void );
+       void         fb_hProfileSampleThread( void );
+#endif
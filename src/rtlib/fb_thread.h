@@ -36,6 +36,8 @@ enum {
 	FB_TLSKEY_INPUT,
 	FB_TLSKEY_PRINTUSG,
 	FB_TLSKEY_GFX,
+	FB_TLSKEY_PROFILE,
+	FB_TLSKEY_DATA,
 	FB_TLSKEYS
 };
 
@@ -47,4 +49,20 @@ FBCALL void              fb_TlsFreeCtxTb( void );
        void              fb_TlsExit     ( void );
 #endif
 
+#ifdef ENABLE_NATIVE_TLS
+/* the table is thread-local itself, so an existing context can be
+   returned without calling into fb_TlsGetCtx() */
+extern FB_TLSVAR void *__fb_tls_ctxtb[FB_TLSKEYS];
+
+static __inline__ void *fb_hTlsGetCtx( int index, size_t len )
+{
+	void *ctx = __fb_tls_ctxtb[index];
+	if( ctx == NULL )
+		ctx = fb_TlsGetCtx( index, len );
+	return ctx;
+}
+
+#define FB_TLSGETCTX(id) ((FB_##id##CTX *)fb_hTlsGetCtx( FB_TLSKEY_##id, sizeof( FB_##id##CTX ) ))
+#else
 #define FB_TLSGETCTX(id) ((FB_##id##CTX *)fb_TlsGetCtx( FB_TLSKEY_##id, sizeof( FB_##id##CTX ) ))
+#endif
@@ -186,51 +186,22 @@ static __inline__ FB_WCHAR *fb_wstr_Move( FB_WCHAR *dst, const FB_WCHAR *src, ss
 	return (FB_WCHAR *) FB_MEMCPYX( dst, src, chars * sizeof( FB_WCHAR ) );
 }
 
-static __inline__ void fb_wstr_Fill( FB_WCHAR *dst, FB_WCHAR c, ssize_t chars )
-{
-	ssize_t i;
-	for( i = 0; i < chars; i++ )
-		*dst++ = c;
-	/* add null-term */
-	*dst = _LC('\0');
-}
+/* Fill with n characters (c) and terminate with NUL. */
+void fb_wstr_Fill( FB_WCHAR *dst, FB_WCHAR c, ssize_t chars );
 
 /* Skip all characters (c) from the beginning of the string, max 'n' chars. */
-static __inline__ const FB_WCHAR *fb_wstr_SkipChar( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c )
-{
-	if( s == NULL )
-		return NULL;
-
-	const FB_WCHAR *p = s;
-	while( chars > 0 )
-	{
-		if( *p != c )
-			return p;
-		++p;
-		--chars;
-	}
-
-	return p;
-}
+const FB_WCHAR *fb_wstr_SkipChar( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c );
 
 /* Skip all characters (c) from the end of the string, max 'n' chars. */
-static __inline__ const FB_WCHAR *fb_wstr_SkipCharRev( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c )
-{
-	if( (s == NULL) || (chars <= 0) )
-		return s;
+const FB_WCHAR *fb_wstr_SkipCharRev( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c );
 
-	/* fixed-len's are filled with null's as in PB, strip them too */
-	const FB_WCHAR *p = &s[chars];
-	while( chars > 0 )
-	{
-		--p;
-		if( *p != c )
-			return ++p;
-		--chars;
-	}
+/* Number of characters from the beginning (end) of the string, max 'n',
+   that are in set (or are NUL, as with wcschr()). */
+ssize_t fb_wstr_SkipAny( const FB_WCHAR *s, ssize_t chars, const FB_WCHAR *set );
+ssize_t fb_wstr_SkipAnyRev( const FB_WCHAR *s, ssize_t chars, const FB_WCHAR *set );
 
-	return p;
-}
+/* UCASE/LCASE: mode 1 = ASCII letters only, else by the locale. */
+void fb_wstr_ConvCase( FB_WCHAR *dst, const FB_WCHAR *src, ssize_t chars, int upper, int mode );
 
 static __inline__ FB_WCHAR *fb_wstr_Instr( const FB_WCHAR *s, const FB_WCHAR *patt )
 {
@@ -87,11 +87,15 @@ int fb_FileGetDataEx
                      handle->putback_size );
 		}
 
-        pachData += bytes;
-
         if( handle->encod != FB_FILE_ENCOD_ASCII )
         	bytes /= sizeof( FB_WCHAR );
 
+        /* bytes is the number of chars now, advance by what was stored */
+        if( is_unicode )
+        	pachData += bytes * sizeof( FB_WCHAR );
+        else
+        	pachData += bytes;
+
         read_chars = bytes;
         chars -= bytes;
     }
@@ -90,3 +90,52 @@ FBCALL void fb_GosubExit( GOSUBCTX * ctx )
 		}
 	}
 }
+
+/* Overflow of the index stack the compiler keeps in the procedure frame
+   for GOSUB with -gen gcc/llvm (see ast-gosub.bas::hDispatchPush()):
+   entries beyond its FB_GOSUBSTACKSIZE are stored in a heap block, whose
+   first element is its capacity. *stk is NULL until the first overflow,
+   it's freed by fb_GosubStackExit() */
+
+/*:::::*/
+FBCALL int fb_GosubStackPush( size_t **stk, size_t depth, size_t index )
+{
+	size_t *p, capacity;
+
+	capacity = (*stk ? (*stk)[0] : 0);
+	if( depth >= capacity )
+	{
+		capacity = (capacity ? capacity * 2 : 64);
+		if( (depth >= capacity) || (capacity >= SIZE_MAX / sizeof( size_t )) )
+			return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+
+		p = realloc( *stk, (1 + capacity) * sizeof( size_t ) );
+		if( p == NULL )
+			return fb_ErrorSetNum( FB_RTERROR_OUTOFMEM );
+
+		p[0] = capacity;
+		*stk = p;
+	}
+
+	(*stk)[1 + depth] = index;
+
+	return fb_ErrorSetNum( FB_RTERROR_OK );
+}
+
+/*:::::*/
+FBCALL size_t fb_GosubStackGet( size_t *stk, size_t depth )
+{
+	/* not pushed (out of memory): an invalid index, RETURN then leaves
+	   the procedure through the dispatcher's default label */
+	if( (stk == NULL) || (depth >= stk[0]) )
+		return (size_t)-1;
+
+	return stk[1 + depth];
+}
+
+/*:::::*/
+FBCALL void fb_GosubStackExit( size_t **stk )
+{
+	free( *stk );
+	*stk = NULL;
+}
@@ -24,6 +24,11 @@ void fb_hRtInit( void )
 	fb_TlsInit( );
 #endif
 
+#ifdef HOST_LINUX
+	/* FB_SAMPLE_PROFILE sampling profiler */
+	fb_hProfileSampleInit( );
+#endif
+
 	/**
 	 * With the default "C" locale (which is just plain 7-bit ASCII),
 	 * our mbstowcs() calls (from fb_wstr_ConvFromA()) fail to convert
@@ -78,6 +83,11 @@ void fb_hRtExit( void )
 	   and it depends on the platform (e.g. GNU/Linux vs MinGW-w64).
 	   Thus it can't be used reliably. */
 
+#ifdef HOST_LINUX
+	/* Stop sampling and write the samples, before the clean-up */
+	fb_hProfileSampleExit( );
+#endif
+
 	fb_FileReset( );
 
 	/* os-dep termination */
@@ -88,6 +98,11 @@ void fb_hRtExit( void )
 	/* Free main thread's TLS contexts */
 	fb_TlsFreeCtxTb( );
 
+	/* Write the -profgen fbrt report, once all threads handed over
+	   their call trees */
+	if( __fb_ctx.exit_profile )
+		__fb_ctx.exit_profile( );
+
 #ifdef ENABLE_MT
 	fb_TlsExit( );
 #endif
@@ -0,0 +1,300 @@
+/* sampling profiler, enabled through the FB_SAMPLE_PROFILE environment variable
+
+     FB_SAMPLE_PROFILE=<rate>[,stack]
+
+   arms a SIGPROF timer firing <rate> times per second of CPU time (1000 if
+   the rate is omitted or invalid). The kernel delivers each SIGPROF to the
+   thread that used up the time slice, so every thread is sampled in
+   proportion to the CPU time it uses. The signal handler stores the
+   interrupted program counter, and with ",stack" the return addresses found
+   by following the frame pointers, into a ring buffer; at exit the samples
+   are written to profile.samples. 'fbc -profreport profile.samples' maps
+   them back to procedure names, using the symbol table of the executable
+   (compile and link with -g, so it isn't stripped). */
+
+/* for REG_RIP etc. and pthread_getattr_np() */
+#define _GNU_SOURCE 1
+
+#include "../fb.h"
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/time.h>
+#include <link.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+
+#if defined HOST_X86_64
+	#define SAMPLE_PC(uc) ((void *)(uc)->uc_mcontext.gregs[REG_RIP])
+	#define SAMPLE_FP(uc) ((void **)(uc)->uc_mcontext.gregs[REG_RBP])
+	#define SAMPLE_SP(uc) ((char *)(uc)->uc_mcontext.gregs[REG_RSP])
+#elif defined HOST_X86
+	#define SAMPLE_PC(uc) ((void *)(uc)->uc_mcontext.gregs[REG_EIP])
+	#define SAMPLE_FP(uc) ((void **)(uc)->uc_mcontext.gregs[REG_EBP])
+	#define SAMPLE_SP(uc) ((char *)(uc)->uc_mcontext.gregs[REG_ESP])
+#elif defined __aarch64__
+	#define SAMPLE_PC(uc) ((void *)(uc)->uc_mcontext.pc)
+	#define SAMPLE_FP(uc) ((void **)(uc)->uc_mcontext.regs[29])
+	#define SAMPLE_SP(uc) ((char *)(uc)->uc_mcontext.sp)
+#elif defined __arm__
+	/* no frame walk: the ARM frame layout depends on the compiler */
+	#define SAMPLE_PC(uc) ((void *)(uc)->uc_mcontext.arm_pc)
+#endif
+
+/* room for this many addresses in total; each sample takes one, or
+   SAMPLE_DEPTH with stack walks */
+#define SAMPLE_BUFSIZE (1024 * 1024)
+#define SAMPLE_DEPTH   16
+#define SAMPLE_FILE    "profile.samples"
+
+#ifdef SAMPLE_PC
+
+static void ** volatile sample_buffer = NULL;
+static size_t sample_stride;             /* addresses per sample */
+static size_t sample_max;                /* samples in the ring buffer */
+static volatile size_t sample_count = 0; /* samples taken, may wrap the ring */
+static volatile int sample_active = 0;   /* handlers currently running */
+static int sample_rate;
+static int sample_stack;
+
+/* bounds of the current thread's stack, to validate the frame pointers */
+static __thread char *stack_lo, *stack_hi;
+
+static void hSampleHandler( int sig, siginfo_t *info, void *context )
+{
+	ucontext_t *uc = (ucontext_t *)context;
+	size_t index;
+	void **buffer, **slot;
+	size_t depth = 1;
+
+	__sync_fetch_and_add( &sample_active, 1 );
+	buffer = sample_buffer;
+	if( buffer == NULL ) {
+		__sync_fetch_and_sub( &sample_active, 1 );
+		return;
+	}
+
+	index = __sync_fetch_and_add( &sample_count, 1 ) % sample_max;
+	slot = buffer + (index * sample_stride);
+	slot[0] = SAMPLE_PC( uc );
+
+#ifdef SAMPLE_FP
+	if( sample_stack && stack_hi ) {
+		/* each frame starts with the caller's frame pointer followed by
+		   the return address; only follow frame pointers that stay on
+		   this thread's stack and move towards its base, so code built
+		   without frame pointers just ends the walk */
+		void **fp = SAMPLE_FP( uc ), **next;
+		char *lo = SAMPLE_SP( uc );
+
+		if( lo < stack_lo )
+			lo = stack_lo;
+
+		while( depth < SAMPLE_DEPTH ) {
+			if( ((char *)fp < lo) || ((char *)(fp + 2) > stack_hi) ||
+			    (((size_t)fp & (sizeof( void * ) - 1)) != 0) )
+				break;
+			slot[depth++] = fp[1];
+			next = (void **)fp[0];
+			if( next <= fp )
+				break;
+			lo = (char *)(fp + 2);
+			fp = next;
+		}
+	}
+#endif
+
+	if( depth < sample_stride )
+		slot[depth] = NULL;
+
+	__sync_fetch_and_sub( &sample_active, 1 );
+}
+
+/* called for every thread created by fb_ThreadCreate() */
+void fb_hProfileSampleThread( void )
+{
+	pthread_attr_t attr;
+	void *addr;
+	size_t size;
+
+	if( (sample_buffer == NULL) || !sample_stack )
+		return;
+
+	if( pthread_getattr_np( pthread_self( ), &attr ) != 0 )
+		return;
+
+	if( pthread_attr_getstack( &attr, &addr, &size ) == 0 ) {
+		stack_lo = (char *)addr;
+		stack_hi = (char *)addr + size;
+	}
+
+	pthread_attr_destroy( &attr );
+}
+
+/* called from fb_hRtInit() */
+void fb_hProfileSampleInit( void )
+{
+	const char *env = getenv( "FB_SAMPLE_PROFILE" );
+	struct sigaction sa, oldsa;
+	struct itimerval timer;
+
+	if( (env == NULL) || (*env == '\0') )
+		return;
+
+	sample_rate = atoi( env );
+	if( (sample_rate <= 0) || (sample_rate > 1000000) )
+		sample_rate = 1000;
+
+#ifdef SAMPLE_FP
+	sample_stack = (strstr( env, ",stack" ) != NULL);
+#else
+	sample_stack = FALSE;
+#endif
+
+	sample_stride = sample_stack ? SAMPLE_DEPTH : 1;
+	sample_max = SAMPLE_BUFSIZE / sample_stride;
+
+	/* allocated up-front, the signal handler must not call malloc() */
+	sample_buffer = calloc( SAMPLE_BUFSIZE, sizeof( void * ) );
+	if( sample_buffer == NULL )
+		return;
+
+	fb_hProfileSampleThread( );
+
+	memset( &sa, 0, sizeof( sa ) );
+	sa.sa_sigaction = hSampleHandler;
+	sa.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset( &sa.sa_mask );
+	if( sigaction( SIGPROF, &sa, &oldsa ) != 0 ) {
+		free( sample_buffer );
+		sample_buffer = NULL;
+		return;
+	}
+
+	/* rates of 1 per second give tv_sec = 1, tv_usec = 0 */
+	timer.it_interval.tv_sec = 1 / sample_rate;
+	timer.it_interval.tv_usec = (1000000 / sample_rate) % 1000000;
+	timer.it_value = timer.it_interval;
+	if( setitimer( ITIMER_PROF, &timer, NULL ) != 0 ) {
+		sigaction( SIGPROF, &oldsa, NULL );
+		free( sample_buffer );
+		sample_buffer = NULL;
+	}
+}
+
+typedef struct _FB_SAMPLE_EXE {
+	ElfW(Addr) bias;
+	ElfW(Addr) lo, hi;
+} FB_SAMPLE_EXE;
+
+static int hFindExe( struct dl_phdr_info *info, size_t size, void *data )
+{
+	FB_SAMPLE_EXE *exe = (FB_SAMPLE_EXE *)data;
+	ElfW(Addr) lo, hi;
+	int i;
+
+	/* the executable is the first object reported */
+	exe->bias = info->dlpi_addr;
+	for( i = 0; i < info->dlpi_phnum; i++ ) {
+		if( info->dlpi_phdr[i].p_type != PT_LOAD )
+			continue;
+		lo = info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+		hi = lo + info->dlpi_phdr[i].p_memsz;
+		if( (exe->hi == 0) || (lo < exe->lo) )
+			exe->lo = lo;
+		if( hi > exe->hi )
+			exe->hi = hi;
+	}
+
+	return 1;
+}
+
+/* called from fb_hRtExit() */
+void fb_hProfileSampleExit( void )
+{
+	struct itimerval timer;
+	sigset_t set;
+	void **buffer;
+	FB_SAMPLE_EXE exe;
+	char exename[1024];
+	size_t count, first, i, j;
+	ssize_t len;
+	ElfW(Addr) addr;
+	void **slot;
+	FILE *f;
+
+	if( sample_buffer == NULL )
+		return;
+
+	/* stop the timer and keep any SIGPROF still pending from reaching the
+	   handler, then wait for handlers running in other threads to finish
+	   before the buffer is read and freed */
+	memset( &timer, 0, sizeof( timer ) );
+	setitimer( ITIMER_PROF, &timer, NULL );
+	sigemptyset( &set );
+	sigaddset( &set, SIGPROF );
+	pthread_sigmask( SIG_BLOCK, &set, NULL );
+	signal( SIGPROF, SIG_IGN );
+
+	buffer = sample_buffer;
+	sample_buffer = NULL;
+	__sync_synchronize( );
+	while( sample_active != 0 )
+		sched_yield( );
+
+	memset( &exe, 0, sizeof( exe ) );
+	dl_iterate_phdr( hFindExe, &exe );
+
+	len = readlink( "/proc/self/exe", exename, sizeof( exename ) - 1 );
+	if( len < 0 )
+		len = 0;
+	exename[len] = '\0';
+
+	f = fopen( SAMPLE_FILE, "w" );
+	if( f != NULL ) {
+		count = sample_count;
+		first = 0;
+		if( count > sample_max ) {
+			/* the ring buffer wrapped, the oldest sample is the next
+			   one to be overwritten */
+			first = count % sample_max;
+		}
+
+		fprintf( f, "fbsamples 1\n" );
+		fprintf( f, "exe %s\n", exename );
+		fprintf( f, "rate %d\n", sample_rate );
+		fprintf( f, "stack %d\n", sample_stack ? 1 : 0 );
+		fprintf( f, "lost %llu\n", (unsigned long long)((count > sample_max) ? count - sample_max : 0) );
+
+		/* one line per sample: the program counter followed by the
+		   return addresses, as offsets into the executable's image
+		   (0 for code in shared libraries) */
+		if( count > sample_max )
+			count = sample_max;
+		for( i = 0; i < count; i++ ) {
+			slot = buffer + (((first + i) % sample_max) * sample_stride);
+			for( j = 0; (j < sample_stride) && (slot[j] != NULL); j++ ) {
+				addr = (ElfW(Addr))slot[j];
+				if( (addr >= exe.lo) && (addr < exe.hi) )
+					addr -= exe.bias;
+				else
+					addr = 0;
+				fprintf( f, (j > 0) ? " %llx" : "%llx", (unsigned long long)addr );
+			}
+			fputc( '\n', f );
+		}
+
+		fclose( f );
+	}
+
+	free( buffer );
+}
+
+#else
+
+/* architecture without a known signal context layout: no sampling */
+void fb_hProfileSampleInit( void ) { }
+void fb_hProfileSampleExit( void ) { }
+void fb_hProfileSampleThread( void ) { }
+
+#endif
@@ -0,0 +1,433 @@
+/* built-in instrumenting profiler (fbc -profgen fbrt)
+
+   fbc emits a fb_ProfileEnter() call at the top of every procedure and a
+   fb_ProfileExit() call behind its exit label. Each thread records its own
+   call tree (one node per distinct call path), so the hooks don't need any
+   locking. When a thread ends, its tree is moved to a global list, and at
+   program exit all trees are written out:
+
+     profile.txt     flat profile, caller -> callee edges and the call trees
+     profile.folded  "a;b;c <self microseconds>" lines (flamegraph.pl input)
+*/
+
+#include "fb.h"
+
+typedef struct _FB_PROFILE_NODE {
+	const char *name;
+	struct _FB_PROFILE_NODE *parent;
+	struct _FB_PROFILE_NODE *child;        /* first callee */
+	struct _FB_PROFILE_NODE *next;         /* next callee of the parent */
+	unsigned long long calls;
+	unsigned long long ticks;              /* inclusive */
+	unsigned long long child_ticks;        /* spent in callees */
+	unsigned long long start;
+} FB_PROFILE_NODE;
+
+typedef struct _FB_PROFILE_THREAD {
+	FB_PROFILE_NODE root;
+	int id;
+	struct _FB_PROFILE_THREAD *next;
+} FB_PROFILE_THREAD;
+
+typedef struct _FB_PROFILECTX {
+	FB_PROFILE_THREAD *thread;
+	FB_PROFILE_NODE *curr;
+} FB_PROFILECTX;
+
+/* aggregated per procedure (caller = NULL) or per caller -> callee edge */
+typedef struct _FB_PROFILE_STAT {
+	const char *caller;
+	const char *name;
+	unsigned long long calls;
+	unsigned long long ticks;
+	unsigned long long self_ticks;
+	struct _FB_PROFILE_STAT *next;
+} FB_PROFILE_STAT;
+
+#define FB_PROFILE_BUCKETS 4096
+
+typedef struct _FB_PROFILE_STATS {
+	FB_PROFILE_STAT *buckets[FB_PROFILE_BUCKETS];
+	size_t count;
+} FB_PROFILE_STATS;
+
+static FB_PROFILE_THREAD *ended_threads = NULL;
+static int thread_count = 0;
+static unsigned long long start_ticks;
+static double start_time;
+
+static void hProfileThreadEnd( void *data );
+static void hProfileEnd( void );
+
+static __inline__ unsigned long long hGetTicks( void )
+{
+#if defined HOST_X86 || defined HOST_X86_64
+	return __builtin_ia32_rdtsc( );
+#else
+	return (unsigned long long)(fb_Timer( ) * 1000000000.0);
+#endif
+}
+
+static void hInitThread( FB_PROFILECTX *ctx )
+{
+	FB_PROFILE_THREAD *thread = calloc( 1, sizeof( FB_PROFILE_THREAD ) );
+
+	FB_LOCK( );
+	if( thread_count == 0 ) {
+		start_ticks = hGetTicks( );
+		start_time = fb_Timer( );
+		__fb_ctx.profile_thread_end = hProfileThreadEnd;
+		__fb_ctx.exit_profile = hProfileEnd;
+	}
+	thread->id = ++thread_count;
+	FB_UNLOCK( );
+
+	ctx->thread = thread;
+	ctx->curr = &thread->root;
+}
+
+FBCALL void *fb_ProfileEnter( const char *procname )
+{
+	FB_PROFILECTX *ctx = FB_TLSGETCTX( PROFILE );
+	FB_PROFILE_NODE *parent, *node, **prev;
+
+	if( ctx->thread == NULL )
+		hInitThread( ctx );
+
+	/* find the callee, and move it to the front of the parent's list,
+	   so procedures called in a loop are found at once */
+	parent = ctx->curr;
+	prev = &parent->child;
+	for( node = parent->child; node != NULL; node = node->next ) {
+		if( node->name == procname )
+			break;
+		prev = &node->next;
+	}
+
+	if( node == NULL ) {
+		node = calloc( 1, sizeof( FB_PROFILE_NODE ) );
+		node->name = procname;
+		node->parent = parent;
+	} else {
+		*prev = node->next;
+	}
+	node->next = parent->child;
+	parent->child = node;
+
+	node->calls += 1;
+	ctx->curr = node;
+	node->start = hGetTicks( );
+
+	return node;
+}
+
+FBCALL void fb_ProfileExit( void *handle )
+{
+	FB_PROFILE_NODE *node = (FB_PROFILE_NODE *)handle;
+	unsigned long long ticks = hGetTicks( ) - node->start;
+
+	node->ticks += ticks;
+	node->parent->child_ticks += ticks;
+
+	/* from the node instead of ctx->curr, so procedures left without
+	   their exit hook (RESUME into a caller) don't skew the tree */
+	FB_TLSGETCTX( PROFILE )->curr = node->parent;
+}
+
+/* close the procedures that are still running (END called from a
+   procedure, threads still running at exit) */
+static void hCloseOpenCalls( FB_PROFILECTX *ctx )
+{
+	unsigned long long now = hGetTicks( );
+	FB_PROFILE_NODE *node;
+
+	for( node = ctx->curr; node->parent != NULL; node = node->parent ) {
+		node->ticks += now - node->start;
+		node->parent->child_ticks += now - node->start;
+	}
+	ctx->curr = node;
+}
+
+/* called through __fb_ctx.profile_thread_end by fb_TlsDelCtx() */
+static void hProfileThreadEnd( void *data )
+{
+	FB_PROFILECTX *ctx = (FB_PROFILECTX *)data;
+
+	if( ctx->thread == NULL )
+		return;
+
+	hCloseOpenCalls( ctx );
+
+	FB_LOCK( );
+	ctx->thread->next = ended_threads;
+	ended_threads = ctx->thread;
+	FB_UNLOCK( );
+
+	ctx->thread = NULL;
+	ctx->curr = NULL;
+}
+
+/*:::::*/
+static unsigned int hHash( const char *s, unsigned int h )
+{
+	while( *s )
+		h = (h * 31) + (unsigned char)*s++;
+	return h;
+}
+
+static FB_PROFILE_STAT *hLookupStat( FB_PROFILE_STATS *stats, const char *caller, const char *name )
+{
+	unsigned int h = hHash( name, caller ? hHash( caller, 0 ) : 0 ) % FB_PROFILE_BUCKETS;
+	FB_PROFILE_STAT *stat;
+
+	for( stat = stats->buckets[h]; stat != NULL; stat = stat->next ) {
+		if( strcmp( stat->name, name ) != 0 )
+			continue;
+		if( (stat->caller == NULL) != (caller == NULL) )
+			continue;
+		if( caller && (strcmp( stat->caller, caller ) != 0) )
+			continue;
+		return stat;
+	}
+
+	stat = calloc( 1, sizeof( FB_PROFILE_STAT ) );
+	stat->caller = caller;
+	stat->name = name;
+	stat->next = stats->buckets[h];
+	stats->buckets[h] = stat;
+	stats->count += 1;
+	return stat;
+}
+
+/* recursive calls must only count once into the inclusive time */
+static int hIsRecursive( FB_PROFILE_NODE *node )
+{
+	FB_PROFILE_NODE *p;
+	for( p = node->parent; p->parent != NULL; p = p->parent ) {
+		if( strcmp( p->name, node->name ) == 0 )
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/* pre-order walk over a call tree, without recursion (trees of recursive
+   procedures can be very deep) */
+static FB_PROFILE_NODE *hNextNode( FB_PROFILE_NODE *node )
+{
+	if( node->child )
+		return node->child;
+
+	while( node->parent != NULL ) {
+		if( node->next )
+			return node->next;
+		node = node->parent;
+	}
+
+	return NULL;
+}
+
+static int hDepth( FB_PROFILE_NODE *node )
+{
+	int depth = 0;
+	for( node = node->parent; node != NULL; node = node->parent )
+		depth += 1;
+	return depth;
+}
+
+static void hAddStats( FB_PROFILE_STATS *procs, FB_PROFILE_STATS *edges, FB_PROFILE_THREAD *thread )
+{
+	FB_PROFILE_NODE *node;
+	FB_PROFILE_STAT *stat;
+	int recursive;
+
+	for( node = hNextNode( &thread->root ); node != NULL; node = hNextNode( node ) ) {
+		recursive = hIsRecursive( node );
+
+		stat = hLookupStat( procs, NULL, node->name );
+		stat->calls += node->calls;
+		stat->self_ticks += node->ticks - node->child_ticks;
+		if( !recursive )
+			stat->ticks += node->ticks;
+
+		if( node->parent->parent != NULL ) {
+			stat = hLookupStat( edges, node->parent->name, node->name );
+			stat->calls += node->calls;
+			stat->self_ticks += node->ticks - node->child_ticks;
+			if( !recursive )
+				stat->ticks += node->ticks;
+		}
+	}
+}
+
+static FB_PROFILE_STAT **hSortStats( FB_PROFILE_STATS *stats, int (*cmp)( const void *, const void * ) )
+{
+	FB_PROFILE_STAT **tb = malloc( (stats->count + 1) * sizeof( FB_PROFILE_STAT * ) );
+	FB_PROFILE_STAT *stat;
+	size_t i, n = 0;
+
+	for( i = 0; i < FB_PROFILE_BUCKETS; i++ )
+		for( stat = stats->buckets[i]; stat != NULL; stat = stat->next )
+			tb[n++] = stat;
+
+	qsort( tb, n, sizeof( FB_PROFILE_STAT * ), cmp );
+	return tb;
+}
+
+static int hCmpSelf( const void *a, const void *b )
+{
+	const FB_PROFILE_STAT *l = *(const FB_PROFILE_STAT **)a, *r = *(const FB_PROFILE_STAT **)b;
+	return (l->self_ticks < r->self_ticks) - (l->self_ticks > r->self_ticks);
+}
+
+static int hCmpTotal( const void *a, const void *b )
+{
+	const FB_PROFILE_STAT *l = *(const FB_PROFILE_STAT **)a, *r = *(const FB_PROFILE_STAT **)b;
+	return (l->ticks < r->ticks) - (l->ticks > r->ticks);
+}
+
+static void hFreeStats( FB_PROFILE_STATS *stats )
+{
+	FB_PROFILE_STAT *stat, *next;
+	size_t i;
+
+	for( i = 0; i < FB_PROFILE_BUCKETS; i++ ) {
+		for( stat = stats->buckets[i]; stat != NULL; stat = next ) {
+			next = stat->next;
+			free( stat );
+		}
+	}
+}
+
+static void hWriteFolded( FILE *f, FB_PROFILE_THREAD *thread, double ticks_per_us )
+{
+	FB_PROFILE_NODE *node, *p, **path = NULL;
+	int depth, maxdepth = 0, i;
+	unsigned long long us;
+
+	for( node = hNextNode( &thread->root ); node != NULL; node = hNextNode( node ) ) {
+		us = (unsigned long long)((double)(node->ticks - node->child_ticks) / ticks_per_us);
+		if( us == 0 )
+			continue;
+
+		depth = hDepth( node );
+		if( depth > maxdepth ) {
+			maxdepth = depth;
+			path = realloc( path, maxdepth * sizeof( FB_PROFILE_NODE * ) );
+		}
+
+		i = depth;
+		for( p = node; p->parent != NULL; p = p->parent )
+			path[--i] = p;
+
+		for( i = 0; i < depth; i++ )
+			fprintf( f, "%s%s", (i > 0) ? ";" : "", path[i]->name );
+		fprintf( f, " %llu\n", us );
+	}
+
+	free( path );
+}
+
+static void hWriteReport( FB_PROFILE_THREAD *threads, double ticks_per_sec )
+{
+	FB_PROFILE_STATS *procs = calloc( 1, sizeof( FB_PROFILE_STATS ) );
+	FB_PROFILE_STATS *edges = calloc( 1, sizeof( FB_PROFILE_STATS ) );
+	FB_PROFILE_THREAD *thread;
+	FB_PROFILE_NODE *node;
+	FB_PROFILE_STAT **tb;
+	double ms = ticks_per_sec / 1000.0;
+	size_t i;
+	FILE *f;
+
+	for( thread = threads; thread != NULL; thread = thread->next )
+		hAddStats( procs, edges, thread );
+
+	f = fopen( "profile.txt", "w" );
+	if( f != NULL ) {
+		fprintf( f, "Profiling results (%d thread%s)\n\n", thread_count, (thread_count != 1) ? "s" : "" );
+
+		fprintf( f, "Procedures, by self time:\n" );
+		fprintf( f, "%12s %14s %14s  %s\n", "calls", "total ms", "self ms", "procedure" );
+		tb = hSortStats( procs, hCmpSelf );
+		for( i = 0; i < procs->count; i++ )
+			fprintf( f, "%12llu %14.3f %14.3f  %s\n", tb[i]->calls,
+			         (double)tb[i]->ticks / ms, (double)tb[i]->self_ticks / ms, tb[i]->name );
+		free( tb );
+
+		fprintf( f, "\nCalls, by total time:\n" );
+		fprintf( f, "%12s %14s %14s  %s\n", "calls", "total ms", "self ms", "caller -> callee" );
+		tb = hSortStats( edges, hCmpTotal );
+		for( i = 0; i < edges->count; i++ )
+			fprintf( f, "%12llu %14.3f %14.3f  %s -> %s\n", tb[i]->calls,
+			         (double)tb[i]->ticks / ms, (double)tb[i]->self_ticks / ms,
+			         tb[i]->caller, tb[i]->name );
+		free( tb );
+
+		for( thread = threads; thread != NULL; thread = thread->next ) {
+			fprintf( f, "\nCall tree, thread %d:\n", thread->id );
+			fprintf( f, "%12s %14s %14s  %s\n", "calls", "total ms", "self ms", "procedure" );
+			for( node = hNextNode( &thread->root ); node != NULL; node = hNextNode( node ) )
+				fprintf( f, "%12llu %14.3f %14.3f  %*s%s\n", node->calls,
+				         (double)node->ticks / ms, (double)(node->ticks - node->child_ticks) / ms,
+				         (hDepth( node ) - 1) * 2, "", node->name );
+		}
+
+		fclose( f );
+	}
+
+	f = fopen( "profile.folded", "w" );
+	if( f != NULL ) {
+		for( thread = threads; thread != NULL; thread = thread->next )
+			hWriteFolded( f, thread, ticks_per_sec / 1000000.0 );
+		fclose( f );
+	}
+
+	hFreeStats( procs );
+	hFreeStats( edges );
+	free( procs );
+	free( edges );
+}
+
+static void hFreeTree( FB_PROFILE_NODE *root )
+{
+	FB_PROFILE_NODE *node = root->child, *next;
+
+	/* free bottom-up: unlink leaves until only the root is left */
+	while( node != NULL ) {
+		if( node->child ) {
+			node = node->child;
+			continue;
+		}
+		next = node->next ? node->next : node->parent;
+		node->parent->child = node->next;
+		free( node );
+		node = (next == root) ? root->child : next;
+	}
+}
+
+/* called through __fb_ctx.exit_profile by fb_hRtExit(), after the main
+   thread's contexts were freed (and so its tree was moved to the list) */
+static void hProfileEnd( void )
+{
+	FB_PROFILE_THREAD *thread, *next;
+	unsigned long long ticks = hGetTicks( ) - start_ticks;
+	double elapsed = fb_Timer( ) - start_time;
+	double ticks_per_sec;
+
+	if( elapsed > 0.0 )
+		ticks_per_sec = (double)ticks / elapsed;
+	else
+		ticks_per_sec = 1000000000.0;
+
+	FB_LOCK( );
+	thread = ended_threads;
+	ended_threads = NULL;
+	FB_UNLOCK( );
+
+	hWriteReport( thread, ticks_per_sec );
+
+	for( ; thread != NULL; thread = next ) {
+		next = thread->next;
+		hFreeTree( &thread->root );
+		free( thread );
+	}
+}
@@ -0,0 +1,194 @@
+/* string builder functions (inc/fbstrbuilder.bi)
+ *
+ * the builder is a normal var-len string, its descriptor's size is the
+ * capacity; appending grows it geometrically and writes numbers straight
+ * into the buffer, without temp strings */
+
+#include "fb.h"
+
+/* make room for len more chars, returns the position to write them at */
+static char *hGrow( FBSTRING *sb, ssize_t len )
+{
+	ssize_t used = FB_STRSIZE( sb ), needed = used + len, newsize;
+	char *data;
+
+	if( (sb->data != NULL) && (needed <= sb->size) )
+		return sb->data + used;
+
+	/* at least double it, so n appends take O(n) time */
+	newsize = sb->size * 2;
+	if( newsize < needed )
+		newsize = needed;
+	if( newsize < 32 )
+		newsize = 32;
+
+	data = (char *)realloc( sb->data, newsize + 1 );
+	if( data == NULL ) {
+		/* try the exact size */
+		newsize = needed;
+		data = (char *)realloc( sb->data, newsize + 1 );
+		if( data == NULL )
+			return NULL;
+	}
+
+	sb->data = data;
+	sb->size = newsize;
+
+	return data + used;
+}
+
+static void hSetLength( FBSTRING *sb, ssize_t len )
+{
+	fb_hStrSetLength( sb, len );
+	sb->data[len] = '\0';
+}
+
+FBCALL void fb_StrReserve( FBSTRING *sb, ssize_t capacity )
+{
+	if( (sb == NULL) || (capacity <= sb->size) )
+		return;
+
+	if( hGrow( sb, capacity - FB_STRSIZE( sb ) ) != NULL )
+		hSetLength( sb, FB_STRSIZE( sb ) );
+}
+
+FBCALL ssize_t fb_StrCapacity( FBSTRING *sb )
+{
+	if( (sb == NULL) || (sb->data == NULL) )
+		return 0;
+
+	return sb->size;
+}
+
+FBCALL void fb_StrClear( FBSTRING *sb )
+{
+	/* keep the buffer for the next round */
+	if( (sb != NULL) && (sb->data != NULL) )
+		hSetLength( sb, 0 );
+}
+
+FBCALL void fb_StrAppendBuf( FBSTRING *sb, const void *src, ssize_t len )
+{
+	char *dst;
+	ssize_t ofs = -1;
+
+	if( (sb == NULL) || (src == NULL) || (len <= 0) )
+		return;
+
+	/* src may be in the builder itself, which can be moved by the realloc() */
+	if( (sb->data != NULL) && ((const char *)src >= sb->data) &&
+	    ((const char *)src < sb->data + sb->size + 1) )
+		ofs = (const char *)src - sb->data;
+
+	dst = hGrow( sb, len );
+	if( dst == NULL )
+		return;
+
+	if( ofs != -1 )
+		src = sb->data + ofs;
+
+	memcpy( dst, src, len );
+	hSetLength( sb, FB_STRSIZE( sb ) + len );
+}
+
+FBCALL void fb_StrAppend( FBSTRING *sb, FBSTRING *src )
+{
+	if( src == NULL )
+		return;
+
+	fb_StrAppendBuf( sb, src->data, FB_STRSIZE( src ) );
+}
+
+FBCALL void fb_StrAppendChar( FBSTRING *sb, int ch, ssize_t count )
+{
+	char *dst;
+
+	if( (sb == NULL) || (count <= 0) )
+		return;
+
+	dst = hGrow( sb, count );
+	if( dst == NULL )
+		return;
+
+	memset( dst, ch, count );
+	hSetLength( sb, FB_STRSIZE( sb ) + count );
+}
+
+FBCALL void fb_StrAppendULongint( FBSTRING *sb, unsigned long long value )
+{
+	char buffer[sizeof( long long ) * 3], *p = buffer + sizeof( buffer );
+
+	/* same as STR() */
+	do {
+		*--p = '0' + (value % 10);
+		value /= 10;
+	} while( value != 0 );
+
+	fb_StrAppendBuf( sb, p, buffer + sizeof( buffer ) - p );
+}
+
+FBCALL void fb_StrAppendLongint( FBSTRING *sb, long long value )
+{
+	char buffer[sizeof( long long ) * 3], *p = buffer + sizeof( buffer );
+	unsigned long long uvalue = (value < 0) ? -(unsigned long long)value : (unsigned long long)value;
+
+	do {
+		*--p = '0' + (uvalue % 10);
+		uvalue /= 10;
+	} while( uvalue != 0 );
+
+	if( value < 0 )
+		*--p = '-';
+
+	fb_StrAppendBuf( sb, p, buffer + sizeof( buffer ) - p );
+}
+
+static void hAppendFloat( FBSTRING *sb, double value, const char *fmt )
+{
+	char buffer[32];
+	int len;
+
+	/* same as STR(): no dot at the end */
+	len = snprintf( buffer, sizeof( buffer ), fmt, value );
+	if( (len > 0) && (buffer[len-1] == '.') )
+		--len;
+
+	fb_StrAppendBuf( sb, buffer, len );
+}
+
+FBCALL void fb_StrAppendDouble( FBSTRING *sb, double value )
+{
+	hAppendFloat( sb, value, "%.16g" );
+}
+
+FBCALL void fb_StrAppendSingle( FBSTRING *sb, float value )
+{
+	hAppendFloat( sb, value, "%.7g" );
+}
+
+/* hand the buffer over to a temp string, the assignment of the result then
+   just takes it over, without a copy */
+FBCALL FBSTRING *fb_StrTake( FBSTRING *sb )
+{
+	FBSTRING *dst;
+
+	if( (sb == NULL) || (sb->data == NULL) )
+		return &__fb_ctx.null_desc;
+
+	FB_STRLOCK( );
+	dst = fb_hStrAllocTmpDesc( );
+	FB_STRUNLOCK( );
+
+	if( dst == NULL )
+		return &__fb_ctx.null_desc;
+
+	dst->data = sb->data;
+	dst->len = FB_STRSIZE( sb ) | FB_TEMPSTRBIT;
+	dst->size = sb->size;
+
+	sb->data = NULL;
+	sb->len = 0;
+	sb->size = 0;
+
+	return dst;
+}
@@ -37,6 +37,25 @@ FBCALL FBSTRING *fb_StrConcat
 	{
 		fb_StrDelete( dst );
 	}
+	/* str1 is a temp (a + b + c...)? append to it and hand its buffer
+	   over to dst, its size grows geometrically as fb_hStrRealloc()
+	   leaves some room */
+	else if( (str1_size == -1) && (str1 != NULL) && (str1 != (void *)dst) && FB_ISTEMP( str1 ) &&
+	         (fb_hStrRealloc( (FBSTRING *)str1, str1_len+str2_len, FB_TRUE ) != NULL) )
+	{
+		FBSTRING *src = (FBSTRING *)str1;
+
+		fb_hStrCopy( src->data + str1_len, str2_ptr, str2_len );
+
+		fb_StrDelete( dst );
+		dst->data = src->data;
+		dst->len = (str1_len+str2_len) | FB_TEMPSTRBIT;
+		dst->size = src->size;
+
+		src->data = NULL;
+		src->len = 0;
+		src->size = 0;
+	}
 	else
 	{
 		/* alloc temp string */
@@ -210,6 +210,44 @@ FBCALL int fb_hStrDelTemp( FBSTRING *str )
 	return res;
 }
 
+/* result of a function returning a part of src (LEFT, MID, TRIM, ...):
+   a temp src is only used once, so it becomes the result itself, with the
+   part moved to the start of its buffer (unless most of a big buffer would
+   be left unused), otherwise the part is copied to a new temp; src is
+   deleted if it's a temp and not reused. Only the descriptor handling is
+   done with the lock held. */
+FBCALL FBSTRING *fb_hStrTempPart( FBSTRING *src, const char *part, ssize_t len )
+{
+	FBSTRING *dst;
+
+	if( len <= 0 )
+	{
+		fb_hStrDelTemp( src );
+		return &__fb_ctx.null_desc;
+	}
+
+	if( FB_ISTEMP( src ) && (src->data != NULL) &&
+	    ((len >= (src->size >> 2)) || (src->size <= 256)) )
+	{
+		if( part != src->data )
+			memmove( src->data, part, len );
+		src->data[len] = '\0';
+		fb_hStrSetLength( src, len );
+		return src;
+	}
+
+	dst = fb_hStrAllocTemp( NULL, len );
+	if( dst != NULL )
+		fb_hStrCopy( dst->data, part, len );
+	else
+		dst = &__fb_ctx.null_desc;
+
+	/* del if temp */
+	fb_hStrDelTemp( src );
+
+	return dst;
+}
+
 FBCALL void fb_hStrCopy( char *dst, const char *src, ssize_t bytes )
 {
     if( (src != NULL) && (bytes > 0) )
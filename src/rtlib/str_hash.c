@@ -0,0 +1,27 @@
+/* string hash, used by SELECT CASE on string literals */
+
+#include "fb.h"
+
+/* FNV-1a, with the seed mixed in at the end; fbc computes the same for the
+   CASE literals at compile-time (parser-compound-select.bas:hHashText() and
+   hHashMix()), so both must be kept in sync */
+FBCALL unsigned int fb_StrHash( FBSTRING *str, unsigned int seed )
+{
+	unsigned int h = 2166136261U;
+	const unsigned char *p;
+	ssize_t i, len;
+
+	if( (str != NULL) && (str->data != NULL) ) {
+		p = (const unsigned char *)str->data;
+		len = FB_STRSIZE( str );
+		for( i = 0; i < len; i++ )
+			h = (h ^ p[i]) * 16777619U;
+	}
+
+	h = (h ^ seed) * 2654435761U;
+	h ^= h >> 16;
+
+	/* no temp deletion: fbc only passes the SELECT's var, and this must
+	   stay cheap, without the string lock */
+	return h;
+}
@@ -0,0 +1,662 @@
+/* string scanning, case mapping and filling helpers, for chars and wchars
+ *
+ * the loops work on 16 bytes at a time with SSE2 (always there on x86-64,
+ * used on x86 if the compiler was told so), or 32 with AVX2 when the CPU
+ * has it (compiled in on x86-64 only, chosen at runtime); the rest is done
+ * unit by unit, giving the same results as the plain loops did before.
+ * Units are 1, 2 or 4 bytes (char, or a FB_WCHAR on Windows or Unix).
+ */
+
+#include "fb.h"
+#include <ctype.h>
+
+#ifdef __SSE2__
+	#include <emmintrin.h>
+	#define ENABLE_SSE2
+#endif
+
+#if defined ENABLE_SSE2 && defined HOST_X86_64 && !defined DISABLE_AVX2 && \
+    (defined __clang__ || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+	#include <immintrin.h>
+	#define ENABLE_AVX2
+	#define AVX2_FUNC __attribute__((target("avx2")))
+	#define HAS_AVX2() __builtin_cpu_supports( "avx2" )
+#endif
+
+/* up to this many different units are compared with SIMD, more are looked
+   up one by one */
+#define MAX_SET 8
+
+#define WCHAR_WIDTH ((int)sizeof( FB_WCHAR ))
+
+static __inline__ unsigned int hUnit( const void *s, ssize_t i, int width )
+{
+	switch( width ) {
+	case 1:  return ((const unsigned char *)s)[i];
+	case 2:  return ((const unsigned short *)s)[i];
+	default: return ((const unsigned int *)s)[i];
+	}
+}
+
+static __inline__ void hSetUnit( void *s, ssize_t i, int width, unsigned int c )
+{
+	switch( width ) {
+	case 1:  ((unsigned char *)s)[i] = c; break;
+	case 2:  ((unsigned short *)s)[i] = c; break;
+	default: ((unsigned int *)s)[i] = c; break;
+	}
+}
+
+static __inline__ int hInSet( unsigned int c, const unsigned int *set, ssize_t set_len )
+{
+	ssize_t i;
+
+	for( i = 0; i < set_len; i++ )
+		if( c == set[i] )
+			return TRUE;
+
+	return FALSE;
+}
+
+/*:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * SSE2                                                                        *
+ *:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+#ifdef ENABLE_SSE2
+
+static __inline__ __m128i hSet1_SSE2( unsigned int c, int width )
+{
+	switch( width ) {
+	case 1:  return _mm_set1_epi8( (char)c );
+	case 2:  return _mm_set1_epi16( (short)c );
+	default: return _mm_set1_epi32( (int)c );
+	}
+}
+
+static __inline__ __m128i hCmpEq_SSE2( __m128i a, __m128i b, int width )
+{
+	switch( width ) {
+	case 1:  return _mm_cmpeq_epi8( a, b );
+	case 2:  return _mm_cmpeq_epi16( a, b );
+	default: return _mm_cmpeq_epi32( a, b );
+	}
+}
+
+static __inline__ __m128i hCmpGt_SSE2( __m128i a, __m128i b, int width )
+{
+	switch( width ) {
+	case 1:  return _mm_cmpgt_epi8( a, b );
+	case 2:  return _mm_cmpgt_epi16( a, b );
+	default: return _mm_cmpgt_epi32( a, b );
+	}
+}
+
+/* number of units at the start (or end) of s that are in the set, checking
+   whole blocks only: it's exact if a unit not in the set was found, else
+   the rest must still be checked */
+static __inline__ ssize_t hSpan_SSE2
+	(
+		const void *s,
+		ssize_t len,
+		int width,
+		const unsigned int *set,
+		ssize_t set_len,
+		int reverse
+	)
+{
+	__m128i v[MAX_SET], b, m;
+	ssize_t k, per = 16 / width, done = 0;
+	unsigned int mask;
+	const char *p;
+
+	for( k = 0; k < set_len; k++ )
+		v[k] = hSet1_SSE2( set[k], width );
+
+	while( len - done >= per ) {
+		if( reverse )
+			p = (const char *)s + (len - done - per) * width;
+		else
+			p = (const char *)s + done * width;
+
+		b = _mm_loadu_si128( (const __m128i *)p );
+		m = hCmpEq_SSE2( b, v[0], width );
+		for( k = 1; k < set_len; k++ )
+			m = _mm_or_si128( m, hCmpEq_SSE2( b, v[k], width ) );
+
+		/* the bytes of units not in the set */
+		mask = _mm_movemask_epi8( m ) ^ 0xFFFF;
+		if( mask != 0 ) {
+			if( reverse )
+				return done + (__builtin_clz( mask ) - 16) / width;
+			return done + __builtin_ctz( mask ) / width;
+		}
+
+		done += per;
+	}
+
+	return done;
+}
+
+/* case mapping of the ASCII letters; with stop_at_high it stops at the
+   first block with a unit > 127, returns the number of units done */
+static __inline__ ssize_t hConvCase_SSE2
+	(
+		void *dst,
+		const void *src,
+		ssize_t len,
+		int width,
+		int upper,
+		int stop_at_high
+	)
+{
+	const __m128i lo = hSet1_SSE2( (upper ? 'a' : 'A') - 1, width );
+	const __m128i hi = hSet1_SSE2( (upper ? 'z' : 'Z') + 1, width );
+	const __m128i bit = hSet1_SSE2( 0x20, width );
+	const __m128i high = hSet1_SSE2( (width == 1) ? 0x80 : ~0x7Fu, width );
+	const __m128i zero = _mm_setzero_si128( );
+	ssize_t per = 16 / width, done = 0;
+	__m128i b, m;
+
+	while( len - done >= per ) {
+		b = _mm_loadu_si128( (const __m128i *)((const char *)src + done * width) );
+
+		if( stop_at_high &&
+		    (_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_and_si128( b, high ), zero ) ) != 0xFFFF) )
+			break;
+
+		/* signed compares: units > 127 (bytes) or > 32767 (wchars) are
+		   negative and never in range */
+		m = _mm_and_si128( hCmpGt_SSE2( b, lo, width ), hCmpGt_SSE2( hi, b, width ) );
+		m = _mm_and_si128( m, bit );
+		b = upper ? _mm_sub_epi8( b, m ) : _mm_add_epi8( b, m );
+
+		_mm_storeu_si128( (__m128i *)((char *)dst + done * width), b );
+		done += per;
+	}
+
+	return done;
+}
+
+#endif /* ENABLE_SSE2 */
+
+/*:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * AVX2                                                                        *
+ *:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+#ifdef ENABLE_AVX2
+
+static __inline__ AVX2_FUNC __m256i hSet1_AVX2( unsigned int c, int width )
+{
+	switch( width ) {
+	case 1:  return _mm256_set1_epi8( (char)c );
+	case 2:  return _mm256_set1_epi16( (short)c );
+	default: return _mm256_set1_epi32( (int)c );
+	}
+}
+
+static __inline__ AVX2_FUNC __m256i hCmpEq_AVX2( __m256i a, __m256i b, int width )
+{
+	switch( width ) {
+	case 1:  return _mm256_cmpeq_epi8( a, b );
+	case 2:  return _mm256_cmpeq_epi16( a, b );
+	default: return _mm256_cmpeq_epi32( a, b );
+	}
+}
+
+static __inline__ AVX2_FUNC __m256i hCmpGt_AVX2( __m256i a, __m256i b, int width )
+{
+	switch( width ) {
+	case 1:  return _mm256_cmpgt_epi8( a, b );
+	case 2:  return _mm256_cmpgt_epi16( a, b );
+	default: return _mm256_cmpgt_epi32( a, b );
+	}
+}
+
+/* same as hSpan_SSE2() */
+static AVX2_FUNC ssize_t hSpan_AVX2
+	(
+		const void *s,
+		ssize_t len,
+		int width,
+		const unsigned int *set,
+		ssize_t set_len,
+		int reverse
+	)
+{
+	__m256i v[MAX_SET], b, m;
+	ssize_t k, per = 32 / width, done = 0;
+	unsigned int mask;
+	const char *p;
+
+	for( k = 0; k < set_len; k++ )
+		v[k] = hSet1_AVX2( set[k], width );
+
+	while( len - done >= per ) {
+		if( reverse )
+			p = (const char *)s + (len - done - per) * width;
+		else
+			p = (const char *)s + done * width;
+
+		b = _mm256_loadu_si256( (const __m256i *)p );
+		m = hCmpEq_AVX2( b, v[0], width );
+		for( k = 1; k < set_len; k++ )
+			m = _mm256_or_si256( m, hCmpEq_AVX2( b, v[k], width ) );
+
+		mask = ~(unsigned int)_mm256_movemask_epi8( m );
+		if( mask != 0 ) {
+			if( reverse )
+				return done + __builtin_clz( mask ) / width;
+			return done + __builtin_ctz( mask ) / width;
+		}
+
+		done += per;
+	}
+
+	return done;
+}
+
+/* same as hConvCase_SSE2() */
+static AVX2_FUNC ssize_t hConvCase_AVX2
+	(
+		void *dst,
+		const void *src,
+		ssize_t len,
+		int width,
+		int upper,
+		int stop_at_high
+	)
+{
+	const __m256i lo = hSet1_AVX2( (upper ? 'a' : 'A') - 1, width );
+	const __m256i hi = hSet1_AVX2( (upper ? 'z' : 'Z') + 1, width );
+	const __m256i bit = hSet1_AVX2( 0x20, width );
+	const __m256i high = hSet1_AVX2( (width == 1) ? 0x80 : ~0x7Fu, width );
+	const __m256i zero = _mm256_setzero_si256( );
+	ssize_t per = 32 / width, done = 0;
+	__m256i b, m;
+
+	while( len - done >= per ) {
+		b = _mm256_loadu_si256( (const __m256i *)((const char *)src + done * width) );
+
+		if( stop_at_high &&
+		    (~(unsigned int)_mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_and_si256( b, high ), zero ) ) != 0) )
+			break;
+
+		m = _mm256_and_si256( hCmpGt_AVX2( b, lo, width ), hCmpGt_AVX2( hi, b, width ) );
+		m = _mm256_and_si256( m, bit );
+		b = upper ? _mm256_sub_epi8( b, m ) : _mm256_add_epi8( b, m );
+
+		_mm256_storeu_si256( (__m256i *)((char *)dst + done * width), b );
+		done += per;
+	}
+
+	return done;
+}
+
+#endif /* ENABLE_AVX2 */
+
+/*:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * generic                                                                     *
+ *:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+/* number of units at the start (or the end, if reverse) of s in the set
+   (inlined, so each caller gets a version for its unit size) */
+static __inline__ ssize_t hSpan
+	(
+		const void *s,
+		ssize_t len,
+		int width,
+		const unsigned int *set,
+		ssize_t set_len,
+		int reverse
+	)
+{
+	ssize_t done = 0;
+
+	if( (s == NULL) || (len <= 0) || (set_len == 0) )
+		return 0;
+
+	if( set_len <= MAX_SET ) {
+#ifdef ENABLE_AVX2
+		if( HAS_AVX2( ) )
+			done = hSpan_AVX2( s, len, width, set, set_len, reverse );
+		else
+#endif
+#ifdef ENABLE_SSE2
+			done = hSpan_SSE2( s, len, width, set, set_len, reverse );
+#else
+			done = 0;
+#endif
+	}
+
+	/* the rest, or a unit not in the set was found */
+	while( (done < len) &&
+	       hInSet( hUnit( s, reverse ? len - 1 - done : done, width ), set, set_len ) )
+		++done;
+
+	return done;
+}
+
+#ifdef ENABLE_SSE2
+/* toupper() and tolower() may be used for the ASCII letters too, if the
+   locale doesn't map them differently (Turkish maps 'i' to a dotted 'I') */
+static int hAsciiCaseIsPlain( int wide )
+{
+	if( wide )
+		return (fb_wstr_ToUpper( _LC('i') ) == _LC('I')) &&
+		       (fb_wstr_ToLower( _LC('I') ) == _LC('i'));
+
+	return (toupper( 'i' ) == 'I') && (tolower( 'I' ) == 'i');
+}
+#endif
+
+/* units i to end - 1, same as the UCASE/LCASE loops always did */
+static __inline__ void hConvCaseUnits
+	(
+		void *dst,
+		const void *src,
+		ssize_t i,
+		ssize_t end,
+		int upper,
+		int mode,
+		int wide
+	)
+{
+	if( wide ) {
+		const FB_WCHAR *s = (const FB_WCHAR *)src;
+		FB_WCHAR *d = (FB_WCHAR *)dst, c;
+
+		if( mode == 1 ) {
+			if( upper ) {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( (c >= 97) && (c <= 122) )
+						c -= 97 - 65;
+					d[i] = c;
+				}
+			} else {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( (c >= 65) && (c <= 90) )
+						c += 97 - 65;
+					d[i] = c;
+				}
+			}
+		} else {
+			if( upper ) {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( fb_wstr_IsLower( c ) )
+						c = fb_wstr_ToUpper( c );
+					d[i] = c;
+				}
+			} else {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( fb_wstr_IsUpper( c ) )
+						c = fb_wstr_ToLower( c );
+					d[i] = c;
+				}
+			}
+		}
+	} else {
+		const char *s = (const char *)src;
+		char *d = (char *)dst;
+		int c;
+
+		if( mode == 1 ) {
+			if( upper ) {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( (c >= 97) && (c <= 122) )
+						c -= 97 - 65;
+					d[i] = c;
+				}
+			} else {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( (c >= 65) && (c <= 90) )
+						c += 97 - 65;
+					d[i] = c;
+				}
+			}
+		} else {
+			if( upper ) {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( islower( c ) )
+						c = toupper( c );
+					d[i] = c;
+				}
+			} else {
+				for( ; i < end; i++ ) {
+					c = s[i];
+					if( isupper( c ) )
+						c = tolower( c );
+					d[i] = c;
+				}
+			}
+		}
+	}
+}
+
+/* mode 1: ASCII only, else by the locale; dst may be src */
+static __inline__ void hConvCase
+	(
+		void *dst,
+		const void *src,
+		ssize_t len,
+		int width,
+		int upper,
+		int mode,
+		int wide
+	)
+{
+	ssize_t i = 0, block;
+
+#if defined ENABLE_SSE2
+	/* by the locale: only blocks of ASCII chars can be done at once */
+	int stop_at_high = (mode != 1);
+	int simd = (mode == 1) || hAsciiCaseIsPlain( wide );
+#endif
+
+	while( i < len ) {
+#if defined ENABLE_AVX2
+		if( simd && HAS_AVX2( ) ) {
+			i += hConvCase_AVX2( (char *)dst + i * width, (const char *)src + i * width,
+			                     len - i, width, upper, stop_at_high );
+			block = 32 / width;
+		} else
+#endif
+#if defined ENABLE_SSE2
+		if( simd ) {
+			i += hConvCase_SSE2( (char *)dst + i * width, (const char *)src + i * width,
+			                     len - i, width, upper, stop_at_high );
+			block = 16 / width;
+		} else
+#endif
+			block = len;
+
+		/* the rest, or a block with chars > 127 */
+		block = (len - i < block) ? len : i + block;
+		hConvCaseUnits( dst, src, i, block, upper, mode, wide );
+		i = block;
+	}
+}
+
+/*:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * chars                                                                       *
+ *:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+FBCALL char *fb_hStrSkipChar( char *s, ssize_t len, int c )
+{
+	unsigned int set[1];
+
+	if( s == NULL )
+		return s;
+
+	/* compared as a char: none match if it's out of range */
+	if( (int)(char)c != c )
+		return s;
+
+	set[0] = (unsigned char)c;
+	return s + hSpan( s, len, 1, set, 1, FALSE );
+}
+
+FBCALL char *fb_hStrSkipCharRev( char *s, ssize_t len, int c )
+{
+	unsigned int set[2];
+	ssize_t set_len = 0;
+
+	if( (s == NULL) || (len <= 0) )
+		return s;
+
+	/* fixed-len's are filled with null's as in PB, strip them too */
+	set[set_len++] = 0;
+	if( ((int)(char)c == c) && (c != 0) )
+		set[set_len++] = (unsigned char)c;
+
+	/* the last char not skipped */
+	return s + len - 1 - hSpan( s, len, 1, set, set_len, TRUE );
+}
+
+/* number of chars at the start (or end) of s that are in the set */
+static ssize_t hStrSpanAny( const char *s, ssize_t len, const char *set, ssize_t set_len, int reverse )
+{
+	unsigned int units[256];
+	unsigned char seen[256];
+	ssize_t i, count = 0;
+
+	if( (s == NULL) || (set == NULL) )
+		return 0;
+
+	/* the set without duplicates */
+	memset( seen, 0, sizeof( seen ) );
+	for( i = 0; i < set_len; i++ ) {
+		unsigned char c = set[i];
+		if( !seen[c] ) {
+			seen[c] = 1;
+			units[count++] = c;
+		}
+	}
+
+	if( count <= MAX_SET )
+		return hSpan( s, len, 1, units, count, reverse );
+
+	/* bigger sets: a table lookup per char */
+	for( i = 0; i < len; i++ )
+		if( !seen[(unsigned char)s[reverse ? len - 1 - i : i]] )
+			break;
+
+	return i;
+}
+
+ssize_t fb_hStrSkipAny( const char *s, ssize_t len, const char *set, ssize_t set_len )
+{
+	return hStrSpanAny( s, len, set, set_len, FALSE );
+}
+
+ssize_t fb_hStrSkipAnyRev( const char *s, ssize_t len, const char *set, ssize_t set_len )
+{
+	return hStrSpanAny( s, len, set, set_len, TRUE );
+}
+
+void fb_hStrConvCase( char *dst, const char *src, ssize_t len, int upper, int mode )
+{
+	hConvCase( dst, src, len, 1, upper, mode, FALSE );
+}
+
+/*:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*
+ * wchars                                                                      *
+ *:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::*/
+
+const FB_WCHAR *fb_wstr_SkipChar( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c )
+{
+	unsigned int set[1];
+
+	if( s == NULL )
+		return NULL;
+
+	set[0] = hUnit( &c, 0, WCHAR_WIDTH );
+	return s + hSpan( s, chars, WCHAR_WIDTH, set, 1, FALSE );
+}
+
+const FB_WCHAR *fb_wstr_SkipCharRev( const FB_WCHAR *s, ssize_t chars, FB_WCHAR c )
+{
+	unsigned int set[1];
+
+	if( (s == NULL) || (chars <= 0) )
+		return s;
+
+	/* the char after the last one not skipped */
+	set[0] = hUnit( &c, 0, WCHAR_WIDTH );
+	return s + chars - hSpan( s, chars, WCHAR_WIDTH, set, 1, TRUE );
+}
+
+/* number of chars at the start (or end) of s in the set (a null-terminated
+   wstring, the null char counts as in it, same as with wcschr()) */
+static ssize_t hWstrSpanAny( const FB_WCHAR *s, ssize_t chars, const FB_WCHAR *set, int reverse )
+{
+	unsigned int units[MAX_SET];
+	ssize_t i, count = 0;
+	unsigned int c;
+
+	if( (s == NULL) || (set == NULL) )
+		return 0;
+
+	units[count++] = 0;
+	for( i = 0; set[i] != _LC('\0'); i++ ) {
+		c = hUnit( set, i, WCHAR_WIDTH );
+		if( hInSet( c, units, count ) )
+			continue;
+
+		/* too many for SIMD */
+		if( count == MAX_SET ) {
+			for( i = 0; i < chars; i++ )
+				if( wcschr( set, s[reverse ? chars - 1 - i : i] ) == NULL )
+					break;
+			return i;
+		}
+
+		units[count++] = c;
+	}
+
+	return hSpan( s, chars, WCHAR_WIDTH, units, count, reverse );
+}
+
+ssize_t fb_wstr_SkipAny( const FB_WCHAR *s, ssize_t chars, const FB_WCHAR *set )
+{
+	return hWstrSpanAny( s, chars, set, FALSE );
+}
+
+ssize_t fb_wstr_SkipAnyRev( const FB_WCHAR *s, ssize_t chars, const FB_WCHAR *set )
+{
+	return hWstrSpanAny( s, chars, set, TRUE );
+}
+
+void fb_wstr_ConvCase( FB_WCHAR *dst, const FB_WCHAR *src, ssize_t chars, int upper, int mode )
+{
+	hConvCase( dst, src, chars, WCHAR_WIDTH, upper, mode, TRUE );
+}
+
+void fb_wstr_Fill( FB_WCHAR *dst, FB_WCHAR c, ssize_t chars )
+{
+	ssize_t i = 0;
+
+	if( chars < 0 )
+		chars = 0;
+
+#ifdef ENABLE_SSE2
+	/* memory bound, SSE2 is enough */
+	const __m128i v = hSet1_SSE2( hUnit( &c, 0, WCHAR_WIDTH ), WCHAR_WIDTH );
+	const ssize_t per = 16 / WCHAR_WIDTH;
+
+	for( ; chars - i >= per; i += per )
+		_mm_storeu_si128( (__m128i *)(dst + i), v );
+#endif
+
+	for( ; i < chars; i++ )
+		hSetUnit( dst, i, WCHAR_WIDTH, hUnit( &c, 0, WCHAR_WIDTH ) );
+
+	/* add null-term */
+	dst[chars] = _LC('\0');
+}
@@ -4,14 +4,11 @@
 
 FBCALL FBSTRING *fb_LEFT( FBSTRING *src, ssize_t chars )
 {
-	FBSTRING 	*dst;
 	ssize_t len, src_len;
 
 	if( src == NULL )
 		return &__fb_ctx.null_desc;
 
-	FB_STRLOCK();
-
 	src_len = FB_STRSIZE( src );
 	if( (src->data != NULL)	&& (chars > 0) && (src_len > 0) )
 	{
@@ -19,26 +16,10 @@ FBCALL FBSTRING *fb_LEFT( FBSTRING *src, ssize_t chars )
 			len = src_len;
 		else
 			len = chars;
+	}
+	else
+		len = 0;
 
-		/* alloc temp string */
-        dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, src->data, len );
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-    }
-    else
-        dst = &__fb_ctx.null_desc;
-
-    /* del if temp */
-    fb_hStrDelTemp_NoLock( src );
-
-    FB_STRUNLOCK();
-
-    return dst;
+	return fb_hStrTempPart( src, src->data, len );
 }
 
-
@@ -9,7 +9,6 @@ FBCALL FBSTRING *fb_LTrimAny
 	)
 {
 	const char *pachText = NULL;
-	FBSTRING *dst;
 	ssize_t len;
 
 	if( src == NULL )
@@ -18,8 +17,6 @@ FBCALL FBSTRING *fb_LTrimAny
 		return &__fb_ctx.null_desc;
 	}
 
-	FB_STRLOCK();
-
 	len = 0;
 	if( src->data != NULL )
 	{
@@ -28,37 +25,14 @@ FBCALL FBSTRING *fb_LTrimAny
 		len = FB_STRSIZE( src );
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				if( FB_MEMCHR( pattern->data, *pachText, len_pattern ) == NULL )
-					break;
-
-				--len;
-				++pachText;
-			}
-		}
-	}
-
-	if( len > 0 )
-	{
-		/* alloc temp string */
-		dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, pachText, len );
+			ssize_t skip = fb_hStrSkipAny( pachText, len, pattern->data, len_pattern );
+			pachText += skip;
+			len -= skip;
 		}
-		else
-			dst = &__fb_ctx.null_desc;
 	}
-	else
-		dst = &__fb_ctx.null_desc;
 
 	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-	fb_hStrDelTemp_NoLock( pattern );
-
-	FB_STRUNLOCK();
+	fb_hStrDelTemp( pattern );
 
-	return dst;
+	return fb_hStrTempPart( src, pachText, len );
 }
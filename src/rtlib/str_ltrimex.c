@@ -8,7 +8,6 @@ FBCALL FBSTRING *fb_LTrimEx
 		FBSTRING *pattern 
 	)
 {
-	FBSTRING *dst;
 	ssize_t len;
 	char *src_ptr = NULL;
 
@@ -18,8 +17,6 @@ FBCALL FBSTRING *fb_LTrimEx
         return &__fb_ctx.null_desc;
     }
 
-	FB_STRLOCK();
-
 	if( src->data != NULL )
     {
         ssize_t len_pattern = ((pattern != NULL) && (pattern->data != NULL)? FB_STRSIZE( pattern ) : 0);
@@ -54,27 +51,9 @@ FBCALL FBSTRING *fb_LTrimEx
 	else
 		len = 0;
 
-	if( len > 0 )
-	{
-		/* alloc temp string */
-        dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, src_ptr, len );
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-    }
-	else
-		dst = &__fb_ctx.null_desc;
-
 	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-    fb_hStrDelTemp_NoLock( pattern );
-
-	FB_STRUNLOCK();
+	fb_hStrDelTemp( pattern );
 
-	return dst;
+	return fb_hStrTempPart( src, src_ptr, len );
 }
 
@@ -4,46 +4,29 @@
 
 FBCALL FBSTRING *fb_StrMid( FBSTRING *src, ssize_t start, ssize_t len )
 {
-    FBSTRING 	*dst;
 	ssize_t src_len;
 
-	FB_STRLOCK();
+	if( src == NULL )
+		return &__fb_ctx.null_desc;
 
-    if( (src != NULL) && (src->data != NULL) && (FB_STRSIZE( src ) > 0) )
+	src_len = FB_STRSIZE( src );
+
+	if( (src->data != NULL) && (src_len > 0) &&
+	    (start > 0) && (start <= src_len) && (len != 0) )
 	{
-        src_len = FB_STRSIZE( src );
-
-        if( (start > 0) && (start <= src_len) && (len != 0) )
-        {
-        	--start;
-
-        	if( len < 0 )
-        		len = src_len;
-
-        	if( start + len > src_len )
-        		len = src_len - start;
-
-			/* alloc temp string */
-            dst = fb_hStrAllocTemp_NoLock( NULL, len );
-			if( dst != NULL )
-            {
-				FB_MEMCPY( dst->data, src->data + start, len );
-				/* null term */
-				dst->data[len] = '\0';
-            }
-        	else
-        		dst = &__fb_ctx.null_desc;
-        }
-        else
-        	dst = &__fb_ctx.null_desc;
-	}
-	else
-		dst = &__fb_ctx.null_desc;
+		--start;
 
-	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
+		if( len < 0 )
+			len = src_len;
 
-	FB_STRUNLOCK();
+		if( start + len > src_len )
+			len = src_len - start;
+	}
+	else
+	{
+		start = 0;
+		len = 0;
+	}
 
-	return dst;
+	return fb_hStrTempPart( src, src->data + start, len );
 }
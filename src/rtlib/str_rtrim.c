@@ -4,14 +4,11 @@
 
 FBCALL FBSTRING *fb_RTRIM( FBSTRING *src )
 {
-	FBSTRING *dst;
 	ssize_t len;
 
 	if( src == NULL )
 		return &__fb_ctx.null_desc;
 
-   	FB_STRLOCK();
-
 	len = 0;
 	if( src->data != NULL )
 	{
@@ -23,26 +20,6 @@ FBCALL FBSTRING *fb_RTRIM( FBSTRING *src )
 		}
 	}
 
-	if( len > 0 )
-	{
-		/* alloc temp string */
-        dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, src->data, len );
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-    }
-	else
-		dst = &__fb_ctx.null_desc;
-
-	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-
-   	FB_STRUNLOCK();
-
-	return dst;
+	return fb_hStrTempPart( src, src->data, len );
 }
 
@@ -4,7 +4,6 @@
 
 FBCALL FBSTRING *fb_RTrimAny( FBSTRING *src, FBSTRING *pattern )
 {
-	FBSTRING *dst;
 	ssize_t len;
 
 	if( src == NULL )
@@ -13,8 +12,6 @@ FBCALL FBSTRING *fb_RTrimAny( FBSTRING *src, FBSTRING *pattern )
 		return &__fb_ctx.null_desc;
 	}
 
-	FB_STRLOCK();
-
 	len = 0;
 	if( src->data != NULL )
 	{
@@ -23,38 +20,12 @@ FBCALL FBSTRING *fb_RTrimAny( FBSTRING *src, FBSTRING *pattern )
 		len = FB_STRSIZE( src );
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				--len;
-				if( FB_MEMCHR( pattern->data, pachText[len], len_pattern ) == NULL )
-				{
-					++len;
-					break;
-				}
-			}
+			len -= fb_hStrSkipAnyRev( pachText, len, pattern->data, len_pattern );
 		}
 	}
 
-	if( len > 0 )
-	{
-		/* alloc temp string */
-		dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, src->data, len );
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-	}
-	else
-		dst = &__fb_ctx.null_desc;
-
 	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-	fb_hStrDelTemp_NoLock( pattern );
-
-	FB_STRUNLOCK();
+	fb_hStrDelTemp( pattern );
 
-	return dst;
+	return fb_hStrTempPart( src, src->data, len );
 }
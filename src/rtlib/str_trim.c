@@ -4,15 +4,12 @@
 
 FBCALL FBSTRING *fb_TRIM( FBSTRING *src )
 {
-	FBSTRING *dst;
 	ssize_t len;
 	char *src_ptr;
 
 	if( src == NULL )
 		return &__fb_ctx.null_desc;
 
-	FB_STRLOCK();
-
 	len = 0;
 	if( src->data != NULL )
 	{
@@ -28,28 +25,9 @@ FBCALL FBSTRING *fb_TRIM( FBSTRING *src )
 	{
 		src_ptr = fb_hStrSkipChar( src->data, FB_STRSIZE( src ), 32 );
 		len -= (ssize_t)(src_ptr - src->data);
-		if( len > 0 )
-		{
-			/* alloc temp string */
-            dst = fb_hStrAllocTemp_NoLock( NULL, len );
-			if( dst != NULL )
-			{
-				/* simple copy */
-				fb_hStrCopy( dst->data, src_ptr, len );
-			}
-			else
-				dst = &__fb_ctx.null_desc;
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-    }
+	}
 	else
-		dst = &__fb_ctx.null_desc;
-
-	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-
-	FB_STRUNLOCK();
+		src_ptr = src->data;
 
-	return dst;
+	return fb_hStrTempPart( src, src_ptr, len );
 }
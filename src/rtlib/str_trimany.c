@@ -5,7 +5,6 @@
 FBCALL FBSTRING *fb_TrimAny( FBSTRING *src, FBSTRING *pattern )
 {
 	const char *pachText = NULL;
-	FBSTRING *dst;
 	ssize_t len;
 
 	if( src == NULL ) 
@@ -14,8 +13,6 @@ FBCALL FBSTRING *fb_TrimAny( FBSTRING *src, FBSTRING *pattern )
 		return &__fb_ctx.null_desc;
 	}
 
-	FB_STRLOCK();
-
 	len = 0;
 	if( src->data != NULL )
 	{
@@ -24,46 +21,15 @@ FBCALL FBSTRING *fb_TrimAny( FBSTRING *src, FBSTRING *pattern )
 		len = FB_STRSIZE( src );
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				if( FB_MEMCHR( pattern->data, *pachText, len_pattern ) == NULL )
-					break;
-
-				--len;
-				++pachText;
-			}
-			while ( len != 0 )
-			{
-				--len;
-				if( FB_MEMCHR( pattern->data, pachText[len], len_pattern ) == NULL ) 
-				{
-					++len;
-					break;
-				}
-			}
-		}
-	}
-
-	if( len > 0 )
-	{
-		/* alloc temp string */
-		dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, pachText, len );
+			ssize_t skip = fb_hStrSkipAny( pachText, len, pattern->data, len_pattern );
+			pachText += skip;
+			len -= skip;
+			len -= fb_hStrSkipAnyRev( pachText, len, pattern->data, len_pattern );
 		}
-		else
-			dst = &__fb_ctx.null_desc;
 	}
-	else
-		dst = &__fb_ctx.null_desc;
 
 	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-	fb_hStrDelTemp_NoLock( pattern );
-
-	FB_STRUNLOCK();
+	fb_hStrDelTemp( pattern );
 
-	return dst;
+	return fb_hStrTempPart( src, pachText, len );
 }
@@ -4,7 +4,6 @@
 
 FBCALL FBSTRING *fb_TrimEx( FBSTRING *src, FBSTRING *pattern )
 {
-	FBSTRING *dst;
 	ssize_t len;
 	char *src_ptr = NULL;
 
@@ -14,8 +13,6 @@ FBCALL FBSTRING *fb_TrimEx( FBSTRING *src, FBSTRING *pattern )
         return &__fb_ctx.null_desc;
     }
 
-	FB_STRLOCK();
-
 	if( src->data != NULL )
     {
         ssize_t len_pattern = ((pattern != NULL) && (pattern->data != NULL)? FB_STRSIZE( pattern ) : 0);
@@ -73,28 +70,11 @@ FBCALL FBSTRING *fb_TrimEx( FBSTRING *src, FBSTRING *pattern )
 	else
 		len = 0;
 
-	if( len > 0 )
-	{
-		/* alloc temp string */
-        dst = fb_hStrAllocTemp_NoLock( NULL, len );
-		if( dst != NULL )
-		{
-			/* simple copy */
-			fb_hStrCopy( dst->data, src_ptr, len );
-		}
-		else
-			dst = &__fb_ctx.null_desc;
-    }
-	else
-		dst = &__fb_ctx.null_desc;
-
 	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
-    fb_hStrDelTemp_NoLock( pattern );
-
-	FB_STRUNLOCK();
+	/* del if temp */
+	fb_hStrDelTemp( pattern );
 
-	return dst;
+	return fb_hStrTempPart( src, src_ptr, len );
 }
 
 
@@ -1,59 +1,37 @@
 /* ucase$ function */
 
 #include "fb.h"
-#include <ctype.h>
 
 FBCALL FBSTRING *fb_StrUcase2( FBSTRING *src, int mode )
 {
 	FBSTRING 	*dst;
-	ssize_t i, len = 0;
-	int c;
-	char		*s, *d;
+	ssize_t len;
 
 	if( src == NULL )
 		return &__fb_ctx.null_desc;
 
-	FB_STRLOCK();
-
-	if( src->data ) {
-		len = FB_STRSIZE( src );
-
-		/* alloc temp string */
-		dst = fb_hStrAllocTemp_NoLock( NULL, len );
-	} else {
-		dst = NULL;
+	if( src->data == NULL ) {
+		/* del if temp */
+		fb_hStrDelTemp( src );
+		return &__fb_ctx.null_desc;
 	}
 
-	if( dst ) {
-		s = src->data;
-		d = dst->data;
-
-		if( mode == 1 ) {
-			for( i = 0; i < len; i++ ) {
-				c = *s++;
-				if( (c >= 97) && (c <= 122) )
-					c -= 97 - 65;
-				*d++ = c;
-			}
-		} else {
-			for( i = 0; i < len; i++ ) {
-				c = *s++;
-				if( islower( c ) )
-					c = toupper( c );
-				*d++ = c;
-			}
-		}
-
-		/* null char */
-		*d = '\0';
+	len = FB_STRSIZE( src );
+
+	/* a temp is only used once, convert it in place */
+	if( FB_ISTEMP( src ) ) {
+		dst = src;
 	} else {
-		dst = &__fb_ctx.null_desc;
+		/* alloc temp string */
+		dst = fb_hStrAllocTemp( NULL, len );
+		if( dst == NULL )
+			return &__fb_ctx.null_desc;
 	}
 
-	/* del if temp */
-	fb_hStrDelTemp_NoLock( src );
+	fb_hStrConvCase( dst->data, src->data, len, TRUE, mode );
 
-	FB_STRUNLOCK();
+	/* null char */
+	dst->data[len] = '\0';
 
 	return dst;
 }
@@ -18,14 +18,9 @@ FBCALL FB_WCHAR *fb_WstrLTrimAny ( const FB_WCHAR *src, const FB_WCHAR *pattern
 		pachText = src;
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				if( wcschr( pattern, *pachText )==NULL ) {
-					break;
-				}
-				--len;
-				++pachText;
-			}
+			ssize_t skip = fb_wstr_SkipAny( pachText, len, pattern );
+			pachText += skip;
+			len -= skip;
 		}
 	}
 
@@ -18,14 +18,7 @@ FBCALL FB_WCHAR *fb_WstrRTrimAny ( const FB_WCHAR *src, const FB_WCHAR *pattern
 		pachText = src;
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				--len;
-				if( wcschr( pattern, pachText[len] ) == NULL ) {
-					++len;
-					break;
-				}
-			}
+			len -= fb_wstr_SkipAnyRev( pachText, len, pattern );
 		}
 	}
 
@@ -19,22 +19,10 @@ FBCALL FB_WCHAR *fb_WstrTrimAny ( const FB_WCHAR *src, const FB_WCHAR *pattern )
 		len = fb_wstr_Len( src );
 		if( len_pattern != 0 )
 		{
-			while ( len != 0 )
-			{
-				if( wcschr( pattern, *pachText )==NULL ) {
-					break;
-				}
-				--len;
-				++pachText;
-			}
-			while ( len != 0 )
-			{
-				--len;
-				if( wcschr( pattern, pachText[len] )==NULL ) {
-					++len;
-					break;
-				}
-			}
+			ssize_t skip = fb_wstr_SkipAny( pachText, len, pattern );
+			pachText += skip;
+			len -= skip;
+			len -= fb_wstr_SkipAnyRev( pachText, len, pattern );
 		}
 	}
 
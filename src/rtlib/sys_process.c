@@ -0,0 +1,439 @@
+/* child processes with pipes (inc/fbprocess.bi) */
+
+/* for pipe2() */
+#define _GNU_SOURCE 1
+
+#include "fb.h"
+
+#ifdef HOST_UNIX
+
+#include <sys/wait.h>
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+extern char **environ;
+
+struct _FB_PROCESS {
+	pid_t pid;
+	int in, out, err;       /* parent's ends of the pipes, or -1 */
+	int exitcode;           /* FB_PROCESS_RUNNING until reaped */
+};
+
+/* the child only gets the dup2()'ed copies; with pipe2() no other thread's
+   fork() can inherit the pipes before FD_CLOEXEC is set */
+static int hPipe( int fds[2] )
+{
+#if defined HOST_LINUX || defined HOST_FREEBSD || defined HOST_NETBSD || defined HOST_OPENBSD
+	return (pipe2( fds, O_CLOEXEC ) == 0);
+#else
+	if( pipe( fds ) != 0 )
+		return FALSE;
+
+	fcntl( fds[0], F_SETFD, FD_CLOEXEC );
+	fcntl( fds[1], F_SETFD, FD_CLOEXEC );
+	return TRUE;
+#endif
+}
+
+static void hClose( int *fd )
+{
+	if( *fd != -1 ) {
+		close( *fd );
+		*fd = -1;
+	}
+}
+
+static int hExitCode( int status )
+{
+	if( WIFEXITED( status ) )
+		return WEXITSTATUS( status );
+	/* killed by a signal: same as the shell's $? */
+	if( WIFSIGNALED( status ) )
+		return 128 + WTERMSIG( status );
+	return -1;
+}
+
+/* reap the child if it ended, without blocking unless told so */
+static int hReap( FB_PROCESS *proc, int block )
+{
+	pid_t res;
+	int status;
+
+	if( proc->exitcode != FB_PROCESS_RUNNING )
+		return TRUE;
+
+	do {
+		res = waitpid( proc->pid, &status, block ? 0 : WNOHANG );
+	} while( (res == -1) && (errno == EINTR) );
+
+	if( res == proc->pid ) {
+		proc->exitcode = hExitCode( status );
+		return TRUE;
+	}
+
+	if( res == -1 ) {
+		/* not our child anymore (reaped elsewhere) */
+		proc->exitcode = -1;
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+static int *hStreamFd( FB_PROCESS *proc, int stream )
+{
+	switch( stream ) {
+	case FB_PROCESS_STDOUT:
+		return &proc->out;
+	case FB_PROCESS_STDERR:
+		return &proc->err;
+	}
+	return NULL;
+}
+
+FBCALL FB_PROCESS *fb_ProcessStart( const char *program, const char *args, int flags )
+{
+	int inpipe[2] = { -1, -1 }, outpipe[2] = { -1, -1 }, errpipe[2] = { -1, -1 };
+	posix_spawn_file_actions_t actions;
+	char *arguments, **argv, *p;
+	int i, argc = 0, ok = TRUE;
+	ssize_t len;
+	FB_PROCESS *proc;
+
+	if( (program == NULL) || (*program == '\0') )
+		return NULL;
+
+	/* same argument parsing as EXEC */
+	if( args == NULL )
+		args = "";
+	len = strlen( args );
+	arguments = alloca( len + 1 );
+	arguments[len] = 0;
+	if( len )
+		argc = fb_hParseArgs( arguments, args, len );
+	if( argc == -1 )
+		return NULL;
+
+	argc++;			/* add 1 for program name */
+	argv = alloca( sizeof( char * ) * (argc + 1) );
+	argv[0] = (char *)program;
+	p = arguments;
+	for( i = 1; i < argc; i++ ) {
+		argv[i] = p;
+		while( *p++ );
+	}
+	argv[argc] = NULL;
+
+	proc = (FB_PROCESS *)malloc( sizeof( FB_PROCESS ) );
+	if( proc == NULL )
+		return NULL;
+	proc->in = proc->out = proc->err = -1;
+	proc->exitcode = FB_PROCESS_RUNNING;
+
+	posix_spawn_file_actions_init( &actions );
+
+	if( flags & FB_PROCESS_STDIN ) {
+		ok = ok && hPipe( inpipe );
+		ok = ok && (posix_spawn_file_actions_adddup2( &actions, inpipe[0], 0 ) == 0);
+	}
+	if( flags & FB_PROCESS_STDOUT ) {
+		ok = ok && hPipe( outpipe );
+		ok = ok && (posix_spawn_file_actions_adddup2( &actions, outpipe[1], 1 ) == 0);
+		if( flags & FB_PROCESS_MERGE )
+			ok = ok && (posix_spawn_file_actions_adddup2( &actions, outpipe[1], 2 ) == 0);
+	}
+	if( (flags & FB_PROCESS_STDERR) && !(flags & FB_PROCESS_MERGE) ) {
+		ok = ok && hPipe( errpipe );
+		ok = ok && (posix_spawn_file_actions_adddup2( &actions, errpipe[1], 2 ) == 0);
+	}
+
+	if( ok )
+		ok = (posix_spawnp( &proc->pid, program, &actions, NULL, argv, environ ) == 0);
+
+	posix_spawn_file_actions_destroy( &actions );
+
+	/* the child's ends */
+	hClose( &inpipe[0] );
+	hClose( &outpipe[1] );
+	hClose( &errpipe[1] );
+
+	proc->in = inpipe[1];
+	proc->out = outpipe[0];
+	proc->err = errpipe[0];
+
+	if( !ok ) {
+		hClose( &proc->in );
+		hClose( &proc->out );
+		hClose( &proc->err );
+		free( proc );
+		return NULL;
+	}
+
+	return proc;
+}
+
+FBCALL ssize_t fb_ProcessWrite( FB_PROCESS *proc, const void *buffer, ssize_t size )
+{
+	ssize_t done = 0, res = 0;
+	sigset_t set, oldset, pending;
+	struct timespec zero = { 0, 0 };
+	int was_pending;
+
+	if( (proc == NULL) || (proc->in == -1) || (size < 0) )
+		return -1;
+
+	/* writing to a child that closed its stdin raises SIGPIPE, which
+	   would end the program; block it for this thread, and take back
+	   the one raised by the write (but not one that was already
+	   pending) so the write just fails with EPIPE */
+	sigemptyset( &set );
+	sigaddset( &set, SIGPIPE );
+	pthread_sigmask( SIG_BLOCK, &set, &oldset );
+	sigpending( &pending );
+	was_pending = sigismember( &pending, SIGPIPE );
+
+	while( done < size ) {
+		res = write( proc->in, (const char *)buffer + done, size - done );
+		if( res == -1 ) {
+			if( errno == EINTR )
+				continue;
+			break;
+		}
+		done += res;
+	}
+
+	if( (res == -1) && (errno == EPIPE) && !was_pending ) {
+		while( (sigtimedwait( &set, NULL, &zero ) == -1) && (errno == EINTR) )
+			;
+	}
+
+	pthread_sigmask( SIG_SETMASK, &oldset, NULL );
+
+	return (res == -1) ? -1 : done;
+}
+
+FBCALL int fb_ProcessCloseInput( FB_PROCESS *proc )
+{
+	if( (proc == NULL) || (proc->in == -1) )
+		return -1;
+
+	/* the child sees EOF on its stdin */
+	hClose( &proc->in );
+	return 0;
+}
+
+FBCALL ssize_t fb_ProcessRead( FB_PROCESS *proc, int stream, void *buffer, ssize_t size )
+{
+	int *fd;
+	ssize_t res;
+
+	if( (proc == NULL) || (size < 0) )
+		return -1;
+
+	fd = hStreamFd( proc, stream );
+	if( (fd == NULL) || (*fd == -1) )
+		return -1;
+
+	do {
+		res = read( *fd, buffer, size );
+	} while( (res == -1) && (errno == EINTR) );
+
+	/* EOF: the child closed its end, no need to keep ours */
+	if( (res == 0) && (size > 0) )
+		hClose( fd );
+
+	return res;
+}
+
+FBCALL FBSTRING *fb_ProcessReadAll( FB_PROCESS *proc, int stream )
+{
+	FBSTRING *dst;
+	char *data = NULL, *p;
+	ssize_t len = 0, size = 0, res;
+
+	for( ;; ) {
+		if( size - len < 4096 ) {
+			size = (size == 0) ? 16384 : size * 2;
+			p = realloc( data, size );
+			if( p == NULL )
+				break;
+			data = p;
+		}
+
+		res = fb_ProcessRead( proc, stream, data + len, size - len );
+		if( res <= 0 )
+			break;
+		len += res;
+	}
+
+	dst = &__fb_ctx.null_desc;
+	if( len > 0 ) {
+		dst = fb_hStrAllocTemp( NULL, len );
+		if( dst != NULL )
+			fb_hStrCopy( dst->data, data, len );
+		else
+			dst = &__fb_ctx.null_desc;
+	}
+
+	free( data );
+	return dst;
+}
+
+FBCALL int fb_ProcessPoll( FB_PROCESS *proc, int timeout )
+{
+	struct pollfd fds[2];
+	int count = 0, res, result = 0;
+
+	if( proc == NULL )
+		return -1;
+
+	if( proc->out != -1 ) {
+		fds[count].fd = proc->out;
+		fds[count].events = POLLIN;
+		count++;
+	}
+	if( proc->err != -1 ) {
+		fds[count].fd = proc->err;
+		fds[count].events = POLLIN;
+		count++;
+	}
+
+	if( (count == 0) && !hReap( proc, FALSE ) ) {
+		/* nothing to read: only the exit can be waited for */
+		return (fb_ProcessWait( proc, timeout ) == FB_PROCESS_RUNNING) ? 0 : FB_PROCESS_EXITED;
+	}
+
+	if( count > 0 ) {
+		do {
+			res = poll( fds, count, timeout );
+		} while( (res == -1) && (errno == EINTR) );
+
+		if( res == -1 )
+			return -1;
+
+		/* readable or closed (POLLHUP): a read won't block */
+		for( count--; count >= 0; count-- ) {
+			if( fds[count].revents == 0 )
+				continue;
+			result |= (fds[count].fd == proc->out) ? FB_PROCESS_STDOUT : FB_PROCESS_STDERR;
+		}
+	}
+
+	if( hReap( proc, FALSE ) )
+		result |= FB_PROCESS_EXITED;
+
+	return result;
+}
+
+FBCALL int fb_ProcessWait( FB_PROCESS *proc, int timeout )
+{
+	double until;
+	int ms = 1;
+
+	if( proc == NULL )
+		return -1;
+
+	if( timeout < 0 ) {
+		hReap( proc, TRUE );
+		return proc->exitcode;
+	}
+
+	/* POSIX has no waitpid() with a timeout: poll with a growing delay,
+	   up to 50ms, so short-lived children are noticed quickly */
+	until = fb_Timer( ) + (timeout / 1000.0);
+	while( !hReap( proc, FALSE ) ) {
+		if( fb_Timer( ) >= until )
+			break;
+		poll( NULL, 0, ms );
+		if( ms < 50 )
+			ms *= 2;
+	}
+
+	return proc->exitcode;
+}
+
+FBCALL int fb_ProcessKill( FB_PROCESS *proc )
+{
+	if( proc == NULL )
+		return -1;
+
+	if( proc->exitcode != FB_PROCESS_RUNNING )
+		return 0;
+
+	return (kill( proc->pid, SIGKILL ) == 0) ? 0 : -1;
+}
+
+FBCALL int fb_ProcessClose( FB_PROCESS *proc )
+{
+	int exitcode;
+
+	if( proc == NULL )
+		return -1;
+
+	hClose( &proc->in );
+	hClose( &proc->out );
+	hClose( &proc->err );
+
+	/* don't leave a zombie behind */
+	hReap( proc, TRUE );
+	exitcode = proc->exitcode;
+
+	free( proc );
+	return exitcode;
+}
+
+#else
+
+/* not available on this platform */
+
+FBCALL FB_PROCESS *fb_ProcessStart( const char *program, const char *args, int flags )
+{
+	return NULL;
+}
+
+FBCALL ssize_t fb_ProcessWrite( FB_PROCESS *proc, const void *buffer, ssize_t size )
+{
+	return -1;
+}
+
+FBCALL int fb_ProcessCloseInput( FB_PROCESS *proc )
+{
+	return -1;
+}
+
+FBCALL ssize_t fb_ProcessRead( FB_PROCESS *proc, int stream, void *buffer, ssize_t size )
+{
+	return -1;
+}
+
+FBCALL FBSTRING *fb_ProcessReadAll( FB_PROCESS *proc, int stream )
+{
+	return &__fb_ctx.null_desc;
+}
+
+FBCALL int fb_ProcessPoll( FB_PROCESS *proc, int timeout )
+{
+	return -1;
+}
+
+FBCALL int fb_ProcessWait( FB_PROCESS *proc, int timeout )
+{
+	return -1;
+}
+
+FBCALL int fb_ProcessKill( FB_PROCESS *proc )
+{
+	return -1;
+}
+
+FBCALL int fb_ProcessClose( FB_PROCESS *proc )
+{
+	return -1;
+}
+
+#endif
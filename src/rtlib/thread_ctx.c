@@ -4,7 +4,14 @@
 #include "fb_private_thread.h"
 #include "fb_gfx_private.h"
 
-#if defined ENABLE_MT && defined HOST_UNIX
+#if defined ENABLE_NATIVE_TLS
+	/* __fb_tls_ctxtb[] is __thread, no keys needed */
+	#define FB_TLSENTRY           void *
+	#define FB_TLSALLOC(key)
+	#define FB_TLSFREE(key)
+	#define FB_TLSSET(key,value)  key = (value)
+	#define FB_TLSGET(key)        key
+#elif defined ENABLE_MT && defined HOST_UNIX
 	#define FB_TLSENTRY           pthread_key_t
 	#define FB_TLSALLOC(key)      pthread_key_create( &(key), NULL )
 	#define FB_TLSFREE(key)       pthread_key_delete( (key) )
@@ -30,7 +37,11 @@
 	#define FB_TLSGET(key)        key
 #endif
 
+#ifdef ENABLE_NATIVE_TLS
+FB_TLSVAR FB_TLSENTRY __fb_tls_ctxtb[FB_TLSKEYS];
+#else
 static FB_TLSENTRY __fb_tls_ctxtb[FB_TLSKEYS];
+#endif
 
 /* Retrieve or create new TLS context for given key */
 FBCALL void *fb_TlsGetCtx( int index, size_t len )
@@ -57,6 +68,11 @@ FBCALL void fb_TlsDelCtx( int index )
 			   so it requires extra clean-up when the thread exits.
 			   see also gfxlib2's fb_hGetContext() */
 			free( ((FB_GFXCTX *)ctx)->line );
+		} else if( index == FB_TLSKEY_PROFILE ) {
+			/* the profiler keeps the thread's call tree for the
+			   report written at exit, see profile.c */
+			if( __fb_ctx.profile_thread_end )
+				__fb_ctx.profile_thread_end( ctx );
 		}
 		free( ctx );
 		FB_TLSSET( __fb_tls_ctxtb[index], NULL );
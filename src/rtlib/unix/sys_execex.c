@@ -1,6 +1,9 @@
 #include "../fb.h"
 #include "fb_private_console.h"
 #include <sys/wait.h>
+#include <spawn.h>
+
+extern char **environ;
 
 FBCALL int fb_ExecEx( FBSTRING *program, FBSTRING *args, int do_fork )
 {
@@ -64,28 +67,19 @@ FBCALL int fb_ExecEx( FBSTRING *program, FBSTRING *args, int do_fork )
 	FB_UNLOCK( );
 
 	if( do_fork ) {
-		pid = fork();
-		if( pid != -1 ) {
-			if (pid == 0) {
-				/* execvp() only returns if it failed */
-				execvp( buffer, argv );
-				/* HACK: execvp() failed, this must be communiated to the parent process *somehow*,
-				   so fb_ExecEx() can return -1 there */
-				/* Using _Exit() instead of exit() to prevent the child from flusing file I/O and
-				   running global destructors (especially the rtlib's own cleanup), which may try
-				   to wait on threads to finish (e.g. hinit.c::bg_thread()), but fork() doesn't
-				   duplicate other threads besides the current one, so their pthread handles will be
-				   invalid here in the child process. */
-				_Exit( 255 );
-				/* FIXME: won't be able to tell the difference if the exec'ed program returned 255.
-				   Maybe a pipe could be used instead of the 255 exit code? Unless that's too slow/has side-effects */
-			} else if( (waitpid(pid, &status, 0) > 0) && WIFEXITED(status) ) {
-				res = WEXITSTATUS(status);
-				if( res == 255 ) {
-					/* See the HACK above */
-					res = -1;
-				}
-			}
+		/* posix_spawnp() instead of fork() + execvp(): it doesn't have
+		   to duplicate the page tables of a big parent process, and it
+		   reports a failed exec directly, instead of through a special
+		   exit code of the child. */
+		if( (posix_spawnp( &pid, buffer, NULL, NULL, argv, environ ) == 0) &&
+		    (waitpid( pid, &status, 0 ) > 0) && WIFEXITED( status ) ) {
+			res = WEXITSTATUS( status );
+#if defined __GLIBC__ && !__GLIBC_PREREQ( 2, 24 )
+			/* glibc before 2.24 can't report a failed exec, the
+			   child exits with code 127 instead, as the shell does */
+			if( res == 127 )
+				res = -1;
+#endif
 		}
 	} else {
 		res = execvp( buffer, argv );
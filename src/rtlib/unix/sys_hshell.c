@@ -3,6 +3,48 @@
 #include "../fb.h"
 #include "fb_private_console.h"
 #include <sys/wait.h>
+#include <spawn.h>
+#include <signal.h>
+
+extern char **environ;
+
+/* same as system(), but with posix_spawn() instead of fork(), which is
+   slow for processes with a big heap */
+static int hSystem( char *program )
+{
+	char *argv[4] = { "sh", "-c", program, NULL };
+	struct sigaction ignore, oldint, oldquit;
+	posix_spawnattr_t attr;
+	sigset_t sigdef;
+	pid_t pid;
+	int status = -1, res;
+
+	/* like system(): the shell gets Ctrl+C/Ctrl+\, not the caller */
+	memset( &ignore, 0, sizeof( ignore ) );
+	ignore.sa_handler = SIG_IGN;
+	sigemptyset( &ignore.sa_mask );
+	sigaction( SIGINT, &ignore, &oldint );
+	sigaction( SIGQUIT, &ignore, &oldquit );
+
+	sigemptyset( &sigdef );
+	sigaddset( &sigdef, SIGINT );
+	sigaddset( &sigdef, SIGQUIT );
+	posix_spawnattr_init( &attr );
+	posix_spawnattr_setsigdefault( &attr, &sigdef );
+	posix_spawnattr_setflags( &attr, POSIX_SPAWN_SETSIGDEF );
+
+	res = posix_spawn( &pid, "/bin/sh", NULL, &attr, argv, environ );
+	if( res == 0 ) {
+		if( waitpid( pid, &status, 0 ) == -1 )
+			status = -1;
+	}
+
+	posix_spawnattr_destroy( &attr );
+	sigaction( SIGINT, &oldint, NULL );
+	sigaction( SIGQUIT, &oldquit, NULL );
+
+	return status;
+}
 
 int fb_hShell( char *program )
 {
@@ -12,9 +54,9 @@ int fb_hShell( char *program )
 	fb_hExitConsole();
 	FB_UNLOCK( );
 
-	errcode = system( program );
+	errcode = hSystem( program );
 
-	/* system() result uses same format as the status
+	/* hSystem() result uses same format as the status
 	   returned by waitpid(), or -1 on error */
 	if( errcode != -1 && WIFEXITED( errcode ) ) {
 		errcode = WEXITSTATUS( errcode );
@@ -8,6 +8,10 @@ static void *threadproc( void *param )
 {
 	FBTHREADINFO *info = param;
 
+#ifdef HOST_LINUX
+	fb_hProfileSampleThread( );
+#endif
+
 	/* call the user thread */
 	info->proc( info->param );
 	free( info );
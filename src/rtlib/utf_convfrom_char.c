@@ -1,6 +1,9 @@
 /* ascii to UTF conversion */
 
 #include "fb.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 static char *hToUTF8( const char *src, ssize_t chars, char *dst, ssize_t *bytes )
 {
@@ -40,6 +43,19 @@ static char *hToUTF16( const char *src, ssize_t chars, char *dst, ssize_t *bytes
 	}
 
 	p = (UTF_16 *)dst;
+
+#ifdef __SSE2__
+	/* zero-extend 16 chars at once */
+	for( ; chars >= 16; chars -= 16 )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i *)src );
+		_mm_storeu_si128( (__m128i *)p, _mm_unpacklo_epi8( v, _mm_setzero_si128( ) ) );
+		_mm_storeu_si128( (__m128i *)(p + 8), _mm_unpackhi_epi8( v, _mm_setzero_si128( ) ) );
+		src += 16;
+		p += 16;
+	}
+#endif
+
 	while( chars > 0 )
 	{
 		*p++ = (unsigned char)*src++;
@@ -68,6 +84,23 @@ static char *hToUTF32( const char *src, ssize_t chars, char *dst, ssize_t *bytes
 	}
 
 	p = (UTF_32 *)dst;
+
+#ifdef __SSE2__
+	/* zero-extend 16 chars at once */
+	for( ; chars >= 16; chars -= 16 )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i *)src );
+		__m128i lo = _mm_unpacklo_epi8( v, _mm_setzero_si128( ) );
+		__m128i hi = _mm_unpackhi_epi8( v, _mm_setzero_si128( ) );
+		_mm_storeu_si128( (__m128i *)p, _mm_unpacklo_epi16( lo, _mm_setzero_si128( ) ) );
+		_mm_storeu_si128( (__m128i *)(p + 4), _mm_unpackhi_epi16( lo, _mm_setzero_si128( ) ) );
+		_mm_storeu_si128( (__m128i *)(p + 8), _mm_unpacklo_epi16( hi, _mm_setzero_si128( ) ) );
+		_mm_storeu_si128( (__m128i *)(p + 12), _mm_unpackhi_epi16( hi, _mm_setzero_si128( ) ) );
+		src += 16;
+		p += 16;
+	}
+#endif
+
 	while( chars > 0 )
 	{
 		*p++ = (unsigned char)*src++;
@@ -3,6 +3,56 @@
  */
 
 #include "fb.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* copy the chars < 0x80 at the start of 'src', which are the same in UTF-8,
+   returning how many were copied; 16 at once with SSE2 */
+static ssize_t hAsciiToUTF8( const FB_WCHAR *src, ssize_t chars, UTF_8 *dst )
+{
+	ssize_t i = 0;
+
+#ifdef __SSE2__
+	if( sizeof( FB_WCHAR ) == sizeof( UTF_32 ) )
+	{
+		const __m128i high = _mm_set1_epi32( ~0x7F );
+		for( ; i + 16 <= chars; i += 16 )
+		{
+			__m128i v0 = _mm_loadu_si128( (const __m128i *)(src + i) );
+			__m128i v1 = _mm_loadu_si128( (const __m128i *)(src + i + 4) );
+			__m128i v2 = _mm_loadu_si128( (const __m128i *)(src + i + 8) );
+			__m128i v3 = _mm_loadu_si128( (const __m128i *)(src + i + 12) );
+			__m128i any = _mm_or_si128( _mm_or_si128( v0, v1 ), _mm_or_si128( v2, v3 ) );
+			if( _mm_movemask_epi8( _mm_cmpeq_epi32( _mm_and_si128( any, high ), _mm_setzero_si128( ) ) ) != 0xFFFF )
+				break;
+			_mm_storeu_si128( (__m128i *)(dst + i),
+			                  _mm_packus_epi16( _mm_packs_epi32( v0, v1 ), _mm_packs_epi32( v2, v3 ) ) );
+		}
+	}
+	else if( sizeof( FB_WCHAR ) == sizeof( UTF_16 ) )
+	{
+		const __m128i high = _mm_set1_epi16( ~0x7F );
+		for( ; i + 16 <= chars; i += 16 )
+		{
+			__m128i v0 = _mm_loadu_si128( (const __m128i *)(src + i) );
+			__m128i v1 = _mm_loadu_si128( (const __m128i *)(src + i + 8) );
+			__m128i any = _mm_or_si128( v0, v1 );
+			if( _mm_movemask_epi8( _mm_cmpeq_epi16( _mm_and_si128( any, high ), _mm_setzero_si128( ) ) ) != 0xFFFF )
+				break;
+			_mm_storeu_si128( (__m128i *)(dst + i), _mm_packus_epi16( v0, v1 ) );
+		}
+	}
+#endif
+
+	while( (i < chars) && ((UTF_32)src[i] < 0x80) )
+	{
+		dst[i] = (UTF_8)src[i];
+		++i;
+	}
+
+	return i;
+}
 
 static void hUTF16ToUTF8( const FB_WCHAR *src, ssize_t chars, UTF_8 *dst, ssize_t *total_bytes )
 {
@@ -12,6 +62,17 @@ static void hUTF16ToUTF8( const FB_WCHAR *src, ssize_t chars, UTF_8 *dst, ssize_
 	*total_bytes = 0;
 	while( chars > 0 )
 	{
+		bytes = hAsciiToUTF8( src, chars, dst );
+		if( bytes > 0 )
+		{
+			src += bytes;
+			dst += bytes;
+			*total_bytes += bytes;
+			chars -= bytes;
+			if( chars == 0 )
+				break;
+		}
+
 		c = *src++;
 		if( c >= UTF16_SUR_HIGH_START && c <= UTF16_SUR_HIGH_END )
 		{
@@ -64,6 +125,17 @@ static void hUTF32ToUTF8( const FB_WCHAR *src, ssize_t chars, UTF_8 *dst, ssize_
 	*total_bytes = 0;
 	while( chars > 0 )
 	{
+		bytes = hAsciiToUTF8( src, chars, dst );
+		if( bytes > 0 )
+		{
+			src += bytes;
+			dst += bytes;
+			*total_bytes += bytes;
+			chars -= bytes;
+			if( chars == 0 )
+				break;
+		}
+
 		c = *src++;
 		if( c < (UTF_32)0x80 )
 			bytes =	1;
@@ -70,7 +70,7 @@ if 'dst' is not null
 char *fb_hUTF8ToChar( const UTF_8 *src, char *dst, ssize_t *chars )
 {
 	UTF_32 c;
-	ssize_t extbytes, charsleft;
+	ssize_t extbytes, charsleft, ascii;
 	char *buffer = dst;
 	
     if( dst == NULL )
@@ -79,6 +79,16 @@ char *fb_hUTF8ToChar( const UTF_8 *src, char *dst, ssize_t *chars )
 	    charsleft = 0;
 	    do 
 	    {
+			/* ASCII fast path */
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			if( ascii > 0 )
+			{
+				memcpy( dst, src, ascii );
+				src += ascii;
+				dst += ascii;
+				charsleft -= ascii;
+			}
+
 			extbytes = __fb_utf8_trailingTb[(unsigned int)*src];
 	
 			c = 0;
@@ -110,7 +120,8 @@ char *fb_hUTF8ToChar( const UTF_8 *src, char *dst, ssize_t *chars )
 	
 			if( charsleft == 0 )
 			{
-				charsleft = 8;
+				/* double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				char *newbuffer = realloc( buffer, dst_size );
 				if( newbuffer == NULL )
@@ -137,6 +148,17 @@ char *fb_hUTF8ToChar( const UTF_8 *src, char *dst, ssize_t *chars )
 	    charsleft = *chars;
 	    while( charsleft > 0 )
 	    {
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			if( ascii > 0 )
+			{
+				memcpy( dst, src, ascii );
+				src += ascii;
+				dst += ascii;
+				charsleft -= ascii;
+				if( charsleft == 0 )
+					break;
+			}
+
 			extbytes = __fb_utf8_trailingTb[*src];
 	
 			c = 0;
@@ -202,7 +224,8 @@ char *fb_hUTF16ToChar( const UTF_16 *src, char *dst, ssize_t *chars )
 	
 			if( charsleft == 0 )
 			{
-				charsleft = 8;
+				/* double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				char *newbuffer = realloc( buffer, dst_size );
 				if( newbuffer == NULL )
@@ -269,7 +292,8 @@ char *fb_hUTF32ToChar( const UTF_32 *src, char *dst, ssize_t *chars )
 	
 			if( charsleft == 0 )
 			{
-				charsleft = 8;
+				/* double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				char *newbuffer = realloc( buffer, dst_size );
 				if( newbuffer == NULL )
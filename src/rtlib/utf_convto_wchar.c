@@ -14,7 +14,7 @@ char *fb_hUTF32ToChar( const UTF_32 *src, char *dst, ssize_t *chars );
 static FB_WCHAR *hUTF8ToUTF16( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 {
 	UTF_32 c;
-	ssize_t extbytes, charsleft;
+	ssize_t extbytes, charsleft, ascii, i;
 	FB_WCHAR *buffer = dst;
 	
     if( dst == NULL )
@@ -23,6 +23,14 @@ static FB_WCHAR *hUTF8ToUTF16( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 	    charsleft = 0;
 	    do 
 	    {
+			/* ASCII fast path */
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			for( i = 0; i < ascii; i++ )
+				dst[i] = src[i];
+			src += ascii;
+			dst += ascii;
+			charsleft -= ascii;
+
 			extbytes = __fb_utf8_trailingTb[(unsigned int)*src];
 	
 			c = 0;
@@ -55,8 +63,8 @@ static FB_WCHAR *hUTF8ToUTF16( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 				/* If we still have room for 1 char, reclaim it */
 				dst_size -= charsleft;
 
-				/* Make room for some chars */
-				charsleft = 8;
+				/* Make room for some chars, double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 
 				FB_WCHAR *newbuffer = realloc( buffer, dst_size * sizeof( FB_WCHAR ) );
@@ -92,6 +100,18 @@ static FB_WCHAR *hUTF8ToUTF16( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 	    charsleft = *chars;
 	    while( charsleft > 0 )
 	    {
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			if( ascii > 0 )
+			{
+				for( i = 0; i < ascii; i++ )
+					dst[i] = src[i];
+				src += ascii;
+				dst += ascii;
+				charsleft -= ascii;
+				if( charsleft == 0 )
+					break;
+			}
+
 			extbytes = __fb_utf8_trailingTb[*src];
 	
 			c = 0;
@@ -146,7 +166,7 @@ static FB_WCHAR *hUTF8ToUTF16( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 static FB_WCHAR *hUTF8ToUTF32( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 {
 	UTF_32 c;
-	ssize_t extbytes, charsleft;
+	ssize_t extbytes, charsleft, ascii, i;
 	FB_WCHAR *buffer = dst;
 	
     if( dst == NULL )
@@ -155,6 +175,14 @@ static FB_WCHAR *hUTF8ToUTF32( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 	    charsleft = 0;
 	    do 
 	    {
+			/* ASCII fast path */
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			for( i = 0; i < ascii; i++ )
+				dst[i] = src[i];
+			src += ascii;
+			dst += ascii;
+			charsleft -= ascii;
+
 			extbytes = __fb_utf8_trailingTb[(unsigned int)*src];
 	
 			c = 0;
@@ -183,7 +211,8 @@ static FB_WCHAR *hUTF8ToUTF32( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 
 			if( charsleft == 0 )
 			{
-				charsleft = 8;
+				/* double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				FB_WCHAR *newbuffer = realloc( buffer, dst_size * sizeof( FB_WCHAR ) );
 				if( newbuffer == NULL )
@@ -210,6 +239,18 @@ static FB_WCHAR *hUTF8ToUTF32( const UTF_8 *src, FB_WCHAR *dst, ssize_t *chars )
 	    charsleft = *chars;
 	    while( charsleft > 0 )
 	    {
+			ascii = fb_hUTF8AsciiLenZ( src, charsleft );
+			if( ascii > 0 )
+			{
+				for( i = 0; i < ascii; i++ )
+					dst[i] = src[i];
+				src += ascii;
+				dst += ascii;
+				charsleft -= ascii;
+				if( charsleft == 0 )
+					break;
+			}
+
 			extbytes = __fb_utf8_trailingTb[*src];
 	
 			c = 0;
@@ -317,7 +358,8 @@ static FB_WCHAR *hUTF16ToUTF32( const UTF_16 *src, FB_WCHAR *dst, ssize_t *chars
 	
 			if( charsleft == 0 )
 			{
-				charsleft = 8;
+				/* double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				FB_WCHAR *newbuffer = realloc( buffer, dst_size * sizeof( FB_WCHAR ) );
 				if( newbuffer == NULL ) {
@@ -404,8 +446,8 @@ static FB_WCHAR *hUTF32ToUTF16( const UTF_32 *src, FB_WCHAR *dst, ssize_t *chars
 				/* If we still have room for 1 char, reclaim it */
 				dst_size -= charsleft;
 
-				/* Make room for some chars */
-				charsleft = 8;
+				/* Make room for some chars, double it */
+				charsleft = (dst_size < 8) ? 8 : dst_size;
 				dst_size += charsleft;
 				FB_WCHAR *newbuffer = realloc( buffer, dst_size * sizeof( FB_WCHAR ) );
 				if( newbuffer == NULL ) {
@@ -3,6 +3,9 @@
  */
 
 #include "fb.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 const UTF_8 __fb_utf8_bmarkTb[7] = 
 	{ 
@@ -47,23 +50,117 @@ const UTF_32 __fb_utf8_offsetsTb[6] =
 void fb_hCharToUTF8( const char *src, ssize_t chars, char *dst, ssize_t *total_bytes )
 {
 	UTF_8 c;
+	ssize_t ascii;
 
 	*total_bytes = 0;
 	while( chars > 0 )
 	{
-		c = *src++;
-		if( c < 0x80 )
-		{
-			*dst++ = c;
-			*total_bytes += 1;
-		}
-		else
+		/* ASCII is the same in UTF-8 */
+		ascii = fb_hUTF8AsciiLen( (const UTF_8 *)src, chars );
+		if( ascii > 0 )
 		{
-			*dst++ = 0xC0 | (c >> 6);
-			*dst++ = ((c | UTF8_BYTEMARK) & UTF8_BYTEMASK);
-			*total_bytes += 2;
+			memcpy( dst, src, ascii );
+			src += ascii;
+			dst += ascii;
+			*total_bytes += ascii;
+			chars -= ascii;
+			if( chars == 0 )
+				break;
 		}
 
+		c = *src++;
+		*dst++ = 0xC0 | (c >> 6);
+		*dst++ = ((c | UTF8_BYTEMARK) & UTF8_BYTEMASK);
+		*total_bytes += 2;
+
 		--chars;
 	}
 }
+
+/*
+	ssize_t fb_hUTF8AsciiLen( const UTF_8 *src, ssize_t len )
+	ssize_t fb_hUTF8AsciiLenZ( const UTF_8 *src, ssize_t max )
+
+		return the number of chars < 0x80 at the start of 'src', that can
+		be copied as they are, looking at no more than 'len'/'max' chars;
+		the Z version also stops at a null char, for null-terminated
+		strings of unknown length.
+
+		used by the converters and the file decoders for their ASCII fast
+		path, checking 16 chars at once with SSE2 if available, or 8 with
+		integer ops.
+*/
+
+#define HAS_HIGHBIT( w ) ((w) & (((size_t)-1 / 0xFF) * 0x80))
+#define HAS_NULL( w )    (((w) - ((size_t)-1 / 0xFF)) & ~(w) & (((size_t)-1 / 0xFF) * 0x80))
+
+ssize_t fb_hUTF8AsciiLen( const UTF_8 *src, ssize_t len )
+{
+	ssize_t i = 0;
+
+#ifdef __SSE2__
+	for( ; i + 16 <= len; i += 16 )
+	{
+		int mask = _mm_movemask_epi8( _mm_loadu_si128( (const __m128i *)(src + i) ) );
+		if( mask != 0 )
+			return i + __builtin_ctz( mask );
+	}
+#else
+	for( ; i + (ssize_t)sizeof( size_t ) <= len; i += sizeof( size_t ) )
+	{
+		size_t w;
+		memcpy( &w, src + i, sizeof( size_t ) );
+		if( HAS_HIGHBIT( w ) )
+			break;
+	}
+#endif
+
+	while( (i < len) && (src[i] < 0x80) )
+		++i;
+
+	return i;
+}
+
+ssize_t fb_hUTF8AsciiLenZ( const UTF_8 *src, ssize_t max )
+{
+	const UTF_8 *p = src, *limit = src + max;
+
+	/* aligned loads can't cross into an unmapped page, even if they read
+	   past the null char */
+#ifdef __SSE2__
+	while( (p < limit) && (((size_t)p & 15) != 0) )
+	{
+		if( (*p == 0) || (*p >= 0x80) )
+			return p - src;
+		++p;
+	}
+
+	for( ; p + 16 <= limit; p += 16 )
+	{
+		__m128i v = _mm_load_si128( (const __m128i *)p );
+		int mask = _mm_movemask_epi8( v ) |
+		           _mm_movemask_epi8( _mm_cmpeq_epi8( v, _mm_setzero_si128( ) ) );
+		if( mask != 0 )
+			return (p - src) + __builtin_ctz( mask );
+	}
+#else
+	while( (p < limit) && (((size_t)p & (sizeof( size_t ) - 1)) != 0) )
+	{
+		if( (*p == 0) || (*p >= 0x80) )
+			return p - src;
+		++p;
+	}
+
+	for( ; p + sizeof( size_t ) <= limit; p += sizeof( size_t ) )
+	{
+		size_t w = *(const size_t *)p;
+		if( HAS_HIGHBIT( w ) || HAS_NULL( w ) )
+			break;
+	}
+#endif
+
+	while( (p < limit) && (*p != 0) && (*p < 0x80) )
+		++p;
+
+	return p - src;
+}
@@ -0,0 +1,538 @@
+# include "fbcunit.bi"
+
+'' SELECT CASEs on strings with more literals than the compiler holds back
+'' for the hash lookup: the held back compares must be emitted in place
+'' once the tables are full, nested SELECTs included
+
+SUITE( fbc_tests.compound.select_hash_large )
+
+	'' 1500 literals held back, then a nested SELECT whose 700 literals
+	'' don't fit anymore, then one more level that fits again
+	private function nested( byref s as string, byref t as string ) as integer
+		select case s
+		case "o0", "o1", "o2", "o3", "o4", "o5", "o6", "o7", "o8", "o9" : return 0
+		case "o10", "o11", "o12", "o13", "o14", "o15", "o16", "o17", "o18", "o19" : return 1
+		case "o20", "o21", "o22", "o23", "o24", "o25", "o26", "o27", "o28", "o29" : return 2
+		case "o30", "o31", "o32", "o33", "o34", "o35", "o36", "o37", "o38", "o39" : return 3
+		case "o40", "o41", "o42", "o43", "o44", "o45", "o46", "o47", "o48", "o49" : return 4
+		case "o50", "o51", "o52", "o53", "o54", "o55", "o56", "o57", "o58", "o59" : return 5
+		case "o60", "o61", "o62", "o63", "o64", "o65", "o66", "o67", "o68", "o69" : return 6
+		case "o70", "o71", "o72", "o73", "o74", "o75", "o76", "o77", "o78", "o79" : return 7
+		case "o80", "o81", "o82", "o83", "o84", "o85", "o86", "o87", "o88", "o89" : return 8
+		case "o90", "o91", "o92", "o93", "o94", "o95", "o96", "o97", "o98", "o99" : return 9
+		case "o100", "o101", "o102", "o103", "o104", "o105", "o106", "o107", "o108", "o109" : return 10
+		case "o110", "o111", "o112", "o113", "o114", "o115", "o116", "o117", "o118", "o119" : return 11
+		case "o120", "o121", "o122", "o123", "o124", "o125", "o126", "o127", "o128", "o129" : return 12
+		case "o130", "o131", "o132", "o133", "o134", "o135", "o136", "o137", "o138", "o139" : return 13
+		case "o140", "o141", "o142", "o143", "o144", "o145", "o146", "o147", "o148", "o149" : return 14
+		case "o150", "o151", "o152", "o153", "o154", "o155", "o156", "o157", "o158", "o159" : return 15
+		case "o160", "o161", "o162", "o163", "o164", "o165", "o166", "o167", "o168", "o169" : return 16
+		case "o170", "o171", "o172", "o173", "o174", "o175", "o176", "o177", "o178", "o179" : return 17
+		case "o180", "o181", "o182", "o183", "o184", "o185", "o186", "o187", "o188", "o189" : return 18
+		case "o190", "o191", "o192", "o193", "o194", "o195", "o196", "o197", "o198", "o199" : return 19
+		case "o200", "o201", "o202", "o203", "o204", "o205", "o206", "o207", "o208", "o209" : return 20
+		case "o210", "o211", "o212", "o213", "o214", "o215", "o216", "o217", "o218", "o219" : return 21
+		case "o220", "o221", "o222", "o223", "o224", "o225", "o226", "o227", "o228", "o229" : return 22
+		case "o230", "o231", "o232", "o233", "o234", "o235", "o236", "o237", "o238", "o239" : return 23
+		case "o240", "o241", "o242", "o243", "o244", "o245", "o246", "o247", "o248", "o249" : return 24
+		case "o250", "o251", "o252", "o253", "o254", "o255", "o256", "o257", "o258", "o259" : return 25
+		case "o260", "o261", "o262", "o263", "o264", "o265", "o266", "o267", "o268", "o269" : return 26
+		case "o270", "o271", "o272", "o273", "o274", "o275", "o276", "o277", "o278", "o279" : return 27
+		case "o280", "o281", "o282", "o283", "o284", "o285", "o286", "o287", "o288", "o289" : return 28
+		case "o290", "o291", "o292", "o293", "o294", "o295", "o296", "o297", "o298", "o299" : return 29
+		case "o300", "o301", "o302", "o303", "o304", "o305", "o306", "o307", "o308", "o309" : return 30
+		case "o310", "o311", "o312", "o313", "o314", "o315", "o316", "o317", "o318", "o319" : return 31
+		case "o320", "o321", "o322", "o323", "o324", "o325", "o326", "o327", "o328", "o329" : return 32
+		case "o330", "o331", "o332", "o333", "o334", "o335", "o336", "o337", "o338", "o339" : return 33
+		case "o340", "o341", "o342", "o343", "o344", "o345", "o346", "o347", "o348", "o349" : return 34
+		case "o350", "o351", "o352", "o353", "o354", "o355", "o356", "o357", "o358", "o359" : return 35
+		case "o360", "o361", "o362", "o363", "o364", "o365", "o366", "o367", "o368", "o369" : return 36
+		case "o370", "o371", "o372", "o373", "o374", "o375", "o376", "o377", "o378", "o379" : return 37
+		case "o380", "o381", "o382", "o383", "o384", "o385", "o386", "o387", "o388", "o389" : return 38
+		case "o390", "o391", "o392", "o393", "o394", "o395", "o396", "o397", "o398", "o399" : return 39
+		case "o400", "o401", "o402", "o403", "o404", "o405", "o406", "o407", "o408", "o409" : return 40
+		case "o410", "o411", "o412", "o413", "o414", "o415", "o416", "o417", "o418", "o419" : return 41
+		case "o420", "o421", "o422", "o423", "o424", "o425", "o426", "o427", "o428", "o429" : return 42
+		case "o430", "o431", "o432", "o433", "o434", "o435", "o436", "o437", "o438", "o439" : return 43
+		case "o440", "o441", "o442", "o443", "o444", "o445", "o446", "o447", "o448", "o449" : return 44
+		case "o450", "o451", "o452", "o453", "o454", "o455", "o456", "o457", "o458", "o459" : return 45
+		case "o460", "o461", "o462", "o463", "o464", "o465", "o466", "o467", "o468", "o469" : return 46
+		case "o470", "o471", "o472", "o473", "o474", "o475", "o476", "o477", "o478", "o479" : return 47
+		case "o480", "o481", "o482", "o483", "o484", "o485", "o486", "o487", "o488", "o489" : return 48
+		case "o490", "o491", "o492", "o493", "o494", "o495", "o496", "o497", "o498", "o499" : return 49
+		case "o500", "o501", "o502", "o503", "o504", "o505", "o506", "o507", "o508", "o509" : return 50
+		case "o510", "o511", "o512", "o513", "o514", "o515", "o516", "o517", "o518", "o519" : return 51
+		case "o520", "o521", "o522", "o523", "o524", "o525", "o526", "o527", "o528", "o529" : return 52
+		case "o530", "o531", "o532", "o533", "o534", "o535", "o536", "o537", "o538", "o539" : return 53
+		case "o540", "o541", "o542", "o543", "o544", "o545", "o546", "o547", "o548", "o549" : return 54
+		case "o550", "o551", "o552", "o553", "o554", "o555", "o556", "o557", "o558", "o559" : return 55
+		case "o560", "o561", "o562", "o563", "o564", "o565", "o566", "o567", "o568", "o569" : return 56
+		case "o570", "o571", "o572", "o573", "o574", "o575", "o576", "o577", "o578", "o579" : return 57
+		case "o580", "o581", "o582", "o583", "o584", "o585", "o586", "o587", "o588", "o589" : return 58
+		case "o590", "o591", "o592", "o593", "o594", "o595", "o596", "o597", "o598", "o599" : return 59
+		case "o600", "o601", "o602", "o603", "o604", "o605", "o606", "o607", "o608", "o609" : return 60
+		case "o610", "o611", "o612", "o613", "o614", "o615", "o616", "o617", "o618", "o619" : return 61
+		case "o620", "o621", "o622", "o623", "o624", "o625", "o626", "o627", "o628", "o629" : return 62
+		case "o630", "o631", "o632", "o633", "o634", "o635", "o636", "o637", "o638", "o639" : return 63
+		case "o640", "o641", "o642", "o643", "o644", "o645", "o646", "o647", "o648", "o649" : return 64
+		case "o650", "o651", "o652", "o653", "o654", "o655", "o656", "o657", "o658", "o659" : return 65
+		case "o660", "o661", "o662", "o663", "o664", "o665", "o666", "o667", "o668", "o669" : return 66
+		case "o670", "o671", "o672", "o673", "o674", "o675", "o676", "o677", "o678", "o679" : return 67
+		case "o680", "o681", "o682", "o683", "o684", "o685", "o686", "o687", "o688", "o689" : return 68
+		case "o690", "o691", "o692", "o693", "o694", "o695", "o696", "o697", "o698", "o699" : return 69
+		case "o700", "o701", "o702", "o703", "o704", "o705", "o706", "o707", "o708", "o709" : return 70
+		case "o710", "o711", "o712", "o713", "o714", "o715", "o716", "o717", "o718", "o719" : return 71
+		case "o720", "o721", "o722", "o723", "o724", "o725", "o726", "o727", "o728", "o729" : return 72
+		case "o730", "o731", "o732", "o733", "o734", "o735", "o736", "o737", "o738", "o739" : return 73
+		case "o740", "o741", "o742", "o743", "o744", "o745", "o746", "o747", "o748", "o749" : return 74
+		case "o750", "o751", "o752", "o753", "o754", "o755", "o756", "o757", "o758", "o759" : return 75
+		case "o760", "o761", "o762", "o763", "o764", "o765", "o766", "o767", "o768", "o769" : return 76
+		case "o770", "o771", "o772", "o773", "o774", "o775", "o776", "o777", "o778", "o779" : return 77
+		case "o780", "o781", "o782", "o783", "o784", "o785", "o786", "o787", "o788", "o789" : return 78
+		case "o790", "o791", "o792", "o793", "o794", "o795", "o796", "o797", "o798", "o799" : return 79
+		case "o800", "o801", "o802", "o803", "o804", "o805", "o806", "o807", "o808", "o809" : return 80
+		case "o810", "o811", "o812", "o813", "o814", "o815", "o816", "o817", "o818", "o819" : return 81
+		case "o820", "o821", "o822", "o823", "o824", "o825", "o826", "o827", "o828", "o829" : return 82
+		case "o830", "o831", "o832", "o833", "o834", "o835", "o836", "o837", "o838", "o839" : return 83
+		case "o840", "o841", "o842", "o843", "o844", "o845", "o846", "o847", "o848", "o849" : return 84
+		case "o850", "o851", "o852", "o853", "o854", "o855", "o856", "o857", "o858", "o859" : return 85
+		case "o860", "o861", "o862", "o863", "o864", "o865", "o866", "o867", "o868", "o869" : return 86
+		case "o870", "o871", "o872", "o873", "o874", "o875", "o876", "o877", "o878", "o879" : return 87
+		case "o880", "o881", "o882", "o883", "o884", "o885", "o886", "o887", "o888", "o889" : return 88
+		case "o890", "o891", "o892", "o893", "o894", "o895", "o896", "o897", "o898", "o899" : return 89
+		case "o900", "o901", "o902", "o903", "o904", "o905", "o906", "o907", "o908", "o909" : return 90
+		case "o910", "o911", "o912", "o913", "o914", "o915", "o916", "o917", "o918", "o919" : return 91
+		case "o920", "o921", "o922", "o923", "o924", "o925", "o926", "o927", "o928", "o929" : return 92
+		case "o930", "o931", "o932", "o933", "o934", "o935", "o936", "o937", "o938", "o939" : return 93
+		case "o940", "o941", "o942", "o943", "o944", "o945", "o946", "o947", "o948", "o949" : return 94
+		case "o950", "o951", "o952", "o953", "o954", "o955", "o956", "o957", "o958", "o959" : return 95
+		case "o960", "o961", "o962", "o963", "o964", "o965", "o966", "o967", "o968", "o969" : return 96
+		case "o970", "o971", "o972", "o973", "o974", "o975", "o976", "o977", "o978", "o979" : return 97
+		case "o980", "o981", "o982", "o983", "o984", "o985", "o986", "o987", "o988", "o989" : return 98
+		case "o990", "o991", "o992", "o993", "o994", "o995", "o996", "o997", "o998", "o999" : return 99
+		case "o1000", "o1001", "o1002", "o1003", "o1004", "o1005", "o1006", "o1007", "o1008", "o1009" : return 100
+		case "o1010", "o1011", "o1012", "o1013", "o1014", "o1015", "o1016", "o1017", "o1018", "o1019" : return 101
+		case "o1020", "o1021", "o1022", "o1023", "o1024", "o1025", "o1026", "o1027", "o1028", "o1029" : return 102
+		case "o1030", "o1031", "o1032", "o1033", "o1034", "o1035", "o1036", "o1037", "o1038", "o1039" : return 103
+		case "o1040", "o1041", "o1042", "o1043", "o1044", "o1045", "o1046", "o1047", "o1048", "o1049" : return 104
+		case "o1050", "o1051", "o1052", "o1053", "o1054", "o1055", "o1056", "o1057", "o1058", "o1059" : return 105
+		case "o1060", "o1061", "o1062", "o1063", "o1064", "o1065", "o1066", "o1067", "o1068", "o1069" : return 106
+		case "o1070", "o1071", "o1072", "o1073", "o1074", "o1075", "o1076", "o1077", "o1078", "o1079" : return 107
+		case "o1080", "o1081", "o1082", "o1083", "o1084", "o1085", "o1086", "o1087", "o1088", "o1089" : return 108
+		case "o1090", "o1091", "o1092", "o1093", "o1094", "o1095", "o1096", "o1097", "o1098", "o1099" : return 109
+		case "o1100", "o1101", "o1102", "o1103", "o1104", "o1105", "o1106", "o1107", "o1108", "o1109" : return 110
+		case "o1110", "o1111", "o1112", "o1113", "o1114", "o1115", "o1116", "o1117", "o1118", "o1119" : return 111
+		case "o1120", "o1121", "o1122", "o1123", "o1124", "o1125", "o1126", "o1127", "o1128", "o1129" : return 112
+		case "o1130", "o1131", "o1132", "o1133", "o1134", "o1135", "o1136", "o1137", "o1138", "o1139" : return 113
+		case "o1140", "o1141", "o1142", "o1143", "o1144", "o1145", "o1146", "o1147", "o1148", "o1149" : return 114
+		case "o1150", "o1151", "o1152", "o1153", "o1154", "o1155", "o1156", "o1157", "o1158", "o1159" : return 115
+		case "o1160", "o1161", "o1162", "o1163", "o1164", "o1165", "o1166", "o1167", "o1168", "o1169" : return 116
+		case "o1170", "o1171", "o1172", "o1173", "o1174", "o1175", "o1176", "o1177", "o1178", "o1179" : return 117
+		case "o1180", "o1181", "o1182", "o1183", "o1184", "o1185", "o1186", "o1187", "o1188", "o1189" : return 118
+		case "o1190", "o1191", "o1192", "o1193", "o1194", "o1195", "o1196", "o1197", "o1198", "o1199" : return 119
+		case "o1200", "o1201", "o1202", "o1203", "o1204", "o1205", "o1206", "o1207", "o1208", "o1209" : return 120
+		case "o1210", "o1211", "o1212", "o1213", "o1214", "o1215", "o1216", "o1217", "o1218", "o1219" : return 121
+		case "o1220", "o1221", "o1222", "o1223", "o1224", "o1225", "o1226", "o1227", "o1228", "o1229" : return 122
+		case "o1230", "o1231", "o1232", "o1233", "o1234", "o1235", "o1236", "o1237", "o1238", "o1239" : return 123
+		case "o1240", "o1241", "o1242", "o1243", "o1244", "o1245", "o1246", "o1247", "o1248", "o1249" : return 124
+		case "o1250", "o1251", "o1252", "o1253", "o1254", "o1255", "o1256", "o1257", "o1258", "o1259" : return 125
+		case "o1260", "o1261", "o1262", "o1263", "o1264", "o1265", "o1266", "o1267", "o1268", "o1269" : return 126
+		case "o1270", "o1271", "o1272", "o1273", "o1274", "o1275", "o1276", "o1277", "o1278", "o1279" : return 127
+		case "o1280", "o1281", "o1282", "o1283", "o1284", "o1285", "o1286", "o1287", "o1288", "o1289" : return 128
+		case "o1290", "o1291", "o1292", "o1293", "o1294", "o1295", "o1296", "o1297", "o1298", "o1299" : return 129
+		case "o1300", "o1301", "o1302", "o1303", "o1304", "o1305", "o1306", "o1307", "o1308", "o1309" : return 130
+		case "o1310", "o1311", "o1312", "o1313", "o1314", "o1315", "o1316", "o1317", "o1318", "o1319" : return 131
+		case "o1320", "o1321", "o1322", "o1323", "o1324", "o1325", "o1326", "o1327", "o1328", "o1329" : return 132
+		case "o1330", "o1331", "o1332", "o1333", "o1334", "o1335", "o1336", "o1337", "o1338", "o1339" : return 133
+		case "o1340", "o1341", "o1342", "o1343", "o1344", "o1345", "o1346", "o1347", "o1348", "o1349" : return 134
+		case "o1350", "o1351", "o1352", "o1353", "o1354", "o1355", "o1356", "o1357", "o1358", "o1359" : return 135
+		case "o1360", "o1361", "o1362", "o1363", "o1364", "o1365", "o1366", "o1367", "o1368", "o1369" : return 136
+		case "o1370", "o1371", "o1372", "o1373", "o1374", "o1375", "o1376", "o1377", "o1378", "o1379" : return 137
+		case "o1380", "o1381", "o1382", "o1383", "o1384", "o1385", "o1386", "o1387", "o1388", "o1389" : return 138
+		case "o1390", "o1391", "o1392", "o1393", "o1394", "o1395", "o1396", "o1397", "o1398", "o1399" : return 139
+		case "o1400", "o1401", "o1402", "o1403", "o1404", "o1405", "o1406", "o1407", "o1408", "o1409" : return 140
+		case "o1410", "o1411", "o1412", "o1413", "o1414", "o1415", "o1416", "o1417", "o1418", "o1419" : return 141
+		case "o1420", "o1421", "o1422", "o1423", "o1424", "o1425", "o1426", "o1427", "o1428", "o1429" : return 142
+		case "o1430", "o1431", "o1432", "o1433", "o1434", "o1435", "o1436", "o1437", "o1438", "o1439" : return 143
+		case "o1440", "o1441", "o1442", "o1443", "o1444", "o1445", "o1446", "o1447", "o1448", "o1449" : return 144
+		case "o1450", "o1451", "o1452", "o1453", "o1454", "o1455", "o1456", "o1457", "o1458", "o1459" : return 145
+		case "o1460", "o1461", "o1462", "o1463", "o1464", "o1465", "o1466", "o1467", "o1468", "o1469" : return 146
+		case "o1470", "o1471", "o1472", "o1473", "o1474", "o1475", "o1476", "o1477", "o1478", "o1479" : return 147
+		case "o1480", "o1481", "o1482", "o1483", "o1484", "o1485", "o1486", "o1487", "o1488", "o1489" : return 148
+		case "o1490", "o1491", "o1492", "o1493", "o1494", "o1495", "o1496", "o1497", "o1498", "o1499" : return 149
+		case "inner"
+			select case t
+			case "i0", "i1", "i2", "i3", "i4", "i5", "i6" : return 1000 + 0
+			case "i7", "i8", "i9", "i10", "i11", "i12", "i13" : return 1000 + 1
+			case "i14", "i15", "i16", "i17", "i18", "i19", "i20" : return 1000 + 2
+			case "i21", "i22", "i23", "i24", "i25", "i26", "i27" : return 1000 + 3
+			case "i28", "i29", "i30", "i31", "i32", "i33", "i34" : return 1000 + 4
+			case "i35", "i36", "i37", "i38", "i39", "i40", "i41" : return 1000 + 5
+			case "i42", "i43", "i44", "i45", "i46", "i47", "i48" : return 1000 + 6
+			case "i49", "i50", "i51", "i52", "i53", "i54", "i55" : return 1000 + 7
+			case "i56", "i57", "i58", "i59", "i60", "i61", "i62" : return 1000 + 8
+			case "i63", "i64", "i65", "i66", "i67", "i68", "i69" : return 1000 + 9
+			case "i70", "i71", "i72", "i73", "i74", "i75", "i76" : return 1000 + 10
+			case "i77", "i78", "i79", "i80", "i81", "i82", "i83" : return 1000 + 11
+			case "i84", "i85", "i86", "i87", "i88", "i89", "i90" : return 1000 + 12
+			case "i91", "i92", "i93", "i94", "i95", "i96", "i97" : return 1000 + 13
+			case "i98", "i99", "i100", "i101", "i102", "i103", "i104" : return 1000 + 14
+			case "i105", "i106", "i107", "i108", "i109", "i110", "i111" : return 1000 + 15
+			case "i112", "i113", "i114", "i115", "i116", "i117", "i118" : return 1000 + 16
+			case "i119", "i120", "i121", "i122", "i123", "i124", "i125" : return 1000 + 17
+			case "i126", "i127", "i128", "i129", "i130", "i131", "i132" : return 1000 + 18
+			case "i133", "i134", "i135", "i136", "i137", "i138", "i139" : return 1000 + 19
+			case "i140", "i141", "i142", "i143", "i144", "i145", "i146" : return 1000 + 20
+			case "i147", "i148", "i149", "i150", "i151", "i152", "i153" : return 1000 + 21
+			case "i154", "i155", "i156", "i157", "i158", "i159", "i160" : return 1000 + 22
+			case "i161", "i162", "i163", "i164", "i165", "i166", "i167" : return 1000 + 23
+			case "i168", "i169", "i170", "i171", "i172", "i173", "i174" : return 1000 + 24
+			case "i175", "i176", "i177", "i178", "i179", "i180", "i181" : return 1000 + 25
+			case "i182", "i183", "i184", "i185", "i186", "i187", "i188" : return 1000 + 26
+			case "i189", "i190", "i191", "i192", "i193", "i194", "i195" : return 1000 + 27
+			case "i196", "i197", "i198", "i199", "i200", "i201", "i202" : return 1000 + 28
+			case "i203", "i204", "i205", "i206", "i207", "i208", "i209" : return 1000 + 29
+			case "i210", "i211", "i212", "i213", "i214", "i215", "i216" : return 1000 + 30
+			case "i217", "i218", "i219", "i220", "i221", "i222", "i223" : return 1000 + 31
+			case "i224", "i225", "i226", "i227", "i228", "i229", "i230" : return 1000 + 32
+			case "i231", "i232", "i233", "i234", "i235", "i236", "i237" : return 1000 + 33
+			case "i238", "i239", "i240", "i241", "i242", "i243", "i244" : return 1000 + 34
+			case "i245", "i246", "i247", "i248", "i249", "i250", "i251" : return 1000 + 35
+			case "i252", "i253", "i254", "i255", "i256", "i257", "i258" : return 1000 + 36
+			case "i259", "i260", "i261", "i262", "i263", "i264", "i265" : return 1000 + 37
+			case "i266", "i267", "i268", "i269", "i270", "i271", "i272" : return 1000 + 38
+			case "i273", "i274", "i275", "i276", "i277", "i278", "i279" : return 1000 + 39
+			case "i280", "i281", "i282", "i283", "i284", "i285", "i286" : return 1000 + 40
+			case "i287", "i288", "i289", "i290", "i291", "i292", "i293" : return 1000 + 41
+			case "i294", "i295", "i296", "i297", "i298", "i299", "i300" : return 1000 + 42
+			case "i301", "i302", "i303", "i304", "i305", "i306", "i307" : return 1000 + 43
+			case "i308", "i309", "i310", "i311", "i312", "i313", "i314" : return 1000 + 44
+			case "i315", "i316", "i317", "i318", "i319", "i320", "i321" : return 1000 + 45
+			case "i322", "i323", "i324", "i325", "i326", "i327", "i328" : return 1000 + 46
+			case "i329", "i330", "i331", "i332", "i333", "i334", "i335" : return 1000 + 47
+			case "i336", "i337", "i338", "i339", "i340", "i341", "i342" : return 1000 + 48
+			case "i343", "i344", "i345", "i346", "i347", "i348", "i349" : return 1000 + 49
+			case "i350", "i351", "i352", "i353", "i354", "i355", "i356" : return 1000 + 50
+			case "i357", "i358", "i359", "i360", "i361", "i362", "i363" : return 1000 + 51
+			case "i364", "i365", "i366", "i367", "i368", "i369", "i370" : return 1000 + 52
+			case "i371", "i372", "i373", "i374", "i375", "i376", "i377" : return 1000 + 53
+			case "i378", "i379", "i380", "i381", "i382", "i383", "i384" : return 1000 + 54
+			case "i385", "i386", "i387", "i388", "i389", "i390", "i391" : return 1000 + 55
+			case "i392", "i393", "i394", "i395", "i396", "i397", "i398" : return 1000 + 56
+			case "i399", "i400", "i401", "i402", "i403", "i404", "i405" : return 1000 + 57
+			case "i406", "i407", "i408", "i409", "i410", "i411", "i412" : return 1000 + 58
+			case "i413", "i414", "i415", "i416", "i417", "i418", "i419" : return 1000 + 59
+			case "i420", "i421", "i422", "i423", "i424", "i425", "i426" : return 1000 + 60
+			case "i427", "i428", "i429", "i430", "i431", "i432", "i433" : return 1000 + 61
+			case "i434", "i435", "i436", "i437", "i438", "i439", "i440" : return 1000 + 62
+			case "i441", "i442", "i443", "i444", "i445", "i446", "i447" : return 1000 + 63
+			case "i448", "i449", "i450", "i451", "i452", "i453", "i454" : return 1000 + 64
+			case "i455", "i456", "i457", "i458", "i459", "i460", "i461" : return 1000 + 65
+			case "i462", "i463", "i464", "i465", "i466", "i467", "i468" : return 1000 + 66
+			case "i469", "i470", "i471", "i472", "i473", "i474", "i475" : return 1000 + 67
+			case "i476", "i477", "i478", "i479", "i480", "i481", "i482" : return 1000 + 68
+			case "i483", "i484", "i485", "i486", "i487", "i488", "i489" : return 1000 + 69
+			case "i490", "i491", "i492", "i493", "i494", "i495", "i496" : return 1000 + 70
+			case "i497", "i498", "i499", "i500", "i501", "i502", "i503" : return 1000 + 71
+			case "i504", "i505", "i506", "i507", "i508", "i509", "i510" : return 1000 + 72
+			case "i511", "i512", "i513", "i514", "i515", "i516", "i517" : return 1000 + 73
+			case "i518", "i519", "i520", "i521", "i522", "i523", "i524" : return 1000 + 74
+			case "i525", "i526", "i527", "i528", "i529", "i530", "i531" : return 1000 + 75
+			case "i532", "i533", "i534", "i535", "i536", "i537", "i538" : return 1000 + 76
+			case "i539", "i540", "i541", "i542", "i543", "i544", "i545" : return 1000 + 77
+			case "i546", "i547", "i548", "i549", "i550", "i551", "i552" : return 1000 + 78
+			case "i553", "i554", "i555", "i556", "i557", "i558", "i559" : return 1000 + 79
+			case "i560", "i561", "i562", "i563", "i564", "i565", "i566" : return 1000 + 80
+			case "i567", "i568", "i569", "i570", "i571", "i572", "i573" : return 1000 + 81
+			case "i574", "i575", "i576", "i577", "i578", "i579", "i580" : return 1000 + 82
+			case "i581", "i582", "i583", "i584", "i585", "i586", "i587" : return 1000 + 83
+			case "i588", "i589", "i590", "i591", "i592", "i593", "i594" : return 1000 + 84
+			case "i595", "i596", "i597", "i598", "i599", "i600", "i601" : return 1000 + 85
+			case "i602", "i603", "i604", "i605", "i606", "i607", "i608" : return 1000 + 86
+			case "i609", "i610", "i611", "i612", "i613", "i614", "i615" : return 1000 + 87
+			case "i616", "i617", "i618", "i619", "i620", "i621", "i622" : return 1000 + 88
+			case "i623", "i624", "i625", "i626", "i627", "i628", "i629" : return 1000 + 89
+			case "i630", "i631", "i632", "i633", "i634", "i635", "i636" : return 1000 + 90
+			case "i637", "i638", "i639", "i640", "i641", "i642", "i643" : return 1000 + 91
+			case "i644", "i645", "i646", "i647", "i648", "i649", "i650" : return 1000 + 92
+			case "i651", "i652", "i653", "i654", "i655", "i656", "i657" : return 1000 + 93
+			case "i658", "i659", "i660", "i661", "i662", "i663", "i664" : return 1000 + 94
+			case "i665", "i666", "i667", "i668", "i669", "i670", "i671" : return 1000 + 95
+			case "i672", "i673", "i674", "i675", "i676", "i677", "i678" : return 1000 + 96
+			case "i679", "i680", "i681", "i682", "i683", "i684", "i685" : return 1000 + 97
+			case "i686", "i687", "i688", "i689", "i690", "i691", "i692" : return 1000 + 98
+			case "i693", "i694", "i695", "i696", "i697", "i698", "i699" : return 1000 + 99
+			case "deeper"
+				select case s + t
+				case "x0" : return 3000 + 0
+				case "x1" : return 3000 + 1
+				case "x2" : return 3000 + 2
+				case "x3" : return 3000 + 3
+				case "x4" : return 3000 + 4
+				case "x5" : return 3000 + 5
+				case "x6" : return 3000 + 6
+				case "x7" : return 3000 + 7
+				case "innerdeeper" : return 2999
+				case else : return 2000
+				end select
+			case else : return 1999
+			end select
+		case else : return -1
+		end select
+	end function
+
+	'' 2000 literals held back, then a single CASE with 2200 literals that
+	'' fills up the table while it's parsed
+	private function longcase( byref s as string ) as integer
+		select case s
+		case "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7", "a8", "a9", "a10", "a11", "a12", "a13", "a14", "a15", "a16", "a17", "a18", "a19", _
+		     "a20", "a21", "a22", "a23", "a24", "a25", "a26", "a27", "a28", "a29", "a30", "a31", "a32", "a33", "a34", "a35", "a36", "a37", "a38", "a39", _
+		     "a40", "a41", "a42", "a43", "a44", "a45", "a46", "a47", "a48", "a49", "a50", "a51", "a52", "a53", "a54", "a55", "a56", "a57", "a58", "a59", _
+		     "a60", "a61", "a62", "a63", "a64", "a65", "a66", "a67", "a68", "a69", "a70", "a71", "a72", "a73", "a74", "a75", "a76", "a77", "a78", "a79", _
+		     "a80", "a81", "a82", "a83", "a84", "a85", "a86", "a87", "a88", "a89", "a90", "a91", "a92", "a93", "a94", "a95", "a96", "a97", "a98", "a99", _
+		     "a100", "a101", "a102", "a103", "a104", "a105", "a106", "a107", "a108", "a109", "a110", "a111", "a112", "a113", "a114", "a115", "a116", "a117", "a118", "a119", _
+		     "a120", "a121", "a122", "a123", "a124", "a125", "a126", "a127", "a128", "a129", "a130", "a131", "a132", "a133", "a134", "a135", "a136", "a137", "a138", "a139", _
+		     "a140", "a141", "a142", "a143", "a144", "a145", "a146", "a147", "a148", "a149", "a150", "a151", "a152", "a153", "a154", "a155", "a156", "a157", "a158", "a159", _
+		     "a160", "a161", "a162", "a163", "a164", "a165", "a166", "a167", "a168", "a169", "a170", "a171", "a172", "a173", "a174", "a175", "a176", "a177", "a178", "a179", _
+		     "a180", "a181", "a182", "a183", "a184", "a185", "a186", "a187", "a188", "a189", "a190", "a191", "a192", "a193", "a194", "a195", "a196", "a197", "a198", "a199"
+			return 0
+		case "a200", "a201", "a202", "a203", "a204", "a205", "a206", "a207", "a208", "a209", "a210", "a211", "a212", "a213", "a214", "a215", "a216", "a217", "a218", "a219", _
+		     "a220", "a221", "a222", "a223", "a224", "a225", "a226", "a227", "a228", "a229", "a230", "a231", "a232", "a233", "a234", "a235", "a236", "a237", "a238", "a239", _
+		     "a240", "a241", "a242", "a243", "a244", "a245", "a246", "a247", "a248", "a249", "a250", "a251", "a252", "a253", "a254", "a255", "a256", "a257", "a258", "a259", _
+		     "a260", "a261", "a262", "a263", "a264", "a265", "a266", "a267", "a268", "a269", "a270", "a271", "a272", "a273", "a274", "a275", "a276", "a277", "a278", "a279", _
+		     "a280", "a281", "a282", "a283", "a284", "a285", "a286", "a287", "a288", "a289", "a290", "a291", "a292", "a293", "a294", "a295", "a296", "a297", "a298", "a299", _
+		     "a300", "a301", "a302", "a303", "a304", "a305", "a306", "a307", "a308", "a309", "a310", "a311", "a312", "a313", "a314", "a315", "a316", "a317", "a318", "a319", _
+		     "a320", "a321", "a322", "a323", "a324", "a325", "a326", "a327", "a328", "a329", "a330", "a331", "a332", "a333", "a334", "a335", "a336", "a337", "a338", "a339", _
+		     "a340", "a341", "a342", "a343", "a344", "a345", "a346", "a347", "a348", "a349", "a350", "a351", "a352", "a353", "a354", "a355", "a356", "a357", "a358", "a359", _
+		     "a360", "a361", "a362", "a363", "a364", "a365", "a366", "a367", "a368", "a369", "a370", "a371", "a372", "a373", "a374", "a375", "a376", "a377", "a378", "a379", _
+		     "a380", "a381", "a382", "a383", "a384", "a385", "a386", "a387", "a388", "a389", "a390", "a391", "a392", "a393", "a394", "a395", "a396", "a397", "a398", "a399"
+			return 1
+		case "a400", "a401", "a402", "a403", "a404", "a405", "a406", "a407", "a408", "a409", "a410", "a411", "a412", "a413", "a414", "a415", "a416", "a417", "a418", "a419", _
+		     "a420", "a421", "a422", "a423", "a424", "a425", "a426", "a427", "a428", "a429", "a430", "a431", "a432", "a433", "a434", "a435", "a436", "a437", "a438", "a439", _
+		     "a440", "a441", "a442", "a443", "a444", "a445", "a446", "a447", "a448", "a449", "a450", "a451", "a452", "a453", "a454", "a455", "a456", "a457", "a458", "a459", _
+		     "a460", "a461", "a462", "a463", "a464", "a465", "a466", "a467", "a468", "a469", "a470", "a471", "a472", "a473", "a474", "a475", "a476", "a477", "a478", "a479", _
+		     "a480", "a481", "a482", "a483", "a484", "a485", "a486", "a487", "a488", "a489", "a490", "a491", "a492", "a493", "a494", "a495", "a496", "a497", "a498", "a499", _
+		     "a500", "a501", "a502", "a503", "a504", "a505", "a506", "a507", "a508", "a509", "a510", "a511", "a512", "a513", "a514", "a515", "a516", "a517", "a518", "a519", _
+		     "a520", "a521", "a522", "a523", "a524", "a525", "a526", "a527", "a528", "a529", "a530", "a531", "a532", "a533", "a534", "a535", "a536", "a537", "a538", "a539", _
+		     "a540", "a541", "a542", "a543", "a544", "a545", "a546", "a547", "a548", "a549", "a550", "a551", "a552", "a553", "a554", "a555", "a556", "a557", "a558", "a559", _
+		     "a560", "a561", "a562", "a563", "a564", "a565", "a566", "a567", "a568", "a569", "a570", "a571", "a572", "a573", "a574", "a575", "a576", "a577", "a578", "a579", _
+		     "a580", "a581", "a582", "a583", "a584", "a585", "a586", "a587", "a588", "a589", "a590", "a591", "a592", "a593", "a594", "a595", "a596", "a597", "a598", "a599"
+			return 2
+		case "a600", "a601", "a602", "a603", "a604", "a605", "a606", "a607", "a608", "a609", "a610", "a611", "a612", "a613", "a614", "a615", "a616", "a617", "a618", "a619", _
+		     "a620", "a621", "a622", "a623", "a624", "a625", "a626", "a627", "a628", "a629", "a630", "a631", "a632", "a633", "a634", "a635", "a636", "a637", "a638", "a639", _
+		     "a640", "a641", "a642", "a643", "a644", "a645", "a646", "a647", "a648", "a649", "a650", "a651", "a652", "a653", "a654", "a655", "a656", "a657", "a658", "a659", _
+		     "a660", "a661", "a662", "a663", "a664", "a665", "a666", "a667", "a668", "a669", "a670", "a671", "a672", "a673", "a674", "a675", "a676", "a677", "a678", "a679", _
+		     "a680", "a681", "a682", "a683", "a684", "a685", "a686", "a687", "a688", "a689", "a690", "a691", "a692", "a693", "a694", "a695", "a696", "a697", "a698", "a699", _
+		     "a700", "a701", "a702", "a703", "a704", "a705", "a706", "a707", "a708", "a709", "a710", "a711", "a712", "a713", "a714", "a715", "a716", "a717", "a718", "a719", _
+		     "a720", "a721", "a722", "a723", "a724", "a725", "a726", "a727", "a728", "a729", "a730", "a731", "a732", "a733", "a734", "a735", "a736", "a737", "a738", "a739", _
+		     "a740", "a741", "a742", "a743", "a744", "a745", "a746", "a747", "a748", "a749", "a750", "a751", "a752", "a753", "a754", "a755", "a756", "a757", "a758", "a759", _
+		     "a760", "a761", "a762", "a763", "a764", "a765", "a766", "a767", "a768", "a769", "a770", "a771", "a772", "a773", "a774", "a775", "a776", "a777", "a778", "a779", _
+		     "a780", "a781", "a782", "a783", "a784", "a785", "a786", "a787", "a788", "a789", "a790", "a791", "a792", "a793", "a794", "a795", "a796", "a797", "a798", "a799"
+			return 3
+		case "a800", "a801", "a802", "a803", "a804", "a805", "a806", "a807", "a808", "a809", "a810", "a811", "a812", "a813", "a814", "a815", "a816", "a817", "a818", "a819", _
+		     "a820", "a821", "a822", "a823", "a824", "a825", "a826", "a827", "a828", "a829", "a830", "a831", "a832", "a833", "a834", "a835", "a836", "a837", "a838", "a839", _
+		     "a840", "a841", "a842", "a843", "a844", "a845", "a846", "a847", "a848", "a849", "a850", "a851", "a852", "a853", "a854", "a855", "a856", "a857", "a858", "a859", _
+		     "a860", "a861", "a862", "a863", "a864", "a865", "a866", "a867", "a868", "a869", "a870", "a871", "a872", "a873", "a874", "a875", "a876", "a877", "a878", "a879", _
+		     "a880", "a881", "a882", "a883", "a884", "a885", "a886", "a887", "a888", "a889", "a890", "a891", "a892", "a893", "a894", "a895", "a896", "a897", "a898", "a899", _
+		     "a900", "a901", "a902", "a903", "a904", "a905", "a906", "a907", "a908", "a909", "a910", "a911", "a912", "a913", "a914", "a915", "a916", "a917", "a918", "a919", _
+		     "a920", "a921", "a922", "a923", "a924", "a925", "a926", "a927", "a928", "a929", "a930", "a931", "a932", "a933", "a934", "a935", "a936", "a937", "a938", "a939", _
+		     "a940", "a941", "a942", "a943", "a944", "a945", "a946", "a947", "a948", "a949", "a950", "a951", "a952", "a953", "a954", "a955", "a956", "a957", "a958", "a959", _
+		     "a960", "a961", "a962", "a963", "a964", "a965", "a966", "a967", "a968", "a969", "a970", "a971", "a972", "a973", "a974", "a975", "a976", "a977", "a978", "a979", _
+		     "a980", "a981", "a982", "a983", "a984", "a985", "a986", "a987", "a988", "a989", "a990", "a991", "a992", "a993", "a994", "a995", "a996", "a997", "a998", "a999"
+			return 4
+		case "a1000", "a1001", "a1002", "a1003", "a1004", "a1005", "a1006", "a1007", "a1008", "a1009", "a1010", "a1011", "a1012", "a1013", "a1014", "a1015", "a1016", "a1017", "a1018", "a1019", _
+		     "a1020", "a1021", "a1022", "a1023", "a1024", "a1025", "a1026", "a1027", "a1028", "a1029", "a1030", "a1031", "a1032", "a1033", "a1034", "a1035", "a1036", "a1037", "a1038", "a1039", _
+		     "a1040", "a1041", "a1042", "a1043", "a1044", "a1045", "a1046", "a1047", "a1048", "a1049", "a1050", "a1051", "a1052", "a1053", "a1054", "a1055", "a1056", "a1057", "a1058", "a1059", _
+		     "a1060", "a1061", "a1062", "a1063", "a1064", "a1065", "a1066", "a1067", "a1068", "a1069", "a1070", "a1071", "a1072", "a1073", "a1074", "a1075", "a1076", "a1077", "a1078", "a1079", _
+		     "a1080", "a1081", "a1082", "a1083", "a1084", "a1085", "a1086", "a1087", "a1088", "a1089", "a1090", "a1091", "a1092", "a1093", "a1094", "a1095", "a1096", "a1097", "a1098", "a1099", _
+		     "a1100", "a1101", "a1102", "a1103", "a1104", "a1105", "a1106", "a1107", "a1108", "a1109", "a1110", "a1111", "a1112", "a1113", "a1114", "a1115", "a1116", "a1117", "a1118", "a1119", _
+		     "a1120", "a1121", "a1122", "a1123", "a1124", "a1125", "a1126", "a1127", "a1128", "a1129", "a1130", "a1131", "a1132", "a1133", "a1134", "a1135", "a1136", "a1137", "a1138", "a1139", _
+		     "a1140", "a1141", "a1142", "a1143", "a1144", "a1145", "a1146", "a1147", "a1148", "a1149", "a1150", "a1151", "a1152", "a1153", "a1154", "a1155", "a1156", "a1157", "a1158", "a1159", _
+		     "a1160", "a1161", "a1162", "a1163", "a1164", "a1165", "a1166", "a1167", "a1168", "a1169", "a1170", "a1171", "a1172", "a1173", "a1174", "a1175", "a1176", "a1177", "a1178", "a1179", _
+		     "a1180", "a1181", "a1182", "a1183", "a1184", "a1185", "a1186", "a1187", "a1188", "a1189", "a1190", "a1191", "a1192", "a1193", "a1194", "a1195", "a1196", "a1197", "a1198", "a1199"
+			return 5
+		case "a1200", "a1201", "a1202", "a1203", "a1204", "a1205", "a1206", "a1207", "a1208", "a1209", "a1210", "a1211", "a1212", "a1213", "a1214", "a1215", "a1216", "a1217", "a1218", "a1219", _
+		     "a1220", "a1221", "a1222", "a1223", "a1224", "a1225", "a1226", "a1227", "a1228", "a1229", "a1230", "a1231", "a1232", "a1233", "a1234", "a1235", "a1236", "a1237", "a1238", "a1239", _
+		     "a1240", "a1241", "a1242", "a1243", "a1244", "a1245", "a1246", "a1247", "a1248", "a1249", "a1250", "a1251", "a1252", "a1253", "a1254", "a1255", "a1256", "a1257", "a1258", "a1259", _
+		     "a1260", "a1261", "a1262", "a1263", "a1264", "a1265", "a1266", "a1267", "a1268", "a1269", "a1270", "a1271", "a1272", "a1273", "a1274", "a1275", "a1276", "a1277", "a1278", "a1279", _
+		     "a1280", "a1281", "a1282", "a1283", "a1284", "a1285", "a1286", "a1287", "a1288", "a1289", "a1290", "a1291", "a1292", "a1293", "a1294", "a1295", "a1296", "a1297", "a1298", "a1299", _
+		     "a1300", "a1301", "a1302", "a1303", "a1304", "a1305", "a1306", "a1307", "a1308", "a1309", "a1310", "a1311", "a1312", "a1313", "a1314", "a1315", "a1316", "a1317", "a1318", "a1319", _
+		     "a1320", "a1321", "a1322", "a1323", "a1324", "a1325", "a1326", "a1327", "a1328", "a1329", "a1330", "a1331", "a1332", "a1333", "a1334", "a1335", "a1336", "a1337", "a1338", "a1339", _
+		     "a1340", "a1341", "a1342", "a1343", "a1344", "a1345", "a1346", "a1347", "a1348", "a1349", "a1350", "a1351", "a1352", "a1353", "a1354", "a1355", "a1356", "a1357", "a1358", "a1359", _
+		     "a1360", "a1361", "a1362", "a1363", "a1364", "a1365", "a1366", "a1367", "a1368", "a1369", "a1370", "a1371", "a1372", "a1373", "a1374", "a1375", "a1376", "a1377", "a1378", "a1379", _
+		     "a1380", "a1381", "a1382", "a1383", "a1384", "a1385", "a1386", "a1387", "a1388", "a1389", "a1390", "a1391", "a1392", "a1393", "a1394", "a1395", "a1396", "a1397", "a1398", "a1399"
+			return 6
+		case "a1400", "a1401", "a1402", "a1403", "a1404", "a1405", "a1406", "a1407", "a1408", "a1409", "a1410", "a1411", "a1412", "a1413", "a1414", "a1415", "a1416", "a1417", "a1418", "a1419", _
+		     "a1420", "a1421", "a1422", "a1423", "a1424", "a1425", "a1426", "a1427", "a1428", "a1429", "a1430", "a1431", "a1432", "a1433", "a1434", "a1435", "a1436", "a1437", "a1438", "a1439", _
+		     "a1440", "a1441", "a1442", "a1443", "a1444", "a1445", "a1446", "a1447", "a1448", "a1449", "a1450", "a1451", "a1452", "a1453", "a1454", "a1455", "a1456", "a1457", "a1458", "a1459", _
+		     "a1460", "a1461", "a1462", "a1463", "a1464", "a1465", "a1466", "a1467", "a1468", "a1469", "a1470", "a1471", "a1472", "a1473", "a1474", "a1475", "a1476", "a1477", "a1478", "a1479", _
+		     "a1480", "a1481", "a1482", "a1483", "a1484", "a1485", "a1486", "a1487", "a1488", "a1489", "a1490", "a1491", "a1492", "a1493", "a1494", "a1495", "a1496", "a1497", "a1498", "a1499", _
+		     "a1500", "a1501", "a1502", "a1503", "a1504", "a1505", "a1506", "a1507", "a1508", "a1509", "a1510", "a1511", "a1512", "a1513", "a1514", "a1515", "a1516", "a1517", "a1518", "a1519", _
+		     "a1520", "a1521", "a1522", "a1523", "a1524", "a1525", "a1526", "a1527", "a1528", "a1529", "a1530", "a1531", "a1532", "a1533", "a1534", "a1535", "a1536", "a1537", "a1538", "a1539", _
+		     "a1540", "a1541", "a1542", "a1543", "a1544", "a1545", "a1546", "a1547", "a1548", "a1549", "a1550", "a1551", "a1552", "a1553", "a1554", "a1555", "a1556", "a1557", "a1558", "a1559", _
+		     "a1560", "a1561", "a1562", "a1563", "a1564", "a1565", "a1566", "a1567", "a1568", "a1569", "a1570", "a1571", "a1572", "a1573", "a1574", "a1575", "a1576", "a1577", "a1578", "a1579", _
+		     "a1580", "a1581", "a1582", "a1583", "a1584", "a1585", "a1586", "a1587", "a1588", "a1589", "a1590", "a1591", "a1592", "a1593", "a1594", "a1595", "a1596", "a1597", "a1598", "a1599"
+			return 7
+		case "a1600", "a1601", "a1602", "a1603", "a1604", "a1605", "a1606", "a1607", "a1608", "a1609", "a1610", "a1611", "a1612", "a1613", "a1614", "a1615", "a1616", "a1617", "a1618", "a1619", _
+		     "a1620", "a1621", "a1622", "a1623", "a1624", "a1625", "a1626", "a1627", "a1628", "a1629", "a1630", "a1631", "a1632", "a1633", "a1634", "a1635", "a1636", "a1637", "a1638", "a1639", _
+		     "a1640", "a1641", "a1642", "a1643", "a1644", "a1645", "a1646", "a1647", "a1648", "a1649", "a1650", "a1651", "a1652", "a1653", "a1654", "a1655", "a1656", "a1657", "a1658", "a1659", _
+		     "a1660", "a1661", "a1662", "a1663", "a1664", "a1665", "a1666", "a1667", "a1668", "a1669", "a1670", "a1671", "a1672", "a1673", "a1674", "a1675", "a1676", "a1677", "a1678", "a1679", _
+		     "a1680", "a1681", "a1682", "a1683", "a1684", "a1685", "a1686", "a1687", "a1688", "a1689", "a1690", "a1691", "a1692", "a1693", "a1694", "a1695", "a1696", "a1697", "a1698", "a1699", _
+		     "a1700", "a1701", "a1702", "a1703", "a1704", "a1705", "a1706", "a1707", "a1708", "a1709", "a1710", "a1711", "a1712", "a1713", "a1714", "a1715", "a1716", "a1717", "a1718", "a1719", _
+		     "a1720", "a1721", "a1722", "a1723", "a1724", "a1725", "a1726", "a1727", "a1728", "a1729", "a1730", "a1731", "a1732", "a1733", "a1734", "a1735", "a1736", "a1737", "a1738", "a1739", _
+		     "a1740", "a1741", "a1742", "a1743", "a1744", "a1745", "a1746", "a1747", "a1748", "a1749", "a1750", "a1751", "a1752", "a1753", "a1754", "a1755", "a1756", "a1757", "a1758", "a1759", _
+		     "a1760", "a1761", "a1762", "a1763", "a1764", "a1765", "a1766", "a1767", "a1768", "a1769", "a1770", "a1771", "a1772", "a1773", "a1774", "a1775", "a1776", "a1777", "a1778", "a1779", _
+		     "a1780", "a1781", "a1782", "a1783", "a1784", "a1785", "a1786", "a1787", "a1788", "a1789", "a1790", "a1791", "a1792", "a1793", "a1794", "a1795", "a1796", "a1797", "a1798", "a1799"
+			return 8
+		case "a1800", "a1801", "a1802", "a1803", "a1804", "a1805", "a1806", "a1807", "a1808", "a1809", "a1810", "a1811", "a1812", "a1813", "a1814", "a1815", "a1816", "a1817", "a1818", "a1819", _
+		     "a1820", "a1821", "a1822", "a1823", "a1824", "a1825", "a1826", "a1827", "a1828", "a1829", "a1830", "a1831", "a1832", "a1833", "a1834", "a1835", "a1836", "a1837", "a1838", "a1839", _
+		     "a1840", "a1841", "a1842", "a1843", "a1844", "a1845", "a1846", "a1847", "a1848", "a1849", "a1850", "a1851", "a1852", "a1853", "a1854", "a1855", "a1856", "a1857", "a1858", "a1859", _
+		     "a1860", "a1861", "a1862", "a1863", "a1864", "a1865", "a1866", "a1867", "a1868", "a1869", "a1870", "a1871", "a1872", "a1873", "a1874", "a1875", "a1876", "a1877", "a1878", "a1879", _
+		     "a1880", "a1881", "a1882", "a1883", "a1884", "a1885", "a1886", "a1887", "a1888", "a1889", "a1890", "a1891", "a1892", "a1893", "a1894", "a1895", "a1896", "a1897", "a1898", "a1899", _
+		     "a1900", "a1901", "a1902", "a1903", "a1904", "a1905", "a1906", "a1907", "a1908", "a1909", "a1910", "a1911", "a1912", "a1913", "a1914", "a1915", "a1916", "a1917", "a1918", "a1919", _
+		     "a1920", "a1921", "a1922", "a1923", "a1924", "a1925", "a1926", "a1927", "a1928", "a1929", "a1930", "a1931", "a1932", "a1933", "a1934", "a1935", "a1936", "a1937", "a1938", "a1939", _
+		     "a1940", "a1941", "a1942", "a1943", "a1944", "a1945", "a1946", "a1947", "a1948", "a1949", "a1950", "a1951", "a1952", "a1953", "a1954", "a1955", "a1956", "a1957", "a1958", "a1959", _
+		     "a1960", "a1961", "a1962", "a1963", "a1964", "a1965", "a1966", "a1967", "a1968", "a1969", "a1970", "a1971", "a1972", "a1973", "a1974", "a1975", "a1976", "a1977", "a1978", "a1979", _
+		     "a1980", "a1981", "a1982", "a1983", "a1984", "a1985", "a1986", "a1987", "a1988", "a1989", "a1990", "a1991", "a1992", "a1993", "a1994", "a1995", "a1996", "a1997", "a1998", "a1999"
+			return 9
+		case "b0", "b1", "b2", "b3", "b4", "b5", "b6", "b7", "b8", "b9", "b10", "b11", "b12", "b13", "b14", "b15", "b16", "b17", "b18", "b19", _
+		     "b20", "b21", "b22", "b23", "b24", "b25", "b26", "b27", "b28", "b29", "b30", "b31", "b32", "b33", "b34", "b35", "b36", "b37", "b38", "b39", _
+		     "b40", "b41", "b42", "b43", "b44", "b45", "b46", "b47", "b48", "b49", "b50", "b51", "b52", "b53", "b54", "b55", "b56", "b57", "b58", "b59", _
+		     "b60", "b61", "b62", "b63", "b64", "b65", "b66", "b67", "b68", "b69", "b70", "b71", "b72", "b73", "b74", "b75", "b76", "b77", "b78", "b79", _
+		     "b80", "b81", "b82", "b83", "b84", "b85", "b86", "b87", "b88", "b89", "b90", "b91", "b92", "b93", "b94", "b95", "b96", "b97", "b98", "b99", _
+		     "b100", "b101", "b102", "b103", "b104", "b105", "b106", "b107", "b108", "b109", "b110", "b111", "b112", "b113", "b114", "b115", "b116", "b117", "b118", "b119", _
+		     "b120", "b121", "b122", "b123", "b124", "b125", "b126", "b127", "b128", "b129", "b130", "b131", "b132", "b133", "b134", "b135", "b136", "b137", "b138", "b139", _
+		     "b140", "b141", "b142", "b143", "b144", "b145", "b146", "b147", "b148", "b149", "b150", "b151", "b152", "b153", "b154", "b155", "b156", "b157", "b158", "b159", _
+		     "b160", "b161", "b162", "b163", "b164", "b165", "b166", "b167", "b168", "b169", "b170", "b171", "b172", "b173", "b174", "b175", "b176", "b177", "b178", "b179", _
+		     "b180", "b181", "b182", "b183", "b184", "b185", "b186", "b187", "b188", "b189", "b190", "b191", "b192", "b193", "b194", "b195", "b196", "b197", "b198", "b199", _
+		     "b200", "b201", "b202", "b203", "b204", "b205", "b206", "b207", "b208", "b209", "b210", "b211", "b212", "b213", "b214", "b215", "b216", "b217", "b218", "b219", _
+		     "b220", "b221", "b222", "b223", "b224", "b225", "b226", "b227", "b228", "b229", "b230", "b231", "b232", "b233", "b234", "b235", "b236", "b237", "b238", "b239", _
+		     "b240", "b241", "b242", "b243", "b244", "b245", "b246", "b247", "b248", "b249", "b250", "b251", "b252", "b253", "b254", "b255", "b256", "b257", "b258", "b259", _
+		     "b260", "b261", "b262", "b263", "b264", "b265", "b266", "b267", "b268", "b269", "b270", "b271", "b272", "b273", "b274", "b275", "b276", "b277", "b278", "b279", _
+		     "b280", "b281", "b282", "b283", "b284", "b285", "b286", "b287", "b288", "b289", "b290", "b291", "b292", "b293", "b294", "b295", "b296", "b297", "b298", "b299", _
+		     "b300", "b301", "b302", "b303", "b304", "b305", "b306", "b307", "b308", "b309", "b310", "b311", "b312", "b313", "b314", "b315", "b316", "b317", "b318", "b319", _
+		     "b320", "b321", "b322", "b323", "b324", "b325", "b326", "b327", "b328", "b329", "b330", "b331", "b332", "b333", "b334", "b335", "b336", "b337", "b338", "b339", _
+		     "b340", "b341", "b342", "b343", "b344", "b345", "b346", "b347", "b348", "b349", "b350", "b351", "b352", "b353", "b354", "b355", "b356", "b357", "b358", "b359", _
+		     "b360", "b361", "b362", "b363", "b364", "b365", "b366", "b367", "b368", "b369", "b370", "b371", "b372", "b373", "b374", "b375", "b376", "b377", "b378", "b379", _
+		     "b380", "b381", "b382", "b383", "b384", "b385", "b386", "b387", "b388", "b389", "b390", "b391", "b392", "b393", "b394", "b395", "b396", "b397", "b398", "b399", _
+		     "b400", "b401", "b402", "b403", "b404", "b405", "b406", "b407", "b408", "b409", "b410", "b411", "b412", "b413", "b414", "b415", "b416", "b417", "b418", "b419", _
+		     "b420", "b421", "b422", "b423", "b424", "b425", "b426", "b427", "b428", "b429", "b430", "b431", "b432", "b433", "b434", "b435", "b436", "b437", "b438", "b439", _
+		     "b440", "b441", "b442", "b443", "b444", "b445", "b446", "b447", "b448", "b449", "b450", "b451", "b452", "b453", "b454", "b455", "b456", "b457", "b458", "b459", _
+		     "b460", "b461", "b462", "b463", "b464", "b465", "b466", "b467", "b468", "b469", "b470", "b471", "b472", "b473", "b474", "b475", "b476", "b477", "b478", "b479", _
+		     "b480", "b481", "b482", "b483", "b484", "b485", "b486", "b487", "b488", "b489", "b490", "b491", "b492", "b493", "b494", "b495", "b496", "b497", "b498", "b499", _
+		     "b500", "b501", "b502", "b503", "b504", "b505", "b506", "b507", "b508", "b509", "b510", "b511", "b512", "b513", "b514", "b515", "b516", "b517", "b518", "b519", _
+		     "b520", "b521", "b522", "b523", "b524", "b525", "b526", "b527", "b528", "b529", "b530", "b531", "b532", "b533", "b534", "b535", "b536", "b537", "b538", "b539", _
+		     "b540", "b541", "b542", "b543", "b544", "b545", "b546", "b547", "b548", "b549", "b550", "b551", "b552", "b553", "b554", "b555", "b556", "b557", "b558", "b559", _
+		     "b560", "b561", "b562", "b563", "b564", "b565", "b566", "b567", "b568", "b569", "b570", "b571", "b572", "b573", "b574", "b575", "b576", "b577", "b578", "b579", _
+		     "b580", "b581", "b582", "b583", "b584", "b585", "b586", "b587", "b588", "b589", "b590", "b591", "b592", "b593", "b594", "b595", "b596", "b597", "b598", "b599", _
+		     "b600", "b601", "b602", "b603", "b604", "b605", "b606", "b607", "b608", "b609", "b610", "b611", "b612", "b613", "b614", "b615", "b616", "b617", "b618", "b619", _
+		     "b620", "b621", "b622", "b623", "b624", "b625", "b626", "b627", "b628", "b629", "b630", "b631", "b632", "b633", "b634", "b635", "b636", "b637", "b638", "b639", _
+		     "b640", "b641", "b642", "b643", "b644", "b645", "b646", "b647", "b648", "b649", "b650", "b651", "b652", "b653", "b654", "b655", "b656", "b657", "b658", "b659", _
+		     "b660", "b661", "b662", "b663", "b664", "b665", "b666", "b667", "b668", "b669", "b670", "b671", "b672", "b673", "b674", "b675", "b676", "b677", "b678", "b679", _
+		     "b680", "b681", "b682", "b683", "b684", "b685", "b686", "b687", "b688", "b689", "b690", "b691", "b692", "b693", "b694", "b695", "b696", "b697", "b698", "b699", _
+		     "b700", "b701", "b702", "b703", "b704", "b705", "b706", "b707", "b708", "b709", "b710", "b711", "b712", "b713", "b714", "b715", "b716", "b717", "b718", "b719", _
+		     "b720", "b721", "b722", "b723", "b724", "b725", "b726", "b727", "b728", "b729", "b730", "b731", "b732", "b733", "b734", "b735", "b736", "b737", "b738", "b739", _
+		     "b740", "b741", "b742", "b743", "b744", "b745", "b746", "b747", "b748", "b749", "b750", "b751", "b752", "b753", "b754", "b755", "b756", "b757", "b758", "b759", _
+		     "b760", "b761", "b762", "b763", "b764", "b765", "b766", "b767", "b768", "b769", "b770", "b771", "b772", "b773", "b774", "b775", "b776", "b777", "b778", "b779", _
+		     "b780", "b781", "b782", "b783", "b784", "b785", "b786", "b787", "b788", "b789", "b790", "b791", "b792", "b793", "b794", "b795", "b796", "b797", "b798", "b799", _
+		     "b800", "b801", "b802", "b803", "b804", "b805", "b806", "b807", "b808", "b809", "b810", "b811", "b812", "b813", "b814", "b815", "b816", "b817", "b818", "b819", _
+		     "b820", "b821", "b822", "b823", "b824", "b825", "b826", "b827", "b828", "b829", "b830", "b831", "b832", "b833", "b834", "b835", "b836", "b837", "b838", "b839", _
+		     "b840", "b841", "b842", "b843", "b844", "b845", "b846", "b847", "b848", "b849", "b850", "b851", "b852", "b853", "b854", "b855", "b856", "b857", "b858", "b859", _
+		     "b860", "b861", "b862", "b863", "b864", "b865", "b866", "b867", "b868", "b869", "b870", "b871", "b872", "b873", "b874", "b875", "b876", "b877", "b878", "b879", _
+		     "b880", "b881", "b882", "b883", "b884", "b885", "b886", "b887", "b888", "b889", "b890", "b891", "b892", "b893", "b894", "b895", "b896", "b897", "b898", "b899", _
+		     "b900", "b901", "b902", "b903", "b904", "b905", "b906", "b907", "b908", "b909", "b910", "b911", "b912", "b913", "b914", "b915", "b916", "b917", "b918", "b919", _
+		     "b920", "b921", "b922", "b923", "b924", "b925", "b926", "b927", "b928", "b929", "b930", "b931", "b932", "b933", "b934", "b935", "b936", "b937", "b938", "b939", _
+		     "b940", "b941", "b942", "b943", "b944", "b945", "b946", "b947", "b948", "b949", "b950", "b951", "b952", "b953", "b954", "b955", "b956", "b957", "b958", "b959", _
+		     "b960", "b961", "b962", "b963", "b964", "b965", "b966", "b967", "b968", "b969", "b970", "b971", "b972", "b973", "b974", "b975", "b976", "b977", "b978", "b979", _
+		     "b980", "b981", "b982", "b983", "b984", "b985", "b986", "b987", "b988", "b989", "b990", "b991", "b992", "b993", "b994", "b995", "b996", "b997", "b998", "b999", _
+		     "b1000", "b1001", "b1002", "b1003", "b1004", "b1005", "b1006", "b1007", "b1008", "b1009", "b1010", "b1011", "b1012", "b1013", "b1014", "b1015", "b1016", "b1017", "b1018", "b1019", _
+		     "b1020", "b1021", "b1022", "b1023", "b1024", "b1025", "b1026", "b1027", "b1028", "b1029", "b1030", "b1031", "b1032", "b1033", "b1034", "b1035", "b1036", "b1037", "b1038", "b1039", _
+		     "b1040", "b1041", "b1042", "b1043", "b1044", "b1045", "b1046", "b1047", "b1048", "b1049", "b1050", "b1051", "b1052", "b1053", "b1054", "b1055", "b1056", "b1057", "b1058", "b1059", _
+		     "b1060", "b1061", "b1062", "b1063", "b1064", "b1065", "b1066", "b1067", "b1068", "b1069", "b1070", "b1071", "b1072", "b1073", "b1074", "b1075", "b1076", "b1077", "b1078", "b1079", _
+		     "b1080", "b1081", "b1082", "b1083", "b1084", "b1085", "b1086", "b1087", "b1088", "b1089", "b1090", "b1091", "b1092", "b1093", "b1094", "b1095", "b1096", "b1097", "b1098", "b1099", _
+		     "b1100", "b1101", "b1102", "b1103", "b1104", "b1105", "b1106", "b1107", "b1108", "b1109", "b1110", "b1111", "b1112", "b1113", "b1114", "b1115", "b1116", "b1117", "b1118", "b1119", _
+		     "b1120", "b1121", "b1122", "b1123", "b1124", "b1125", "b1126", "b1127", "b1128", "b1129", "b1130", "b1131", "b1132", "b1133", "b1134", "b1135", "b1136", "b1137", "b1138", "b1139", _
+		     "b1140", "b1141", "b1142", "b1143", "b1144", "b1145", "b1146", "b1147", "b1148", "b1149", "b1150", "b1151", "b1152", "b1153", "b1154", "b1155", "b1156", "b1157", "b1158", "b1159", _
+		     "b1160", "b1161", "b1162", "b1163", "b1164", "b1165", "b1166", "b1167", "b1168", "b1169", "b1170", "b1171", "b1172", "b1173", "b1174", "b1175", "b1176", "b1177", "b1178", "b1179", _
+		     "b1180", "b1181", "b1182", "b1183", "b1184", "b1185", "b1186", "b1187", "b1188", "b1189", "b1190", "b1191", "b1192", "b1193", "b1194", "b1195", "b1196", "b1197", "b1198", "b1199", _
+		     "b1200", "b1201", "b1202", "b1203", "b1204", "b1205", "b1206", "b1207", "b1208", "b1209", "b1210", "b1211", "b1212", "b1213", "b1214", "b1215", "b1216", "b1217", "b1218", "b1219", _
+		     "b1220", "b1221", "b1222", "b1223", "b1224", "b1225", "b1226", "b1227", "b1228", "b1229", "b1230", "b1231", "b1232", "b1233", "b1234", "b1235", "b1236", "b1237", "b1238", "b1239", _
+		     "b1240", "b1241", "b1242", "b1243", "b1244", "b1245", "b1246", "b1247", "b1248", "b1249", "b1250", "b1251", "b1252", "b1253", "b1254", "b1255", "b1256", "b1257", "b1258", "b1259", _
+		     "b1260", "b1261", "b1262", "b1263", "b1264", "b1265", "b1266", "b1267", "b1268", "b1269", "b1270", "b1271", "b1272", "b1273", "b1274", "b1275", "b1276", "b1277", "b1278", "b1279", _
+		     "b1280", "b1281", "b1282", "b1283", "b1284", "b1285", "b1286", "b1287", "b1288", "b1289", "b1290", "b1291", "b1292", "b1293", "b1294", "b1295", "b1296", "b1297", "b1298", "b1299", _
+		     "b1300", "b1301", "b1302", "b1303", "b1304", "b1305", "b1306", "b1307", "b1308", "b1309", "b1310", "b1311", "b1312", "b1313", "b1314", "b1315", "b1316", "b1317", "b1318", "b1319", _
+		     "b1320", "b1321", "b1322", "b1323", "b1324", "b1325", "b1326", "b1327", "b1328", "b1329", "b1330", "b1331", "b1332", "b1333", "b1334", "b1335", "b1336", "b1337", "b1338", "b1339", _
+		     "b1340", "b1341", "b1342", "b1343", "b1344", "b1345", "b1346", "b1347", "b1348", "b1349", "b1350", "b1351", "b1352", "b1353", "b1354", "b1355", "b1356", "b1357", "b1358", "b1359", _
+		     "b1360", "b1361", "b1362", "b1363", "b1364", "b1365", "b1366", "b1367", "b1368", "b1369", "b1370", "b1371", "b1372", "b1373", "b1374", "b1375", "b1376", "b1377", "b1378", "b1379", _
+		     "b1380", "b1381", "b1382", "b1383", "b1384", "b1385", "b1386", "b1387", "b1388", "b1389", "b1390", "b1391", "b1392", "b1393", "b1394", "b1395", "b1396", "b1397", "b1398", "b1399", _
+		     "b1400", "b1401", "b1402", "b1403", "b1404", "b1405", "b1406", "b1407", "b1408", "b1409", "b1410", "b1411", "b1412", "b1413", "b1414", "b1415", "b1416", "b1417", "b1418", "b1419", _
+		     "b1420", "b1421", "b1422", "b1423", "b1424", "b1425", "b1426", "b1427", "b1428", "b1429", "b1430", "b1431", "b1432", "b1433", "b1434", "b1435", "b1436", "b1437", "b1438", "b1439", _
+		     "b1440", "b1441", "b1442", "b1443", "b1444", "b1445", "b1446", "b1447", "b1448", "b1449", "b1450", "b1451", "b1452", "b1453", "b1454", "b1455", "b1456", "b1457", "b1458", "b1459", _
+		     "b1460", "b1461", "b1462", "b1463", "b1464", "b1465", "b1466", "b1467", "b1468", "b1469", "b1470", "b1471", "b1472", "b1473", "b1474", "b1475", "b1476", "b1477", "b1478", "b1479", _
+		     "b1480", "b1481", "b1482", "b1483", "b1484", "b1485", "b1486", "b1487", "b1488", "b1489", "b1490", "b1491", "b1492", "b1493", "b1494", "b1495", "b1496", "b1497", "b1498", "b1499", _
+		     "b1500", "b1501", "b1502", "b1503", "b1504", "b1505", "b1506", "b1507", "b1508", "b1509", "b1510", "b1511", "b1512", "b1513", "b1514", "b1515", "b1516", "b1517", "b1518", "b1519", _
+		     "b1520", "b1521", "b1522", "b1523", "b1524", "b1525", "b1526", "b1527", "b1528", "b1529", "b1530", "b1531", "b1532", "b1533", "b1534", "b1535", "b1536", "b1537", "b1538", "b1539", _
+		     "b1540", "b1541", "b1542", "b1543", "b1544", "b1545", "b1546", "b1547", "b1548", "b1549", "b1550", "b1551", "b1552", "b1553", "b1554", "b1555", "b1556", "b1557", "b1558", "b1559", _
+		     "b1560", "b1561", "b1562", "b1563", "b1564", "b1565", "b1566", "b1567", "b1568", "b1569", "b1570", "b1571", "b1572", "b1573", "b1574", "b1575", "b1576", "b1577", "b1578", "b1579", _
+		     "b1580", "b1581", "b1582", "b1583", "b1584", "b1585", "b1586", "b1587", "b1588", "b1589", "b1590", "b1591", "b1592", "b1593", "b1594", "b1595", "b1596", "b1597", "b1598", "b1599", _
+		     "b1600", "b1601", "b1602", "b1603", "b1604", "b1605", "b1606", "b1607", "b1608", "b1609", "b1610", "b1611", "b1612", "b1613", "b1614", "b1615", "b1616", "b1617", "b1618", "b1619", _
+		     "b1620", "b1621", "b1622", "b1623", "b1624", "b1625", "b1626", "b1627", "b1628", "b1629", "b1630", "b1631", "b1632", "b1633", "b1634", "b1635", "b1636", "b1637", "b1638", "b1639", _
+		     "b1640", "b1641", "b1642", "b1643", "b1644", "b1645", "b1646", "b1647", "b1648", "b1649", "b1650", "b1651", "b1652", "b1653", "b1654", "b1655", "b1656", "b1657", "b1658", "b1659", _
+		     "b1660", "b1661", "b1662", "b1663", "b1664", "b1665", "b1666", "b1667", "b1668", "b1669", "b1670", "b1671", "b1672", "b1673", "b1674", "b1675", "b1676", "b1677", "b1678", "b1679", _
+		     "b1680", "b1681", "b1682", "b1683", "b1684", "b1685", "b1686", "b1687", "b1688", "b1689", "b1690", "b1691", "b1692", "b1693", "b1694", "b1695", "b1696", "b1697", "b1698", "b1699", _
+		     "b1700", "b1701", "b1702", "b1703", "b1704", "b1705", "b1706", "b1707", "b1708", "b1709", "b1710", "b1711", "b1712", "b1713", "b1714", "b1715", "b1716", "b1717", "b1718", "b1719", _
+		     "b1720", "b1721", "b1722", "b1723", "b1724", "b1725", "b1726", "b1727", "b1728", "b1729", "b1730", "b1731", "b1732", "b1733", "b1734", "b1735", "b1736", "b1737", "b1738", "b1739", _
+		     "b1740", "b1741", "b1742", "b1743", "b1744", "b1745", "b1746", "b1747", "b1748", "b1749", "b1750", "b1751", "b1752", "b1753", "b1754", "b1755", "b1756", "b1757", "b1758", "b1759", _
+		     "b1760", "b1761", "b1762", "b1763", "b1764", "b1765", "b1766", "b1767", "b1768", "b1769", "b1770", "b1771", "b1772", "b1773", "b1774", "b1775", "b1776", "b1777", "b1778", "b1779", _
+		     "b1780", "b1781", "b1782", "b1783", "b1784", "b1785", "b1786", "b1787", "b1788", "b1789", "b1790", "b1791", "b1792", "b1793", "b1794", "b1795", "b1796", "b1797", "b1798", "b1799", _
+		     "b1800", "b1801", "b1802", "b1803", "b1804", "b1805", "b1806", "b1807", "b1808", "b1809", "b1810", "b1811", "b1812", "b1813", "b1814", "b1815", "b1816", "b1817", "b1818", "b1819", _
+		     "b1820", "b1821", "b1822", "b1823", "b1824", "b1825", "b1826", "b1827", "b1828", "b1829", "b1830", "b1831", "b1832", "b1833", "b1834", "b1835", "b1836", "b1837", "b1838", "b1839", _
+		     "b1840", "b1841", "b1842", "b1843", "b1844", "b1845", "b1846", "b1847", "b1848", "b1849", "b1850", "b1851", "b1852", "b1853", "b1854", "b1855", "b1856", "b1857", "b1858", "b1859", _
+		     "b1860", "b1861", "b1862", "b1863", "b1864", "b1865", "b1866", "b1867", "b1868", "b1869", "b1870", "b1871", "b1872", "b1873", "b1874", "b1875", "b1876", "b1877", "b1878", "b1879", _
+		     "b1880", "b1881", "b1882", "b1883", "b1884", "b1885", "b1886", "b1887", "b1888", "b1889", "b1890", "b1891", "b1892", "b1893", "b1894", "b1895", "b1896", "b1897", "b1898", "b1899", _
+		     "b1900", "b1901", "b1902", "b1903", "b1904", "b1905", "b1906", "b1907", "b1908", "b1909", "b1910", "b1911", "b1912", "b1913", "b1914", "b1915", "b1916", "b1917", "b1918", "b1919", _
+		     "b1920", "b1921", "b1922", "b1923", "b1924", "b1925", "b1926", "b1927", "b1928", "b1929", "b1930", "b1931", "b1932", "b1933", "b1934", "b1935", "b1936", "b1937", "b1938", "b1939", _
+		     "b1940", "b1941", "b1942", "b1943", "b1944", "b1945", "b1946", "b1947", "b1948", "b1949", "b1950", "b1951", "b1952", "b1953", "b1954", "b1955", "b1956", "b1957", "b1958", "b1959", _
+		     "b1960", "b1961", "b1962", "b1963", "b1964", "b1965", "b1966", "b1967", "b1968", "b1969", "b1970", "b1971", "b1972", "b1973", "b1974", "b1975", "b1976", "b1977", "b1978", "b1979", _
+		     "b1980", "b1981", "b1982", "b1983", "b1984", "b1985", "b1986", "b1987", "b1988", "b1989", "b1990", "b1991", "b1992", "b1993", "b1994", "b1995", "b1996", "b1997", "b1998", "b1999", _
+		     "b2000", "b2001", "b2002", "b2003", "b2004", "b2005", "b2006", "b2007", "b2008", "b2009", "b2010", "b2011", "b2012", "b2013", "b2014", "b2015", "b2016", "b2017", "b2018", "b2019", _
+		     "b2020", "b2021", "b2022", "b2023", "b2024", "b2025", "b2026", "b2027", "b2028", "b2029", "b2030", "b2031", "b2032", "b2033", "b2034", "b2035", "b2036", "b2037", "b2038", "b2039", _
+		     "b2040", "b2041", "b2042", "b2043", "b2044", "b2045", "b2046", "b2047", "b2048", "b2049", "b2050", "b2051", "b2052", "b2053", "b2054", "b2055", "b2056", "b2057", "b2058", "b2059", _
+		     "b2060", "b2061", "b2062", "b2063", "b2064", "b2065", "b2066", "b2067", "b2068", "b2069", "b2070", "b2071", "b2072", "b2073", "b2074", "b2075", "b2076", "b2077", "b2078", "b2079", _
+		     "b2080", "b2081", "b2082", "b2083", "b2084", "b2085", "b2086", "b2087", "b2088", "b2089", "b2090", "b2091", "b2092", "b2093", "b2094", "b2095", "b2096", "b2097", "b2098", "b2099", _
+		     "b2100", "b2101", "b2102", "b2103", "b2104", "b2105", "b2106", "b2107", "b2108", "b2109", "b2110", "b2111", "b2112", "b2113", "b2114", "b2115", "b2116", "b2117", "b2118", "b2119", _
+		     "b2120", "b2121", "b2122", "b2123", "b2124", "b2125", "b2126", "b2127", "b2128", "b2129", "b2130", "b2131", "b2132", "b2133", "b2134", "b2135", "b2136", "b2137", "b2138", "b2139", _
+		     "b2140", "b2141", "b2142", "b2143", "b2144", "b2145", "b2146", "b2147", "b2148", "b2149", "b2150", "b2151", "b2152", "b2153", "b2154", "b2155", "b2156", "b2157", "b2158", "b2159", _
+		     "b2160", "b2161", "b2162", "b2163", "b2164", "b2165", "b2166", "b2167", "b2168", "b2169", "b2170", "b2171", "b2172", "b2173", "b2174", "b2175", "b2176", "b2177", "b2178", "b2179", _
+		     "b2180", "b2181", "b2182", "b2183", "b2184", "b2185", "b2186", "b2187", "b2188", "b2189", "b2190", "b2191", "b2192", "b2193", "b2194", "b2195", "b2196", "b2197", "b2198", "b2199"
+			return 100
+		case "after" : return 101
+		case else : return -1
+		end select
+	end function
+
+	TEST( nestedSelects )
+		for i as integer = 0 to 1499
+			CU_ASSERT_EQUAL( nested( "o" & i, "" ), i \ 10 )
+		next
+		for i as integer = 0 to 699
+			CU_ASSERT_EQUAL( nested( "inner", "i" & i ), 1000 + i \ 7 )
+		next
+		CU_ASSERT_EQUAL( nested( "inner", "i700" ), 1999 )
+		CU_ASSERT_EQUAL( nested( "inner", "deeper" ), 2999 )
+		CU_ASSERT_EQUAL( nested( "o1500", "" ), -1 )
+		CU_ASSERT_EQUAL( nested( "", "" ), -1 )
+	END_TEST
+
+	TEST( longCase )
+		for i as integer = 0 to 1999
+			CU_ASSERT_EQUAL( longcase( "a" & i ), i \ 200 )
+		next
+		for i as integer = 0 to 2199
+			CU_ASSERT_EQUAL( longcase( "b" & i ), 100 )
+		next
+		CU_ASSERT_EQUAL( longcase( "after" ), 101 )
+		CU_ASSERT_EQUAL( longcase( "a2000" ), -1 )
+	END_TEST
+
+END_SUITE
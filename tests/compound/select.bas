@@ -499,4 +499,189 @@ SUITE( fbc_tests.compound.select_ )
 		checkStrings( check      , wstr( i )       , w, wstr( "123" ) )
 	END_TEST
 
+	'' enough CASE literals for the hash lookup
+	private function hashedKeyword( byref s as string ) as integer
+		select case s
+		case "if", "then"
+			return 1
+		case "else"
+			return 2
+		case "while"
+			return 3
+		case "wend"
+			return 4
+		case "do", "loop", "while"
+			'' "while" is never reached here
+			return 5
+		case "for"
+			return 6
+		case "next"
+			return 7
+		case ""
+			return 8
+		case !"tab\there"
+			return 9
+		case "IF"
+			return 10
+		case else
+			return -1
+		end select
+	end function
+
+	private function hashedNoElse( byref s as string ) as integer
+		dim as integer result = 0
+		select case s
+		case "a" : result = 1
+		case "b" : result = 2
+		case "c" : result = 3
+		case "d" : result = 4
+		case "e" : result = 5
+		case "f" : result = 6
+		case "g" : result = 7
+		case "h" : result = 8
+		end select
+		function = result
+	end function
+
+	'' a CASE that isn't a literal: compared one by one, as before
+	private function hashedMixed( byref s as string, byref v as string ) as integer
+		select case s
+		case "1" : return 1
+		case "2" : return 2
+		case "3" : return 3
+		case "4" : return 4
+		case v   : return 5
+		case "6" : return 6
+		case "7" : return 7
+		case "8" : return 8
+		case "9" : return 9
+		case else : return -1
+		end select
+	end function
+
+	TEST( case_string_hashed )
+		CU_ASSERT_EQUAL( hashedKeyword( "if" ), 1 )
+		CU_ASSERT_EQUAL( hashedKeyword( "then" ), 1 )
+		CU_ASSERT_EQUAL( hashedKeyword( "else" ), 2 )
+		CU_ASSERT_EQUAL( hashedKeyword( "while" ), 3 )
+		CU_ASSERT_EQUAL( hashedKeyword( "wend" ), 4 )
+		CU_ASSERT_EQUAL( hashedKeyword( "do" ), 5 )
+		CU_ASSERT_EQUAL( hashedKeyword( "loop" ), 5 )
+		CU_ASSERT_EQUAL( hashedKeyword( "for" ), 6 )
+		CU_ASSERT_EQUAL( hashedKeyword( "next" ), 7 )
+		CU_ASSERT_EQUAL( hashedKeyword( "" ), 8 )
+		CU_ASSERT_EQUAL( hashedKeyword( !"tab\there" ), 9 )
+		CU_ASSERT_EQUAL( hashedKeyword( "IF" ), 10 )
+		CU_ASSERT_EQUAL( hashedKeyword( "If" ), -1 )
+		CU_ASSERT_EQUAL( hashedKeyword( "if " ), -1 )
+		CU_ASSERT_EQUAL( hashedKeyword( "fo" ), -1 )
+		CU_ASSERT_EQUAL( hashedKeyword( "tab" ), -1 )
+
+		for i as integer = asc( "a" ) to asc( "h" )
+			CU_ASSERT_EQUAL( hashedNoElse( chr( i ) ), i - asc( "a" ) + 1 )
+		next
+		CU_ASSERT_EQUAL( hashedNoElse( "i" ), 0 )
+		CU_ASSERT_EQUAL( hashedNoElse( "" ), 0 )
+
+		CU_ASSERT_EQUAL( hashedMixed( "3", "5" ), 3 )
+		CU_ASSERT_EQUAL( hashedMixed( "5", "5" ), 5 )
+		CU_ASSERT_EQUAL( hashedMixed( "9", "5" ), 9 )
+		CU_ASSERT_EQUAL( hashedMixed( "8", "8" ), 5 )
+		CU_ASSERT_EQUAL( hashedMixed( "0", "5" ), -1 )
+	END_TEST
+
+	'' literals and a non-literal in the same CASE, after literal CASEs,
+	'' with duplicates on both sides of the fallback
+	private function hashedMixedClause( byref s as string, byref v as string ) as integer
+		select case s
+		case "a", "b" : return 1
+		case "c"      : return 2
+		case "d", "a" : return 3
+		case "e"      : return 4
+		case "f", v   : return 5
+		case "g", "c" : return 6
+		case "h"      : return 7
+		case "i"      : return 8
+		case else     : return -1
+		end select
+	end function
+
+	TEST( case_string_hashed_fallback )
+		CU_ASSERT_EQUAL( hashedMixedClause( "a", "z" ), 1 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "b", "z" ), 1 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "c", "z" ), 2 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "d", "z" ), 3 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "e", "z" ), 4 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "f", "z" ), 5 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "z", "z" ), 5 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "e", "e" ), 4 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "g", "z" ), 6 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "h", "z" ), 7 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "i", "z" ), 8 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "i", "i" ), 5 )
+		CU_ASSERT_EQUAL( hashedMixedClause( "j", "z" ), -1 )
+	END_TEST
+
+	'' hashed SELECTs inside the CASE blocks of a hashed SELECT
+	private function hashedNested( byref s as string, byref t as string ) as integer
+		select case s
+		case "1" : return 1
+		case "2" : return 2
+		case "3"
+			select case t
+			case "a" : return 31
+			case "b" : return 32
+			case "c" : return 33
+			case "d" : return 34
+			case "e" : return 35
+			case "f" : return 36
+			case "g" : return 37
+			case "h"
+				select case s + t
+				case "3a" : return 0
+				case "3b" : return 0
+				case "3c" : return 0
+				case "3d" : return 0
+				case "3e" : return 0
+				case "3f" : return 0
+				case "3g" : return 0
+				case "3h" : return 38
+				case else : return 0
+				end select
+			case else : return 30
+			end select
+		case "4" : return 4
+		case "5" : return 5
+		case "6" : return 6
+		case "7"
+			select case t
+			case "a" : return 71
+			case "b" : return 72
+			case "c" : return 73
+			case "d" : return 74
+			case "e" : return 75
+			case "f" : return 76
+			case "g" : return 77
+			case "h" : return 78
+			end select
+			return 70
+		case "8" : return 8
+		case else : return -1
+		end select
+	end function
+
+	TEST( case_string_hashed_nested )
+		CU_ASSERT_EQUAL( hashedNested( "1", "a" ), 1 )
+		CU_ASSERT_EQUAL( hashedNested( "3", "a" ), 31 )
+		CU_ASSERT_EQUAL( hashedNested( "3", "g" ), 37 )
+		CU_ASSERT_EQUAL( hashedNested( "3", "h" ), 38 )
+		CU_ASSERT_EQUAL( hashedNested( "3", "x" ), 30 )
+		CU_ASSERT_EQUAL( hashedNested( "4", "a" ), 4 )
+		CU_ASSERT_EQUAL( hashedNested( "7", "b" ), 72 )
+		CU_ASSERT_EQUAL( hashedNested( "7", "h" ), 78 )
+		CU_ASSERT_EQUAL( hashedNested( "7", "x" ), 70 )
+		CU_ASSERT_EQUAL( hashedNested( "8", "a" ), 8 )
+		CU_ASSERT_EQUAL( hashedNested( "a", "a" ), -1 )
+	END_TEST
+
 END_SUITE
@@ -525,4 +525,55 @@ SUITE( fbc_tests.fbc_int.array )
 
 	END_TEST
 
+	TEST( reserve )
+		dim a() as integer
+		dim ap as FBC.FBARRAY ptr = FBC.ArrayDescriptorPtr( a() )
+		dim p as any ptr
+
+		'' room for 100 elements, bounds unchanged
+		CU_ASSERT( FBC.ArrayReserve( a(), 100 ) = 0 )
+		CU_ASSERT( lbound( a ) = 0 )
+		CU_ASSERT( ubound( a ) = -1 )
+		CU_ASSERT( ap->size = 0 )
+		CU_ASSERT( (ap->flags and FBC.FBARRAY_FLAGS_CAPACITY) <> 0 )
+		p = ap->base_ptr
+
+		'' appending within the reserved room doesn't move the array
+		for i as integer = 0 to 99
+			redim preserve a(0 to i)
+			a(i) = i
+		next
+		CU_ASSERT( ap->base_ptr = p )
+		check_array( ap, p, sizeof(integer) * 100, sizeof(integer), 1 )
+		check_dim( ap, 0, 100, 0, 99 )
+
+		'' growing past it keeps the contents
+		for i as integer = 100 to 999
+			redim preserve a(0 to i)
+			a(i) = i
+		next
+		check_dim( ap, 0, 1000, 0, 999 )
+		for i as integer = 0 to 999
+			CU_ASSERT( a(i) = i )
+		next
+
+		'' shrink frees the room beyond the bounds only
+		CU_ASSERT( FBC.ArrayShrink( a() ) = 0 )
+		CU_ASSERT( (ap->flags and FBC.FBARRAY_FLAGS_CAPACITY) = 0 )
+		check_array( ap, @a(0), sizeof(integer) * 1000, sizeof(integer), 1 )
+		for i as integer = 0 to 999
+			CU_ASSERT( a(i) = i )
+		next
+
+		erase a
+		CU_ASSERT( (ap->flags and FBC.FBARRAY_FLAGS_CAPACITY) = 0 )
+	END_TEST
+
+	TEST( reserve_fixed )
+		static a(0 to 9) as integer
+
+		'' fixed-length arrays don't own their memory
+		CU_ASSERT( FBC.ArrayReserve( a(), 100 ) <> 0 )
+	END_TEST
+
 END_SUITE
@@ -0,0 +1,188 @@
+' TEST_MODE : MULTI_MODULE_TEST
+
+'' fbc -server (see server.bmk for FBC_EXE): start a server, send it compile
+'' requests over its socket, and check the output and the exit code that
+'' come back; a second server on the same socket must fail, and a socket
+'' left over by a killed server must be taken over
+
+#ifdef __FB_UNIX__
+
+extern "C"
+	declare function socket_ alias "socket" ( byval domain as long, byval type_ as long, byval protocol as long ) as long
+	declare function connect_ alias "connect" ( byval fd as long, byval addr as const any ptr, byval addrlen as ulong ) as long
+	declare function read_ alias "read" ( byval fd as long, byval buffer as any ptr, byval size as uinteger ) as integer
+	declare function write_ alias "write" ( byval fd as long, byval buffer as const any ptr, byval size as uinteger ) as integer
+	declare function close_ alias "close" ( byval fd as long ) as long
+end extern
+
+const AF_UNIX     = 1
+const SOCK_STREAM = 1
+
+type SERVERADDR
+#if defined( __FB_LINUX__ ) or defined( __FB_CYGWIN__ )
+	family		as ushort
+	path		as zstring * 108
+#else
+	len_		as ubyte
+	family		as ubyte
+	path		as zstring * 104
+#endif
+end type
+
+const SOCKPATH = "server-smoke.sock"
+const PIDFILE  = "server-smoke.pid"
+const SRC_OK   = "server-smoke-ok.bas"
+const SRC_ERR  = "server-smoke-err.bas"
+const EXE_OK   = "server-smoke-ok"
+
+private function hConnect( ) as long
+	dim as SERVERADDR addr
+	dim as long fd = any
+
+	addr.family = AF_UNIX
+	addr.path = SOCKPATH
+
+	fd = socket_( AF_UNIX, SOCK_STREAM, 0 )
+	if( fd >= 0 ) then
+		if( connect_( fd, @addr, sizeof( addr ) ) = 0 ) then
+			return fd
+		end if
+		close_( fd )
+	end if
+
+	return -1
+end function
+
+'' start a server in the background, returns its pid once it accepts
+'' connections
+private function hStartServer( ) as string
+	dim as string pid
+	dim as long fd = -1
+	dim as integer f = any
+
+	shell( FBC_EXE & " -server " & SOCKPATH & " > /dev/null 2>&1 & echo $! > " & PIDFILE )
+
+	for i as integer = 1 to 100
+		fd = hConnect( )
+		if( fd >= 0 ) then
+			exit for
+		end if
+		sleep 100, 1
+	next
+	assert( fd >= 0 )
+	close_( fd )
+
+	f = freefile( )
+	open PIDFILE for input as #f
+	line input #f, pid
+	close #f
+	kill PIDFILE
+
+	function = pid
+end function
+
+'' send a request, returns everything the server wrote back
+private function hRequest( args() as string ) as string
+	dim as zstring * 4096+1 buffer = any
+	dim as integer bytes = any
+	dim as long fd = hConnect( )
+	dim as string s
+
+	assert( fd >= 0 )
+
+	s = curdir( ) & !"\n"
+	for i as integer = lbound( args ) to ubound( args )
+		s &= args(i) & !"\n"
+	next
+	s &= !"\n"
+	assert( write_( fd, strptr( s ), len( s ) ) = len( s ) )
+
+	s = ""
+	do
+		bytes = read_( fd, @buffer, 4096 )
+		if( bytes <= 0 ) then
+			exit do
+		end if
+		buffer[bytes] = 0
+		s &= buffer
+	loop
+	close_( fd )
+
+	function = s
+end function
+
+private sub hWriteFile( byref filename as string, byref text as string )
+	dim as integer f = freefile( )
+	open filename for output as #f
+	print #f, text
+	close #f
+end sub
+
+dim as string pid, res
+
+hWriteFile( SRC_OK, "print MSG" )
+hWriteFile( SRC_ERR, "print undeclared_variable" )
+
+pid = hStartServer( )
+
+'' the same socket is in use
+assert( shell( FBC_EXE & " -server " & SOCKPATH & " > /dev/null 2>&1" ) <> 0 )
+
+'' compiled by the server's process
+scope
+	dim as string args(0 to 5) = { "-c", SRC_OK, "-d", "MSG=1", "-o", "server-smoke-ok.o" }
+	res = hRequest( args() )
+	assert( right( res, 7 ) = !"exit 0\n" )
+	assert( len( dir( "server-smoke-ok.o" ) ) > 0 )
+	kill "server-smoke-ok.o"
+end scope
+
+scope
+	dim as string args(0 to 1) = { "-c", SRC_ERR }
+	res = hRequest( args() )
+	assert( right( res, 7 ) = !"exit 1\n" )
+	assert( instr( res, SRC_ERR & "(1) error" ) > 0 )
+end scope
+
+'' -lang is run by a new fbc; the arguments must get there unchanged,
+'' quotes and spaces included
+scope
+	dim as string Q = chr( 34 )
+	dim as string args(0 to 6) = _
+	{ _
+		"-lang", "fb", _
+		"-d", "MSG=" & Q & "it's a " & Q & Q & "quoted" & Q & Q & " arg" & Q, _
+		SRC_OK, "-x", EXE_OK _
+	}
+	res = hRequest( args() )
+	assert( right( res, 7 ) = !"exit 0\n" )
+
+	dim as string ln
+	dim as integer f = freefile( )
+	assert( open pipe( "./" & EXE_OK, for input, as #f ) = 0 )
+	line input #f, ln
+	close #f
+	kill EXE_OK
+	assert( ln = "it's a " & Q & "quoted" & Q & " arg" )
+end scope
+
+'' killed: the socket stays, the next server takes it over
+shell( "kill -9 " & pid )
+sleep 200, 1
+assert( hConnect( ) < 0 )
+
+pid = hStartServer( )
+
+scope
+	dim as string args(0 to 1) = { "-c", SRC_ERR }
+	res = hRequest( args() )
+	assert( right( res, 7 ) = !"exit 1\n" )
+end scope
+
+shell( "kill " & pid )
+sleep 200, 1
+kill SOCKPATH
+kill SRC_OK
+kill SRC_ERR
+
+#endif
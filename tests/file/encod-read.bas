@@ -0,0 +1,269 @@
+# include "fbcunit.bi"
+
+'' Files opened with ENCODING are read ahead into a 32 KB decode buffer.
+'' The file here is a few times that, with 2, 3 and 4 byte UTF-8 chars
+'' (surrogate pairs in UTF-16) at every offset, so some of them are cut
+'' at the buffer's end, and a line longer than the whole buffer. It's
+'' read back with LINE INPUT, GET, INPUT$ and WINPUT$ mixed, and with
+'' SEEK back to positions returned by SEEK().
+
+SUITE( fbc_tests.file_.encod_read )
+
+	const FILENAME = "encod-read.txt"
+
+	const TOTAL_CHARS = 150000
+	const LONGLINE_START = 60000
+	const LONGLINE_LEN = 20000
+	const CR_POS = 100003
+
+	'' the file's content, char by char
+	private function hCharAt( byval k as integer ) as ulong
+		if( (k >= LONGLINE_START) and (k < LONGLINE_START + LONGLINE_LEN) ) then
+			return &h20AC
+		end if
+
+		'' a lone CR, the next char isn't a LF
+		if( k = CR_POS ) then
+			return 13
+		end if
+
+		select case (k * 7 + k \ 13) mod 23
+		case 0, 11
+			return 10
+		case 1, 5
+			return &hE9
+		case 2, 8, 15
+			return &h20AC
+		case 3
+			return &h416
+		case 4
+			#if sizeof( wstring ) = 4
+				return &h1F600
+			#else
+				return &h3042
+			#endif
+		case else
+			return asc( "a" ) + (k mod 26)
+		end select
+	end function
+
+	'' as read into a string
+	private function hAsciiAt( byval k as integer ) as ulong
+		dim as ulong c = hCharAt( k )
+		if( c > 255 ) then
+			c = asc( "?" )
+		end if
+		return c
+	end function
+
+	private sub hWriteFile( byref encod as string )
+		dim as wstring * 1001 chunk
+		dim as integer f = freefile( ), k = 0
+
+		if( open( FILENAME, for output, encoding encod, as #f ) <> 0 ) then
+			CU_FAIL_FATAL( "couldn't open test file." )
+		end if
+
+		while( k < TOTAL_CHARS )
+			dim as integer n = 0
+			while( (n < 1000) and (k < TOTAL_CHARS) )
+				chunk[n] = hCharAt( k )
+				n += 1
+				k += 1
+			wend
+			chunk[n] = 0
+			print #f, chunk;
+		wend
+
+		close #f
+	end sub
+
+	'' the index of the line's end (LF, CR or CR LF), or TOTAL_CHARS
+	private function hLineEnd( byval k as integer ) as integer
+		while( k < TOTAL_CHARS )
+			select case hCharAt( k )
+			case 10, 13
+				exit while
+			end select
+			k += 1
+		wend
+		return k
+	end function
+
+	private function hNextLine( byval k as integer ) as integer
+		k = hLineEnd( k )
+		if( k < TOTAL_CHARS ) then
+			if( hCharAt( k ) = 13 ) then
+				if( k + 1 < TOTAL_CHARS ) then
+					if( hCharAt( k + 1 ) = 10 ) then
+						k += 1
+					end if
+				end if
+			end if
+			k += 1
+		end if
+		return k
+	end function
+
+	private function hMatchW( byref w as wstring, byval k as integer, byval chars as integer ) as integer
+		if( len( w ) <> chars ) then
+			return FALSE
+		end if
+		for i as integer = 0 to chars - 1
+			if( w[i] <> hCharAt( k + i ) ) then
+				return FALSE
+			end if
+		next
+		return TRUE
+	end function
+
+	private function hMatchA( byref s as string, byval k as integer, byval chars as integer ) as integer
+		if( len( s ) <> chars ) then
+			return FALSE
+		end if
+		for i as integer = 0 to chars - 1
+			if( s[i] <> hAsciiAt( k + i ) ) then
+				return FALSE
+			end if
+		next
+		return TRUE
+	end function
+
+	dim shared as wstring * (LONGLINE_LEN + 1000) wline
+	dim shared as ulong seed
+
+	private function hRand( byval n as integer ) as integer
+		seed = seed * 1664525 + 1013904223
+		return (seed shr 8) mod n
+	end function
+
+	private sub hReadLines( byref encod as string )
+		dim as integer f = freefile( ), k = 0, lines = 0
+		dim as string s
+
+		if( open( FILENAME, for input, encoding encod, as #f ) <> 0 ) then
+			CU_FAIL_FATAL( "couldn't open test file." )
+		end if
+
+		while( eof( f ) = FALSE )
+			dim as integer e = hLineEnd( k )
+			if( (lines and 1) = 0 ) then
+				line input #f, wline
+				CU_ASSERT( hMatchW( wline, k, e - k ) )
+			else
+				line input #f, s
+				CU_ASSERT( hMatchA( s, k, e - k ) )
+			end if
+			k = hNextLine( k )
+			lines += 1
+		wend
+
+		CU_ASSERT_EQUAL( k, TOTAL_CHARS )
+
+		close #f
+	end sub
+
+	private sub hReadMixed( byref encod as string )
+		dim as integer f = freefile( ), k = 0, n, e
+		dim as integer savedk = 0, rewinds = 0
+		dim as longint saved
+		dim as string s
+
+		if( open( FILENAME, for input, encoding encod, as #f ) <> 0 ) then
+			CU_FAIL_FATAL( "couldn't open test file." )
+		end if
+
+		saved = seek( f )
+
+		do
+			CU_ASSERT_EQUAL( eof( f ), (k >= TOTAL_CHARS) )
+
+			if( k >= TOTAL_CHARS ) then
+				if( rewinds = 2 ) then
+					exit do
+				end if
+				'' back to where SEEK() was last called
+				seek #f, saved
+				k = savedk
+				rewinds += 1
+				continue do
+			end if
+
+			select case hRand( 10 )
+			case 0, 1
+				e = hLineEnd( k )
+				line input #f, wline
+				CU_ASSERT( hMatchW( wline, k, e - k ) )
+				k = hNextLine( k )
+
+			case 2, 3
+				e = hLineEnd( k )
+				line input #f, s
+				CU_ASSERT( hMatchA( s, k, e - k ) )
+				k = hNextLine( k )
+
+			case 4
+				'' a few chars or a few blocks
+				n = iif( hRand( 2 ), 1 + hRand( 8 ), 1 + hRand( 70000 ) )
+				if( n > TOTAL_CHARS - k ) then
+					n = TOTAL_CHARS - k
+				end if
+				s = space( n )
+				get #f, , s
+				CU_ASSERT( hMatchA( s, k, n ) )
+				k += n
+
+			case 5
+				n = 1 + hRand( 5000 )
+				if( n > TOTAL_CHARS - k ) then
+					n = TOTAL_CHARS - k
+				end if
+				s = input( n, #f )
+				CU_ASSERT( hMatchA( s, k, n ) )
+				k += n
+
+			case 6
+				n = 1 + hRand( 5000 )
+				if( n > TOTAL_CHARS - k ) then
+					n = TOTAL_CHARS - k
+				end if
+				wline = winput( n, #f )
+				CU_ASSERT( hMatchW( wline, k, n ) )
+				k += n
+
+			case 7, 8
+				saved = seek( f )
+				savedk = k
+
+			case else
+				seek #f, saved
+				k = savedk
+			end select
+		loop
+
+		close #f
+	end sub
+
+	private sub hTest( byref encod as string )
+		hWriteFile( encod )
+		hReadLines( encod )
+		seed = 1
+		hReadMixed( encod )
+		seed = 12345
+		hReadMixed( encod )
+		kill FILENAME
+	end sub
+
+	TEST( utf8 )
+		hTest( "utf8" )
+	END_TEST
+
+	TEST( utf16 )
+		hTest( "utf16" )
+	END_TEST
+
+	TEST( utf32 )
+		hTest( "utf32" )
+	END_TEST
+
+END_SUITE
@@ -0,0 +1,58 @@
+# include "fbcunit.bi"
+
+#include "fbprocess.bi"
+
+SUITE( fbc_tests.functions.process )
+
+#ifdef __FB_UNIX__
+
+	TEST( pipes )
+		dim as any ptr p = ProcessStart( "tr", "a-z A-Z", fbProcessStdin or fbProcessStdout )
+		CU_ASSERT( p <> 0 )
+
+		dim as string text = "hello world"
+		CU_ASSERT_EQUAL( ProcessWrite( p, strptr( text ), len( text ) ), len( text ) )
+		CU_ASSERT_EQUAL( ProcessCloseInput( p ), 0 )
+
+		CU_ASSERT_EQUAL( ProcessReadAll( p, fbProcessStdout ), "HELLO WORLD" )
+		CU_ASSERT_EQUAL( ProcessClose( p ), 0 )
+	END_TEST
+
+	TEST( exitcode )
+		dim as any ptr p = ProcessStart( "sh", "-c ""echo oops >&2; exit 3""", fbProcessStderr )
+		CU_ASSERT( p <> 0 )
+
+		CU_ASSERT( (ProcessPoll( p, -1 ) and fbProcessStderr) <> 0 )
+		CU_ASSERT_EQUAL( ProcessReadAll( p, fbProcessStderr ), !"oops\n" )
+		CU_ASSERT_EQUAL( ProcessWait( p ), 3 )
+		CU_ASSERT_EQUAL( ProcessClose( p ), 3 )
+	END_TEST
+
+	TEST( timeout )
+		dim as any ptr p = ProcessStart( "sleep", "10" )
+		CU_ASSERT( p <> 0 )
+
+		CU_ASSERT_EQUAL( ProcessWait( p, 10 ), fbProcessRunning )
+		CU_ASSERT_EQUAL( ProcessKill( p ), 0 )
+		CU_ASSERT_EQUAL( ProcessClose( p ), 128 + 9 )
+	END_TEST
+
+	TEST( brokenPipe )
+		'' the child doesn't read its stdin: the write fails instead of
+		'' SIGPIPE ending the program
+		dim as any ptr p = ProcessStart( "true", , fbProcessStdin )
+		CU_ASSERT( p <> 0 )
+		CU_ASSERT_EQUAL( ProcessWait( p ), 0 )
+
+		dim as string text = space( 100000 )
+		CU_ASSERT_EQUAL( ProcessWrite( p, strptr( text ), len( text ) ), -1 )
+		CU_ASSERT_EQUAL( ProcessClose( p ), 0 )
+	END_TEST
+
+	TEST( missing )
+		CU_ASSERT( ProcessStart( "./no-such-program" ) = 0 )
+	END_TEST
+
+#endif
+
+END_SUITE
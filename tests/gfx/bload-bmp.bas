@@ -0,0 +1,141 @@
+# include "fbcunit.bi"
+#include once "fbgfx.bi"
+
+'' BLOAD of 24 and 32-bit BMPs into 16 and 32-bit images, with widths that
+'' leave a remainder after the 4 pixels converted at once, checked against
+'' a conversion done one pixel at a time; BSAVE'ing the image and loading
+'' it again must give the same pixels
+
+SUITE( fbc_tests.gfx.bload_bmp )
+
+	const H = 3
+	const FILENAME = "bload-bmp.bmp"
+
+	'' different in every channel of every pixel
+	private sub hColor _
+		( _
+			byval x as integer, byval y as integer, _
+			byref r as ulong, byref g as ulong, byref b as ulong, byref a as ulong _
+		)
+
+		r = (x * 11 + y * 173 + 91) and 255
+		g = (x * 59 + y * 7 + 200) and 255
+		b = (x * 37 + y * 101 + 13) and 255
+		a = (x * 29 + y * 3 + 1) and 255
+	end sub
+
+	'' BITMAPINFOHEADER, BI_RGB, bottom-up rows padded to 4 bytes
+	private sub hWriteBmp( byval w as integer, byval bitcount as integer )
+		dim as integer bytes = bitcount \ 8
+		dim as integer stride = (w * bytes + 3) and not 3
+		dim as ulong r, g, b, a
+		dim as string s
+
+		s = "BM" & mkl( 14 + 40 + stride * H ) & mkl( 0 ) & mkl( 14 + 40 )
+		s &= mkl( 40 ) & mkl( w ) & mkl( H ) & mkshort( 1 ) & mkshort( bitcount )
+		s &= mkl( 0 ) & mkl( stride * H ) & mkl( 2835 ) & mkl( 2835 ) & mkl( 0 ) & mkl( 0 )
+
+		for y as integer = H - 1 to 0 step -1
+			dim as string row = string( stride, 0 )
+			for x as integer = 0 to w - 1
+				hColor( x, y, r, g, b, a )
+				row[x * bytes + 0] = b
+				row[x * bytes + 1] = g
+				row[x * bytes + 2] = r
+				if( bytes = 4 ) then
+					row[x * bytes + 3] = a
+				end if
+			next
+			s &= row
+		next
+
+		dim as integer f = freefile( )
+		CU_ASSERT( open( FILENAME, for binary, access write, as #f ) = 0 )
+		put #f, , s
+		close #f
+	end sub
+
+	private function hExpected _
+		( _
+			byval x as integer, byval y as integer, _
+			byval bitcount as integer, byval depth as integer _
+		) as ulong
+
+		dim as ulong r, g, b, a
+		hColor( x, y, r, g, b, a )
+
+		if( bitcount = 24 ) then
+			a = 255
+		end if
+
+		if( depth = 16 ) then
+			return ((r shr 3) shl 11) or ((g shr 2) shl 5) or (b shr 3)
+		end if
+
+		return (a shl 24) or (r shl 16) or (g shl 8) or b
+	end function
+
+	private function hPixel( byval img as fb.Image ptr, byval x as integer, byval y as integer ) as ulong
+		dim as ubyte ptr row = cast( ubyte ptr, img + 1 ) + y * img->pitch
+		if( img->bpp = 2 ) then
+			return cast( ushort ptr, row )[x]
+		end if
+		return cast( ulong ptr, row )[x]
+	end function
+
+	private sub hLoad( byval bitcount as integer, byval depth as integer )
+		dim as integer widths(0 to 5) = { 1, 3, 5, 13, 21, 35 }
+
+		for i as integer = 0 to ubound( widths )
+			dim as integer w = widths(i)
+
+			'' (also resets the cached target, the images can reuse
+			'' the memory of the previous ones)
+			CU_ASSERT( screenres( 64, 16, depth, , fb.GFX_NULL ) = 0 )
+
+			hWriteBmp( w, bitcount )
+
+			dim as fb.Image ptr img = imagecreate( w, H, 0 )
+			CU_ASSERT( bload( FILENAME, img ) = 0 )
+			kill FILENAME
+
+			for y as integer = 0 to H - 1
+				for x as integer = 0 to w - 1
+					CU_ASSERT_EQUAL( hPixel( img, x, y ), hExpected( x, y, bitcount, depth ) )
+				next
+			next
+
+			CU_ASSERT( bsave( FILENAME, img ) = 0 )
+
+			dim as fb.Image ptr img2 = imagecreate( w, H, 0 )
+			CU_ASSERT( bload( FILENAME, img2 ) = 0 )
+			kill FILENAME
+
+			for y as integer = 0 to H - 1
+				for x as integer = 0 to w - 1
+					CU_ASSERT_EQUAL( hPixel( img2, x, y ), hPixel( img, x, y ) )
+				next
+			next
+
+			imagedestroy( img2 )
+			imagedestroy( img )
+		next
+	end sub
+
+	TEST( bmp24to32 )
+		hLoad( 24, 32 )
+	END_TEST
+
+	TEST( bmp32to32 )
+		hLoad( 32, 32 )
+	END_TEST
+
+	TEST( bmp24to16 )
+		hLoad( 24, 16 )
+	END_TEST
+
+	TEST( bmp32to16 )
+		hLoad( 32, 16 )
+	END_TEST
+
+END_SUITE
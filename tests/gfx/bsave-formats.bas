@@ -0,0 +1,93 @@
+# include "fbcunit.bi"
+#include once "fbgfx.bi"
+
+'' BSAVE to .png/.qoi: the PNG writer uses stored deflate blocks, so the
+'' pixels of a small image can be checked at fixed offsets in the file
+
+SUITE( fbc_tests.gfx.bsave_formats )
+
+	const SCREEN_W = 2
+	const SCREEN_H = 1
+
+	'' 8 signature + 25 IHDR + 8 IDAT chunk header + 2 zlib + 5 block header
+	const PNG_FILTER = 48
+	const PNG_PIXELS = PNG_FILTER + 1
+
+	'' 14 bytes header
+	const QOI_DATA = 14
+
+	private function hLoadFile( byref filename as const string ) as string
+		dim as string s
+		dim as integer f = freefile( )
+		if( open( filename, for binary, access read, as #f ) = 0 ) then
+			s = space( lof( f ) )
+			get #f, , s
+			close #f
+		end if
+		kill filename
+		return s
+	end function
+
+	TEST( screenPng )
+		CU_ASSERT( screenres( SCREEN_W, SCREEN_H, 32, , fb.GFX_NULL ) = 0 )
+		cls
+		pset( 1, 0 ), rgb(10,20,30)
+
+		CU_ASSERT( bsave( "bsave-formats.png", 0 ) = 0 )
+		dim as string s = hLoadFile( "bsave-formats.png" )
+
+		CU_ASSERT( mid( s, 2, 3 ) = "PNG" )
+		'' color type 6 (RGBA)
+		CU_ASSERT_EQUAL( s[8 + 8 + 9], 6 )
+		CU_ASSERT_EQUAL( s[PNG_FILTER], 0 )
+
+		'' pixels cleared by CLS are opaque
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 0], 0 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 1], 0 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 2], 0 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 3], 255 )
+
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 4], 10 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 5], 20 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 6], 30 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 7], 255 )
+	END_TEST
+
+	TEST( screenQoi )
+		CU_ASSERT( screenres( SCREEN_W, SCREEN_H, 32, , fb.GFX_NULL ) = 0 )
+		cls
+		pset( 1, 0 ), rgb(10,20,30)
+
+		CU_ASSERT( bsave( "bsave-formats.qoi", 0 ) = 0 )
+		dim as string s = hLoadFile( "bsave-formats.qoi" )
+
+		CU_ASSERT( left( s, 4 ) = "qoif" )
+		CU_ASSERT_EQUAL( s[12], 4 )
+
+		'' opaque black is the initial pixel: QOI_OP_RUN of 1
+		CU_ASSERT_EQUAL( s[QOI_DATA + 0], &hC0 )
+
+		'' same alpha: QOI_OP_RGB, not QOI_OP_RGBA
+		CU_ASSERT_EQUAL( s[QOI_DATA + 1], &hFE )
+		CU_ASSERT_EQUAL( s[QOI_DATA + 2], 10 )
+		CU_ASSERT_EQUAL( s[QOI_DATA + 3], 20 )
+		CU_ASSERT_EQUAL( s[QOI_DATA + 4], 30 )
+	END_TEST
+
+	TEST( imageKeepsAlpha )
+		CU_ASSERT( screenres( SCREEN_W, SCREEN_H, 32, , fb.GFX_NULL ) = 0 )
+
+		dim as any ptr img = imagecreate( SCREEN_W, SCREEN_H, rgba(1,2,3,128) )
+		CU_ASSERT( img <> NULL )
+
+		CU_ASSERT( bsave( "bsave-formats.png", img ) = 0 )
+		dim as string s = hLoadFile( "bsave-formats.png" )
+		imagedestroy( img )
+
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 0], 1 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 1], 2 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 2], 3 )
+		CU_ASSERT_EQUAL( s[PNG_PIXELS + 3], 128 )
+	END_TEST
+
+END_SUITE
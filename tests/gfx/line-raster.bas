@@ -0,0 +1,305 @@
+# include "fbcunit.bi"
+#include once "fbgfx.bi"
+
+'' LINE, LINE B/BF, CIRCLE, FB.PolyLine and FB.LineSegments drawn into an
+'' image buffer, checked pixel by pixel: '#' is the drawing color, '.' is
+'' untouched
+
+SUITE( fbc_tests.gfx.line_raster )
+
+	const W = 16
+	const H = 10
+	const C = rgba(255,255,255,255)
+
+	dim shared as fb.Image ptr img
+
+	private sub hBegin( byval depth as integer = 32 )
+		CU_ASSERT( screenres( W, H, 32, , fb.GFX_NULL ) = 0 )
+		img = imagecreate( W, H, 0, depth )
+		CU_ASSERT( img <> NULL )
+	end sub
+
+	private sub hCheck( expected() as string, byval colour as ulong = C )
+		for y as integer = 0 to H - 1
+			dim as string row = string( W, "." )
+			for x as integer = 0 to W - 1
+				dim as ulong p = point( x, y, img )
+				if( p = colour ) then
+					row[x] = asc( "#" )
+				elseif( p <> 0 ) then
+					row[x] = asc( "?" )
+				end if
+			next
+			CU_ASSERT_EQUAL( row, expected(y) )
+		next
+		imagedestroy( img )
+		img = NULL
+	end sub
+
+	'' both endpoints are drawn, in either direction
+	TEST( diagonal )
+		hBegin( )
+		line img, (1,1)-(14,6), C
+		line img, (2,9)-(7,2), C
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			".##.............", _
+			"...##..#........", _
+			".....###........", _
+			"......#.###.....", _
+			".....#.....##...", _
+			"....#........##.", _
+			"...#............", _
+			"...#............", _
+			"..#............." _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( horizontalVertical )
+		hBegin( )
+		line img, (0,0)-(15,0), C
+		line img, (15,9)-(15,2), C
+		line img, (4,5)-(4,5), C
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"################", _
+			"................", _
+			"...............#", _
+			"...............#", _
+			"...............#", _
+			"....#..........#", _
+			"...............#", _
+			"...............#", _
+			"...............#", _
+			"...............#" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	'' lines partly outside the image keep the slope they would have unclipped
+	TEST( clipping )
+		hBegin( )
+		line img, (-6,-4)-(20,12), C
+		line img, (-3,8)-(30,8), C
+		line img, (12,-5)-(12,40), C
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"##..........#...", _
+			"..#.........#...", _
+			"...##.......#...", _
+			".....##.....#...", _
+			".......#....#...", _
+			"........##..#...", _
+			"..........###...", _
+			"............#...", _
+			"################", _
+			"............#..#" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( stepCoords )
+		hBegin( )
+		'' (2,1)-(7,4)
+		line img, (2,1)-step(5,3), C
+		'' from the last point, (7,4)-(10,1)
+		line img, -(10,1), C
+		'' (11,3)-(14,6)
+		line img, step(1,2)-step(3,3), C
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			"..#.......#.....", _
+			"...##....#......", _
+			".....##.#..#....", _
+			".......#....#...", _
+			".............#..", _
+			"..............#.", _
+			"................", _
+			"................", _
+			"................" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	'' the style starts at the first point, also when it is clipped away
+	TEST( styleMask )
+		hBegin( )
+		line img, (0,1)-(15,1), C, , &hF0F0
+		line img, (15,3)-(0,3), C, , &hCCCC
+		line img, (-5,5)-(15,5), C, , &hF0F0
+		line img, (1,7)-(13,9), C, , &hAAAA
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			"####....####....", _
+			"................", _
+			"..##..##..##..##", _
+			"................", _
+			"...####....####.", _
+			"................", _
+			".#.#............", _
+			".....#.#.#......", _
+			"...........#.#.." _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( box )
+		hBegin( )
+		line img, (1,1)-(6,5), C, B
+		line img, (14,8)-(9,2), C, BF
+		line img, (-2,7)-(4,12), C, B
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			".######.........", _
+			".#....#..######.", _
+			".#....#..######.", _
+			".#....#..######.", _
+			".######..######.", _
+			".........######.", _
+			"#####....######.", _
+			"....#....######.", _
+			"....#..........." _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( boxStyle )
+		hBegin( )
+		line img, (1,1)-(14,8), C, B, &hCCCC
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			".#.##..##..##.#.", _
+			".#............#.", _
+			"................", _
+			"................", _
+			".#............#.", _
+			".#............#.", _
+			"................", _
+			".##..##..##..##.", _
+			"................" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( circle_ )
+		hBegin( )
+		circle img, (5,4), 4, C
+		circle img, (15,9), 5, C
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"....###.........", _
+			"...#...#........", _
+			"..#.....#.......", _
+			".#.......#......", _
+			".#.......#....##", _
+			".#.......#..##..", _
+			"..#.....#..#....", _
+			"...#...#...#....", _
+			"....###...#.....", _
+			"..........#....." _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( circleFillStep )
+		hBegin( )
+		circle img, (3,4), 2, C, , , , F
+		'' ellipse around (11,5), relative to the last center
+		circle img, step(8,1), 4, C, , , 0.5
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			"................", _
+			"...#............", _
+			"..###....#####..", _
+			".#####..#.....#.", _
+			"..###..#.......#", _
+			"...#....#.....#.", _
+			".........#####..", _
+			"................", _
+			"................" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	TEST( polyLine )
+		hBegin( )
+		dim as single pts(0 to 11) = { 1,1, 14,1, 14,8, 1,8, 1,3, 10,3 }
+		fb.PolyLine( img, @pts(0), 6, C )
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"................", _
+			".##############.", _
+			"..............#.", _
+			".##########...#.", _
+			".#............#.", _
+			".#............#.", _
+			".#............#.", _
+			".#............#.", _
+			".##############.", _
+			"................" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	'' every segment restarts the style, as separate LINEs would
+	TEST( lineSegments )
+		hBegin( )
+		dim as single segs(0 to 11) = { 0,0, 15,9,  15,0, 0,9,  -4,4, 20,4 }
+		fb.LineSegments( img, @segs(0), 3, C, &hF0F0 )
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"#..............#", _
+			".##..........##.", _
+			"...#........#...", _
+			"................", _
+			"....####....####", _
+			"......####......", _
+			".....#....#.....", _
+			"....#......#....", _
+			"................", _
+			"................" _
+		}
+		hCheck( expected() )
+	END_TEST
+
+	'' an 8bpp image on a 32bpp screen
+	TEST( imageDepth )
+		hBegin( 8 )
+		line img, (-3,4)-(20,4), 15
+		line img, (3,-3)-(3,20), 15
+
+		dim as string expected(0 to H-1) = _
+		{ _
+			"...#............", _
+			"...#............", _
+			"...#............", _
+			"...#............", _
+			"################", _
+			"...#............", _
+			"...#............", _
+			"...#............", _
+			"...#............", _
+			"...#............" _
+		}
+		hCheck( expected(), 15 )
+	END_TEST
+
+END_SUITE
@@ -0,0 +1,143 @@
+#include "fbcunit.bi"
+
+'' Bound checks on a FOR counter are dropped when the counter's range fits
+'' the array's bounds, and -exx checks are done inline by the C/LLVM
+'' backends. The results must be the same with and without -exx, and the
+'' checks that can fail must still be there (only tested with -exx).
+
+#define ERR_OUTOFBOUNDS 6
+#define ERR_NULLPTR     7
+
+SUITE( fbc_tests.optimizations.boundchk_for )
+
+	'' counter range within the bounds: check dropped
+	TEST( inRange )
+		dim as integer a(0 to 9), b(-5 to 5), sum = 0
+
+		for i as integer = 0 to 9
+			a(i) = i
+		next
+		for i as integer = 9 to 0 step -1
+			sum += a(i)
+		next
+		CU_ASSERT_EQUAL( sum, 45 )
+
+		for i as integer = -5 to 5
+			b(i) = i * 2
+		next
+		CU_ASSERT_EQUAL( b(-5), -10 )
+		CU_ASSERT_EQUAL( b(5), 10 )
+
+		'' unsigned counters, widened to the signed INTEGER index: check
+		'' dropped too
+		dim as ubyte c(0 to 255)
+		for i as ubyte = 0 to 254
+			c(i) = i
+		next
+		CU_ASSERT_EQUAL( c(254), 254 )
+		CU_ASSERT_EQUAL( c(255), 0 )
+
+		dim as ushort d(0 to 1000)
+		for i as ushort = 1000 to 1 step -1
+			d(i) = i
+		next
+		CU_ASSERT_EQUAL( d(0), 0 )
+		CU_ASSERT_EQUAL( d(1), 1 )
+		CU_ASSERT_EQUAL( d(1000), 1000 )
+	END_TEST
+
+#if __FB_ERR__ and &h0008
+
+	'' 0 to 300 fits a(0 to 300), but cbyte(i) wraps around to -128..127,
+	'' so the check must stay
+	private function hNarrowedCounter( ) as integer
+		dim as integer a(0 to 300)
+		on local error goto failed
+		for i as integer = 0 to 300
+			a(cbyte(i)) = i
+		next
+		return 0
+	failed:
+		return err( )
+	end function
+
+	'' the counter changes in the body, so its range isn't known
+	private function hChangedCounter( ) as integer
+		dim as integer a(0 to 9)
+		on local error goto failed
+		for i as integer = 0 to 9
+			i += 5
+			a(i) = i
+		next
+		return 0
+	failed:
+		return err( )
+	end function
+
+	'' not the counter itself
+	private function hCounterExpr( ) as integer
+		dim as integer a(0 to 9)
+		on local error goto failed
+		for i as integer = 0 to 9
+			a(i + 1) = i
+		next
+		return 0
+	failed:
+		return err( )
+	end function
+
+	private function hIndex( a() as integer, byval i as integer ) as integer
+		on local error goto failed
+		a(i) = i
+		return 0
+	failed:
+		return err( )
+	end function
+
+	TEST( narrowedCounter )
+		CU_ASSERT_EQUAL( hNarrowedCounter( ), ERR_OUTOFBOUNDS )
+	END_TEST
+
+	TEST( changedCounter )
+		CU_ASSERT_EQUAL( hChangedCounter( ), ERR_OUTOFBOUNDS )
+		CU_ASSERT_EQUAL( hCounterExpr( ), ERR_OUTOFBOUNDS )
+	END_TEST
+
+	'' inline checks: lbound <> 0 is a single unsigned compare too
+	TEST( inlineBoundChk )
+		dim as integer a(), b()
+		redim a(0 to 4)
+		redim b(1 to 5)
+
+		CU_ASSERT_EQUAL( hIndex( a(), 0 ), 0 )
+		CU_ASSERT_EQUAL( hIndex( a(), 4 ), 0 )
+		CU_ASSERT_EQUAL( hIndex( a(), -1 ), ERR_OUTOFBOUNDS )
+		CU_ASSERT_EQUAL( hIndex( a(), 5 ), ERR_OUTOFBOUNDS )
+
+		CU_ASSERT_EQUAL( hIndex( b(), 1 ), 0 )
+		CU_ASSERT_EQUAL( hIndex( b(), 5 ), 0 )
+		CU_ASSERT_EQUAL( hIndex( b(), 0 ), ERR_OUTOFBOUNDS )
+		CU_ASSERT_EQUAL( hIndex( b(), 6 ), ERR_OUTOFBOUNDS )
+		CU_ASSERT_EQUAL( hIndex( b(), -&h7FFFFFFF ), ERR_OUTOFBOUNDS )
+	END_TEST
+
+#endif
+
+#if __FB_ERR__ and &h0010
+
+	private function hDeref( byval p as integer ptr ) as integer
+		on local error goto failed
+		return *p
+	failed:
+		return -err( )
+	end function
+
+	TEST( inlineNullPtrChk )
+		dim as integer i = 123
+		CU_ASSERT_EQUAL( hDeref( @i ), 123 )
+		CU_ASSERT_EQUAL( hDeref( 0 ), -ERR_NULLPTR )
+	END_TEST
+
+#endif
+
+END_SUITE
@@ -0,0 +1,283 @@
+' TEST_MODE : MULTI_MODULE_TEST
+
+'' FOR loops unrolled by -vec (see vector-for.bmk) must give the same results
+'' as the same loops written with WHILE, which are never unrolled: for every
+'' trip count from 0 to 2*W+1 (W = 4 SINGLEs or 2 DOUBLEs per vector), with
+'' dependences between the iterations, pointers overlapping by less than a
+'' vector, and unsigned counters
+
+const N = 32
+
+'' constant bounds, the ones below W-1 aren't unrolled at all
+#macro hConstLoop( P, LO, HI )
+	P##Init( )
+
+	for i as integer = LO to HI
+		P##c(i) = P##a(i) - P##b(i)
+	next
+
+	j = LO
+	while( j <= HI )
+		P##rc(j) = P##ra(j) - P##rb(j)
+		j += 1
+	wend
+
+	P##Check( )
+#endmacro
+
+#macro hDefineTests( T, W, P )
+
+dim shared as T P##a(0 to N-1), P##b(0 to N-1), P##c(0 to N-1)
+dim shared as T P##ra(0 to N-1), P##rb(0 to N-1), P##rc(0 to N-1)
+
+private sub P##Init( )
+	dim as integer j = 0
+	while( j < N )
+		P##a(j) = j * 1.5 + 1
+		P##b(j) = 100 - j * 0.25
+		P##c(j) = -1
+		P##ra(j) = P##a(j)
+		P##rb(j) = P##b(j)
+		P##rc(j) = P##c(j)
+		j += 1
+	wend
+end sub
+
+private sub P##Check( )
+	dim as integer j = 0
+	while( j < N )
+		assert( P##a(j) = P##ra(j) )
+		assert( P##b(j) = P##rb(j) )
+		assert( P##c(j) = P##rc(j) )
+		j += 1
+	wend
+end sub
+
+'' variable bounds
+private sub P##TripCounts( )
+	dim as T k = 0.5
+	dim as integer j = any, hi = any
+
+	for lo as integer = 0 to W
+		for n as integer = 0 to 2*W+1
+			hi = lo + n - 1
+
+			P##Init( )
+
+			for i as integer = lo to hi
+				P##c(i) = P##a(i) * P##b(i) + k
+			next
+
+			j = lo
+			while( j <= hi )
+				P##rc(j) = P##ra(j) * P##rb(j) + k
+				j += 1
+			wend
+
+			P##Check( )
+		next
+	next
+end sub
+
+private sub P##ConstTripCounts( )
+	dim as integer j = any
+
+	hConstLoop( P, 0, -1 )
+	hConstLoop( P, 0, 0 )
+	hConstLoop( P, 0, 1 )
+	hConstLoop( P, 0, 2 )
+	hConstLoop( P, 0, 3 )
+	hConstLoop( P, 0, 4 )
+	hConstLoop( P, 0, 5 )
+	hConstLoop( P, 0, 6 )
+	hConstLoop( P, 0, 7 )
+	hConstLoop( P, 0, 8 )
+	hConstLoop( P, 0, 9 )
+	hConstLoop( P, 3, 12 )
+end sub
+
+'' a(i+1) = a(i) reads what the previous iteration stored, a(i) = a(i+1)
+'' what the next one will overwrite
+private sub P##Dependences( )
+	dim as integer j = any, hi = any
+
+	for lo as integer = 0 to W
+		for n as integer = 0 to 2*W+1
+			hi = lo + n - 1
+
+			P##Init( )
+
+			for i as integer = lo to hi
+				P##a(i+1) = P##a(i)
+			next
+
+			for i as integer = lo to hi
+				P##b(i) = P##b(i+1) + P##a(i)
+			next
+
+			j = lo
+			while( j <= hi )
+				P##ra(j+1) = P##ra(j)
+				j += 1
+			wend
+
+			j = lo
+			while( j <= hi )
+				P##rb(j) = P##rb(j+1) + P##ra(j)
+				j += 1
+			wend
+
+			P##Check( )
+		next
+	next
+end sub
+
+'' several statements, the later ones reading what the earlier ones stored,
+'' behind or ahead of it
+private sub P##MultiStmts( )
+	dim as T k = 2
+	dim as integer j = any, hi = any
+
+	for lo as integer = 1 to W + 1
+		for n as integer = 0 to 2*W+1
+			hi = lo + n - 1
+
+			P##Init( )
+
+			for i as integer = lo to hi
+				P##b(i) = P##a(i) * k
+				P##c(i) = P##b(i) + P##a(i+1)
+				P##a(i) = P##c(i) - P##b(i-1)
+			next
+
+			j = lo
+			while( j <= hi )
+				P##rb(j) = P##ra(j) * k
+				P##rc(j) = P##rb(j) + P##ra(j+1)
+				P##ra(j) = P##rc(j) - P##rb(j-1)
+				j += 1
+			wend
+
+			P##Check( )
+
+			P##Init( )
+
+			for i as integer = lo to hi
+				P##c(i) = P##a(i) + k
+				P##a(i) = P##c(i+1) * k
+			next
+
+			j = lo
+			while( j <= hi )
+				P##rc(j) = P##ra(j) + k
+				P##ra(j) = P##rc(j+1) * k
+				j += 1
+			wend
+
+			P##Check( )
+		next
+	next
+end sub
+
+'' p and q into the same array, from 2*W elements apart to overlapping
+private sub P##Pointers( )
+	dim as T k = 3, k2 = 0.25
+	dim as T ptr p = any, q = any
+	dim as integer j = any
+
+	for d as integer = -2*W to 2*W
+		for n as integer = 0 to 2*W+1
+			P##Init( )
+
+			p = @P##a(2*W + 2 + d)
+			q = @P##a(2*W + 2)
+			for i as integer = 0 to n - 1
+				p[i] = q[i] * k + k2
+			next
+
+			p = @P##ra(2*W + 2 + d)
+			q = @P##ra(2*W + 2)
+			j = 0
+			while( j < n )
+				p[j] = q[j] * k + k2
+				j += 1
+			wend
+
+			P##Check( )
+		next
+	next
+end sub
+
+'' end - (W-1) wraps around for unsigned counters with an end below W-1
+private sub P##Unsigned( )
+	dim as uinteger e = any, j = any
+	dim as ulong e32 = any, j32 = any
+
+	for lo as uinteger = 0 to W
+		for n as uinteger = 0 to 2*W+1
+			'' (no end below 0)
+			if( lo + n = 0 ) then
+				continue for
+			end if
+
+			e = lo + n - 1
+			e32 = e
+
+			P##Init( )
+
+			for i as uinteger = lo to e
+				P##c(i) = P##a(i) + P##b(i)
+			next
+
+			for i as ulong = lo to e32
+				P##a(i) = P##b(i) * P##b(i)
+			next
+
+			j = lo
+			while( j <= e )
+				P##rc(j) = P##ra(j) + P##rb(j)
+				j += 1
+			wend
+
+			j32 = lo
+			while( j32 <= e32 )
+				P##ra(j32) = P##rb(j32) * P##rb(j32)
+				j32 += 1
+			wend
+
+			P##Check( )
+		next
+	next
+
+	P##Init( )
+
+	for i as uinteger = 0 to 0
+		P##c(i) = P##a(i) * P##b(i)
+	next
+	for i as uinteger = 1 to 2
+		P##c(i) = P##a(i) * P##b(i)
+	next
+	for i as uinteger = 3 to 2
+		P##c(i) = P##a(i) * P##b(i)
+	next
+
+	j = 0
+	while( j <= 2 )
+		P##rc(j) = P##ra(j) * P##rb(j)
+		j += 1
+	wend
+
+	P##Check( )
+end sub
+
+P##TripCounts( )
+P##ConstTripCounts( )
+P##Dependences( )
+P##MultiStmts( )
+P##Pointers( )
+P##Unsigned( )
+
+#endmacro
+
+hDefineTests( single, 4, s )
+hDefineTests( double, 2, d )
@@ -0,0 +1,159 @@
+' TEST_MODE : MULTI_MODULE_TEST
+
+'' DATA/READ/RESTORE with typed DATA tables, built with -z typed-data (see
+'' data-typed.bmk); the results must be the same as with the text DATA
+
+data_first:
+data 1, 2, 3
+
+data_long:
+data -1, 2147483647, -2147483648
+
+data_longint:
+data 2147483648, -9223372036854775807, &hFF
+
+data_double:
+data 0.5, -1.25, 3
+
+data_text:
+data 1e3, 18446744073709551615, "abc", "12.5"
+
+data_mixed:
+data 7, "x", 2.5, 8
+
+data_label:
+data 100
+data_label2:
+data 200, 300
+
+dim as integer i
+dim as longint l
+dim as ulongint ul
+dim as double d
+dim as single f
+dim as byte b
+dim as ubyte ub
+dim as short sh
+dim as boolean bo
+dim as string s
+dim as wstring * 32 w
+dim as zstring * 32 z
+
+'' numbers into all kinds of types
+restore data_long
+read i, l, d
+assert( i = -1 )
+assert( l = 2147483647 )
+assert( d = -2147483648 )
+
+restore data_longint
+read l, l
+assert( l = -9223372036854775807 )
+read ub
+assert( ub = 255 )
+
+restore data_long
+read b, ub, sh
+assert( b = -1 )
+assert( ub = 255 )
+assert( sh = 0 )
+
+restore data_double
+read d, f, i
+assert( d = 0.5 )
+assert( f = -1.25 )
+assert( i = 3 )
+
+'' a double into an integer stops at the decimal point, as with text DATA
+restore data_double
+read i, l
+assert( i = 0 )
+assert( l = -1 )
+
+restore data_first
+read bo, bo
+assert( bo = true )
+
+'' numbers into strings give the DATA's text back
+restore data_long
+read s
+assert( s = "-1" )
+read w
+assert( w = "2147483647" )
+read z
+assert( z = "-2147483648" )
+
+restore data_double
+read s, w
+assert( s = "0.5" )
+assert( w = "-1.25" )
+
+'' values that stay text
+restore data_text
+read d, ul, s, d
+assert( d = 12.5 )
+assert( ul = 18446744073709551615ull )
+assert( s = "abc" )
+
+restore data_text
+read s, s
+assert( s = "18446744073709551615" )
+read w, i
+assert( w = "abc" )
+assert( i = 12 )
+
+'' tables and text in the same DATA
+restore data_mixed
+read i, s, d, l
+assert( i = 7 )
+assert( s = "x" )
+assert( d = 2.5 )
+assert( l = 8 )
+
+'' RESTORE to a label between DATA statements, and reading on across them
+restore data_label2
+read i
+assert( i = 200 )
+restore data_label
+read i, l, d
+assert( i = 100 )
+assert( l = 200 )
+assert( d = 300 )
+
+'' READ array()
+dim as long a(0 to 4)
+restore data_first
+read a()
+assert( a(0) = 1 )
+assert( a(2) = 3 )
+assert( a(3) = -1 )
+assert( a(4) = 2147483647 )
+
+dim as double da(1 to 3)
+restore data_double
+read da()
+assert( da(1) = 0.5 )
+assert( da(2) = -1.25 )
+assert( da(3) = 3 )
+
+'' blank RESTORE goes back to the first DATA
+read i
+restore
+read i
+assert( i = 1 )
+
+'' every thread starts at the first DATA, and has its own cursor
+sub reader( byval p as any ptr )
+	dim as integer ptr v = p
+	read v[0], v[1]
+end sub
+
+restore data_label2
+dim as integer v(0 to 1)
+dim as any ptr t = threadcreate( @reader, @v(0) )
+threadwait( t )
+assert( v(0) = 1 )
+assert( v(1) = 2 )
+
+read i
+assert( i = 200 )
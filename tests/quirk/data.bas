@@ -13,6 +13,10 @@ data "-4", "-5", "-6"
 data_3:
 data 1/2, 2/2, 3/2, 4/2, 5/2, 6/2
 
+data_4:
+data 10, 20, 30, 40
+data "a", "b", 7
+
 SUITE( fbc_tests.quirk.data_ )
 
 	TEST( integer_ )
@@ -50,4 +54,36 @@ SUITE( fbc_tests.quirk.data_ )
 
 	END_TEST
 
+	TEST( array_ )
+		dim as long a(1 to 2, 0 to 1)
+		dim as string s(0 to 1)
+		dim as double d(0 to 1)
+		dim as integer i
+
+		'' READ array() reads all elements in memory order
+		restore data_4
+		read a(), s(), i
+		CU_ASSERT_EQUAL( a(1, 0), 10 )
+		CU_ASSERT_EQUAL( a(1, 1), 20 )
+		CU_ASSERT_EQUAL( a(2, 0), 30 )
+		CU_ASSERT_EQUAL( a(2, 1), 40 )
+		CU_ASSERT_EQUAL( s(0), "a" )
+		CU_ASSERT_EQUAL( s(1), "b" )
+		CU_ASSERT_EQUAL( i, 7 )
+
+		restore data_3
+		read d()
+		CU_ASSERT_EQUAL( d(0), 0.5 )
+		CU_ASSERT_EQUAL( d(1), 1.0 )
+
+		'' and doesn't read past the last DATA
+		restore data_4
+		redim as integer b(0 to 2)
+		read b()
+		read i
+		CU_ASSERT_EQUAL( b(2), 30 )
+		CU_ASSERT_EQUAL( i, 40 )
+
+	END_TEST
+
 END_SUITE
@@ -0,0 +1,65 @@
+' TEST_MODE : COMPILE_AND_RUN_OK
+
+#lang "fblite"
+option gosub
+
+'' GOSUB nesting deeper than the index stack kept in the procedure's frame
+'' (256 entries with -gen gcc/llvm) must still return to the right places
+
+const DEPTH = 1000
+
+dim shared as integer level, maxlevel, returns
+
+sub recurse( byval n as integer )
+	level = 0
+	maxlevel = 0
+	returns = 0
+	gosub down
+	assert( level = 0 )
+	assert( maxlevel = n )
+	assert( returns = n )
+	exit sub
+
+down:
+	level += 1
+	if( level > maxlevel ) then maxlevel = level
+	if( level < n ) then gosub down
+	level -= 1
+	returns += 1
+	return
+end sub
+
+sub ongosub( )
+	dim as integer n = 0, back = 0
+	gosub down
+	assert( n = DEPTH )
+	assert( back = DEPTH )
+	exit sub
+
+down:
+	n += 1
+	if( n < DEPTH ) then on 1 gosub down
+	back += 1
+	return
+end sub
+
+recurse( 10 )
+recurse( DEPTH )
+'' again, after the heap block was freed at the previous exit
+recurse( DEPTH )
+recurse( 256 )
+recurse( 257 )
+ongosub( )
+
+'' module level
+dim as integer n, back
+gosub down
+assert( n = DEPTH )
+assert( back = DEPTH )
+end
+
+down:
+	n += 1
+	if( n < DEPTH ) then gosub down
+	back += 1
+	return
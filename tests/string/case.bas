@@ -146,4 +146,20 @@ SUITE( fbc_tests.string_.case_ )
 		CU_ASSERT( ucase( w, 1 ) = wstr( !"FOO\nFOOAA" ) )
 	END_TEST
 
+	TEST( longStrings )
+		'' converted in blocks, the rest char by char
+		dim as string lower, upper
+		for i as integer = 0 to 100
+			CU_ASSERT( ucase( lower, 1 ) = upper )
+			CU_ASSERT( lcase( upper, 1 ) = lower )
+			CU_ASSERT( ucase( wstr( lower ) ) = wstr( upper ) )
+			CU_ASSERT( lcase( wstr( upper ) ) = wstr( lower ) )
+			lower &= chr( asc( "a" ) + (i mod 26) ) & "@["
+			upper &= chr( asc( "A" ) + (i mod 26) ) & "@["
+		next
+
+		'' non-ASCII chars are left alone in ASCII-only mode
+		CU_ASSERT( ucase( string( 40, "a" ) & chr( 228 ) & string( 40, "b" ), 1 ) = string( 40, "A" ) & chr( 228 ) & string( 40, "B" ) )
+	END_TEST
+
 END_SUITE
@@ -0,0 +1,76 @@
+# include "fbcunit.bi"
+
+#include "fbstrbuilder.bi"
+
+SUITE( fbc_tests.string_.strbuilder )
+
+	TEST( append )
+		dim as string sb
+		dim as zstring * 4 z = "xyz"
+
+		StrReserve( sb, 100 )
+		CU_ASSERT( StrCapacity( sb ) >= 100 )
+		CU_ASSERT_EQUAL( len( sb ), 0 )
+
+		StrAppend( sb, "a" )
+		StrAppendChar( sb, asc( "," ) )
+		StrAppendInt( sb, -123 )
+		StrAppendChar( sb, asc( "," ) )
+		StrAppendUInt( sb, &hFFFFFFFFFFFFFFFFull )
+		StrAppendChar( sb, asc( "," ) )
+		StrAppendDouble( sb, 0.5 )
+		StrAppendChar( sb, asc( "," ) )
+		StrAppendSingle( sb, 2.0 )
+		StrAppendChar( sb, asc( "-" ), 3 )
+		StrAppendBuf( sb, @z, 2 )
+
+		CU_ASSERT_EQUAL( sb, "a,-123,18446744073709551615,0.5,2---xy" )
+	END_TEST
+
+	TEST( same_as_str )
+		dim as string sb
+		dim as double d = 1 / 3
+
+		StrAppendInt( sb, -9223372036854775807ll - 1 )
+		StrAppendDouble( sb, d )
+		StrAppendDouble( sb, 1e300 )
+		CU_ASSERT_EQUAL( sb, str( -9223372036854775807ll - 1 ) + str( d ) + str( 1e300 ) )
+	END_TEST
+
+	TEST( grow )
+		dim as string sb, expected
+
+		for i as integer = 1 to 1000
+			StrAppendInt( sb, i )
+			StrAppendChar( sb, 10 )
+			expected += str( i ) + chr( 10 )
+		next
+		CU_ASSERT_EQUAL( sb, expected )
+
+		'' appending to itself
+		StrAppend( sb, sb )
+		CU_ASSERT_EQUAL( sb, expected + expected )
+	END_TEST
+
+	TEST( clear_take )
+		dim as string sb, s
+
+		StrAppend( sb, "hello" )
+		dim as integer capacity = StrCapacity( sb )
+
+		StrClear( sb )
+		CU_ASSERT_EQUAL( sb, "" )
+		CU_ASSERT_EQUAL( StrCapacity( sb ), capacity )
+
+		StrAppend( sb, "world" )
+		dim as any ptr p = strptr( sb )
+		s = StrTake( sb )
+		CU_ASSERT_EQUAL( s, "world" )
+		CU_ASSERT_EQUAL( sb, "" )
+		CU_ASSERT_EQUAL( StrCapacity( sb ), 0 )
+
+		'' no copy
+		CU_ASSERT( strptr( s ) = p )
+	END_TEST
+
+END_SUITE
@@ -297,4 +297,25 @@ SUITE( fbc_tests.string_.trim_ )
 
 	END_TEST
 
+	TEST( longStrings )
+		'' long enough runs to be scanned in blocks, with the first
+		'' char that stops the scan at every position of a block
+		for i as integer = 0 to 70
+			dim s as string = space( i ) & "x" & space( 70 - i ) & "y" & space( i )
+			CU_ASSERT( trim( s ) = "x" & space( 70 - i ) & "y" )
+			CU_ASSERT( ltrim( s ) = "x" & space( 70 - i ) & "y" & space( i ) )
+			CU_ASSERT( rtrim( s ) = space( i ) & "x" & space( 70 - i ) & "y" )
+
+			s = string( i, "a" ) & !"\t" & string( i, "b" ) & "c" & string( i, "a" )
+			CU_ASSERT( trim( s, any "ab" ) = !"\t" & string( i, "b" ) & "c" )
+			CU_ASSERT( trim( s, any "abc" ) = !"\t" )
+			CU_ASSERT( ltrim( s, any "ab" ) = !"\t" & string( i, "b" ) & "c" & string( i, "a" ) )
+			CU_ASSERT( rtrim( s, any "ab" ) = string( i, "a" ) & !"\t" & string( i, "b" ) & "c" )
+
+			dim w as wstring * 256 = wspace( i ) & "x" & wspace( i )
+			CU_ASSERT( trim( w ) = "x" )
+			CU_ASSERT( trim( w, any " x" ) = "" )
+		next
+	END_TEST
+
 END_SUITE
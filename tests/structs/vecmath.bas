@@ -0,0 +1,179 @@
+#include "fbcunit.bi"
+
+#include "fbvecmath.bi"
+
+SUITE( fbc_tests.structs.vecmath )
+
+	TEST( vec4f )
+		dim as single x(0 to 7) = { 1, 2, 3, 4, 5, 6, 7, 8 }
+		dim as single y(0 to 7)
+		dim as Vec4f a, b, c
+
+		a = Vec4fLoad( @x(0) )
+		b = Vec4fLoad( @x(4) )
+
+		c = a + b
+		CU_ASSERT_EQUAL( c.x, 6 )
+		CU_ASSERT_EQUAL( c.w, 12 )
+
+		c = b - a * 2.0f
+		CU_ASSERT_EQUAL( c.x, 3 )
+		CU_ASSERT_EQUAL( c.y, 2 )
+		CU_ASSERT_EQUAL( c.z, 1 )
+		CU_ASSERT_EQUAL( c.w, 0 )
+
+		c = -(b / a)
+		CU_ASSERT_EQUAL( c.x, -5 )
+		CU_ASSERT_EQUAL( c.y, -3 )
+
+		Vec4fStore( @y(1), a * b )
+		CU_ASSERT_EQUAL( y(0), 0 )
+		CU_ASSERT_EQUAL( y(1), 5 )
+		CU_ASSERT_EQUAL( y(4), 32 )
+		CU_ASSERT_EQUAL( y(5), 0 )
+
+		CU_ASSERT_EQUAL( Vec4fSum( a ), 10 )
+		CU_ASSERT_EQUAL( Vec4fDot( a, b ), 70 )
+		CU_ASSERT_EQUAL( Vec4fHMin( b ), 5 )
+		CU_ASSERT_EQUAL( Vec4fHMax( b ), 8 )
+
+		c = Vec4fSqrt( Vec4fSplat( 16 ) )
+		CU_ASSERT_EQUAL( c.x, 4 )
+		CU_ASSERT_EQUAL( c.w, 4 )
+	END_TEST
+
+	TEST( shuffle )
+		dim as Vec4f a = ( 1, 2, 3, 4 ), c
+		dim as Vec4i i = ( 10, 20, 30, 40 ), j
+		dim as Vec2d d = ( 1, 2 ), e
+		dim as ubyte idx(0 to 7) = { 7, 6, 5, 4, 3, 2, 1, 0 }
+		dim as Vec8s s, t
+
+		c = Vec4fShuffle( a, 3, 2, 1, 0 )
+		CU_ASSERT_EQUAL( c.x, 4 )
+		CU_ASSERT_EQUAL( c.y, 3 )
+		CU_ASSERT_EQUAL( c.z, 2 )
+		CU_ASSERT_EQUAL( c.w, 1 )
+
+		'' indices wrap around
+		j = Vec4iShuffle( i, 0, 0, 5, 7 )
+		CU_ASSERT_EQUAL( j.x, 10 )
+		CU_ASSERT_EQUAL( j.y, 10 )
+		CU_ASSERT_EQUAL( j.z, 20 )
+		CU_ASSERT_EQUAL( j.w, 40 )
+
+		e = Vec2dShuffle( d, 1, 0 )
+		CU_ASSERT_EQUAL( e.x, 2 )
+		CU_ASSERT_EQUAL( e.y, 1 )
+
+		for k as integer = 0 to 7
+			cptr( short ptr, @s )[k] = k
+		next
+		t = Vec8sShuffle( s, @idx(0) )
+		for k as integer = 0 to 7
+			CU_ASSERT_EQUAL( cptr( short ptr, @t )[k], 7 - k )
+		next
+	END_TEST
+
+	TEST( integer_ops )
+		dim as Vec4i a = ( 1, -2, 3, -4 ), b = ( &hF0, &h0F, &hFF, 0 ), c
+		dim as short src(0 to 7) = { 1, 2, 3, 4, 5, 6, 7, 32767 }
+		dim as Vec8s s, t
+
+		c = Vec4iMax( a, Vec4iSplat( 0 ) )
+		CU_ASSERT_EQUAL( c.x, 1 )
+		CU_ASSERT_EQUAL( c.y, 0 )
+		CU_ASSERT_EQUAL( c.w, 0 )
+
+		c = (b and Vec4iSplat( &h3C )) shl 1
+		CU_ASSERT_EQUAL( c.x, &h60 )
+		CU_ASSERT_EQUAL( c.y, &h18 )
+		CU_ASSERT_EQUAL( c.z, &h78 )
+		CU_ASSERT_EQUAL( Vec4iHMin( a ), -4 )
+		CU_ASSERT_EQUAL( Vec4iSum( a ), -2 )
+
+		s = Vec8sLoad( @src(0) )
+		t = s + Vec8sSplat( 1 )
+		CU_ASSERT_EQUAL( t.e0, 2 )
+		'' wraps around like SHORT
+		CU_ASSERT_EQUAL( t.e7, -32768 )
+		CU_ASSERT_EQUAL( Vec8sHMin( t ), -32768 )
+		'' but the sum doesn't
+		CU_ASSERT_EQUAL( Vec8sSum( s ), 32767 + 28 )
+
+		t = (s * 2) shr 1
+		CU_ASSERT_EQUAL( t.e0, 1 )
+		CU_ASSERT_EQUAL( t.e7, -1 )
+	END_TEST
+
+	TEST( vec2d )
+		dim as double x(0 to 3) = { 0.5, 1.5, 2.5, 3.5 }
+		dim as Vec2d a, b
+
+		a = Vec2dLoad( @x(0) )
+		b = Vec2dLoad( @x(2) )
+
+		Vec2dStore( @x(0), a * b + Vec2dSplat( 1 ) )
+		CU_ASSERT_EQUAL( x(0), 2.25 )
+		CU_ASSERT_EQUAL( x(1), 6.25 )
+		CU_ASSERT_EQUAL( Vec2dDot( a, b ), 6.5 )
+		CU_ASSERT_EQUAL( Vec2dHMax( Vec2dMin( a, b ) ), 1.5 )
+	END_TEST
+
+#if __FB_BACKEND__ = "gcc"
+	type Outer
+		a as byte
+		v as Vec4f
+	end type
+
+	private function hTwice( byval v as Vec4i ) as Vec4i
+		return v + v
+	end function
+
+	private sub hNegate( byref v as Vec4i )
+		v = -v
+	end sub
+
+	'' the operators that are only built in for the gcc vector types
+	TEST( builtin )
+		dim as Vec4i a = ( 7, -7, 100, 3 ), b
+		dim as Vec4f f = ( 1, 2, 4, 8 ), g
+		dim as Outer o
+
+		'' laid out like the plain UDT
+		CU_ASSERT_EQUAL( sizeof( Vec4f ), 16 )
+		CU_ASSERT_EQUAL( sizeof( Outer ), 20 )
+		CU_ASSERT_EQUAL( offsetof( Outer, v ), 4 )
+
+		b = a \ 2
+		CU_ASSERT_EQUAL( b.x, 3 )
+		CU_ASSERT_EQUAL( b.y, -3 )
+		b = a mod Vec4iSplat( 4 )
+		CU_ASSERT_EQUAL( b.x, 3 )
+		CU_ASSERT_EQUAL( b.y, -3 )
+		CU_ASSERT_EQUAL( b.z, 0 )
+		b = not a
+		CU_ASSERT_EQUAL( b.x, -8 )
+		CU_ASSERT_EQUAL( b.w, -4 )
+
+		'' scalar on the lhs
+		g = 16.0f / f
+		CU_ASSERT_EQUAL( g.x, 16 )
+		CU_ASSERT_EQUAL( g.w, 2 )
+
+		'' in memory like any other UDT
+		o.v = f * f
+		o.v += f
+		CU_ASSERT_EQUAL( o.v.y, 6 )
+		CU_ASSERT_EQUAL( o.v.w, 72 )
+		CU_ASSERT_EQUAL( (f - 1).z, 3 )
+
+		b = hTwice( a - 1 )
+		CU_ASSERT_EQUAL( b.x, 12 )
+		CU_ASSERT_EQUAL( b.z, 198 )
+		hNegate( b )
+		CU_ASSERT_EQUAL( b.y, 16 )
+	END_TEST
+#endif
+
+END_SUITE
@@ -0,0 +1,10 @@
+' TEST_MODE : COMPILE_ONLY_FAIL
+
+'' no constructors or destructor
+type V vector
+	as single x, y, z, w
+	declare constructor( )
+end type
+
+constructor V( )
+end constructor
@@ -0,0 +1,6 @@
+' TEST_MODE : COMPILE_ONLY_FAIL
+
+'' 2, 4, 8, ... elements
+type V vector
+	as single x, y, z
+end type
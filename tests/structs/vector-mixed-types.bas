@@ -0,0 +1,7 @@
+' TEST_MODE : COMPILE_ONLY_FAIL
+
+'' all fields must have the same type
+type V vector
+	as single x, y
+	as long z, w
+end type
@@ -0,0 +1,9 @@
+' TEST_MODE : COMPILE_ONLY_FAIL
+
+'' no relational operators
+type V vector
+	as long x, y, z, w
+end type
+
+dim as V a, b
+print a < b